@@ -6,6 +6,11 @@
  */
 
 #include "GameManager.h"
+#include "Engine/Components/Animator/AnimatorComponent.h"
+#include "Engine/Components/Collision/AABBCollider.h"
+#include "Engine/Components/Collision/OBBCollider.h"
+#include "Engine/Components/Collision/SphereCollider.h"
+#include "Engine/Components/Model/ModelComponent.h"
 
 void GameManager::Initialize()
 {
@@ -21,6 +26,14 @@ void GameManager::Initialize()
 	gameObjectFactory_ = std::make_unique<GameObjectFactory>();
 	gameObjectManager_->SetGameObjectFactory(gameObjectFactory_.get());
 
+	//コンポーネントのストレージを登録（依存される種類から順に更新される、アニメーターを持つモデルはアニメーターが更新する）
+	gameObjectManager_->RegisterComponentStorage<TransformComponent>();
+	gameObjectManager_->RegisterComponentStorage<AnimatorComponent>();
+	gameObjectManager_->RegisterComponentStorage<ModelComponent>();
+	gameObjectManager_->RegisterComponentStorage<AABBCollider>();
+	gameObjectManager_->RegisterComponentStorage<OBBCollider>();
+	gameObjectManager_->RegisterComponentStorage<SphereCollider>();
+
 	//衝突属性の追加
 	collisionAttributeManager_->AddAttribute("Player",          0b0000001, 0b0011100);
 	collisionAttributeManager_->AddAttribute("PlayerWeapon",    0b0000010, 0b0010100);
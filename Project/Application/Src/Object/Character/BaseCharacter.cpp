@@ -9,6 +9,27 @@
 #include "Engine/Framework/Object/GameObjectManager.h"
 #include "Application/Src/Object/Magic/Magic.h"
 
+void BaseCharacter::RequestAssets(const std::string& name)
+{
+    //音声の読み込みを要求
+    std::map<std::string, std::string> audioFiles{};
+    LoadResourceFromCSV("Application/Resources/Config/Sounds/" + name + "Sounds.csv", audioFiles);
+    for (const auto& [key, fileName] : audioFiles)
+    {
+        Audio::GetInstance()->LoadAudioFileAsync(fileName);
+    }
+
+    //アニメーションをまとめてベイクしたファイルの読み込みを要求
+    std::map<std::string, std::string> animations{};
+    LoadResourceFromCSV("Application/Resources/Config/Animations/" + name + "Animations.csv", animations);
+    std::vector<std::string> animationFileNames{};
+    for (const auto& [animationName, path] : animations)
+    {
+        animationFileNames.push_back(path);
+    }
+    AnimationManager::LoadBakedAnimationsAsync(name + "/Animations/" + name + "Animations.anim", animationFileNames);
+}
+
 void BaseCharacter::Initialize()
 {
     //基底クラスの初期化
@@ -301,10 +322,18 @@ void BaseCharacter::InitializeAnimator()
     //オーディオCSVを読み込む
     LoadResourceFromCSV(kFilePath, animations);
 
+    //アニメーションをまとめてベイクしたファイルから読み込む
+    std::vector<std::string> animationFileNames{};
+    for (const auto& [name, path] : animations)
+    {
+        animationFileNames.push_back(path);
+    }
+    AnimationManager::LoadBakedAnimations(name_ + "/Animations/" + name_ + "Animations.anim", animationFileNames);
+
     //読み込んだアニメーションを追加
     for (const auto& [name, path] : animations)
     {
-        animator_->AddAnimation(name, AnimationManager::Create(path));
+        animator_->AddAnimation(name, AnimationManager::Create(path, 0.0f, true));
     }
 
     //通常アニメーションを再生
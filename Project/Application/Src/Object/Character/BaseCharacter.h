@@ -33,6 +33,12 @@ public:
 	/// </summary>
 	virtual ~BaseCharacter() = default;
 
+    /// <summary>
+    /// キャラクターの音声とアニメーションの読み込みを要求（シーンの初期化の前に呼ぶ）
+    /// </summary>
+    /// <param name="name">キャラクターの名前</param>
+    static void RequestAssets(const std::string& name);
+
     /// <summary>
     /// 初期化
     /// </summary>
@@ -360,7 +366,7 @@ protected:
     /// </summary>
     /// <param name="filePath">ファイルパス</param>
     /// <param name="resourceMap">読み込んだリソースのキーとデータを格納するマップ</param>
-    void LoadResourceFromCSV(const std::string& filePath, std::map<std::string, std::string>& resourceMap);
+    static void LoadResourceFromCSV(const std::string& filePath, std::map<std::string, std::string>& resourceMap);
 
     /// <summary>
     /// 指定されたコンテナのキーを取り出し配列として返す関数
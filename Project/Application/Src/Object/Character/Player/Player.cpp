@@ -150,6 +150,34 @@ void Player::InitializeActionMap()
 	}
 }
 
+void Player::InitializeAnimator()
+{
+	//ブレンドツリーの子のアニメーション（閾値の昇順）
+	static const std::pair<const char*, float> kWalkClips[] = {
+		{ "Walk3", -1.0f },//左
+		{ "Walk1",  0.0f },//前
+		{ "Walk4",  1.0f },//右
+	};
+
+	//通常のアニメーションを追加
+	BaseCharacter::InitializeAnimator();
+
+	//単体で再生するアニメーションと時間を共有しないようにブレンドツリー用のアニメーションを別に作成して追加
+	AnimationBlendTree* blendTree = new AnimationBlendTree();
+	std::vector<std::pair<int32_t, float>> children{};
+	for (const auto& [clipName, threshold] : kWalkClips)
+	{
+		const std::string animationName = std::string(kLockonWalkBlendTreeName) + "/" + clipName;
+		Animation* animation = AnimationManager::Create(name_ + "/Animations/" + clipName + ".gltf", 0.0f, true);
+		animator_->AddAnimation(animationName, animation);
+		children.emplace_back(blendTree->AddClipNode(animation), threshold);
+	}
+
+	//歩く方向で左・前・右の歩きを補間する（歩幅が揃うように再生位置を揃える）
+	blendTree->SetRootNode(blendTree->AddBlend1DNode(kWalkDirectionParameterName, children, true));
+	animator_->AddBlendTree(kLockonWalkBlendTreeName, blendTree);
+}
+
 void Player::InitializeUISprites()
 {
 	////基底クラスの呼び出し
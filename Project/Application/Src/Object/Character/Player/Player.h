@@ -22,6 +22,10 @@ public:
     //アクションの最大数
     static const int32_t kMaxActionCount = 6;
 
+    //ロックオン中の歩きのブレンドツリーの名前とブレンドの値のパラメーターの名前（-1で左、0で前、1で右）
+    static constexpr const char* kLockonWalkBlendTreeName = "LockonWalk";
+    static constexpr const char* kWalkDirectionParameterName = "WalkDirection";
+
     //ボタンの種類を示す列挙体
     enum ButtonType
     {
@@ -183,6 +187,11 @@ private:
     /// </summary>
     void InitializeActionMap() override;
 
+    /// <summary>
+    /// アニメーターの初期化（ロックオン中の歩きのブレンドツリーを追加する）
+    /// </summary>
+    void InitializeAnimator() override;
+
     /// <summary>
     /// UIのスプライトの初期化
     /// </summary>
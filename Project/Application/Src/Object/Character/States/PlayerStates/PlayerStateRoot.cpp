@@ -158,6 +158,13 @@ void PlayerStateRoot::UpdateAnimation(const Vector3& inputValue, bool isRunning)
 		//新しいアニメーションを再生
 		SetAnimationControllerAndPlayAnimation(currentAnimationName_, true); 
 	}
+
+	//ロックオン中の歩きのブレンドツリーの場合は歩く方向を設定（後ろ向きの入力は左右のどちらかにする）
+	if (currentAnimationName_ == Player::kLockonWalkBlendTreeName)
+	{
+		const float walkDirection = std::atan2(inputValue.x, std::max(inputValue.z, 0.0f)) / (std::numbers::pi_v<float> * 0.5f);
+		character_->GetAnimator()->GetBlendTree(currentAnimationName_)->SetParameter(Player::kWalkDirectionParameterName, std::clamp(walkDirection, -1.0f, 1.0f));
+	}
 }
 
 std::string PlayerStateRoot::GetAnimationNameBasedOnLockon(const Vector3& inputValue, bool isRunning) const
@@ -173,17 +180,13 @@ std::string PlayerStateRoot::GetAnimationNameBasedOnLockon(const Vector3& inputV
 
 const std::string PlayerStateRoot::DetermineWalkingAnimation(const Vector3& inputValue) const
 {
-	//入力ベクトルの方向に応じて歩行アニメーションを決定
-	if (std::abs(inputValue.z) > std::abs(inputValue.x))
+	//後退のアニメーション
+	if (inputValue.z < 0.0f && std::abs(inputValue.z) > std::abs(inputValue.x))
 	{
-		//前進または後退のアニメーション
-		return (inputValue.z > 0.0f) ? "Walk1" : "Walk2";
-	}
-	else
-	{
-		//左右移動のアニメーション
-		return (inputValue.x < 0.0f) ? "Walk3" : "Walk4";
+		return "Walk2";
 	}
+	//前進と左右移動は歩く方向でブレンドする
+	return Player::kLockonWalkBlendTreeName;
 }
 
 const std::string PlayerStateRoot::DetermineRunningAnimation(const Vector3& inputValue) const
@@ -206,9 +209,12 @@ bool PlayerStateRoot::IsOppositeAnimation(const std::string& currentAnimationNam
 	//待機アニメーションが設定されている場合は必ず逆方向として扱う
 	if (currentAnimationName == "Idle" || animationName == "Idle") return true;
 
-	//アニメーション名の末尾の数字を比較して逆方向かどうかを判定
-	int currentNum = std::stoi(currentAnimationName.substr(currentAnimationName.size() - 1));
-	int newNum = std::stoi(animationName.substr(animationName.size() - 1));
+	//アニメーション名の末尾の数字を比較して逆方向かどうかを判定（歩きのブレンドツリーは前進として扱う）
+	auto getDirectionNumber = [](const std::string& name) {
+		return name == Player::kLockonWalkBlendTreeName ? 1 : std::stoi(name.substr(name.size() - 1));
+		};
+	int currentNum = getDirectionNumber(currentAnimationName);
+	int newNum = getDirectionNumber(animationName);
 
 	//1と2、3と4が逆方向のアニメーションとして認識
 	return (currentNum == 1 && newNum == 2) || (currentNum == 2 && newNum == 1) || (currentNum == 3 && newNum == 4) || (currentNum == 4 && newNum == 3);
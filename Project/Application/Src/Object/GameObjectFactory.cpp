@@ -37,11 +37,15 @@ GameObject* GameObjectFactory::CreateGameObject(const std::string& objectName)
 	else if (objectName.find("BackGroundObject") != std::string::npos)
 	{
 		BackGroundObject* backGroundObject = new BackGroundObject();
+		//数が多いのでコンポーネントをストレージでまとめて更新する
+		backGroundObject->SetUseComponentStorage(true);
 		return backGroundObject;
 	}
 	else if (objectName.find("BreakableObject") != std::string::npos)
 	{
 		BreakableObject* breakbleObject = new BreakableObject();
+		//数が多いのでコンポーネントをストレージでまとめて更新する
+		breakbleObject->SetUseComponentStorage(true);
 		return breakbleObject;
 	}
 
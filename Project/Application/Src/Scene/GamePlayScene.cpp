@@ -19,6 +19,9 @@ void GamePlayScene::Initialize()
 	//オーディオのインスタンスを取得
 	audio_ = Audio::GetInstance();
 
+	//アセットを並列に読み込む
+	RequestAssets();
+
 	//ゲームオブジェクトマネージャーの初期化
 	gameObjectManager_ = GameObjectManager::GetInstance();
 	gameObjectManager_->Clear();
@@ -160,6 +163,30 @@ void GamePlayScene::DrawUI()
 #pragma endregion
 }
 
+void GamePlayScene::RequestAssets()
+{
+	//レベルデータで使われているモデルとModelComponentの初期のモデルの読み込みを要求
+	LevelManager::RequestModels("GameScene");
+	ModelManager::LoadAsync("Cube");
+
+	//キャラクターの音声とアニメーション、武器のモデルの読み込みを要求
+	for (const std::string& name : { std::string("Player"), std::string("Enemy") })
+	{
+		BaseCharacter::RequestAssets(name);
+		ModelManager::LoadAsync(name + "Weapon");
+	}
+
+	//魔法のモデル、ロックオンと軌跡のテクスチャ、BGMと効果音の読み込みを要求
+	ModelManager::LoadAsync("Sphere");
+	TextureManager::LoadAsync("Reticle.png");
+	TextureManager::LoadAsync("Trail2.png");
+	audio_->LoadAudioFileAsync("GameScene.mp3");
+	audio_->LoadAudioFileAsync("RockBreak.mp3");
+
+	//全ての読み込みを待つ（GPUリソースの作成はこのスレッドで順番に行う）
+	AssetLoader::GetInstance()->WaitAll();
+}
+
 void GamePlayScene::InitializeCameraController()
 {
 	//カメラコントローラーの初期化
@@ -212,8 +239,10 @@ void GamePlayScene::InitializeCharacter(BaseCharacter* character)
 	//コンバットアニメーションエディターにキャラクターを設定
 	editorManager_->GetCombatAnimationEditor()->AddEditableCharacter(character);
 
-	//キャラクターをコライダーの配列に追加
-	colliders_.push_back(character->GetComponent<Collider>());
+	//キャラクターをコライダーの配列に追加（ダッシュ中のすり抜けを防ぐため連続的な衝突判定を行う）
+	Collider* characterCollider = character->GetComponent<Collider>();
+	characterCollider->SetIsContinuous(true);
+	colliders_.push_back(characterCollider);
 
 	//武器の生成
 	InitializeWeapon(character);
@@ -241,6 +270,9 @@ void GamePlayScene::InitializeWeapon(BaseCharacter* character)
 	collider->SetCollisionAttribute(collisionAttrManager->GetAttribute(weaponName));
 	collider->SetCollisionMask(collisionAttrManager->GetMask(weaponName));
 
+	//高速に振り抜いた際のすり抜けを防ぐため連続的な衝突判定を行う
+	collider->SetIsContinuous(true);
+
 	//キャラクターに武器を設定
 	character->SetWeapon(weapon);
 
@@ -254,6 +286,13 @@ void GamePlayScene::InitializeBreakableObject()
 	for (BreakableObject* object : gameObjectManager_->GetGameObjectsByStringProperty<BreakableObject>("BreakableObject"))
 	{
 		object->SetParticleEffectEditor(editorManager_->GetParticleEffectEditor());
+
+		//破壊オブジェクトは動かないので静的なコライダーとして一度だけ登録する
+		if (Collider* collider = object->GetComponent<Collider>())
+		{
+			collider->SetIsStatic(true);
+			collisionManager_->SetColliderList(collider);
+		}
 	}
 }
 
@@ -292,12 +331,6 @@ void GamePlayScene::UpdateColliders()
 		collisionManager_->SetColliderList(magicProjectile->GetComponent<Collider>());
 	}
 
-	//破壊可能オブジェクトをマネージャーに追加
-	for (BreakableObject* breakableObject : gameObjectManager_->GetGameObjects<BreakableObject>("BreakableObject"))
-	{
-		collisionManager_->SetColliderList(breakableObject->GetComponent<Collider>());
-	}
-
 	//衝突判定
 	collisionManager_->CheckAllCollisions();
 }
@@ -55,6 +55,11 @@ public:
 	void DrawUI() override;
 
 private:
+	/// <summary>
+	/// シーンで使うアセットの読み込みをまとめて要求して待つ
+	/// </summary>
+	void RequestAssets();
+
 	/// <summary>
 	/// カメラコントローラーの初期化
 	/// </summary>
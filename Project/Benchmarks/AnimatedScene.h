@@ -0,0 +1,107 @@
+/**
+ * @file AnimatedScene.h
+ * @brief アニメーターのベンチマーク・テスト用にプレイヤーのモデルを持つゲームオブジェクトを並べるシーン
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "PlayerScene.h"
+#include "Engine/Components/Animator/AnimatorComponent.h"
+#include "Engine/Components/Model/ModelComponent.h"
+#include "Engine/Framework/Object/GameObjectManager.h"
+#include "Engine/Utilities/GameTimer.h"
+#include <memory>
+#include <vector>
+
+//トランスフォーム・モデル・アニメーターを持つゲームオブジェクトをゲームと同じ順番で登録したストレージで更新するシーン
+class AnimatedScene
+{
+public:
+	/// <summary>
+	/// ゲームオブジェクトごとに異なるクリップを再生するゲームオブジェクトを並べる
+	/// </summary>
+	/// <param name="useComponentStorage">コンポーネントをストレージで確保するかどうか</param>
+	/// <param name="objectCount">ゲームオブジェクトの数</param>
+	AnimatedScene(const bool useComponentStorage, const uint32_t objectCount) : factory_(useComponentStorage)
+	{
+		//GameManagerと同じ順番でストレージを登録
+		gameObjectManager_ = GameObjectManager::GetInstance();
+		gameObjectManager_->RegisterComponentStorage<TransformComponent>();
+		gameObjectManager_->RegisterComponentStorage<AnimatorComponent>();
+		gameObjectManager_->RegisterComponentStorage<ModelComponent>();
+		gameObjectManager_->SetGameObjectFactory(&factory_);
+
+		const std::vector<Animation::AnimationData>& animationDatas = PlayerScene::GetAnimationDatas();
+		for (uint32_t i = 0; i < objectCount; ++i)
+		{
+			GameObject* gameObject = GameObjectManager::CreateGameObject("AnimatedObject");
+			gameObject->GetComponent<TransformComponent>()->worldTransform_.translation_ = { i * 2.0f, 0.0f, (i % 3) * 1.5f };
+
+			//モデルはシーンが持つ（ヘッドレスビルドではモデルマネージャーが作らないので）
+			models_.push_back(PlayerScene::CreateModel());
+			gameObject->AddComponent<ModelComponent>()->SetModel(models_.back().get());
+
+			//ゲームオブジェクトごとにクリップと再生速度をずらす
+			Animation* animation = new Animation();
+			animation->Initialize(std::make_shared<const std::vector<Animation::AnimationData>>(1, animationDatas[i % animationDatas.size()]));
+			AnimatorComponent* animator = gameObject->AddComponent<AnimatorComponent>();
+			animator->AddAnimation("Clip", animation);
+			animator->PlayAnimation("Clip", 1.0f + (i % 4) * 0.25f, true);
+		}
+	}
+
+	~AnimatedScene()
+	{
+		//モデルより先にゲームオブジェクトを破棄する
+		GameObjectManager::Destroy();
+	}
+
+	//1フレーム更新
+	void Update()
+	{
+		GameTimer::Update();
+		gameObjectManager_->Update();
+	}
+
+	//モデルが更新された回数を取得（モデルの更新ごとにマテリアルが1回書き込まれる）
+	uint32_t GetModelUpdateCount(const size_t index) const { return models_[index]->GetMaterial(0)->GetConstantBuffer()->GetMapCount(); };
+
+	//全てのモデルのジョイントのワールド行列を集める
+	void CollectJointMatrices(std::vector<Matrix4x4>& matrices) const
+	{
+		for (const std::unique_ptr<Model>& model : models_)
+		{
+			for (const WorldTransform& jointWorldTransform : model->GetJointWorldTransforms())
+			{
+				matrices.push_back(jointWorldTransform.matWorld_);
+			}
+		}
+	}
+
+	//モデルの数を取得
+	size_t GetModelCount() const { return models_.size(); };
+
+private:
+	//ストレージを使うかどうかを切り替えられるゲームオブジェクトファクトリー
+	class Factory : public AbstractGameObjectFactory
+	{
+	public:
+		Factory(const bool useComponentStorage) : useComponentStorage_(useComponentStorage) {};
+
+		GameObject* CreateGameObject(const std::string&) override
+		{
+			GameObject* gameObject = new GameObject();
+			gameObject->SetUseComponentStorage(useComponentStorage_);
+			return gameObject;
+		}
+
+	private:
+		bool useComponentStorage_ = false;
+	};
+
+private:
+	Factory factory_;
+	GameObjectManager* gameObjectManager_ = nullptr;
+	std::vector<std::unique_ptr<Model>> models_{};
+};
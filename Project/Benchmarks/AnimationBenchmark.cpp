@@ -0,0 +1,453 @@
+/**
+ * @file AnimationBenchmark.cpp
+ * @brief キーフレームのサンプリングと再サンプリング・圧縮の誤差、アニメーターの並列更新のベンチマーク・テスト
+ * @author 青木智滉
+ * @date
+ */
+
+#include "Benchmark.h"
+#include "AnimatedScene.h"
+#include "PlayerScene.h"
+#include "Engine/3D/Model/AnimationBlendTree.h"
+#include "Engine/3D/Model/AnimationPose.h"
+#include "Engine/Utilities/GameTimer.h"
+#include "Engine/Utilities/JobSystem.h"
+#include "Engine/Math/MathFunction.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace
+{
+	//サンプリングするレート
+	const float kFrameRate = 60.0f;
+
+	//圧縮したキーフレームの時間の段階数（尺を65535等分する）
+	const float kCompressedTimeSteps = 65535.0f;
+
+	//15ビットに量子化した回転の角度の誤差の上限（3成分が半段階ずつずれ、復元した成分も同じだけずれた場合の角度）
+	const float kQuaternionQuantizationError = 4.0f * std::sqrt(3.0f) * std::sqrt(0.5f) / 32767.0f;
+
+	//先頭からキーフレームを線形に探して補間する（カーソルを使う前の検索方法）
+	template <typename tValue>
+	tValue SampleLinear(std::span<const Animation::Keyframe<tValue>> keyframes, float time)
+	{
+		if (keyframes.size() == 1 || time <= keyframes[0].time)
+		{
+			return keyframes[0].value;
+		}
+		for (size_t index = 0; index + 1 < keyframes.size(); ++index)
+		{
+			if (keyframes[index].time <= time && time <= keyframes[index + 1].time)
+			{
+				const float t = (time - keyframes[index].time) / (keyframes[index + 1].time - keyframes[index].time);
+				if constexpr (std::is_same_v<tValue, Quaternion>)
+				{
+					return Mathf::Slerp(keyframes[index].value, keyframes[index + 1].value, t);
+				}
+				else
+				{
+					return Mathf::Lerp(keyframes[index].value, keyframes[index + 1].value, t);
+				}
+			}
+		}
+		return keyframes.back().value;
+	}
+
+	//線形探索で全てのジョイントの姿勢を求める
+	void SampleReferencePose(const Model& model, const Animation::AnimationData& animationData, float time, AnimationPose& pose)
+	{
+		const Model::Skeleton& skeleton = model.GetSkeleton();
+		for (size_t jointIndex = 0; jointIndex < skeleton.joints.size(); ++jointIndex)
+		{
+			auto it = animationData.channelIndices.find(Animation::HashName(skeleton.joints[jointIndex].name));
+			if (it == animationData.channelIndices.end()) continue;
+			const Animation::NodeAnimation& nodeAnimation = animationData.nodeAnimations[it->second];
+			const std::span<const Animation::KeyframeVector3> vector3Keyframes(animationData.vector3Keyframes);
+			const std::span<const Animation::KeyframeQuaternion> quaternionKeyframes(animationData.quaternionKeyframes);
+			pose.GetTranslates()[jointIndex] = SampleLinear(vector3Keyframes.subspan(nodeAnimation.translate.keyframeOffset, nodeAnimation.translate.keyframeCount), time);
+			pose.GetRotates()[jointIndex] = SampleLinear(quaternionKeyframes.subspan(nodeAnimation.rotate.keyframeOffset, nodeAnimation.rotate.keyframeCount), time);
+			pose.GetScales()[jointIndex] = SampleLinear(vector3Keyframes.subspan(nodeAnimation.scale.keyframeOffset, nodeAnimation.scale.keyframeCount), time);
+		}
+	}
+
+	//2つの姿勢の最大の差（クォータニオンは符号が逆でも同じ回転として扱う）
+	float CalculatePoseError(const AnimationPose& a, const AnimationPose& b)
+	{
+		float error = 0.0f;
+		for (uint32_t i = 0; i < a.GetJointCount(); ++i)
+		{
+			const Vector3 translate = a.GetTranslates()[i] - b.GetTranslates()[i];
+			const Vector3 scale = a.GetScales()[i] - b.GetScales()[i];
+			const Quaternion& q0 = a.GetRotates()[i];
+			const Quaternion& q1 = b.GetRotates()[i];
+			const float sign = q0.x * q1.x + q0.y * q1.y + q0.z * q1.z + q0.w * q1.w < 0.0f ? -1.0f : 1.0f;
+			error = std::max({ error, std::fabs(translate.x), std::fabs(translate.y), std::fabs(translate.z),
+				std::fabs(scale.x), std::fabs(scale.y), std::fabs(scale.z),
+				std::fabs(q0.x - sign * q1.x), std::fabs(q0.y - sign * q1.y), std::fabs(q0.z - sign * q1.z), std::fabs(q0.w - sign * q1.w) });
+		}
+		return error;
+	}
+
+	//クリップの全てのフレームの時間（順番に再生した場合）
+	std::vector<float> MakeFrameTimes(const Animation::AnimationData& animationData)
+	{
+		std::vector<float> times{};
+		for (uint32_t frame = 0; frame <= static_cast<uint32_t>(animationData.duration * kFrameRate); ++frame)
+		{
+			times.push_back(std::min(frame / kFrameRate, animationData.duration));
+		}
+		return times;
+	}
+
+	//アニメーションデータを加工してアニメーションを作成
+	std::unique_ptr<Animation> CreateAnimation(std::vector<Animation::AnimationData> animationDatas, float sampleRate, bool isCompressed)
+	{
+		for (Animation::AnimationData& animationData : animationDatas)
+		{
+			if (isCompressed) Animation::Compress(animationData);
+			if (sampleRate > 0.0f) Animation::Resample(animationData, sampleRate);
+		}
+		std::unique_ptr<Animation> animation = std::make_unique<Animation>();
+		animation->Initialize(std::make_shared<const std::vector<Animation::AnimationData>>(std::move(animationDatas)));
+		return animation;
+	}
+
+	//カーソルを使ったサンプリングが線形探索と一致し、再サンプリングした結果が許容誤差内か（逆再生と時間の飛びも含む）
+	Benchmark::Registration samplingTest("Animation/CursorSampling", Benchmark::Kind::kTest, []() {
+		const std::vector<Animation::AnimationData>& animationDatas = PlayerScene::GetAnimationDatas();
+		std::unique_ptr<Model> model = PlayerScene::CreateModel();
+		std::unique_ptr<Animation> keyframeAnimation = CreateAnimation(animationDatas, 0.0f, false);
+		std::unique_ptr<Animation> resampledAnimation = CreateAnimation(animationDatas, kFrameRate, false);
+
+		AnimationPose reference{};
+		AnimationPose keyframe{};
+		AnimationPose resampled{};
+		reference.CopyFromSkeleton(model->GetSkeleton());
+		keyframe.CopyFromSkeleton(model->GetSkeleton());
+		resampled.CopyFromSkeleton(model->GetSkeleton());
+
+		bool result = Benchmark::Expect(animationDatas.size() >= 2, "アニメーションが読み込まれていない");
+		std::mt19937 random(3);
+		for (const Animation::AnimationData& animationData : animationDatas)
+		{
+			keyframeAnimation->PlayAnimation(animationData.name, 1.0f, true);
+			resampledAnimation->PlayAnimation(animationData.name, 1.0f, true);
+
+			//順再生・逆再生・ランダムな順番の時間
+			std::vector<float> times = MakeFrameTimes(animationData);
+			const size_t frameCount = times.size();
+			times.insert(times.end(), times.rbegin(), times.rbegin() + frameCount);
+			std::vector<float> shuffled(times.begin(), times.begin() + frameCount);
+			std::shuffle(shuffled.begin(), shuffled.end(), random);
+			times.insert(times.end(), shuffled.begin(), shuffled.end());
+
+			float keyframeError = 0.0f;
+			float resampledError = 0.0f;
+			for (float time : times)
+			{
+				SampleReferencePose(*model, animationData, time, reference);
+				keyframeAnimation->SetAnimationTime(time);
+				keyframeAnimation->SamplePose(model.get(), keyframe);
+				resampledAnimation->SetAnimationTime(time);
+				resampledAnimation->SamplePose(model.get(), resampled);
+				keyframeError = std::max(keyframeError, CalculatePoseError(reference, keyframe));
+				resampledError = std::max(resampledError, CalculatePoseError(reference, resampled));
+			}
+			result &= Benchmark::Expect(keyframeError <= 1e-5f, animationData.name + ": cursor sampling differs from the linear search by " + std::to_string(keyframeError));
+			result &= Benchmark::Expect(resampledError <= 1e-4f, animationData.name + ": resampled pose differs from the keyframes by " + std::to_string(resampledError));
+		}
+		return result;
+		});
+
+	//クリップのキーフレームの時間とその中間の時間（補間した値も比べる）
+	std::vector<float> MakeKeyframeTimes(const Animation::AnimationData& animationData)
+	{
+		std::vector<float> times{};
+		for (const Animation::KeyframeVector3& keyframe : animationData.vector3Keyframes) times.push_back(keyframe.time);
+		for (const Animation::KeyframeQuaternion& keyframe : animationData.quaternionKeyframes) times.push_back(keyframe.time);
+		std::sort(times.begin(), times.end());
+		times.erase(std::unique(times.begin(), times.end()), times.end());
+		const size_t keyframeCount = times.size();
+		for (size_t i = 0; i + 1 < keyframeCount; ++i)
+		{
+			times.push_back((times[i] + times[i + 1]) * 0.5f);
+		}
+		return times;
+	}
+
+	//2つの回転の間の角度（符号が逆でも同じ回転。floatのacosでは小さい角度を表せないので弦の長さから求める）
+	float CalculateRotationAngle(const Quaternion& q0, const Quaternion& q1)
+	{
+		const float sign = q0.x * q1.x + q0.y * q1.y + q0.z * q1.z + q0.w * q1.w < 0.0f ? -1.0f : 1.0f;
+		const Quaternion difference = { q0.x - sign * q1.x, q0.y - sign * q1.y, q0.z - sign * q1.z, q0.w - sign * q1.w };
+		const float chord = std::sqrt(difference.x * difference.x + difference.y * difference.y + difference.z * difference.z + difference.w * difference.w);
+		return 4.0f * std::asin(std::min(chord * 0.5f, 1.0f));
+	}
+
+	//隣り合うキーフレームの間の最大の速さ（時間を量子化したことによる誤差の見積もりに使う）
+	struct KeyframeSpeed
+	{
+		float translate = 0.0f;
+		float rotate = 0.0f;
+		float scale = 0.0f;
+	};
+
+	//クリップの全てのチャンネルのキーフレームの最大の速さを求める
+	KeyframeSpeed CalculateMaxKeyframeSpeed(const Animation::AnimationData& animationData)
+	{
+		auto vector3Speed = [&](const Animation::AnimationCurve<Vector3>& curve) {
+			float speed = 0.0f;
+			for (uint32_t i = curve.keyframeOffset; i + 1 < curve.keyframeOffset + curve.keyframeCount; ++i)
+			{
+				const Animation::KeyframeVector3& k0 = animationData.vector3Keyframes[i];
+				const Animation::KeyframeVector3& k1 = animationData.vector3Keyframes[i + 1];
+				if (k1.time <= k0.time) continue;
+				speed = std::max(speed, Mathf::Length(k1.value - k0.value) / (k1.time - k0.time));
+			}
+			return speed;
+			};
+
+		KeyframeSpeed result{};
+		for (const Animation::NodeAnimation& nodeAnimation : animationData.nodeAnimations)
+		{
+			result.translate = std::max(result.translate, vector3Speed(nodeAnimation.translate));
+			result.scale = std::max(result.scale, vector3Speed(nodeAnimation.scale));
+			for (uint32_t i = nodeAnimation.rotate.keyframeOffset; i + 1 < nodeAnimation.rotate.keyframeOffset + nodeAnimation.rotate.keyframeCount; ++i)
+			{
+				const Animation::KeyframeQuaternion& k0 = animationData.quaternionKeyframes[i];
+				const Animation::KeyframeQuaternion& k1 = animationData.quaternionKeyframes[i + 1];
+				if (k1.time <= k0.time) continue;
+				result.rotate = std::max(result.rotate, CalculateRotationAngle(k0.value, k1.value) / (k1.time - k0.time));
+			}
+		}
+		return result;
+	}
+
+	//圧縮したクリップを展開した姿勢が元のキーフレームから許容誤差内か（クリップごとのメモリも表示する）
+	Benchmark::Registration compressionTest("Animation/CompressionError", Benchmark::Kind::kTest, []() {
+		const std::vector<Animation::AnimationData>& animationDatas = PlayerScene::GetAnimationDatas();
+		std::unique_ptr<Model> model = PlayerScene::CreateModel();
+
+		//圧縮したアニメーション
+		std::vector<Animation::AnimationData> compressedDatas = animationDatas;
+		for (Animation::AnimationData& animationData : compressedDatas)
+		{
+			Animation::Compress(animationData);
+		}
+		std::unique_ptr<Animation> animation = std::make_unique<Animation>();
+		animation->Initialize(std::make_shared<const std::vector<Animation::AnimationData>>(compressedDatas));
+
+		AnimationPose reference{};
+		AnimationPose compressed{};
+		reference.CopyFromSkeleton(model->GetSkeleton());
+		compressed.CopyFromSkeleton(model->GetSkeleton());
+
+		bool result = Benchmark::Expect(!animationDatas.empty(), "アニメーションが読み込まれていない");
+		size_t sourceBytes = 0;
+		size_t compressedBytes = 0;
+		for (size_t index = 0; index < animationDatas.size(); ++index)
+		{
+			const Animation::AnimationData& source = animationDatas[index];
+			const Animation::AnimationData& compressedData = compressedDatas[index];
+			result &= Benchmark::Expect(compressedData.isCompressed && compressedData.vector3Keyframes.empty() && compressedData.quaternionKeyframes.empty(), source.name + ": keyframes are not compressed");
+			animation->PlayAnimation(source.name, 1.0f, true);
+
+			float translateError = 0.0f;
+			float rotateError = 0.0f;
+			float scaleError = 0.0f;
+			for (float time : MakeKeyframeTimes(source))
+			{
+				SampleReferencePose(*model, source, time, reference);
+				animation->SetAnimationTime(time);
+				animation->SamplePose(model.get(), compressed);
+				for (uint32_t i = 0; i < reference.GetJointCount(); ++i)
+				{
+					const Vector3 translate = reference.GetTranslates()[i] - compressed.GetTranslates()[i];
+					const Vector3 scale = reference.GetScales()[i] - compressed.GetScales()[i];
+					translateError = std::max(translateError, Mathf::Length(translate));
+					scaleError = std::max(scaleError, Mathf::Length(scale));
+					rotateError = std::max(rotateError, CalculateRotationAngle(reference.GetRotates()[i], compressed.GetRotates()[i]));
+				}
+			}
+
+			//元のキーフレームと量子化したキーフレームのメモリ
+			const size_t clipSourceBytes = source.vector3Keyframes.size() * sizeof(Animation::KeyframeVector3) + source.quaternionKeyframes.size() * sizeof(Animation::KeyframeQuaternion);
+			const size_t clipCompressedBytes = (compressedData.compressedVector3Keyframes.size() + compressedData.compressedQuaternionKeyframes.size()) * sizeof(Animation::CompressedKeyframe);
+			sourceBytes += clipSourceBytes;
+			compressedBytes += clipCompressedBytes;
+			Benchmark::Report(source.name + " memory", clipCompressedBytes / 1024.0, ("KB (from " + std::to_string(clipSourceBytes / 1024) + " KB)").c_str());
+			Benchmark::Report(source.name + " max error", rotateError * 1000.0, ("mrad, translate " + std::to_string(translateError) + ", scale " + std::to_string(scaleError)).c_str());
+
+			//許容誤差に値の量子化（1段階）と時間の量子化（1段階の間に動く量）の分を足した範囲
+			const KeyframeSpeed speed = CalculateMaxKeyframeSpeed(source);
+			const float timeStep = source.duration / kCompressedTimeSteps;
+			const float translateBound = 0.001f + Mathf::Length(compressedData.translateStep) + speed.translate * timeStep;
+			const float rotateBound = 0.0005f + kQuaternionQuantizationError + speed.rotate * timeStep;
+			const float scaleBound = 0.0001f + Mathf::Length(compressedData.scaleStep) + speed.scale * timeStep;
+			result &= Benchmark::Expect(translateError <= translateBound, source.name + ": translation error " + std::to_string(translateError) + " exceeds " + std::to_string(translateBound));
+			result &= Benchmark::Expect(rotateError <= rotateBound, source.name + ": rotation error " + std::to_string(rotateError) + " rad exceeds " + std::to_string(rotateBound));
+			result &= Benchmark::Expect(scaleError <= scaleBound, source.name + ": scale error " + std::to_string(scaleError) + " exceeds " + std::to_string(scaleBound));
+		}
+		Benchmark::Report("total memory", compressedBytes / 1024.0, ("KB (from " + std::to_string(sourceBytes / 1024) + " KB)").c_str());
+		result &= Benchmark::Expect(compressedBytes * 4 < sourceBytes, "compressed keyframes are not smaller than a quarter of the source");
+		return result;
+		});
+
+	//プレイヤーのロックオン中の歩き（左・前・右の1Dブレンド）がパラメーターに応じて子のクリップを補間するか
+	Benchmark::Registration blendTreeTest("Animation/WalkBlend1D", Benchmark::Kind::kTest, []() {
+		const std::vector<Animation::AnimationData>& animationDatas = PlayerScene::GetAnimationDatas();
+		std::unique_ptr<Model> model = PlayerScene::CreateModel();
+
+		//Player::InitializeAnimatorと同じ構成のブレンドツリーを作る
+		const std::pair<const char*, float> walkClips[] = { { "Walk3", -1.0f }, { "Walk1", 0.0f }, { "Walk4", 1.0f } };
+		std::vector<std::unique_ptr<Animation>> animations{};
+		AnimationBlendTree blendTree{};
+		std::vector<std::pair<int32_t, float>> children{};
+		for (const auto& [clipName, threshold] : walkClips)
+		{
+			auto it = std::find_if(animationDatas.begin(), animationDatas.end(), [&](const Animation::AnimationData& data) { return data.name == clipName; });
+			if (!Benchmark::Expect(it != animationDatas.end(), std::string(clipName) + " is not loaded")) return false;
+			animations.push_back(CreateAnimation({ *it }, 0.0f, false));
+			children.emplace_back(blendTree.AddClipNode(animations.back().get()), threshold);
+		}
+		blendTree.SetRootNode(blendTree.AddBlend1DNode("WalkDirection", children, true));
+		blendTree.PlayAnimation(1.0f, true);
+
+		AnimationPose actual{};
+		AnimationPose lower{};
+		AnimationPose upper{};
+		actual.CopyFromSkeleton(model->GetSkeleton());
+		lower.CopyFromSkeleton(model->GetSkeleton());
+		upper.CopyFromSkeleton(model->GetSkeleton());
+
+		//パラメーターを変えながら再生し、隣り合う2つのクリップを個別にサンプリングして補間した姿勢と比べる
+		GameTimer::Update();
+		bool result = true;
+		float maxError = 0.0f;
+		float minPhaseDifference = 1.0f;
+		for (uint32_t frame = 0; frame < 120; ++frame)
+		{
+			const float parameter = std::sin(frame * 0.05f) * 1.2f;
+			blendTree.SetParameter("WalkDirection", parameter);
+			blendTree.UpdateAnimationTime();
+			actual.CopyFromSkeleton(model->GetSkeleton());
+			blendTree.Evaluate(model.get(), actual);
+
+			const float clamped = std::clamp(parameter, -1.0f, 1.0f);
+			const uint32_t segment = clamped < 0.0f ? 0 : 1;
+			const float blendFactor = clamped - (segment == 0 ? -1.0f : 0.0f);
+			lower.CopyFromSkeleton(model->GetSkeleton());
+			upper.CopyFromSkeleton(model->GetSkeleton());
+			animations[segment]->SamplePose(model.get(), lower);
+			animations[segment + 1]->SamplePose(model.get(), upper);
+			lower.Blend(lower, upper, blendFactor);
+			maxError = std::max(maxError, CalculatePoseError(actual, lower));
+
+			//再生位置が揃っているか
+			const float phase0 = animations[segment]->GetAnimationTime() / animations[segment]->GetDuration();
+			const float phase1 = animations[segment + 1]->GetAnimationTime() / animations[segment + 1]->GetDuration();
+			minPhaseDifference = std::min(minPhaseDifference, 1.0f - std::fabs(phase0 - phase1));
+		}
+		result &= Benchmark::Expect(maxError <= 1e-5f, "blend tree pose differs from blending the clips by " + std::to_string(maxError));
+		result &= Benchmark::Expect(minPhaseDifference >= 1.0f - 1e-4f, "walk clips are not synchronized");
+		return result;
+		});
+
+	//全てのクリップを順番に再生したときの1フレームあたりのサンプリング時間
+	Benchmark::Registration samplingBenchmark("Animation/Sampling", Benchmark::Kind::kBenchmark, []() {
+		const std::vector<Animation::AnimationData>& animationDatas = PlayerScene::GetAnimationDatas();
+		std::unique_ptr<Model> model = PlayerScene::CreateModel();
+		AnimationPose pose{};
+		pose.CopyFromSkeleton(model->GetSkeleton());
+
+		//フレーム数を数える
+		size_t frameCount = 0;
+		for (const Animation::AnimationData& animationData : animationDatas)
+		{
+			frameCount += MakeFrameTimes(animationData).size();
+		}
+
+		//カーソルを使う前の線形探索
+		const double linear = Benchmark::MeasureMicroseconds(3, [&]() {
+			for (const Animation::AnimationData& animationData : animationDatas)
+			{
+				for (float time : MakeFrameTimes(animationData))
+				{
+					SampleReferencePose(*model, animationData, time, pose);
+				}
+			}
+			});
+		Benchmark::Report("linear search", linear / frameCount, "us/frame");
+
+		//カーソル・再サンプリング・圧縮
+		auto measure = [&](const char* label, float sampleRate, bool isCompressed) {
+			std::unique_ptr<Animation> animation = CreateAnimation(animationDatas, sampleRate, isCompressed);
+			const double time = Benchmark::MeasureMicroseconds(3, [&]() {
+				for (const Animation::AnimationData& animationData : animationDatas)
+				{
+					animation->PlayAnimation(animationData.name, 1.0f, true);
+					for (float frameTime : MakeFrameTimes(animationData))
+					{
+						animation->SetAnimationTime(frameTime);
+						animation->SamplePose(model.get(), pose);
+					}
+				}
+				});
+			Benchmark::Report(label, time / frameCount, "us/frame");
+			};
+		measure("cursor", 0.0f, false);
+		measure("resampled 60Hz", kFrameRate, false);
+		measure("compressed", 0.0f, true);
+		return true;
+		});
+
+	//ワーカースレッドの数を設定（0の場合は呼び出したスレッドだけで処理する）
+	void SetWorkerCount(uint32_t workerCount)
+	{
+		if (workerCount == 0)
+		{
+			JobSystem::GetInstance()->Finalize();
+			return;
+		}
+		JobSystem::GetInstance()->Initialize(workerCount);
+	}
+
+	//アニメーターを並列に更新しても、呼び出したスレッドだけで更新した場合と同じジョイントの行列になるか
+	Benchmark::Registration parallelAnimatorTest("Animation/ParallelAnimatorsMatchSerial", Benchmark::Kind::kTest, []() {
+		//ワーカースレッドの数ごとにシーンを30フレーム動かしたジョイントの行列を集める
+		auto run = [](uint32_t workerCount) {
+			SetWorkerCount(workerCount);
+			std::vector<Matrix4x4> jointMatrices{};
+			AnimatedScene scene(true, 12);
+			for (uint32_t frame = 0; frame < 30; ++frame)
+			{
+				scene.Update();
+			}
+			scene.CollectJointMatrices(jointMatrices);
+			return jointMatrices;
+			};
+
+		const std::vector<Matrix4x4> expected = run(0);
+		bool result = Benchmark::Expect(!expected.empty(), "ジョイントがない");
+		for (uint32_t workerCount : { 1u, 3u, 7u })
+		{
+			result &= Benchmark::Expect(run(workerCount) == expected, std::to_string(workerCount) + " workers: joint matrices differ from the serial update");
+		}
+		SetWorkerCount(0);
+		return result;
+		});
+
+	//ワーカースレッドの数ごとのアニメーターを持つゲームオブジェクトの更新時間
+	Benchmark::Registration animatorWorkerBenchmark("Animation/AnimatorWorkers", Benchmark::Kind::kBenchmark, []() {
+		for (uint32_t workerCount : { 0u, 1u, 3u, 7u })
+		{
+			SetWorkerCount(workerCount);
+			AnimatedScene scene(true, 64);
+			const double microseconds = Benchmark::MeasureMicroseconds(20, [&]() { scene.Update(); });
+			Benchmark::Report("64 animated objects, " + std::to_string(workerCount) + " workers", microseconds, "us/frame");
+		}
+		SetWorkerCount(0);
+		return true;
+		});
+}
@@ -0,0 +1,101 @@
+/**
+ * @file AssetLoaderBenchmark.cpp
+ * @brief アセットの非同期読み込みのテスト
+ * @author 青木智滉
+ * @date
+ */
+
+#include "Benchmark.h"
+#include "Engine/Utilities/AssetLoader.h"
+#include <atomic>
+#include <stdexcept>
+
+namespace
+{
+	//ワーカースレッドの読み込み中に要求された読み込みも含めて、全ての完了処理が1回ずつ行われるか
+	Benchmark::Registration nestedRequestTest("AssetLoader/NestedRequests", Benchmark::Kind::kTest, []() {
+		static const uint32_t kRequestCount = 256;
+		static const uint32_t kNestedCount = 4;
+		JobSystem::GetInstance()->Initialize(4);
+		AssetLoader* assetLoader = AssetLoader::GetInstance();
+
+		std::atomic<uint32_t> loadCount = 0;
+		uint32_t finalizeCount = 0;
+		std::vector<AssetLoader::Handle> handles{};
+		for (uint32_t i = 0; i < kRequestCount; ++i)
+		{
+			//ModelManagerの読み込みがテクスチャの読み込みを要求するのと同じように、ワーカースレッドから要求する
+			handles.push_back(assetLoader->Request([&]() -> AssetLoader::FinalizeFunction {
+				++loadCount;
+				for (uint32_t j = 0; j < kNestedCount; ++j)
+				{
+					assetLoader->Request([&]() -> AssetLoader::FinalizeFunction {
+						++loadCount;
+						return [&]() { ++finalizeCount; };
+						});
+				}
+				return [&]() { ++finalizeCount; };
+				}));
+		}
+
+		//最初の要求だけ個別に待ってから残りを全て待つ
+		assetLoader->Wait(handles.front());
+		bool result = Benchmark::Expect(handles.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready, "Wait returned before the request was finalized");
+		assetLoader->WaitAll();
+		JobSystem::GetInstance()->Finalize();
+
+		const uint32_t expectedCount = kRequestCount * (kNestedCount + 1);
+		result &= Benchmark::Expect(loadCount == expectedCount, std::to_string(loadCount) + " loads, expected " + std::to_string(expectedCount));
+		result &= Benchmark::Expect(finalizeCount == expectedCount, std::to_string(finalizeCount) + " finalizations, expected " + std::to_string(expectedCount));
+		return result;
+		});
+
+	//読み込みや完了処理で発生した例外が待っているスレッドで投げ直され、他の読み込みは完了するか
+	Benchmark::Registration exceptionTest("AssetLoader/ExceptionReachesWaiter", Benchmark::Kind::kTest, []() {
+		bool result = true;
+		for (uint32_t workerCount : { 0u, 4u })
+		{
+			if (workerCount == 0)
+			{
+				JobSystem::GetInstance()->Finalize();
+			}
+			else
+			{
+				JobSystem::GetInstance()->Initialize(workerCount);
+			}
+			AssetLoader* assetLoader = AssetLoader::GetInstance();
+			const std::string prefix = std::to_string(workerCount) + " workers: ";
+
+			//例外が投げられたかどうかとそのメッセージを取得
+			auto caught = [](const auto& function) -> std::string {
+				try
+				{
+					function();
+				}
+				catch (const std::runtime_error& error)
+				{
+					return error.what();
+				}
+				return "";
+				};
+
+			//個別に待つ場合はその読み込みの例外だけが投げ直される
+			uint32_t finalizeCount = 0;
+			AssetLoader::Handle loadFailed = assetLoader->Request([]() -> AssetLoader::FinalizeFunction { throw std::runtime_error("load"); });
+			AssetLoader::Handle succeeded = assetLoader->Request([&]() -> AssetLoader::FinalizeFunction { return [&]() { ++finalizeCount; }; });
+			result &= Benchmark::Expect(caught([&]() { assetLoader->Wait(loadFailed); }) == "load", prefix + "Wait did not rethrow the load exception");
+			result &= Benchmark::Expect(caught([&]() { assetLoader->Wait(succeeded); }).empty(), prefix + "Wait threw for a successful request");
+			result &= Benchmark::Expect(finalizeCount == 1, prefix + "successful request was not finalized once");
+
+			//全て待つ場合は残りの完了処理を行ってから例外が投げ直される
+			AssetLoader::Handle finalizeFailed = assetLoader->Request([]() -> AssetLoader::FinalizeFunction { return []() { throw std::runtime_error("finalize"); }; });
+			assetLoader->Request([&]() -> AssetLoader::FinalizeFunction { return [&]() { ++finalizeCount; }; });
+			result &= Benchmark::Expect(caught([&]() { assetLoader->WaitAll(); }) == "finalize", prefix + "WaitAll did not rethrow the finalize exception");
+			result &= Benchmark::Expect(finalizeCount == 2, prefix + "WaitAll stopped at the failed request");
+			result &= Benchmark::Expect(caught([&]() { finalizeFailed.get(); }) == "finalize", prefix + "handle does not hold the finalize exception");
+			result &= Benchmark::Expect(caught([&]() { assetLoader->WaitAll(); }).empty(), prefix + "WaitAll threw with nothing pending");
+		}
+		JobSystem::GetInstance()->Finalize();
+		return result;
+		});
+}
@@ -0,0 +1,96 @@
+/**
+ * @file Benchmark.h
+ * @brief ヘッドレスで動かすベンチマークと検証テストの登録・計測を行うファイル
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+	//登録する処理の種類
+	enum class Kind
+	{
+		kTest,     //結果を検証する（失敗すると終了コードが0以外になる）
+		kBenchmark,//時間を計測して表示する
+	};
+
+	//登録する処理（テストは成功したかどうかを返す）
+	using Function = std::function<bool()>;
+
+	//登録された処理
+	struct Entry
+	{
+		std::string name;
+		Kind kind;
+		Function function;
+	};
+
+	//静的な変数の初期化時に処理を登録する
+	struct Registration
+	{
+		Registration(const char* name, Kind kind, Function function);
+	};
+
+	/// <summary>
+	/// 登録された処理を取得
+	/// </summary>
+	/// <returns>登録された処理</returns>
+	std::vector<Entry>& GetEntries();
+
+	/// <summary>
+	/// 計測結果を表示
+	/// </summary>
+	/// <param name="label">項目名</param>
+	/// <param name="value">値</param>
+	/// <param name="unit">単位</param>
+	void Report(const std::string& label, double value, const char* unit);
+
+	/// <summary>
+	/// 条件を検証し、失敗した場合はメッセージを表示
+	/// </summary>
+	/// <param name="condition">条件</param>
+	/// <param name="message">失敗したときのメッセージ</param>
+	/// <returns>条件</returns>
+	bool Expect(bool condition, const std::string& message);
+
+	/// <summary>
+	/// リソースのディレクトリを取得
+	/// </summary>
+	/// <returns>Application/Resourcesのパス</returns>
+	std::string GetResourceDirectory();
+
+	/// <summary>
+	/// 1回あたりの処理時間を計測（数回計測して最も短いものを返す）
+	/// </summary>
+	/// <param name="iterations">1回の計測で呼び出す回数</param>
+	/// <param name="function">計測する処理</param>
+	/// <returns>1回あたりのマイクロ秒</returns>
+	template<class Function>
+	double MeasureMicroseconds(uint32_t iterations, Function&& function)
+	{
+		//1回目はキャッシュを温めるだけにする
+		function();
+		double best = 0.0;
+		for (uint32_t repeat = 0; repeat < 5; ++repeat)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			for (uint32_t i = 0; i < iterations; ++i)
+			{
+				function();
+			}
+			const double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+			if (repeat == 0 || elapsed < best)
+			{
+				best = elapsed;
+			}
+		}
+		return best;
+	}
+}
@@ -0,0 +1,99 @@
+/**
+ * @file BroadPhaseBenchmark.cpp
+ * @brief CollisionManagerのブロードフェーズのベンチマーク・テスト
+ * @author 青木智滉
+ * @date
+ */
+
+#include "Benchmark.h"
+#include "CollisionScene.h"
+#include "Engine/Components/Collision/UniformGridBroadPhase.h"
+#include <cmath>
+#include <string>
+
+namespace
+{
+	//全てのペアを衝突候補にするブロードフェーズ（比較用）
+	class ExhaustiveBroadPhase : public IBroadPhase
+	{
+	public:
+		void CollectPairs(const std::vector<Collider*>& colliders, std::vector<CandidatePair>& pairs) override
+		{
+			for (uint32_t i = 0; i < static_cast<uint32_t>(colliders.size()); ++i)
+			{
+				if (!colliders[i]->GetCollisionEnabled()) continue;
+				const Collider::Bounds bounds = colliders[i]->GetSweptBounds();
+				for (uint32_t j = i + 1; j < static_cast<uint32_t>(colliders.size()); ++j)
+				{
+					if (!colliders[j]->GetCollisionEnabled()) continue;
+					if (!bounds.Overlaps(colliders[j]->GetSweptBounds()) || !colliders[i]->CanCollideWith(colliders[j])) continue;
+					pairs.emplace_back(i, j);
+				}
+			}
+		}
+	};
+
+	//ブロードフェーズの種類
+	enum class BroadPhaseType
+	{
+		kExhaustive,
+		kSweepAndPrune,
+		kUniformGrid,
+	};
+
+	//ブロードフェーズの名前
+	const char* const kBroadPhaseNames[] = { "exhaustive", "sweep and prune", "uniform grid" };
+
+	//ブロードフェーズを作成
+	std::unique_ptr<IBroadPhase> CreateBroadPhase(BroadPhaseType type)
+	{
+		switch (type)
+		{
+		case BroadPhaseType::kExhaustive: return std::make_unique<ExhaustiveBroadPhase>();
+		case BroadPhaseType::kSweepAndPrune: return std::make_unique<SweepAndPruneBroadPhase>();
+		default: return std::make_unique<UniformGridBroadPhase>();
+		}
+	}
+
+	//シーンを指定したフレーム数動かして衝突イベントを記録
+	std::vector<ContactRecorderObject::Event> RunScene(BroadPhaseType type, uint32_t count, float extent, uint32_t frames)
+	{
+		CollisionScene scene(count, extent, 42);
+		CollisionManager collisionManager;
+		collisionManager.SetBroadPhase(CreateBroadPhase(type));
+		for (uint32_t frame = 0; frame < frames; ++frame)
+		{
+			scene.Step(collisionManager, extent);
+		}
+		return scene.GetEvents();
+	}
+
+	//ブロードフェーズを変えても衝突イベントが全てのペアを調べた場合と一致するか
+	Benchmark::Registration broadPhaseTest("Collision/BroadPhaseEquivalence", Benchmark::Kind::kTest, []() {
+		const std::vector<ContactRecorderObject::Event> expected = RunScene(BroadPhaseType::kExhaustive, 600, 20.0f, 60);
+		bool result = Benchmark::Expect(!expected.empty(), "衝突イベントがない");
+		for (BroadPhaseType type : { BroadPhaseType::kSweepAndPrune, BroadPhaseType::kUniformGrid })
+		{
+			result &= Benchmark::Expect(RunScene(type, 600, 20.0f, 60) == expected, std::string(kBroadPhaseNames[static_cast<int>(type)]) + " event log differs");
+		}
+		return result;
+		});
+
+	//ブロードフェーズごとのCheckAllCollisionsの時間
+	Benchmark::Registration broadPhaseBenchmark("Collision/BroadPhase", Benchmark::Kind::kBenchmark, []() {
+		for (uint32_t count : { 1000u, 4000u })
+		{
+			//密度が変わらないように範囲を広げる
+			const float extent = 20.0f * std::sqrt(count / 1000.0f);
+			for (BroadPhaseType type : { BroadPhaseType::kExhaustive, BroadPhaseType::kSweepAndPrune, BroadPhaseType::kUniformGrid })
+			{
+				CollisionScene scene(count, extent, 42);
+				CollisionManager collisionManager;
+				collisionManager.SetBroadPhase(CreateBroadPhase(type));
+				const double microseconds = Benchmark::MeasureMicroseconds(10, [&]() { scene.Step(collisionManager, extent); });
+				Benchmark::Report(std::to_string(count) + " colliders, " + kBroadPhaseNames[static_cast<int>(type)], microseconds, "us/frame");
+			}
+		}
+		return true;
+		});
+}
@@ -0,0 +1,285 @@
+/**
+ * @file CollisionBenchmark.cpp
+ * @brief CollisionManagerの詳細判定・並列化・連続的な衝突判定のベンチマーク・テスト
+ * @author 青木智滉
+ * @date
+ */
+
+#include "Benchmark.h"
+#include "CollisionScene.h"
+#include "Engine/Components/Collision/BoundingVolumeHierarchy.h"
+#include "Engine/Utilities/JobSystem.h"
+#include <cmath>
+#include <string>
+
+namespace
+{
+	//ワーカースレッドの数を設定（0の場合は呼び出したスレッドだけで処理する）
+	void SetWorkerCount(uint32_t workerCount)
+	{
+		if (workerCount == 0)
+		{
+			JobSystem::GetInstance()->Finalize();
+			return;
+		}
+		JobSystem::GetInstance()->Initialize(workerCount);
+	}
+
+	//既定のブロードフェーズでシーンを指定したフレーム数動かして衝突イベントを記録
+	std::vector<ContactRecorderObject::Event> RunScene(uint32_t count, float extent, uint32_t frames)
+	{
+		CollisionScene scene(count, extent, 42);
+		CollisionManager collisionManager;
+		for (uint32_t frame = 0; frame < frames; ++frame)
+		{
+			scene.Step(collisionManager, extent);
+		}
+		return scene.GetEvents();
+	}
+
+	//型ごとの衝突判定関数を直接呼び出す（引数の順番は型の組み合わせに合わせる）
+	bool CallTypedFunction(const Collider* collider1, const Collider* collider2)
+	{
+		const auto* sphere1 = static_cast<const SphereCollider*>(collider1);
+		const auto* aabb1 = static_cast<const AABBCollider*>(collider1);
+		const auto* obb1 = static_cast<const OBBCollider*>(collider1);
+		const auto* sphere2 = static_cast<const SphereCollider*>(collider2);
+		const auto* aabb2 = static_cast<const AABBCollider*>(collider2);
+		const auto* obb2 = static_cast<const OBBCollider*>(collider2);
+		switch (collider1->GetColliderType())
+		{
+		case ColliderType::kSphere:
+			switch (collider2->GetColliderType())
+			{
+			case ColliderType::kSphere: return CollisionManager::CheckSphereSphereCollision(sphere1, sphere2);
+			case ColliderType::kAABB: return CollisionManager::CheckSphereAABBCollision(sphere1, aabb2);
+			default: return CollisionManager::CheckSphereOBBCollision(sphere1, obb2);
+			}
+		case ColliderType::kAABB:
+			switch (collider2->GetColliderType())
+			{
+			case ColliderType::kSphere: return CollisionManager::CheckSphereAABBCollision(sphere2, aabb1);
+			case ColliderType::kAABB: return CollisionManager::CheckAABBAABBCollision(aabb1, aabb2);
+			default: return CollisionManager::CheckAABBOBBCollision(aabb1, obb2);
+			}
+		default:
+			switch (collider2->GetColliderType())
+			{
+			case ColliderType::kSphere: return CollisionManager::CheckSphereOBBCollision(sphere2, obb1);
+			case ColliderType::kAABB: return CollisionManager::CheckAABBOBBCollision(aabb2, obb1);
+			default: return CollisionManager::CheckOBBOBBCollision(obb1, obb2);
+			}
+		}
+	}
+
+	//型の表に置き換える前のdynamic_castを順に試す判定（比較用）
+	bool DynamicCastDispatch(const Collider* collider1, const Collider* collider2)
+	{
+		if (!collider1->GetCollisionEnabled() || !collider2->GetCollisionEnabled())
+		{
+			return false;
+		}
+		if (dynamic_cast<const SphereCollider*>(collider1) && dynamic_cast<const SphereCollider*>(collider2))
+		{
+			return CollisionManager::CheckSphereSphereCollision(static_cast<const SphereCollider*>(collider1), static_cast<const SphereCollider*>(collider2));
+		}
+		else if (dynamic_cast<const AABBCollider*>(collider1) && dynamic_cast<const AABBCollider*>(collider2))
+		{
+			return CollisionManager::CheckAABBAABBCollision(static_cast<const AABBCollider*>(collider1), static_cast<const AABBCollider*>(collider2));
+		}
+		else if (dynamic_cast<const OBBCollider*>(collider1) && dynamic_cast<const OBBCollider*>(collider2))
+		{
+			return CollisionManager::CheckOBBOBBCollision(static_cast<const OBBCollider*>(collider1), static_cast<const OBBCollider*>(collider2));
+		}
+		else if (dynamic_cast<const SphereCollider*>(collider1) && dynamic_cast<const AABBCollider*>(collider2))
+		{
+			return CollisionManager::CheckSphereAABBCollision(static_cast<const SphereCollider*>(collider1), static_cast<const AABBCollider*>(collider2));
+		}
+		else if (dynamic_cast<const AABBCollider*>(collider1) && dynamic_cast<const SphereCollider*>(collider2))
+		{
+			return CollisionManager::CheckSphereAABBCollision(static_cast<const SphereCollider*>(collider2), static_cast<const AABBCollider*>(collider1));
+		}
+		else if (dynamic_cast<const SphereCollider*>(collider1) && dynamic_cast<const OBBCollider*>(collider2))
+		{
+			return CollisionManager::CheckSphereOBBCollision(static_cast<const SphereCollider*>(collider1), static_cast<const OBBCollider*>(collider2));
+		}
+		else if (dynamic_cast<const OBBCollider*>(collider1) && dynamic_cast<const SphereCollider*>(collider2))
+		{
+			return CollisionManager::CheckSphereOBBCollision(static_cast<const SphereCollider*>(collider2), static_cast<const OBBCollider*>(collider1));
+		}
+		else if (dynamic_cast<const AABBCollider*>(collider1) && dynamic_cast<const OBBCollider*>(collider2))
+		{
+			return CollisionManager::CheckAABBOBBCollision(static_cast<const AABBCollider*>(collider1), static_cast<const OBBCollider*>(collider2));
+		}
+		else if (dynamic_cast<const OBBCollider*>(collider1) && dynamic_cast<const AABBCollider*>(collider2))
+		{
+			return CollisionManager::CheckAABBOBBCollision(static_cast<const AABBCollider*>(collider2), static_cast<const OBBCollider*>(collider1));
+		}
+		return false;
+	}
+
+	//型の表からの呼び出しが型ごとの関数を直接呼び出した結果と一致するか
+	Benchmark::Registration dispatchTest("Collision/TypeTableDispatch", Benchmark::Kind::kTest, []() {
+		CollisionScene scene(300, 6.0f, 7);
+		const std::vector<Collider*>& colliders = scene.GetColliders();
+		uint32_t mismatchCount = 0;
+		uint32_t hitCount = 0;
+		for (Collider* collider1 : colliders)
+		{
+			for (Collider* collider2 : colliders)
+			{
+				if (collider1 == collider2) continue;
+				const bool isColliding = CollisionManager::IsColliding(collider1, collider2);
+				hitCount += isColliding ? 1 : 0;
+				if (isColliding != CallTypedFunction(collider1, collider2) || isColliding != DynamicCastDispatch(collider1, collider2) || isColliding != CollisionManager::IsColliding(collider2, collider1))
+				{
+					++mismatchCount;
+				}
+			}
+		}
+		bool result = Benchmark::Expect(hitCount > 0, "衝突しているペアがない");
+		result &= Benchmark::Expect(mismatchCount == 0, std::to_string(mismatchCount) + " pairs differ from the typed functions");
+		return result;
+		});
+
+	//BVHのコールバックの中でさらに同じBVHを探索しても全ての重なりが列挙されるか
+	Benchmark::Registration bvhNestedQueryTest("Collision/BVHNestedQuery", Benchmark::Kind::kTest, []() {
+		CollisionScene scene(1000, 20.0f, 3);
+		const std::vector<Collider*>& colliders = scene.GetColliders();
+		BoundingVolumeHierarchy bvh;
+		bvh.Build(colliders);
+
+		//総当たりで重なっている3つ組の数を数える
+		auto overlaps = [&](uint32_t a, uint32_t b) { return colliders[a]->GetWorldBounds().Overlaps(colliders[b]->GetWorldBounds()); };
+		uint64_t expected = 0;
+		for (uint32_t i = 0; i < static_cast<uint32_t>(colliders.size()); ++i)
+		{
+			for (uint32_t j = 0; j < static_cast<uint32_t>(colliders.size()); ++j)
+			{
+				if (!overlaps(i, j)) continue;
+				for (uint32_t k = 0; k < static_cast<uint32_t>(colliders.size()); ++k)
+				{
+					expected += overlaps(j, k) ? 1 : 0;
+				}
+			}
+		}
+
+		//入れ子にした探索で同じ数になるか
+		uint64_t actual = 0;
+		for (uint32_t i = 0; i < static_cast<uint32_t>(colliders.size()); ++i)
+		{
+			bvh.Query(colliders[i]->GetWorldBounds(), [&](uint32_t j) {
+				bvh.Query(colliders[j]->GetWorldBounds(), [&](uint32_t) { ++actual; });
+				});
+		}
+		bool result = Benchmark::Expect(expected > colliders.size(), "重なっているコライダーがない");
+		result &= Benchmark::Expect(actual == expected, "nested query found " + std::to_string(actual) + " of " + std::to_string(expected));
+		return result;
+		});
+
+	//ワーカースレッドの数を変えても衝突イベントの順番が変わらないか
+	Benchmark::Registration contactOrderTest("Collision/ContactOrderAcrossWorkers", Benchmark::Kind::kTest, []() {
+		SetWorkerCount(0);
+		const std::vector<ContactRecorderObject::Event> expected = RunScene(2000, 30.0f, 30);
+		bool result = Benchmark::Expect(!expected.empty(), "衝突イベントがない");
+		for (uint32_t workerCount : { 1u, 3u, 7u })
+		{
+			SetWorkerCount(workerCount);
+			result &= Benchmark::Expect(RunScene(2000, 30.0f, 30) == expected, std::to_string(workerCount) + " workers: event log differs");
+		}
+		SetWorkerCount(0);
+		return result;
+		});
+
+	//1フレームで90度回転する細長いOBBが、前回と今回の向きの間にある球と衝突するか
+	Benchmark::Registration sweptRotationTest("Collision/SweptOBBRotation", Benchmark::Kind::kTest, []() {
+		bool result = true;
+		for (bool isRotating : { true, false })
+		{
+			std::vector<ContactRecorderObject::Event> events{};
+			uint32_t frame = 0;
+			ContactRecorderObject obbObject;
+			ContactRecorderObject sphereObject;
+			obbObject.SetRecorder(&events, &frame, 0);
+			sphereObject.SetRecorder(&events, &frame, 1);
+			OBBCollider* obb = obbObject.AddComponent<OBBCollider>();
+			obb->SetWorldCenter({ 0.0f,0.0f,0.0f });
+			obb->SetSize({ 3.0f,0.2f,0.2f });
+			obb->SetIsContinuous(true);
+			SphereCollider* sphere = sphereObject.AddComponent<SphereCollider>();
+			sphere->SetRadius(0.2f);
+			sphere->SetWorldCenter(Mathf::Normalize(Vector3{ 1.0f,0.0f,-1.0f }) * 2.0f);
+
+			//前回はX軸、今回はY軸回りに90度回した向き
+			CollisionManager collisionManager;
+			for (; frame < 2; ++frame)
+			{
+				const Quaternion rotation = Mathf::MakeRotateAxisAngleQuaternion({ 0.0f,1.0f,0.0f }, isRotating && frame == 1 ? 3.14159265f * 0.5f : 0.0f);
+				obb->SetOrientations(Mathf::RotateVector({ 1.0f,0.0f,0.0f }, rotation), Mathf::RotateVector({ 0.0f,1.0f,0.0f }, rotation), Mathf::RotateVector({ 0.0f,0.0f,1.0f }, rotation));
+				collisionManager.ClearColliderList();
+				collisionManager.SetColliderList(obb);
+				collisionManager.SetColliderList(sphere);
+				collisionManager.CheckAllCollisions();
+			}
+
+			//どちらの向きでも球には届かないので、回転した場合だけ衝突する
+			result &= Benchmark::Expect(!CollisionManager::IsColliding(obb, sphere), "sphere overlaps the OBB at the end pose");
+			result &= Benchmark::Expect(events.empty() != isRotating, isRotating ? "rotation sweep missed the sphere" : "static OBB hit the sphere");
+		}
+		return result;
+		});
+
+	//dynamic_castを順に試す判定と型の表からの判定の、全ペアあたりの処理量
+	Benchmark::Registration dispatchBenchmark("Collision/Dispatch", Benchmark::Kind::kBenchmark, []() {
+		CollisionScene scene(1000, 20.0f, 7);
+		const std::vector<Collider*>& colliders = scene.GetColliders();
+		const double pairCount = static_cast<double>(colliders.size()) * static_cast<double>(colliders.size() - 1);
+		uint32_t hitCounts[2] = {};
+		const char* const names[] = { "dynamic_cast chain", "type table" };
+		for (uint32_t method = 0; method < 2; ++method)
+		{
+			const double microseconds = Benchmark::MeasureMicroseconds(3, [&]() {
+				uint32_t hitCount = 0;
+				for (const Collider* collider1 : colliders)
+				{
+					for (const Collider* collider2 : colliders)
+					{
+						if (collider1 == collider2) continue;
+						hitCount += (method == 0 ? DynamicCastDispatch(collider1, collider2) : CollisionManager::IsColliding(collider1, collider2)) ? 1 : 0;
+					}
+				}
+				hitCounts[method] = hitCount;
+				});
+			Benchmark::Report(std::string("1000 mixed colliders, ") + names[method], pairCount / microseconds * 1000000.0, "pairs/s");
+		}
+		return Benchmark::Expect(hitCounts[0] == hitCounts[1], "dispatch methods found different hit counts");
+		});
+
+	//ワーカースレッドの数ごとのCheckAllCollisionsの時間
+	Benchmark::Registration workerBenchmark("Collision/Workers", Benchmark::Kind::kBenchmark, []() {
+		for (uint32_t workerCount : { 0u, 1u, 3u, 7u })
+		{
+			SetWorkerCount(workerCount);
+			CollisionScene scene(4000, 40.0f, 42);
+			CollisionManager collisionManager;
+			const double microseconds = Benchmark::MeasureMicroseconds(10, [&]() { scene.Step(collisionManager, 40.0f); });
+			Benchmark::Report("4000 colliders, " + std::to_string(workerCount) + " workers", microseconds, "us/frame");
+		}
+		SetWorkerCount(0);
+		return true;
+		});
+
+	//連続的な衝突判定で移動・回転するコライダーのCheckAllCollisionsの時間
+	Benchmark::Registration sweptBenchmark("Collision/Swept", Benchmark::Kind::kBenchmark, []() {
+		for (uint32_t count : { 1000u, 4000u })
+		{
+			const float extent = 20.0f * std::sqrt(count / 1000.0f);
+			CollisionScene scene(count, extent, 42);
+			scene.SetContinuous();
+			CollisionManager collisionManager;
+			const double microseconds = Benchmark::MeasureMicroseconds(10, [&]() { scene.Step(collisionManager, extent); });
+			Benchmark::Report(std::to_string(count) + " continuous colliders", microseconds, "us/frame");
+		}
+		return true;
+		});
+}
@@ -0,0 +1,214 @@
+/**
+ * @file CollisionScene.h
+ * @brief 衝突判定のベンチマーク・テスト用に乱数でコライダーを配置するシーン
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Engine/Components/Collision/CollisionManager.h"
+#include "Engine/Framework/Object/GameObject.h"
+#include "Engine/Math/MathFunction.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+//衝突イベントを記録するゲームオブジェクト
+class ContactRecorderObject : public GameObject
+{
+public:
+	//記録する衝突イベント
+	struct Event
+	{
+		uint32_t frame;
+		uint32_t self;
+		uint32_t other;
+		char type;//'E' = Enter, 'S' = Stay, 'X' = Exit
+
+		bool operator==(const Event& rhs) const = default;
+	};
+
+	//記録先と番号を設定
+	void SetRecorder(std::vector<Event>* events, const uint32_t* frame, uint32_t id) { events_ = events; frame_ = frame; id_ = id; };
+
+	void OnCollision(GameObject* other) override { Record(other, 'S'); };
+	void OnCollisionEnter(GameObject* other) override { Record(other, 'E'); };
+	void OnCollisionExit(GameObject* other) override { Record(other, 'X'); };
+
+private:
+	void Record(GameObject* other, char type)
+	{
+		if (events_)
+		{
+			events_->push_back({ *frame_, id_, static_cast<ContactRecorderObject*>(other)->id_, type });
+		}
+	}
+
+private:
+	std::vector<Event>* events_ = nullptr;
+	const uint32_t* frame_ = nullptr;
+	uint32_t id_ = 0;
+};
+
+//乱数で配置したコライダーを毎フレーム移動させるシーン
+class CollisionScene
+{
+public:
+	/// <summary>
+	/// 球・AABB・OBBを同じ割合で配置
+	/// </summary>
+	/// <param name="count">コライダーの数</param>
+	/// <param name="extent">配置する範囲の半分の大きさ</param>
+	/// <param name="seed">乱数のシード</param>
+	CollisionScene(uint32_t count, float extent, uint32_t seed)
+		: random_(seed)
+	{
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			std::unique_ptr<ContactRecorderObject> object = std::make_unique<ContactRecorderObject>();
+			object->SetRecorder(&events_, &frame_, i);
+			const Vector3 position = { unit(random_) * extent, unit(random_) * extent * 0.25f, unit(random_) * extent };
+
+			Collider* collider = nullptr;
+			switch (i % 3)
+			{
+			case 0:
+			{
+				SphereCollider* sphere = object->AddComponent<SphereCollider>();
+				sphere->SetRadius(1.0f + unit(random_) * 0.5f);
+				sphere->SetWorldCenter(position);
+				collider = sphere;
+				break;
+			}
+			case 1:
+			{
+				AABBCollider* aabb = object->AddComponent<AABBCollider>();
+				aabb->SetMin({ -1.0f - unit(random_) * 0.5f, -1.0f, -1.5f });
+				aabb->SetMax({ 1.0f, 1.2f + unit(random_) * 0.5f, 1.0f });
+				aabb->SetWorldCenter(position);
+				collider = aabb;
+				break;
+			}
+			default:
+			{
+				OBBCollider* obb = object->AddComponent<OBBCollider>();
+				const Matrix4x4 rotateMatrix = Mathf::MakeRotateMatrix(RandomRotation());
+				obb->SetOrientations({ rotateMatrix.m[0][0], rotateMatrix.m[0][1], rotateMatrix.m[0][2] },
+					{ rotateMatrix.m[1][0], rotateMatrix.m[1][1], rotateMatrix.m[1][2] },
+					{ rotateMatrix.m[2][0], rotateMatrix.m[2][1], rotateMatrix.m[2][2] });
+				obb->SetSize({ 1.5f + unit(random_) * 0.5f, 0.5f, 1.0f });
+				obb->SetWorldCenter(position);
+				obb->Update();
+				collider = obb;
+				break;
+			}
+			}
+
+			//衝突属性とマスクを散らす
+			collider->SetCollisionAttribute(1u << (i % 4));
+			collider->SetCollisionMask(i % 5 == 0 ? 0xffffffffu : ~(1u << ((i + 1) % 4)));
+
+			objects_.push_back(std::move(object));
+			colliders_.push_back(collider);
+			velocities_.push_back({ unit(random_) * 0.5f, unit(random_) * 0.1f, unit(random_) * 0.5f });
+		}
+	}
+
+	/// <summary>
+	/// コライダーを移動させて衝突判定を行う（範囲の外に出たものは反射させる）
+	/// </summary>
+	/// <param name="collisionManager">衝突判定を行うマネージャー</param>
+	/// <param name="extent">範囲の半分の大きさ</param>
+	void Step(CollisionManager& collisionManager, float extent)
+	{
+		collisionManager.ClearColliderList();
+		for (uint32_t i = 0; i < static_cast<uint32_t>(colliders_.size()); ++i)
+		{
+			Vector3 center = GetWorldCenter(colliders_[i]) + velocities_[i];
+			if (std::abs(center.x) > extent) velocities_[i].x = -velocities_[i].x;
+			if (std::abs(center.z) > extent) velocities_[i].z = -velocities_[i].z;
+			SetWorldCenter(colliders_[i], center);
+
+			//連続的な衝突判定を行う場合はOBBを回転させる
+			if (isContinuous_ && colliders_[i]->GetColliderType() == ColliderType::kOBB)
+			{
+				OBBCollider* obb = static_cast<OBBCollider*>(colliders_[i]);
+				const Quaternion rotation = Mathf::MakeRotateAxisAngleQuaternion({ 0.0f,1.0f,0.0f }, 0.3f);
+				obb->SetOrientations(Mathf::RotateVector(obb->GetOrientation(0), rotation), Mathf::RotateVector(obb->GetOrientation(1), rotation), Mathf::RotateVector(obb->GetOrientation(2), rotation));
+			}
+
+			//一部のコライダーは有効・無効を切り替えたり登録を飛ばしたりする
+			if (i % 7 == 0) colliders_[i]->SetCollisionEnabled((frame_ / 3 + i) % 2 == 0);
+			if (!IsRegistered(i, frame_)) continue;
+			collisionManager.SetColliderList(colliders_[i]);
+		}
+		collisionManager.CheckAllCollisions();
+		++frame_;
+	}
+
+	/// <summary>
+	/// 全てのコライダーで連続的な衝突判定を行い、OBBは毎フレーム回転させる
+	/// </summary>
+	void SetContinuous()
+	{
+		isContinuous_ = true;
+		for (Collider* collider : colliders_)
+		{
+			collider->SetIsContinuous(true);
+		}
+	}
+
+	/// <summary>
+	/// ランダムな回転を作成
+	/// </summary>
+	/// <returns>正規化されたクォータニオン</returns>
+	Quaternion RandomRotation()
+	{
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		return Mathf::Normalize(Quaternion{ unit(random_), unit(random_), unit(random_), unit(random_) });
+	}
+
+	//コライダーの中心を取得
+	static Vector3 GetWorldCenter(const Collider* collider)
+	{
+		switch (collider->GetColliderType())
+		{
+		case ColliderType::kSphere: return static_cast<const SphereCollider*>(collider)->GetWorldCenter();
+		case ColliderType::kAABB: return static_cast<const AABBCollider*>(collider)->GetWorldCenter();
+		default: return static_cast<const OBBCollider*>(collider)->GetWorldCenter();
+		}
+	}
+
+	//コライダーの中心を設定
+	static void SetWorldCenter(Collider* collider, const Vector3& center)
+	{
+		switch (collider->GetColliderType())
+		{
+		case ColliderType::kSphere: static_cast<SphereCollider*>(collider)->SetWorldCenter(center); break;
+		case ColliderType::kAABB: static_cast<AABBCollider*>(collider)->SetWorldCenter(center); break;
+		default: static_cast<OBBCollider*>(collider)->SetWorldCenter(center); break;
+		}
+	}
+
+	//指定したフレームにコライダーを登録するか
+	static bool IsRegistered(uint32_t index, uint32_t frame) { return !(index % 11 == 0 && frame % 4 == 1); };
+
+	//コライダーを取得
+	const std::vector<Collider*>& GetColliders() const { return colliders_; };
+
+	//次に判定するフレームを取得
+	uint32_t GetFrame() const { return frame_; };
+
+	//記録された衝突イベントを取得
+	const std::vector<ContactRecorderObject::Event>& GetEvents() const { return events_; };
+
+private:
+	std::mt19937 random_;
+	std::vector<std::unique_ptr<ContactRecorderObject>> objects_{};
+	std::vector<Collider*> colliders_{};
+	std::vector<Vector3> velocities_{};
+	std::vector<ContactRecorderObject::Event> events_{};
+	uint32_t frame_ = 0;
+	bool isContinuous_ = false;
+};
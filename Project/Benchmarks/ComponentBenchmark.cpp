@@ -0,0 +1,298 @@
+/**
+ * @file ComponentBenchmark.cpp
+ * @brief コンポーネントの取得・ストレージのベンチマーク・テスト
+ * @author 青木智滉
+ * @date
+ */
+
+#include "AnimatedScene.h"
+#include "Benchmark.h"
+#include "Engine/Components/Collision/AABBCollider.h"
+#include "Engine/Components/Collision/OBBCollider.h"
+#include "Engine/Components/Collision/SphereCollider.h"
+#include "Engine/Components/Transform/TransformComponent.h"
+#include "Engine/Framework/Object/GameObject.h"
+#include "Engine/Framework/Object/GameObjectManager.h"
+#include <chrono>
+#include <memory>
+#include <random>
+
+namespace
+{
+	//キャッシュを使わずにコンポーネントを先頭から探せるようにしたゲームオブジェクト
+	class LookupObject : public GameObject
+	{
+	public:
+		//キャッシュを使う前と同じようにdynamic_castで先頭から探す
+		template<class Type>
+		Type* ScanComponent() const
+		{
+			for (const auto& component : components_)
+			{
+				if (auto* specificComponent = dynamic_cast<Type*>(component.get()))
+				{
+					return specificComponent;
+				}
+			}
+			return nullptr;
+		}
+	};
+
+	//何もしないコンポーネント（ゲームのコンポーネントの数に合わせるために使う）
+	template<uint32_t kIndex>
+	class EmptyComponent : public Component
+	{
+	public:
+		void Initialize() override {};
+		void Update() override {};
+	};
+
+	//取得する全ての型でキャッシュとdynamic_castの結果が一致するか
+	bool MatchesScan(LookupObject& object)
+	{
+		return object.GetComponent<TransformComponent>() == object.ScanComponent<TransformComponent>()
+			&& object.GetComponent<SphereCollider>() == object.ScanComponent<SphereCollider>()
+			&& object.GetComponent<AABBCollider>() == object.ScanComponent<AABBCollider>()
+			&& object.GetComponent<OBBCollider>() == object.ScanComponent<OBBCollider>()
+			&& object.GetComponent<Collider>() == object.ScanComponent<Collider>()
+			&& object.GetComponent<EmptyComponent<0>>() == object.ScanComponent<EmptyComponent<0>>()
+			&& object.GetComponent<EmptyComponent<1>>() == object.ScanComponent<EmptyComponent<1>>();
+	}
+
+	//コンポーネントを1つずつランダムに追加する
+	void AddRandomComponent(LookupObject& object, uint32_t type)
+	{
+		switch (type)
+		{
+		case 0: object.AddComponent<TransformComponent>(); break;
+		case 1: object.AddComponent<SphereCollider>(); break;
+		case 2: object.AddComponent<AABBCollider>(); break;
+		case 3: object.AddComponent<OBBCollider>(); break;
+		case 4: object.AddComponent<EmptyComponent<0>>(); break;
+		default: object.AddComponent<EmptyComponent<1>>(); break;
+		}
+	}
+
+	//コンポーネントを追加しながら取得した結果が、キャッシュを使わずに探した結果と一致するか（見つからなかった結果や基底クラスで取得した結果も含む）
+	Benchmark::Registration lookupTest("Component/LookupMatchesScan", Benchmark::Kind::kTest, []() {
+		std::mt19937 random(21);
+		std::uniform_int_distribution<uint32_t> typeDistribution(0, 5);
+		uint32_t mismatchCount = 0;
+		for (uint32_t objectIndex = 0; objectIndex < 500; ++objectIndex)
+		{
+			std::unique_ptr<LookupObject> object = std::make_unique<LookupObject>();
+			mismatchCount += MatchesScan(*object) ? 0 : 1;
+			const uint32_t componentCount = 1 + objectIndex % 6;
+			for (uint32_t i = 0; i < componentCount; ++i)
+			{
+				AddRandomComponent(*object, typeDistribution(random));
+				mismatchCount += MatchesScan(*object) ? 0 : 1;
+			}
+		}
+		return Benchmark::Expect(mismatchCount == 0, std::to_string(mismatchCount) + " lookups differ from the dynamic_cast scan");
+		});
+
+	//ゲームのオブジェクトに近い構成（トランスフォーム、コライダー、その他のコンポーネント）で毎フレーム取得する時間
+	Benchmark::Registration lookupBenchmark("Component/Lookup", Benchmark::Kind::kBenchmark, []() {
+		static const uint32_t kObjectCount = 4000;
+		std::vector<std::unique_ptr<LookupObject>> objects{};
+		for (uint32_t i = 0; i < kObjectCount; ++i)
+		{
+			std::unique_ptr<LookupObject> object = std::make_unique<LookupObject>();
+			object->AddComponent<EmptyComponent<0>>();
+			object->AddComponent<EmptyComponent<1>>();
+			object->AddComponent<EmptyComponent<2>>();
+			object->AddComponent<TransformComponent>();
+			AddRandomComponent(*object, 1 + i % 3);
+			objects.push_back(std::move(object));
+		}
+
+		//コンポーネントのUpdateで取得するのと同じ型を取得する
+		uintptr_t checksum = 0;
+		const double scan = Benchmark::MeasureMicroseconds(5, [&]() {
+			for (const std::unique_ptr<LookupObject>& object : objects)
+			{
+				checksum += reinterpret_cast<uintptr_t>(object->ScanComponent<TransformComponent>());
+				checksum += reinterpret_cast<uintptr_t>(object->ScanComponent<Collider>());
+				checksum += reinterpret_cast<uintptr_t>(object->ScanComponent<OBBCollider>());
+				checksum += reinterpret_cast<uintptr_t>(object->ScanComponent<EmptyComponent<3>>());
+			}
+			});
+		const double cached = Benchmark::MeasureMicroseconds(5, [&]() {
+			for (const std::unique_ptr<LookupObject>& object : objects)
+			{
+				checksum -= reinterpret_cast<uintptr_t>(object->GetComponent<TransformComponent>());
+				checksum -= reinterpret_cast<uintptr_t>(object->GetComponent<Collider>());
+				checksum -= reinterpret_cast<uintptr_t>(object->GetComponent<OBBCollider>());
+				checksum -= reinterpret_cast<uintptr_t>(object->GetComponent<EmptyComponent<3>>());
+			}
+			});
+
+		Benchmark::Report("dynamic_cast scan", scan, "us/4000 objects");
+		Benchmark::Report("cached by type id", cached, "us/4000 objects");
+		return Benchmark::Expect(checksum == 0, "lookups differ between the scan and the cache");
+		});
+
+	//ストレージを使うかどうかを切り替えられるゲームオブジェクトファクトリー
+	class StorageFactory : public AbstractGameObjectFactory
+	{
+	public:
+		StorageFactory(const bool useComponentStorage) : useComponentStorage_(useComponentStorage) {};
+
+		GameObject* CreateGameObject(const std::string&) override
+		{
+			GameObject* gameObject = new GameObject();
+			gameObject->SetUseComponentStorage(useComponentStorage_);
+			return gameObject;
+		}
+
+	private:
+		bool useComponentStorage_ = false;
+	};
+
+	//背景のオブジェクトと同じ構成（トランスフォームとコライダー）のゲームオブジェクトを並べたシーン
+	class StorageScene
+	{
+	public:
+		StorageScene(const bool useComponentStorage, const uint32_t objectCount) : factory_(useComponentStorage)
+		{
+			//ゲームと同じ順番でストレージを登録
+			gameObjectManager_ = GameObjectManager::GetInstance();
+			gameObjectManager_->RegisterComponentStorage<TransformComponent>();
+			gameObjectManager_->RegisterComponentStorage<AABBCollider>();
+			gameObjectManager_->RegisterComponentStorage<OBBCollider>();
+			gameObjectManager_->RegisterComponentStorage<SphereCollider>();
+			gameObjectManager_->SetGameObjectFactory(&factory_);
+			for (uint32_t i = 0; i < objectCount; ++i)
+			{
+				GameObject* gameObject = GameObjectManager::CreateGameObject("StorageObject");
+				gameObject->AddComponent<OBBCollider>();
+				spheres_.push_back(gameObject->AddComponent<SphereCollider>());
+				gameObjects_.push_back(gameObject);
+			}
+			gameObjectManager_->Update();
+		}
+
+		~StorageScene()
+		{
+			GameObjectManager::Destroy();
+		}
+
+		//全てのゲームオブジェクトを動かす（一部は無効にする）
+		void Move(const uint32_t frame)
+		{
+			for (uint32_t i = 0; i < gameObjects_.size(); ++i)
+			{
+				gameObjects_[i]->SetIsActive((i + frame) % 5 != 0);
+				gameObjects_[i]->GetComponent<TransformComponent>()->worldTransform_.translation_ = { i * 0.5f, frame * 1.0f, -(i % 7) * 1.0f };
+			}
+		}
+
+		//全てのゲームオブジェクトに破壊フラグを立てる
+		void DestroyAll()
+		{
+			for (GameObject* gameObject : gameObjects_)
+			{
+				gameObject->SetIsDestroy(true);
+			}
+			gameObjects_.clear();
+			spheres_.clear();
+		}
+
+		//球のコライダーのワールド座標を集める
+		void Collect(std::vector<Vector3>& worldCenters) const
+		{
+			for (const SphereCollider* sphere : spheres_)
+			{
+				worldCenters.push_back(sphere->GetWorldCenter());
+			}
+		}
+
+		GameObjectManager* GetGameObjectManager() const { return gameObjectManager_; };
+
+	private:
+		StorageFactory factory_;
+		GameObjectManager* gameObjectManager_ = nullptr;
+		std::vector<GameObject*> gameObjects_{};
+		std::vector<SphereCollider*> spheres_{};
+	};
+
+	//ストレージを使うかどうかでコライダーの更新結果が変わらないか
+	std::vector<Vector3> RunStorageScene(const bool useComponentStorage)
+	{
+		StorageScene scene(useComponentStorage, 300);
+		std::vector<Vector3> worldCenters{};
+		for (uint32_t frame = 0; frame < 12; ++frame)
+		{
+			scene.Move(frame);
+			scene.GetGameObjectManager()->Update();
+			scene.Collect(worldCenters);
+		}
+		return worldCenters;
+	}
+
+	//ストレージでまとめて更新した結果が、ゲームオブジェクトごとに更新した結果と一致するか（途中で無効にしたものは更新されないことも含む）
+	Benchmark::Registration storageTest("Component/StorageMatchesPerObject", Benchmark::Kind::kTest, []() {
+		const std::vector<Vector3> perObject = RunStorageScene(false);
+		const std::vector<Vector3> pooled = RunStorageScene(true);
+		uint32_t mismatchCount = 0;
+		for (size_t i = 0; i < perObject.size(); ++i)
+		{
+			mismatchCount += perObject[i] == pooled[i] ? 0 : 1;
+		}
+		return Benchmark::Expect(mismatchCount == 0, std::to_string(mismatchCount) + " world centers differ from the per-object update");
+		});
+
+	//ゲームオブジェクトごとに更新した場合とストレージでまとめて更新した場合のGameObjectManager::Updateと全て破棄する時間
+	Benchmark::Registration storageBenchmark("Component/Storage", Benchmark::Kind::kBenchmark, []() {
+		for (const uint32_t objectCount : { 4000u, 20000u })
+		{
+			const std::string unit = "us/" + std::to_string(objectCount) + " objects";
+			for (const bool useComponentStorage : { false, true })
+			{
+				StorageScene scene(useComponentStorage, objectCount);
+				scene.Move(1);
+				const double elapsed = Benchmark::MeasureMicroseconds(20, [&]() {
+					scene.GetGameObjectManager()->Update();
+					});
+				Benchmark::Report(useComponentStorage ? "pooled" : "per-object", elapsed, unit.c_str());
+
+				//全て破棄したときに削除する時間（ストレージへの返却を含む）
+				scene.DestroyAll();
+				const auto start = std::chrono::steady_clock::now();
+				scene.GetGameObjectManager()->Update();
+				const double destroy = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+				Benchmark::Report(useComponentStorage ? "pooled, destroy all" : "per-object, destroy all", destroy, unit.c_str());
+			}
+		}
+		return true;
+		});
+
+	//アニメーターを持つゲームオブジェクトのモデルが1フレームに1回だけ更新され、ストレージを使わない場合と同じジョイントの行列になるか
+	Benchmark::Registration animatedStorageTest("Component/AnimatedStorageUpdatesModelOnce", Benchmark::Kind::kTest, []() {
+		bool result = true;
+		std::vector<Matrix4x4> jointMatrices[2]{};
+		for (const bool useComponentStorage : { false, true })
+		{
+			AnimatedScene scene(useComponentStorage, 8);
+			uint32_t wrongCount = 0;
+			for (uint32_t frame = 0; frame < 30; ++frame)
+			{
+				std::vector<uint32_t> updateCounts{};
+				for (size_t i = 0; i < scene.GetModelCount(); ++i)
+				{
+					updateCounts.push_back(scene.GetModelUpdateCount(i));
+				}
+				scene.Update();
+				for (size_t i = 0; i < scene.GetModelCount(); ++i)
+				{
+					wrongCount += scene.GetModelUpdateCount(i) - updateCounts[i] == 1 ? 0 : 1;
+				}
+			}
+			scene.CollectJointMatrices(jointMatrices[useComponentStorage]);
+			result &= Benchmark::Expect(wrongCount == 0, std::string(useComponentStorage ? "pooled" : "per-object") + ": " + std::to_string(wrongCount) + " model updates were not exactly once per frame");
+		}
+		result &= Benchmark::Expect(!jointMatrices[0].empty() && jointMatrices[0] == jointMatrices[1], "joint matrices differ between the per-object and pooled updates");
+		return result;
+		});
+}
@@ -0,0 +1,342 @@
+/**
+ * @file GltfLoader.cpp
+ * @brief ベンチマーク・テスト用にglTFファイルからモデルとアニメーションを読み込むファイル（assimpを使わずに読み込む）
+ * @author 青木智滉
+ * @date
+ */
+
+#include "GltfLoader.h"
+#include "Engine/Externals/nlohmann/json.hpp"
+#include "Engine/Math/MathFunction.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+	//glTFファイルとバッファ
+	struct Document
+	{
+		nlohmann::json json;
+		std::vector<std::vector<char>> buffers;
+	};
+
+	//glTFファイルとバッファを読み込む
+	Document LoadDocument(const std::string& filePath)
+	{
+		Document document{};
+		std::ifstream file(filePath);
+		assert(file.is_open());
+		document.json = nlohmann::json::parse(file);
+		const std::filesystem::path directory = std::filesystem::path(filePath).parent_path();
+		for (const nlohmann::json& buffer : document.json["buffers"])
+		{
+			std::ifstream bufferFile(directory / buffer["uri"].get<std::string>(), std::ios::binary);
+			assert(bufferFile.is_open());
+			document.buffers.emplace_back(std::istreambuf_iterator<char>(bufferFile), std::istreambuf_iterator<char>());
+		}
+		return document;
+	}
+
+	//アクセサーの要素をfloatに変換して読み込む（整数の要素はそのままの値にする）
+	std::vector<float> ReadAccessor(const Document& document, uint32_t accessorIndex, uint32_t& componentCount)
+	{
+		const nlohmann::json& accessor = document.json["accessors"][accessorIndex];
+		const nlohmann::json& bufferView = document.json["bufferViews"][accessor["bufferView"].get<uint32_t>()];
+		const std::string type = accessor["type"];
+		componentCount = type == "SCALAR" ? 1 : type == "VEC2" ? 2 : type == "VEC3" ? 3 : type == "VEC4" ? 4 : 16;
+		const uint32_t componentType = accessor["componentType"];
+		const uint32_t componentSize = componentType == 5126 || componentType == 5125 ? 4 : componentType == 5123 ? 2 : 1;
+		const uint32_t stride = bufferView.value("byteStride", componentSize * componentCount);
+		const uint32_t count = accessor["count"];
+		const char* data = document.buffers[bufferView["buffer"].get<uint32_t>()].data() + bufferView.value("byteOffset", 0u) + accessor.value("byteOffset", 0u);
+
+		std::vector<float> values(count * componentCount);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			for (uint32_t j = 0; j < componentCount; ++j)
+			{
+				const char* element = data + i * stride + j * componentSize;
+				switch (componentType)
+				{
+				case 5126: { float value; std::memcpy(&value, element, 4); values[i * componentCount + j] = value; break; }
+				case 5125: { uint32_t value; std::memcpy(&value, element, 4); values[i * componentCount + j] = static_cast<float>(value); break; }
+				case 5123: { uint16_t value; std::memcpy(&value, element, 2); values[i * componentCount + j] = static_cast<float>(value); break; }
+				default: values[i * componentCount + j] = static_cast<float>(static_cast<uint8_t>(*element)); break;
+				}
+			}
+		}
+		return values;
+	}
+
+	//右手系の行列を左手系に変換（X軸を反転する）
+	Matrix4x4 FlipX(const Matrix4x4& matrix)
+	{
+		Matrix4x4 result = matrix;
+		for (uint32_t i = 0; i < 4; ++i)
+		{
+			result.m[i][0] = -result.m[i][0];
+			result.m[0][i] = -result.m[0][i];
+		}
+		return result;
+	}
+
+	//ノードを再帰的に読み込む
+	Model::Node ReadNode(const Document& document, uint32_t nodeIndex)
+	{
+		const nlohmann::json& node = document.json["nodes"][nodeIndex];
+		const std::vector<float> translate = node.value("translation", std::vector<float>{ 0.0f, 0.0f, 0.0f });
+		const std::vector<float> rotate = node.value("rotation", std::vector<float>{ 0.0f, 0.0f, 0.0f, 1.0f });
+		const std::vector<float> scale = node.value("scale", std::vector<float>{ 1.0f, 1.0f, 1.0f });
+		Model::Node result{};
+		result.scale = { scale[0], scale[1], scale[2] };
+		result.rotate = { rotate[0], -rotate[1], -rotate[2], rotate[3] };
+		result.translate = { -translate[0], translate[1], translate[2] };
+		result.localMatrix = Mathf::MakeAffineMatrix(result.scale, result.rotate, result.translate);
+		result.name = node.value("name", std::string());
+		for (const nlohmann::json& child : node.value("children", nlohmann::json::array()))
+		{
+			result.children.push_back(ReadNode(document, child.get<uint32_t>()));
+		}
+		return result;
+	}
+}
+
+namespace GltfLoader
+{
+	Model::ModelData LoadModel(const std::string& filePath)
+	{
+		const Document document = LoadDocument(filePath);
+		const nlohmann::json& json = document.json;
+		Model::ModelData modelData{};
+
+		//メッシュを持つノードのプリミティブごとにメッシュを作る（assimpと同じ分け方）
+		for (const nlohmann::json& node : json["nodes"])
+		{
+			if (!node.contains("mesh"))
+			{
+				continue;
+			}
+
+			//スキンの逆バインドポーズ行列
+			std::vector<std::string> jointNames{};
+			std::vector<float> inverseBindPoseMatrices{};
+			if (node.contains("skin"))
+			{
+				const nlohmann::json& skin = json["skins"][node["skin"].get<uint32_t>()];
+				for (const nlohmann::json& joint : skin["joints"])
+				{
+					jointNames.push_back(json["nodes"][joint.get<uint32_t>()]["name"]);
+				}
+				uint32_t componentCount = 0;
+				inverseBindPoseMatrices = ReadAccessor(document, skin["inverseBindMatrices"], componentCount);
+			}
+
+			for (const nlohmann::json& primitive : json["meshes"][node["mesh"].get<uint32_t>()]["primitives"])
+			{
+				const nlohmann::json& attributes = primitive["attributes"];
+				uint32_t componentCount = 0;
+				const std::vector<float> positions = ReadAccessor(document, attributes["POSITION"], componentCount);
+				const std::vector<float> normals = ReadAccessor(document, attributes["NORMAL"], componentCount);
+				const std::vector<float> texcoords = ReadAccessor(document, attributes["TEXCOORD_0"], componentCount);
+				const std::vector<float> indices = ReadAccessor(document, primitive["indices"], componentCount);
+
+				//頂点とインデックス（右手系から左手系に変換し、巻き順を反転する）
+				Mesh::MeshData& meshData = modelData.meshData.emplace_back();
+				meshData.materialIndex = primitive.value("material", 0u);
+				meshData.vertices.resize(positions.size() / 3);
+				for (size_t i = 0; i < meshData.vertices.size(); ++i)
+				{
+					meshData.vertices[i].position = { -positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2], 1.0f };
+					meshData.vertices[i].normal = { -normals[i * 3], normals[i * 3 + 1], normals[i * 3 + 2] };
+					meshData.vertices[i].texcoord = { texcoords[i * 2], texcoords[i * 2 + 1] };
+				}
+				for (size_t i = 0; i + 2 < indices.size(); i += 3)
+				{
+					meshData.indices.push_back(static_cast<uint32_t>(indices[i]));
+					meshData.indices.push_back(static_cast<uint32_t>(indices[i + 2]));
+					meshData.indices.push_back(static_cast<uint32_t>(indices[i + 1]));
+				}
+
+				//ジョイントごとのウェイト
+				std::map<std::string, Model::JointWeightData>& skinClusterData = modelData.skinClusterData.emplace_back();
+				if (jointNames.empty() || !attributes.contains("JOINTS_0"))
+				{
+					continue;
+				}
+				const std::vector<float> joints = ReadAccessor(document, attributes["JOINTS_0"], componentCount);
+				const std::vector<float> weights = ReadAccessor(document, attributes["WEIGHTS_0"], componentCount);
+				for (uint32_t vertexIndex = 0; vertexIndex < static_cast<uint32_t>(meshData.vertices.size()); ++vertexIndex)
+				{
+					for (uint32_t k = 0; k < 4; ++k)
+					{
+						const float weight = weights[vertexIndex * 4 + k];
+						if (weight <= 0.0f)
+						{
+							continue;
+						}
+						const uint32_t joint = static_cast<uint32_t>(joints[vertexIndex * 4 + k]);
+						Model::JointWeightData& jointWeightData = skinClusterData[jointNames[joint]];
+						if (jointWeightData.vertexWeights.empty())
+						{
+							Matrix4x4 inverseBindPoseMatrix{};
+							std::memcpy(inverseBindPoseMatrix.m, &inverseBindPoseMatrices[joint * 16], sizeof(float) * 16);
+							jointWeightData.inverseBindPoseMatrix = FlipX(inverseBindPoseMatrix);
+						}
+						jointWeightData.vertexWeights.push_back({ weight, vertexIndex });
+					}
+				}
+			}
+		}
+
+		//マテリアル（テクスチャは読み込まない）
+		modelData.materialData.resize(std::max<size_t>(json.value("materials", nlohmann::json::array()).size(), 1));
+		for (Material::MaterialData& materialData : modelData.materialData)
+		{
+			materialData.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		}
+
+		//ノード階層（ルートが複数ある場合はまとめるノードを作る）
+		const nlohmann::json& rootNodes = json["scenes"][json.value("scene", 0u)]["nodes"];
+		if (rootNodes.size() == 1)
+		{
+			modelData.rootNode = ReadNode(document, rootNodes[0].get<uint32_t>());
+		}
+		else
+		{
+			modelData.rootNode.scale = { 1.0f, 1.0f, 1.0f };
+			modelData.rootNode.rotate = Mathf::IdentityQuaternion();
+			modelData.rootNode.localMatrix = Mathf::MakeIdentity4x4();
+			modelData.rootNode.name = "ROOT";
+			for (const nlohmann::json& rootNode : rootNodes)
+			{
+				modelData.rootNode.children.push_back(ReadNode(document, rootNode.get<uint32_t>()));
+			}
+		}
+		return modelData;
+	}
+
+	std::vector<Animation::AnimationData> LoadAnimations(const std::string& filePath)
+	{
+		const Document document = LoadDocument(filePath);
+		const nlohmann::json& json = document.json;
+		std::vector<Animation::AnimationData> animationDatas{};
+		for (const nlohmann::json& animation : json.value("animations", nlohmann::json::array()))
+		{
+			Animation::AnimationData& animationData = animationDatas.emplace_back();
+			animationData.name = animation.value("name", std::string());
+			animationData.duration = 0.0f;
+
+			//ノードごとにチャンネルをまとめる
+			std::map<uint32_t, std::array<int32_t, 3>> nodeChannels{};
+			std::vector<uint32_t> nodeOrder{};
+			for (uint32_t channelIndex = 0; channelIndex < static_cast<uint32_t>(animation["channels"].size()); ++channelIndex)
+			{
+				const nlohmann::json& target = animation["channels"][channelIndex]["target"];
+				const uint32_t node = target["node"];
+				const std::string path = target["path"];
+				auto it = nodeChannels.find(node);
+				if (it == nodeChannels.end())
+				{
+					it = nodeChannels.emplace(node, std::array<int32_t, 3>{ -1, -1, -1 }).first;
+					nodeOrder.push_back(node);
+				}
+				it->second[path == "translation" ? 0 : path == "rotation" ? 1 : 2] = static_cast<int32_t>(channelIndex);
+			}
+
+			for (uint32_t node : nodeOrder)
+			{
+				//Node名のハッシュが衝突した場合は読み込みに失敗させる（AnimationManagerと同じ）
+				const std::string nodeName = json["nodes"][node]["name"];
+				if (!animationData.channelIndices.emplace(Animation::HashName(nodeName), static_cast<uint32_t>(animationData.nodeAnimations.size())).second)
+				{
+					assert(false && "Node name hash collision");
+					return {};
+				}
+				Animation::NodeAnimation& nodeAnimation = animationData.nodeAnimations.emplace_back();
+
+				//キーフレームを読み込む（チャンネルがない場合は既定値のキーフレームを1つ置く）
+				auto readKeys = [&](int32_t channelIndex, std::vector<float>& times, std::vector<float>& values) {
+					if (channelIndex < 0)
+					{
+						return false;
+					}
+					const nlohmann::json& sampler = animation["samplers"][animation["channels"][channelIndex]["sampler"].get<uint32_t>()];
+					uint32_t componentCount = 0;
+					times = ReadAccessor(document, sampler["input"], componentCount);
+					values = ReadAccessor(document, sampler["output"], componentCount);
+					for (float time : times)
+					{
+						animationData.duration = std::max(animationData.duration, time);
+					}
+					return true;
+				};
+				std::vector<float> times{};
+				std::vector<float> values{};
+				const std::array<int32_t, 3>& channels = nodeChannels[node];
+
+				nodeAnimation.translate.keyframeOffset = static_cast<uint32_t>(animationData.vector3Keyframes.size());
+				if (!readKeys(channels[0], times, values)) { times = { 0.0f }; values = { 0.0f, 0.0f, 0.0f }; }
+				for (size_t i = 0; i < times.size(); ++i)
+				{
+					animationData.vector3Keyframes.push_back({ times[i], { -values[i * 3], values[i * 3 + 1], values[i * 3 + 2] } });
+				}
+				nodeAnimation.translate.keyframeCount = static_cast<uint32_t>(times.size());
+
+				nodeAnimation.rotate.keyframeOffset = static_cast<uint32_t>(animationData.quaternionKeyframes.size());
+				if (!readKeys(channels[1], times, values)) { times = { 0.0f }; values = { 0.0f, 0.0f, 0.0f, 1.0f }; }
+				for (size_t i = 0; i < times.size(); ++i)
+				{
+					animationData.quaternionKeyframes.push_back({ times[i], { values[i * 4], -values[i * 4 + 1], -values[i * 4 + 2], values[i * 4 + 3] } });
+				}
+				nodeAnimation.rotate.keyframeCount = static_cast<uint32_t>(times.size());
+
+				nodeAnimation.scale.keyframeOffset = static_cast<uint32_t>(animationData.vector3Keyframes.size());
+				if (!readKeys(channels[2], times, values)) { times = { 0.0f }; values = { 1.0f, 1.0f, 1.0f }; }
+				for (size_t i = 0; i < times.size(); ++i)
+				{
+					animationData.vector3Keyframes.push_back({ times[i], { values[i * 3], values[i * 3 + 1], values[i * 3 + 2] } });
+				}
+				nodeAnimation.scale.keyframeCount = static_cast<uint32_t>(times.size());
+			}
+		}
+		return animationDatas;
+	}
+
+	std::vector<Animation::AnimationData> LoadAnimationList(const std::string& csvPath, const std::string& modelDirectory)
+	{
+		std::vector<Animation::AnimationData> animationDatas{};
+		std::ifstream file(csvPath);
+		assert(file.is_open());
+		std::string line{};
+		while (std::getline(file, line))
+		{
+			//コメントと空行は飛ばす
+			if (line.empty() || line.starts_with("//"))
+			{
+				continue;
+			}
+			std::stringstream stream(line);
+			std::string name{};
+			std::string path{};
+			std::getline(stream, name, ',');
+			std::getline(stream, path);
+			if (!path.empty() && path.back() == '\r')
+			{
+				path.pop_back();
+			}
+
+			//ファイルの最初のアニメーションをCSVの名前で登録
+			std::vector<Animation::AnimationData> loaded = LoadAnimations(modelDirectory + "/" + path);
+			if (!loaded.empty())
+			{
+				loaded.front().name = name;
+				animationDatas.push_back(std::move(loaded.front()));
+			}
+		}
+		return animationDatas;
+	}
+}
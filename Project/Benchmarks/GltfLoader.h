@@ -0,0 +1,37 @@
+/**
+ * @file GltfLoader.h
+ * @brief ベンチマーク・テスト用にglTFファイルからモデルとアニメーションを読み込むファイル（assimpを使わずに読み込む）
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Engine/3D/Model/Animation.h"
+#include "Engine/3D/Model/Model.h"
+#include <string>
+#include <vector>
+
+namespace GltfLoader
+{
+	/// <summary>
+	/// モデルを読み込む（ModelManagerと同じく右手系から左手系に変換する）
+	/// </summary>
+	/// <param name="filePath">glTFファイルのパス</param>
+	/// <returns>モデルデータ</returns>
+	Model::ModelData LoadModel(const std::string& filePath);
+
+	/// <summary>
+	/// アニメーションを読み込む（AnimationManagerと同じく右手系から左手系に変換する）
+	/// </summary>
+	/// <param name="filePath">glTFファイルのパス</param>
+	/// <returns>アニメーションデータ</returns>
+	std::vector<Animation::AnimationData> LoadAnimations(const std::string& filePath);
+
+	/// <summary>
+	/// アニメーションの一覧のCSVに書かれた全てのアニメーションを読み込む
+	/// </summary>
+	/// <param name="csvPath">CSVファイルのパス</param>
+	/// <param name="modelDirectory">CSVに書かれたパスの基準になるディレクトリ</param>
+	/// <returns>アニメーションデータ（名前はCSVに書かれたものに置き換える）</returns>
+	std::vector<Animation::AnimationData> LoadAnimationList(const std::string& csvPath, const std::string& modelDirectory);
+}
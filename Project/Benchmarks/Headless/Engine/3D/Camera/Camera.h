@@ -0,0 +1,19 @@
+/**
+ * @file Camera.h
+ * @brief ヘッドレスビルド用のカメラ
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Engine/Base/UploadBuffer.h"
+
+class Camera
+{
+public:
+	//コンスタントバッファを取得
+	UploadBuffer* GetConstantBuffer() const { return constBuff_; };
+
+private:
+	UploadBuffer* constBuff_ = nullptr;
+};
@@ -0,0 +1,22 @@
+/**
+ * @file ModelManager.h
+ * @brief ヘッドレスビルド用のモデルマネージャー（モデルファイルは読み込まない）
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Engine/3D/Model/Model.h"
+#include <string>
+
+class ModelManager
+{
+public:
+	/// <summary>
+	/// モデルファイルからモデルを作成（ヘッドレスビルドではモデルを作成しない）
+	/// </summary>
+	/// <param name="modelName">モデルの名前</param>
+	/// <param name="drawPass">描画パス</param>
+	/// <returns>常にnullptr</returns>
+	static Model* CreateFromModelFile(const std::string&, DrawPass) { return nullptr; };
+};
@@ -0,0 +1,24 @@
+/**
+ * @file LineRenderer.h
+ * @brief ヘッドレスビルド用のラインレンダラー（何も描画しない）
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Engine/Math/Vector3.h"
+
+class Camera;
+
+class LineRenderer
+{
+public:
+	//インスタンスを取得
+	static LineRenderer* GetInstance() { static LineRenderer instance; return &instance; };
+
+	//ラインを追加
+	void AddLine(const Vector3&, const Vector3&) {};
+
+	//カメラを設定
+	void SetCamera(const Camera*) {};
+};
@@ -0,0 +1,57 @@
+/**
+ * @file GpuResource.h
+ * @brief ヘッドレスビルド用のGPUリソース（実際のリソースは作らずメモリ上に確保する）
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+typedef unsigned int UINT;
+typedef uint64_t D3D12_GPU_VIRTUAL_ADDRESS;
+
+struct D3D12_GPU_DESCRIPTOR_HANDLE
+{
+	uint64_t ptr;
+};
+
+struct D3D12_VERTEX_BUFFER_VIEW
+{
+	D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+	UINT SizeInBytes;
+	UINT StrideInBytes;
+};
+
+enum DXGI_FORMAT
+{
+	DXGI_FORMAT_R32_UINT
+};
+
+struct D3D12_INDEX_BUFFER_VIEW
+{
+	D3D12_GPU_VIRTUAL_ADDRESS BufferLocation;
+	UINT SizeInBytes;
+	DXGI_FORMAT Format;
+};
+
+class DescriptorHandle
+{
+public:
+	operator D3D12_GPU_DESCRIPTOR_HANDLE() const { return {}; };
+};
+
+class GpuResource
+{
+public:
+	//GPUアドレスの代わりにメモリのアドレスを返す
+	D3D12_GPU_VIRTUAL_ADDRESS GetGpuVirtualAddress() const { return reinterpret_cast<D3D12_GPU_VIRTUAL_ADDRESS>(data_.data()); };
+
+protected:
+	//リソースの代わりのメモリ
+	std::vector<std::byte> data_{};
+};
@@ -0,0 +1,25 @@
+/**
+ * @file RWStructuredBuffer.h
+ * @brief ヘッドレスビルド用のRWStructuredBuffer
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Engine/Base/GpuResource.h"
+
+class RWStructuredBuffer : public GpuResource
+{
+public:
+	//バッファを作成
+	void Create(uint32_t numElements, uint32_t elementSize) { data_.assign(size_t(numElements) * elementSize, std::byte{}); };
+
+	//SRVを取得
+	const DescriptorHandle& GetSRVHandle() const { return handle_; };
+
+	//UAVを取得
+	const DescriptorHandle& GetUAVHandle() const { return handle_; };
+
+private:
+	DescriptorHandle handle_{};
+};
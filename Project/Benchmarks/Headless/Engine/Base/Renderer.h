@@ -0,0 +1,38 @@
+/**
+ * @file Renderer.h
+ * @brief ヘッドレスビルド用のレンダラー（描画するオブジェクトを受け取るだけで何もしない）
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Engine/Base/GpuResource.h"
+
+class RWStructuredBuffer;
+
+enum DrawPass
+{
+	Opaque,
+	Transparent,
+	NumTypes,
+};
+
+class Renderer
+{
+public:
+	//インスタンスを取得
+	static Renderer* GetInstance() { static Renderer instance; return &instance; };
+
+	//オブジェクトを追加
+	void AddObject(D3D12_VERTEX_BUFFER_VIEW, D3D12_INDEX_BUFFER_VIEW, D3D12_GPU_VIRTUAL_ADDRESS, D3D12_GPU_VIRTUAL_ADDRESS, D3D12_GPU_VIRTUAL_ADDRESS,
+		D3D12_GPU_DESCRIPTOR_HANDLE, D3D12_GPU_DESCRIPTOR_HANDLE, UINT, DrawPass) {};
+
+	//スキニングオブジェクトを追加
+	void AddSkinningObject(D3D12_GPU_DESCRIPTOR_HANDLE, D3D12_GPU_DESCRIPTOR_HANDLE, D3D12_GPU_DESCRIPTOR_HANDLE, D3D12_GPU_VIRTUAL_ADDRESS, RWStructuredBuffer*, UINT) {};
+
+	//影の描画用のオブジェクトを追加
+	void AddShadowObject(D3D12_VERTEX_BUFFER_VIEW, D3D12_INDEX_BUFFER_VIEW, D3D12_GPU_VIRTUAL_ADDRESS, UINT) {};
+
+	//ボーンの追加
+	void AddBone(D3D12_VERTEX_BUFFER_VIEW, D3D12_GPU_VIRTUAL_ADDRESS, D3D12_GPU_VIRTUAL_ADDRESS, UINT) {};
+};
@@ -0,0 +1,28 @@
+/**
+ * @file StructuredBuffer.h
+ * @brief ヘッドレスビルド用のStructuredBuffer
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Engine/Base/GpuResource.h"
+
+class StructuredBuffer : public GpuResource
+{
+public:
+	//バッファを作成
+	void Create(uint32_t numElements, uint32_t elementSize) { data_.assign(size_t(numElements) * elementSize, std::byte{}); };
+
+	//リソースに書き込む
+	void* Map() { return data_.data(); };
+
+	//書き込みをやめる
+	void Unmap() {};
+
+	//SRVを取得
+	const DescriptorHandle& GetSRVHandle() const { return srvHandle_; };
+
+private:
+	DescriptorHandle srvHandle_{};
+};
@@ -0,0 +1,19 @@
+/**
+ * @file Texture.h
+ * @brief ヘッドレスビルド用のテクスチャ
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Engine/Base/GpuResource.h"
+
+class Texture : public GpuResource
+{
+public:
+	//SRVを取得
+	const DescriptorHandle& GetSRVHandle() const { return srvHandle_; };
+
+private:
+	DescriptorHandle srvHandle_{};
+};
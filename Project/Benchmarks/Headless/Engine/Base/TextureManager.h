@@ -0,0 +1,26 @@
+/**
+ * @file TextureManager.h
+ * @brief ヘッドレスビルド用のテクスチャマネージャー（読み込まずに空のテクスチャを返す）
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Engine/Base/Texture.h"
+#include <string>
+
+class TextureManager
+{
+public:
+	//インスタンスを取得
+	static TextureManager* GetInstance() { static TextureManager instance; return &instance; };
+
+	//テクスチャを読み込む
+	static void Load(const std::string&) {};
+
+	//テクスチャを探す
+	const Texture* FindTexture(const std::string&) const { return &texture_; };
+
+private:
+	Texture texture_{};
+};
@@ -0,0 +1,34 @@
+/**
+ * @file UploadBuffer.h
+ * @brief ヘッドレスビルド用のアップロードバッファ
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Engine/Base/GpuResource.h"
+
+class UploadBuffer : public GpuResource
+{
+public:
+	//バッファを作成
+	void Create(size_t sizeInBytes) { data_.assign(sizeInBytes, std::byte{}); };
+
+	//リソースに書き込む
+	void* Map() { ++mapCount_; return data_.data(); };
+
+	//書き込みをやめる
+	void Unmap() {};
+
+	//バッファのサイズを取得
+	size_t GetBufferSize() const { return data_.size(); };
+
+	//書き込んだ回数を取得
+	const uint32_t GetMapCount() const { return mapCount_; };
+
+	//書き込まれたデータを取得
+	const void* GetData() const { return data_.data(); };
+
+private:
+	uint32_t mapCount_ = 0;
+};
@@ -0,0 +1,87 @@
+/**
+ * @file Main.cpp
+ * @brief ベンチマークと検証テストを実行するエントリーポイント
+ * @author 青木智滉
+ * @date
+ */
+
+#include "Benchmark.h"
+#include <cstdio>
+#include <cstring>
+
+namespace Benchmark
+{
+	std::vector<Entry>& GetEntries()
+	{
+		static std::vector<Entry> entries;
+		return entries;
+	}
+
+	Registration::Registration(const char* name, Kind kind, Function function)
+	{
+		GetEntries().push_back({ name, kind, std::move(function) });
+	}
+
+	void Report(const std::string& label, double value, const char* unit)
+	{
+		std::printf("  %-48s %12.3f %s\n", label.c_str(), value, unit);
+	}
+
+	bool Expect(bool condition, const std::string& message)
+	{
+		if (!condition)
+		{
+			std::printf("  FAILED: %s\n", message.c_str());
+		}
+		return condition;
+	}
+
+	std::string GetResourceDirectory()
+	{
+		return ENGINE_RESOURCE_DIRECTORY;
+	}
+}
+
+//使い方: EngineBenchmarks [--test | --bench] [名前の一部]
+int main(int argc, char** argv)
+{
+	//実行する種類と名前の絞り込み
+	bool runTests = true;
+	bool runBenchmarks = true;
+	const char* filter = nullptr;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--test") == 0)
+		{
+			runBenchmarks = false;
+		}
+		else if (std::strcmp(argv[i], "--bench") == 0)
+		{
+			runTests = false;
+		}
+		else
+		{
+			filter = argv[i];
+		}
+	}
+
+	//登録順に実行
+	uint32_t failedCount = 0;
+	for (const Benchmark::Entry& entry : Benchmark::GetEntries())
+	{
+		const bool isTest = entry.kind == Benchmark::Kind::kTest;
+		if ((isTest && !runTests) || (!isTest && !runBenchmarks)) continue;
+		if (filter && entry.name.find(filter) == std::string::npos) continue;
+
+		std::printf("[%s] %s\n", isTest ? "test" : "bench", entry.name.c_str());
+		std::fflush(stdout);
+		if (!entry.function() && isTest)
+		{
+			std::printf("  -> FAILED\n");
+			++failedCount;
+		}
+	}
+
+	std::printf("%u failed\n", failedCount);
+	return failedCount == 0 ? 0 : 1;
+}
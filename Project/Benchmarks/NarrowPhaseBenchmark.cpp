@@ -0,0 +1,200 @@
+/**
+ * @file NarrowPhaseBenchmark.cpp
+ * @brief 詳細判定をまとめて行う関数のベンチマーク・テスト
+ * @author 青木智滉
+ * @date
+ */
+
+#include "Benchmark.h"
+#include "CollisionScene.h"
+#include "Engine/Components/Collision/NarrowPhaseBatch.h"
+#include <algorithm>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace
+{
+	//形状ごとのコライダーの配列
+	struct ShapeLists
+	{
+		std::vector<const SphereCollider*> spheres;
+		std::vector<const AABBCollider*> aabbs;
+		std::vector<const OBBCollider*> obbs;
+
+		const std::vector<const SphereCollider*>& Get(const SphereCollider*) const { return spheres; };
+		const std::vector<const AABBCollider*>& Get(const AABBCollider*) const { return aabbs; };
+		const std::vector<const OBBCollider*>& Get(const OBBCollider*) const { return obbs; };
+	};
+
+	//シーンのコライダーを形状ごとに分ける
+	ShapeLists SplitShapes(const CollisionScene& scene)
+	{
+		ShapeLists lists{};
+		for (const Collider* collider : scene.GetColliders())
+		{
+			switch (collider->GetColliderType())
+			{
+			case ColliderType::kSphere: lists.spheres.push_back(static_cast<const SphereCollider*>(collider)); break;
+			case ColliderType::kAABB: lists.aabbs.push_back(static_cast<const AABBCollider*>(collider)); break;
+			default: lists.obbs.push_back(static_cast<const OBBCollider*>(collider)); break;
+			}
+		}
+		return lists;
+	}
+
+	//形状の組み合わせのペアを指定した数だけ作る
+	template <typename Type1, typename Type2>
+	std::vector<std::pair<const Type1*, const Type2*>> MakePairs(const ShapeLists& lists, size_t maxCount)
+	{
+		const std::vector<const Type1*>& shapes1 = lists.Get(static_cast<const Type1*>(nullptr));
+		const std::vector<const Type2*>& shapes2 = lists.Get(static_cast<const Type2*>(nullptr));
+		std::vector<std::pair<const Type1*, const Type2*>> pairs{};
+		for (size_t i = 0; pairs.size() < maxCount; ++i)
+		{
+			pairs.emplace_back(shapes1[i % shapes1.size()], shapes2[(i / shapes1.size() + i * 7) % shapes2.size()]);
+		}
+		return pairs;
+	}
+
+	//全てのレーンの判定結果が型ごとの関数と一致するか調べる（端数のレーンには前回の値を残したまま判定する）
+	template <typename Type1, typename Type2, typename Lanes1, typename Lanes2>
+	bool CheckLanes(const ShapeLists& lists, uint32_t (*test)(const Lanes1&, const Lanes2&), bool (*check)(const Type1*, const Type2*), const char* name)
+	{
+		uint32_t mismatchCount = 0;
+		uint32_t hitCount = 0;
+		for (size_t pairCount = 1; pairCount <= 64; ++pairCount)
+		{
+			const std::vector<std::pair<const Type1*, const Type2*>> pairs = MakePairs<Type1, Type2>(lists, pairCount * 31);
+			Lanes1 lanes1{};
+			Lanes2 lanes2{};
+			for (size_t begin = 0; begin < pairs.size(); begin += NarrowPhaseBatch::kLaneCount)
+			{
+				const uint32_t laneCount = static_cast<uint32_t>(std::min<size_t>(NarrowPhaseBatch::kLaneCount, pairs.size() - begin));
+				for (uint32_t lane = 0; lane < laneCount; ++lane)
+				{
+					NarrowPhaseBatch::Load(lanes1, lane, pairs[begin + lane].first);
+					NarrowPhaseBatch::Load(lanes2, lane, pairs[begin + lane].second);
+				}
+				const uint32_t mask = test(lanes1, lanes2);
+				for (uint32_t lane = 0; lane < laneCount; ++lane)
+				{
+					const bool expected = check(pairs[begin + lane].first, pairs[begin + lane].second);
+					hitCount += expected ? 1 : 0;
+					mismatchCount += (((mask >> lane) & 1u) != 0) != expected ? 1 : 0;
+				}
+			}
+		}
+		bool result = Benchmark::Expect(hitCount > 0, std::string(name) + ": 衝突しているペアがない");
+		result &= Benchmark::Expect(mismatchCount == 0, std::string(name) + ": " + std::to_string(mismatchCount) + " lanes differ from the scalar function");
+		return result;
+	}
+
+	//各レーンの判定結果が型ごとの関数と一致するか
+	Benchmark::Registration laneTest("NarrowPhase/BatchLanes", Benchmark::Kind::kTest, []() {
+		CollisionScene scene(600, 4.0f, 11);
+		const ShapeLists lists = SplitShapes(scene);
+		bool result = CheckLanes(lists, &NarrowPhaseBatch::TestSphereSphere, &CollisionManager::CheckSphereSphereCollision, "sphere-sphere");
+		result &= CheckLanes(lists, &NarrowPhaseBatch::TestSphereOBB, &CollisionManager::CheckSphereOBBCollision, "sphere-obb");
+		result &= CheckLanes(lists, &NarrowPhaseBatch::TestOBBOBB, &CollisionManager::CheckOBBOBBCollision, "obb-obb");
+		return result;
+		});
+
+	//CheckAllCollisionsで衝突したペアが全ての形状の組み合わせで型ごとの関数で判定した結果と一致するか
+	Benchmark::Registration managerTest("NarrowPhase/BatchMatchesScalar", Benchmark::Kind::kTest, []() {
+		bool result = true;
+		uint32_t totalHitCount = 0;
+
+		//ペアの数が4の倍数にならない場合も含むようにコライダーの数を変える
+		for (uint32_t count = 2; count <= 60; ++count)
+		{
+			const float extent = 1.5f + count * 0.05f;
+			CollisionScene scene(count, extent, 100 + count);
+			CollisionManager collisionManager;
+			const std::vector<Collider*>& colliders = scene.GetColliders();
+			for (uint32_t step = 0; step < 6; ++step)
+			{
+				//今回のフレームで衝突したペアをイベントから集める
+				const uint32_t frame = scene.GetFrame();
+				const size_t eventBegin = scene.GetEvents().size();
+				scene.Step(collisionManager, extent);
+				std::set<std::pair<uint32_t, uint32_t>> actual{};
+				for (size_t i = eventBegin; i < scene.GetEvents().size(); ++i)
+				{
+					const ContactRecorderObject::Event& event = scene.GetEvents()[i];
+					if (event.type != 'X')
+					{
+						actual.emplace(std::min(event.self, event.other), std::max(event.self, event.other));
+					}
+				}
+
+				//全てのペアを型ごとの関数で判定
+				std::set<std::pair<uint32_t, uint32_t>> expected{};
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					if (!CollisionScene::IsRegistered(i, frame) || !colliders[i]->GetCollisionEnabled()) continue;
+					for (uint32_t j = i + 1; j < count; ++j)
+					{
+						if (!CollisionScene::IsRegistered(j, frame) || !colliders[j]->GetCollisionEnabled()) continue;
+						if (colliders[i]->CanCollideWith(colliders[j]) && CollisionManager::IsColliding(colliders[i], colliders[j]))
+						{
+							expected.emplace(i, j);
+						}
+					}
+				}
+				totalHitCount += static_cast<uint32_t>(expected.size());
+				result &= Benchmark::Expect(actual == expected, std::to_string(count) + " colliders, frame " + std::to_string(frame) + ": contacts differ from the scalar functions");
+			}
+		}
+		result &= Benchmark::Expect(totalHitCount > 0, "衝突しているペアがない");
+		return result;
+		});
+
+	//型ごとの関数で1ペアずつ判定した場合とまとめて判定した場合の時間
+	template <typename Type1, typename Type2, typename Lanes1, typename Lanes2>
+	void MeasureBatch(const ShapeLists& lists, uint32_t (*test)(const Lanes1&, const Lanes2&), bool (*check)(const Type1*, const Type2*), const char* name)
+	{
+		const std::vector<std::pair<const Type1*, const Type2*>> pairs = MakePairs<Type1, Type2>(lists, 4096);
+
+		uint32_t scalarHitCount = 0;
+		const double scalar = Benchmark::MeasureMicroseconds(20, [&]() {
+			for (const auto& pair : pairs)
+			{
+				scalarHitCount += check(pair.first, pair.second) ? 1 : 0;
+			}
+			});
+
+		uint32_t batchHitCount = 0;
+		const double batch = Benchmark::MeasureMicroseconds(20, [&]() {
+			Lanes1 lanes1{};
+			Lanes2 lanes2{};
+			for (size_t begin = 0; begin < pairs.size(); begin += NarrowPhaseBatch::kLaneCount)
+			{
+				for (uint32_t lane = 0; lane < NarrowPhaseBatch::kLaneCount; ++lane)
+				{
+					NarrowPhaseBatch::Load(lanes1, lane, pairs[begin + lane].first);
+					NarrowPhaseBatch::Load(lanes2, lane, pairs[begin + lane].second);
+				}
+				const uint32_t mask = test(lanes1, lanes2);
+				for (uint32_t lane = 0; lane < NarrowPhaseBatch::kLaneCount; ++lane)
+				{
+					batchHitCount += (mask >> lane) & 1u;
+				}
+			}
+			});
+
+		Benchmark::Report(std::string(name) + ", scalar", scalar, "us/4096 pairs");
+		Benchmark::Report(std::string(name) + ", batch", batch, "us/4096 pairs");
+		Benchmark::Expect(scalarHitCount == batchHitCount, std::string(name) + ": hit counts differ");
+	}
+
+	//形状の組み合わせごとの詳細判定の時間
+	Benchmark::Registration batchBenchmark("NarrowPhase/Batch", Benchmark::Kind::kBenchmark, []() {
+		CollisionScene scene(3000, 12.0f, 5);
+		const ShapeLists lists = SplitShapes(scene);
+		MeasureBatch(lists, &NarrowPhaseBatch::TestSphereSphere, &CollisionManager::CheckSphereSphereCollision, "sphere-sphere");
+		MeasureBatch(lists, &NarrowPhaseBatch::TestSphereOBB, &CollisionManager::CheckSphereOBBCollision, "sphere-obb");
+		MeasureBatch(lists, &NarrowPhaseBatch::TestOBBOBB, &CollisionManager::CheckOBBOBBCollision, "obb-obb");
+		return true;
+		});
+}
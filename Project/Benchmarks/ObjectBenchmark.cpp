@@ -0,0 +1,340 @@
+/**
+ * @file ObjectBenchmark.cpp
+ * @brief ゲームオブジェクトのハンドル・プール・名前の索引のテスト
+ * @author 青木智滉
+ * @date
+ */
+
+#include "Benchmark.h"
+#include "Engine/Framework/Object/GameObjectManager.h"
+#include "Engine/Framework/Object/GameObjectPool.h"
+#include <algorithm>
+#include <random>
+#include <map>
+#include <set>
+#include <string>
+
+namespace
+{
+	//大きさの違うゲームオブジェクト（プールのブロックの大きさが変わる）
+	class LargeObject : public GameObject
+	{
+	private:
+		[[maybe_unused]] std::byte padding_[256]{};
+	};
+
+	//名前が"Large"で始まる場合は大きいゲームオブジェクトを生成するファクトリー
+	class ObjectFactory : public AbstractGameObjectFactory
+	{
+	public:
+		GameObject* CreateGameObject(const std::string& objectName) override
+		{
+			return objectName.starts_with("Large") ? new LargeObject() : new GameObject();
+		}
+	};
+
+	//ゲームオブジェクトマネージャーにファクトリーを設定し、終わったら破棄するシーン
+	class ObjectScene
+	{
+	public:
+		ObjectScene()
+		{
+			gameObjectManager_ = GameObjectManager::GetInstance();
+			gameObjectManager_->SetGameObjectFactory(&factory_);
+		}
+
+		~ObjectScene()
+		{
+			GameObjectManager::Destroy();
+		}
+
+		//ゲームオブジェクトマネージャーを取得
+		GameObjectManager* GetGameObjectManager() const { return gameObjectManager_; };
+
+	private:
+		ObjectFactory factory_;
+		GameObjectManager* gameObjectManager_ = nullptr;
+	};
+
+	//ハンドルが生存中は取得でき、破棄後や再利用されたスロットでは取得できないか
+	Benchmark::Registration handleTest("Object/HandleLifetime", Benchmark::Kind::kTest, []() {
+		ObjectScene scene;
+		GameObjectManager* gameObjectManager = scene.GetGameObjectManager();
+
+		//生存中は生成したゲームオブジェクトを取得でき、種類が違う場合は取得できない
+		GameObject* first = GameObjectManager::CreateGameObject("Object");
+		GameObject* second = GameObjectManager::CreateGameObject("Object");
+		const GameObjectHandle firstHandle = first->GetHandle();
+		const GameObjectHandle secondHandle = second->GetHandle();
+		gameObjectManager->Update();
+		bool result = Benchmark::Expect(gameObjectManager->GetGameObject<GameObject>(firstHandle) == first, "live handle does not resolve");
+		result &= Benchmark::Expect(gameObjectManager->GetGameObject<LargeObject>(firstHandle) == nullptr, "handle resolved to the wrong type");
+
+		//破棄されたゲームオブジェクトのハンドルは取得できない
+		first->SetIsDestroy(true);
+		gameObjectManager->Update();
+		result &= Benchmark::Expect(gameObjectManager->GetGameObject<GameObject>(firstHandle) == nullptr, "destroyed handle still resolves");
+		result &= Benchmark::Expect(gameObjectManager->GetGameObject<GameObject>(secondHandle) == second, "other handle stopped resolving");
+
+		//同じスロットを再利用したゲームオブジェクトは新しい世代のハンドルでだけ取得できる
+		GameObject* third = GameObjectManager::CreateGameObject("Object");
+		const GameObjectHandle thirdHandle = third->GetHandle();
+		result &= Benchmark::Expect(thirdHandle.index == firstHandle.index && thirdHandle.generation != firstHandle.generation, "slot was not recycled with a new generation");
+		result &= Benchmark::Expect(gameObjectManager->GetGameObject<GameObject>(firstHandle) == nullptr, "stale handle resolves to the recycled slot");
+		result &= Benchmark::Expect(gameObjectManager->GetGameObject<GameObject>(thirdHandle) == third, "recycled slot does not resolve");
+
+		//生成と破棄を繰り返しても、生存中のものだけが生成したゲームオブジェクトに解決される
+		struct Issued
+		{
+			GameObjectHandle handle;
+			GameObject* gameObject;
+			uint32_t createdFrame;
+			bool isAlive;
+		};
+		std::vector<Issued> issued{};
+		std::mt19937 random(7);
+		uint32_t wrongCount = 0;
+		uint32_t recycledCount = 0;
+		std::set<uint32_t> usedIndices{};
+		for (uint32_t frame = 0; frame < 60; ++frame)
+		{
+			const uint32_t createCount = random() % 20;
+			for (uint32_t i = 0; i < createCount; ++i)
+			{
+				GameObject* gameObject = GameObjectManager::CreateGameObject(random() % 2 ? "Object" : "LargeObject");
+				recycledCount += usedIndices.insert(gameObject->GetHandle().index).second ? 0 : 1;
+				issued.push_back({ gameObject->GetHandle(), gameObject, frame, true });
+			}
+
+			//前のフレームまでに生成されたものを破棄する（保留中のものは次の更新でゲームオブジェクトのリストに入ってから削除される）
+			for (Issued& entry : issued)
+			{
+				if (entry.isAlive && entry.createdFrame < frame && random() % 4 == 0)
+				{
+					entry.gameObject->SetIsDestroy(true);
+					entry.isAlive = false;
+				}
+			}
+			gameObjectManager->Update();
+			for (const Issued& entry : issued)
+			{
+				wrongCount += gameObjectManager->GetGameObject<GameObject>(entry.handle) == (entry.isAlive ? entry.gameObject : nullptr) ? 0 : 1;
+			}
+		}
+		result &= Benchmark::Expect(recycledCount > 100, "スロットがほとんど再利用されていない");
+		result &= Benchmark::Expect(wrongCount == 0, std::to_string(wrongCount) + " handles resolved incorrectly");
+
+		//全て削除した場合はどのハンドルも取得できない
+		gameObjectManager->Clear();
+		result &= Benchmark::Expect(std::none_of(issued.begin(), issued.end(), [&](const Issued& entry) { return gameObjectManager->GetGameObject<GameObject>(entry.handle); }), "handle resolves after Clear");
+		return result;
+		});
+
+	//破棄されたゲームオブジェクトのブロックが、次に生成される同じ大きさのゲームオブジェクトで再利用されるか
+	Benchmark::Registration poolTest("Object/PoolReusesBlocks", Benchmark::Kind::kTest, []() {
+		bool result = true;
+		{
+			ObjectScene scene;
+			GameObjectManager* gameObjectManager = scene.GetGameObjectManager();
+			GameObject* destroyed = GameObjectManager::CreateGameObject("Object");
+			gameObjectManager->Update();
+			destroyed->SetIsDestroy(true);
+			gameObjectManager->Update();
+
+			//大きさが違うものには使われず、同じ大きさのものに使われる
+			GameObject* large = GameObjectManager::CreateGameObject("LargeObject");
+			GameObject* reused = GameObjectManager::CreateGameObject("Object");
+			result &= Benchmark::Expect(static_cast<void*>(large) != static_cast<void*>(destroyed), "block was reused by a different size");
+			result &= Benchmark::Expect(static_cast<void*>(reused) == static_cast<void*>(destroyed), "block was not reused by the same size");
+		}
+
+		//チャンクをまたいで確保しても重ならずに揃っていて、返却した後は同じブロックだけが使われる
+		static const size_t kSize = 200;
+		static const size_t kCount = GameObjectPool::kBlocksPerChunk * 2 + 1;
+		GameObjectPool* gameObjectPool = GameObjectPool::GetInstance();
+		std::vector<void*> blocks{};
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			blocks.push_back(gameObjectPool->Allocate(kSize));
+		}
+		std::vector<void*> sorted = blocks;
+		std::sort(sorted.begin(), sorted.end(), std::less<void*>());
+		bool isSeparated = true;
+		for (size_t i = 0; i + 1 < sorted.size(); ++i)
+		{
+			isSeparated &= static_cast<std::byte*>(sorted[i]) + kSize <= static_cast<std::byte*>(sorted[i + 1]);
+		}
+		result &= Benchmark::Expect(isSeparated, "blocks overlap");
+		result &= Benchmark::Expect(std::all_of(blocks.begin(), blocks.end(), [](void* block) { return reinterpret_cast<uintptr_t>(block) % __STDCPP_DEFAULT_NEW_ALIGNMENT__ == 0; }), "block is not aligned");
+
+		for (void* block : blocks)
+		{
+			gameObjectPool->Free(block, kSize);
+		}
+		std::vector<void*> reusedBlocks{};
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			reusedBlocks.push_back(gameObjectPool->Allocate(kSize));
+		}
+		std::sort(reusedBlocks.begin(), reusedBlocks.end(), std::less<void*>());
+		result &= Benchmark::Expect(reusedBlocks == sorted, "freed blocks were not reused");
+		for (void* block : reusedBlocks)
+		{
+			gameObjectPool->Free(block, kSize);
+		}
+		return result;
+		});
+
+	//名前の索引を使わずに、登録した順に並べたゲームオブジェクトを先頭から調べる（比較用）
+	class LinearNameScan
+	{
+	public:
+		//生成・名前の変更で末尾に追加
+		void Add(GameObject* gameObject)
+		{
+			std::erase(gameObjects_, gameObject);
+			gameObjects_.push_back(gameObject);
+		}
+
+		//削除
+		void Remove(GameObject* gameObject) { std::erase(gameObjects_, gameObject); };
+
+		//全て削除
+		void Clear() { gameObjects_.clear(); };
+
+		//名前が一致する、または文字列を含むものを集める
+		template <typename Type>
+		std::vector<Type*> Collect(const std::string& searchString, const bool isPartial) const
+		{
+			std::vector<Type*> result{};
+			for (GameObject* gameObject : gameObjects_)
+			{
+				const bool isMatch = isPartial ? gameObject->GetName().find(searchString) != std::string::npos : gameObject->GetName() == searchString;
+				if (Type* castedObject = dynamic_cast<Type*>(gameObject); castedObject && isMatch)
+				{
+					result.push_back(castedObject);
+				}
+			}
+			return result;
+		}
+
+		//登録されているゲームオブジェクトを取得
+		const std::vector<GameObject*>& GetGameObjects() const { return gameObjects_; };
+
+	private:
+		std::vector<GameObject*> gameObjects_{};
+	};
+
+	//部分一致の結果が名前ごとにまとまっていて、名前ごとの順番と集合が線形探索と一致するか
+	template <typename Type>
+	bool MatchesGrouped(const std::vector<Type*>& actual, const std::vector<Type*>& expected)
+	{
+		std::vector<std::string> names{};
+		std::map<std::string, std::vector<Type*>> actualGroups{};
+		std::map<std::string, std::vector<Type*>> expectedGroups{};
+		for (Type* gameObject : actual)
+		{
+			if (names.empty() || names.back() != gameObject->GetName())
+			{
+				names.push_back(gameObject->GetName());
+			}
+			actualGroups[gameObject->GetName()].push_back(gameObject);
+		}
+		for (Type* gameObject : expected)
+		{
+			expectedGroups[gameObject->GetName()].push_back(gameObject);
+		}
+		return names.size() == actualGroups.size() && actualGroups == expectedGroups;
+	}
+
+	//名前の索引を使った取得が、生成・名前の変更・破棄・全削除を繰り返しても線形探索と一致するか
+	Benchmark::Registration nameIndexTest("Object/NameIndexMatchesScan", Benchmark::Kind::kTest, []() {
+		const char* const names[] = { "Enemy", "EnemyBoss", "BossEnemy", "Player", "PlayerWeapon", "LargeRock", "LargeEnemy", "Magic" };
+		const char* const searchStrings[] = { "Enemy", "Boss", "E", "y", "Weapon", "Play", "Large", "Rock", "Missing", "" };
+		ObjectScene scene;
+		GameObjectManager* gameObjectManager = scene.GetGameObjectManager();
+		LinearNameScan linearScan;
+		std::mt19937 random(31);
+		uint32_t wrongCount = 0;
+		uint32_t matchCount = 0;
+
+		//全ての名前と文字列で取得して線形探索と比べる
+		auto compare = [&]() {
+			for (const char* name : names)
+			{
+				const std::vector<GameObject*> expected = linearScan.Collect<GameObject>(name, false);
+				const std::vector<LargeObject*> expectedLarge = linearScan.Collect<LargeObject>(name, false);
+				wrongCount += gameObjectManager->GetGameObjects<GameObject>(name) == expected ? 0 : 1;
+				wrongCount += gameObjectManager->GetGameObjects<LargeObject>(name) == expectedLarge ? 0 : 1;
+				wrongCount += gameObjectManager->GetGameObject<GameObject>(name) == (expected.empty() ? nullptr : expected.front()) ? 0 : 1;
+				wrongCount += gameObjectManager->GetGameObject<LargeObject>(name) == (expectedLarge.empty() ? nullptr : expectedLarge.front()) ? 0 : 1;
+			}
+			for (const char* searchString : searchStrings)
+			{
+				const std::vector<GameObject*> expected = linearScan.Collect<GameObject>(searchString, true);
+				const std::vector<GameObject*> actual = gameObjectManager->GetGameObjectsByStringProperty<GameObject>(searchString);
+				const std::vector<LargeObject*> actualLarge = gameObjectManager->GetGameObjectsByStringProperty<LargeObject>(searchString);
+				wrongCount += MatchesGrouped(actual, expected) ? 0 : 1;
+				wrongCount += MatchesGrouped(actualLarge, linearScan.Collect<LargeObject>(searchString, true)) ? 0 : 1;
+				wrongCount += gameObjectManager->GetGameObjectByStringProperty<GameObject>(searchString) == (actual.empty() ? nullptr : actual.front()) ? 0 : 1;
+				wrongCount += gameObjectManager->GetGameObjectByStringProperty<LargeObject>(searchString) == (actualLarge.empty() ? nullptr : actualLarge.front()) ? 0 : 1;
+				matchCount += static_cast<uint32_t>(expected.size());
+			}
+			};
+
+		std::vector<GameObject*> destroyed{};
+		for (uint32_t frame = 0; frame < 60; ++frame)
+		{
+			//生成（保留中のものも取得できる）
+			const uint32_t createCount = random() % 12;
+			for (uint32_t i = 0; i < createCount; ++i)
+			{
+				linearScan.Add(GameObjectManager::CreateGameObject(names[random() % std::size(names)]));
+			}
+			compare();
+
+			//名前の変更（同じ名前を設定した場合も末尾に移る）
+			const std::vector<GameObject*> gameObjects = linearScan.GetGameObjects();
+			for (GameObject* gameObject : gameObjects)
+			{
+				if (!gameObject->GetIsDestroy() && random() % 6 == 0)
+				{
+					gameObject->SetName(names[random() % std::size(names)]);
+					linearScan.Add(gameObject);
+				}
+			}
+			compare();
+
+			//破棄（まとめて索引から削除される）
+			for (GameObject* gameObject : linearScan.GetGameObjects())
+			{
+				if (!gameObject->GetIsDestroy() && random() % 5 == 0)
+				{
+					gameObject->SetIsDestroy(true);
+					destroyed.push_back(gameObject);
+				}
+			}
+			gameObjectManager->Update();
+
+			//保留中だったものは次の更新で削除される
+			std::erase_if(destroyed, [&](GameObject* gameObject) {
+				if (gameObjectManager->GetGameObject<GameObject>(gameObject->GetHandle()) == gameObject) return false;
+				linearScan.Remove(gameObject);
+				return true;
+				});
+			compare();
+
+			//全削除
+			if (frame % 20 == 19)
+			{
+				gameObjectManager->Clear();
+				linearScan.Clear();
+				destroyed.clear();
+				compare();
+			}
+		}
+		bool result = Benchmark::Expect(matchCount > 1000, "一致したゲームオブジェクトが少ない");
+		result &= Benchmark::Expect(wrongCount == 0, std::to_string(wrongCount) + " name queries differ from the linear scan");
+		return result;
+		});
+}
@@ -0,0 +1,46 @@
+/**
+ * @file PlayerScene.h
+ * @brief アニメーション・スキニングのベンチマーク・テスト用にプレイヤーのモデルとアニメーションを読み込むファイル
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Benchmark.h"
+#include "GltfLoader.h"
+
+namespace PlayerScene
+{
+	/// <summary>
+	/// プレイヤーのモデルの共有データを取得（初回のみ読み込む）
+	/// </summary>
+	/// <returns>モデルの共有データ</returns>
+	inline const std::shared_ptr<const Model::SharedData>& GetSharedData()
+	{
+		static const std::shared_ptr<const Model::SharedData> sharedData =
+			Model::CreateSharedData(GltfLoader::LoadModel(Benchmark::GetResourceDirectory() + "/Models/Player/Player.gltf"));
+		return sharedData;
+	}
+
+	/// <summary>
+	/// プレイヤーのアニメーションを取得（初回のみPlayerAnimations.csvに書かれた全てのファイルを読み込む）
+	/// </summary>
+	/// <returns>アニメーションデータ</returns>
+	inline const std::vector<Animation::AnimationData>& GetAnimationDatas()
+	{
+		static const std::vector<Animation::AnimationData> animationDatas = GltfLoader::LoadAnimationList(
+			Benchmark::GetResourceDirectory() + "/Config/Animations/PlayerAnimations.csv", Benchmark::GetResourceDirectory() + "/Models");
+		return animationDatas;
+	}
+
+	/// <summary>
+	/// プレイヤーのモデルを作成
+	/// </summary>
+	/// <returns>モデル</returns>
+	inline std::unique_ptr<Model> CreateModel()
+	{
+		std::unique_ptr<Model> model = std::make_unique<Model>();
+		model->Initialize(GetSharedData(), DrawPass::Opaque);
+		return model;
+	}
+}
@@ -0,0 +1,361 @@
+/**
+ * @file QueryBenchmark.cpp
+ * @brief CollisionManagerのレイキャスト・スフィアキャスト・重なり判定の問い合わせを総当たりと比べるテスト
+ * @author 青木智滉
+ * @date
+ */
+
+#include "Benchmark.h"
+#include "CollisionScene.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <string>
+
+namespace
+{
+	//問い合わせで使う衝突マスク（0は何にも当たらない）
+	const uint32_t kQueryMasks[] = { 0xffffffffu, 1u << 0, (1u << 1) | (1u << 3), 1u << 2, 0u };
+
+	//一部を静的・無効にしたコライダーを衝突マネージャーに登録するシーン
+	class QueryScene
+	{
+	public:
+		QueryScene(uint32_t seed) : scene_(300, 12.0f, seed)
+		{
+			for (uint32_t i = 0; i < static_cast<uint32_t>(scene_.GetColliders().size()); ++i)
+			{
+				Collider* collider = scene_.GetColliders()[i];
+				collider->SetIsStatic(i % 6 == 0);
+				collider->SetCollisionEnabled(i % 7 != 3);
+			}
+			Register();
+			collisionManager_.CheckAllCollisions();
+		}
+
+		//動的なコライダーだけを動かして登録し直す（問い合わせ用のBVHは次の問い合わせで構築し直される）
+		void MoveDynamicColliders(std::mt19937& random)
+		{
+			std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+			for (Collider* collider : scene_.GetColliders())
+			{
+				if (collider->GetIsStatic()) continue;
+				CollisionScene::SetWorldCenter(collider, CollisionScene::GetWorldCenter(collider) + Vector3{ unit(random) * 3.0f, unit(random), unit(random) * 3.0f });
+			}
+			Register();
+		}
+
+		//問い合わせの対象になるコライダーを総当たりで集める
+		std::vector<const Collider*> GetQueriedColliders(uint32_t mask) const
+		{
+			std::vector<const Collider*> colliders{};
+			for (const Collider* collider : scene_.GetColliders())
+			{
+				if (collider->GetCollisionEnabled() && (collider->GetCollisionAttribute() & mask) != 0)
+				{
+					colliders.push_back(collider);
+				}
+			}
+			return colliders;
+		}
+
+		//問い合わせの始点に使うコライダーの中心を取得
+		Vector3 GetColliderCenter(uint32_t index) const { return CollisionScene::GetWorldCenter(scene_.GetColliders()[index % scene_.GetColliders().size()]); };
+
+		//衝突マネージャーを取得
+		CollisionManager& GetCollisionManager() { return collisionManager_; };
+
+	private:
+		void Register()
+		{
+			collisionManager_.ClearColliderList();
+			for (Collider* collider : scene_.GetColliders())
+			{
+				collisionManager_.SetColliderList(collider);
+			}
+		}
+
+	private:
+		CollisionScene scene_;
+		CollisionManager collisionManager_;
+	};
+
+	//乱数で問い合わせの始点と向きを作る（一部はコライダーの中心から始めたり軸に平行にしたりする）
+	struct QueryRay
+	{
+		Vector3 origin;
+		Vector3 direction;
+		float maxDistance;
+		uint32_t mask;
+	};
+	QueryRay MakeQueryRay(QueryScene& scene, std::mt19937& random, uint32_t index)
+	{
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		QueryRay ray{};
+		ray.origin = index % 5 == 0 ? scene.GetColliderCenter(random()) : Vector3{ unit(random) * 12.0f, unit(random) * 3.0f, unit(random) * 12.0f };
+		ray.direction = index % 10 == 1 ? Vector3{ 0.0f,0.0f,unit(random) < 0.0f ? -3.0f : 3.0f } : Vector3{ unit(random), unit(random) * 0.3f, unit(random) };
+		ray.maxDistance = 4.0f + (unit(random) + 1.0f) * 10.0f;
+		ray.mask = kQueryMasks[index % std::size(kQueryMasks)];
+		return ray;
+	}
+
+	//レイとコライダーが最初に交わる距離（始点が内側にある場合は0）
+	bool RayDistance(const Collider* collider, const Vector3& origin, const Vector3& direction, float maxDistance, float& distance)
+	{
+		if (collider->GetColliderType() == ColliderType::kSphere)
+		{
+			const SphereCollider* sphere = static_cast<const SphereCollider*>(collider);
+			const Vector3 offset = origin - sphere->GetWorldCenter();
+			const float b = Mathf::Dot(offset, direction);
+			const float c = Mathf::Dot(offset, offset) - sphere->GetRadius() * sphere->GetRadius();
+			if (c <= 0.0f)
+			{
+				distance = 0.0f;
+				return true;
+			}
+			if (b > 0.0f || b * b - c < 0.0f) return false;
+			distance = -b - std::sqrt(b * b - c);
+			return distance <= maxDistance;
+		}
+
+		//箱の中心・軸・半分の大きさで表してスラブ法で判定
+		Vector3 center{};
+		Vector3 axes[3] = { { 1.0f,0.0f,0.0f }, { 0.0f,1.0f,0.0f }, { 0.0f,0.0f,1.0f } };
+		Vector3 halfSize{};
+		if (collider->GetColliderType() == ColliderType::kAABB)
+		{
+			const AABBCollider* aabb = static_cast<const AABBCollider*>(collider);
+			center = aabb->GetWorldCenter() + (aabb->GetMin() + aabb->GetMax()) * 0.5f;
+			halfSize = (aabb->GetMax() - aabb->GetMin()) * 0.5f;
+		}
+		else
+		{
+			const OBBCollider* obb = static_cast<const OBBCollider*>(collider);
+			center = obb->GetWorldCenter();
+			for (uint32_t axis = 0; axis < 3; ++axis)
+			{
+				axes[axis] = obb->GetOrientation(axis);
+			}
+			halfSize = obb->GetSize();
+		}
+		const float halfSizes[3] = { halfSize.x, halfSize.y, halfSize.z };
+		float enter = 0.0f;
+		float exit = maxDistance;
+		for (uint32_t axis = 0; axis < 3; ++axis)
+		{
+			const float localOrigin = Mathf::Dot(origin - center, axes[axis]);
+			const float localDirection = Mathf::Dot(direction, axes[axis]);
+			if (std::abs(localDirection) < 1.0e-8f)
+			{
+				if (std::abs(localOrigin) > halfSizes[axis]) return false;
+				continue;
+			}
+			const float t1 = (-halfSizes[axis] - localOrigin) / localDirection;
+			const float t2 = (halfSizes[axis] - localOrigin) / localDirection;
+			enter = std::max(enter, std::min(t1, t2));
+			exit = std::min(exit, std::max(t1, t2));
+			if (enter > exit) return false;
+		}
+		distance = enter;
+		return true;
+	}
+
+	//球を少しずつ動かして最初にいずれかのコライダーと重なる距離を求める（重なり始めは二分探索で絞る）
+	bool FirstOverlapDistance(const std::vector<const Collider*>& colliders, const QueryRay& ray, float radius, float& distance)
+	{
+		const Vector3 direction = Mathf::Normalize(ray.direction);
+		const Vector3 end = ray.origin + direction * ray.maxDistance;
+		const Vector3 extent = { radius, radius, radius };
+		const Collider::Bounds segmentBounds = { Vector3{ std::min(ray.origin.x, end.x), std::min(ray.origin.y, end.y), std::min(ray.origin.z, end.z) } - extent, Vector3{ std::max(ray.origin.x, end.x), std::max(ray.origin.y, end.y), std::max(ray.origin.z, end.z) } + extent };
+
+		//移動範囲に境界ボックスが重なるものだけを調べる
+		std::vector<const Collider*> candidates{};
+		for (const Collider* collider : colliders)
+		{
+			if (collider->GetWorldBounds().Overlaps(segmentBounds))
+			{
+				candidates.push_back(collider);
+			}
+		}
+		SphereCollider probe;
+		probe.SetRadius(radius);
+		auto overlaps = [&](float t) {
+			probe.SetWorldCenter(ray.origin + direction * t);
+			return std::any_of(candidates.begin(), candidates.end(), [&](const Collider* collider) { return CollisionManager::IsColliding(&probe, collider); });
+			};
+
+		static const float kStep = 0.05f;
+		float previous = 0.0f;
+		for (float t = 0.0f; previous < ray.maxDistance; t = std::min(t + kStep, ray.maxDistance))
+		{
+			if (overlaps(t))
+			{
+				float low = previous;
+				float high = t;
+				for (uint32_t i = 0; i < 24 && t > 0.0f; ++i)
+				{
+					const float middle = (low + high) * 0.5f;
+					(overlaps(middle) ? high : low) = middle;
+				}
+				distance = high;
+				return true;
+			}
+			if (t >= ray.maxDistance) break;
+			previous = t;
+		}
+		return false;
+	}
+
+	//レイキャストが総当たりで求めた最も近い当たりと一致するか
+	Benchmark::Registration raycastTest("Collision/QueryRaycast", Benchmark::Kind::kTest, []() {
+		QueryScene scene(11);
+		std::mt19937 random(5);
+		uint32_t mismatchCount = 0;
+		uint32_t hitCount = 0;
+		uint32_t insideCount = 0;
+		for (uint32_t round = 0; round < 2; ++round)
+		{
+			for (uint32_t i = 0; i < 400; ++i)
+			{
+				const QueryRay ray = MakeQueryRay(scene, random, i);
+				const Vector3 direction = Mathf::Normalize(ray.direction);
+
+				//総当たりで最も近い当たりを探す
+				bool expectedHit = false;
+				float expectedDistance = ray.maxDistance;
+				for (const Collider* collider : scene.GetQueriedColliders(ray.mask))
+				{
+					float distance = 0.0f;
+					if (RayDistance(collider, ray.origin, direction, expectedDistance, distance))
+					{
+						expectedHit = true;
+						expectedDistance = distance;
+					}
+				}
+
+				CollisionManager::RaycastHit hit{};
+				const bool isHit = scene.GetCollisionManager().Raycast(ray.origin, ray.direction, ray.maxDistance, ray.mask, hit);
+				hitCount += isHit ? 1 : 0;
+				insideCount += isHit && hit.distance == 0.0f ? 1 : 0;
+				if (isHit != expectedHit)
+				{
+					++mismatchCount;
+					continue;
+				}
+
+				//同じ距離に複数ある場合があるので、当たったコライダーまでの距離も確認する
+				float colliderDistance = 0.0f;
+				if (isHit && (std::abs(hit.distance - expectedDistance) > 1.0e-3f || !RayDistance(hit.collider, ray.origin, direction, ray.maxDistance, colliderDistance) || std::abs(colliderDistance - hit.distance) > 1.0e-3f))
+				{
+					++mismatchCount;
+				}
+			}
+			scene.MoveDynamicColliders(random);
+		}
+		bool result = Benchmark::Expect(hitCount > 100 && insideCount > 10, "当たったレイ・内側から始まったレイが少ない");
+		result &= Benchmark::Expect(mismatchCount == 0, std::to_string(mismatchCount) + " rays differ from brute force");
+		return result;
+		});
+
+	//スフィアキャストの距離が、球を少しずつ動かして総当たりで重なりを調べた距離と一致するか
+	Benchmark::Registration sphereCastTest("Collision/QuerySphereCast", Benchmark::Kind::kTest, []() {
+		//半径を少し変えた球で挟んで、かすめる程度の当たりで結果が揺れないようにする
+		static const float kRadiusMargin = 0.01f;
+		QueryScene scene(13);
+		std::mt19937 random(9);
+		std::uniform_real_distribution<float> radiusDistribution(0.2f, 1.0f);
+		uint32_t mismatchCount = 0;
+		uint32_t hitCount = 0;
+		uint32_t insideCount = 0;
+		for (uint32_t round = 0; round < 2; ++round)
+		{
+			for (uint32_t i = 0; i < 150; ++i)
+			{
+				const QueryRay ray = MakeQueryRay(scene, random, i);
+				const float radius = radiusDistribution(random);
+				const std::vector<const Collider*> colliders = scene.GetQueriedColliders(ray.mask);
+				float shrunkDistance = 0.0f;
+				float grownDistance = 0.0f;
+				const bool isShrunkHit = FirstOverlapDistance(colliders, ray, radius - kRadiusMargin, shrunkDistance);
+				const bool isGrownHit = FirstOverlapDistance(colliders, ray, radius + kRadiusMargin, grownDistance);
+
+				CollisionManager::RaycastHit hit{};
+				const bool isHit = scene.GetCollisionManager().SphereCast(ray.origin, radius, ray.direction, ray.maxDistance, ray.mask, hit);
+				hitCount += isHit ? 1 : 0;
+				insideCount += isHit && hit.distance == 0.0f ? 1 : 0;
+
+				//小さい球が当たるなら当たり、当たった距離は大きい球と小さい球が当たる距離の間にある
+				bool isMatch = isHit || !isShrunkHit;
+				if (isHit)
+				{
+					SphereCollider probe;
+					probe.SetRadius(radius + kRadiusMargin);
+					probe.SetWorldCenter(ray.origin + Mathf::Normalize(ray.direction) * hit.distance);
+					isMatch &= isGrownHit && hit.distance >= grownDistance - 1.0e-3f && (!isShrunkHit || hit.distance <= shrunkDistance + 1.0e-3f);
+					isMatch &= hit.distance <= ray.maxDistance && CollisionManager::IsColliding(&probe, hit.collider);
+				}
+				mismatchCount += isMatch ? 0 : 1;
+			}
+			scene.MoveDynamicColliders(random);
+		}
+		bool result = Benchmark::Expect(hitCount > 50 && insideCount > 5, "当たったキャスト・内側から始まったキャストが少ない");
+		result &= Benchmark::Expect(mismatchCount == 0, std::to_string(mismatchCount) + " sphere casts differ from brute force");
+		return result;
+		});
+
+	//球・回転した箱と重なるコライダーが、全てのコライダーと判定した結果と一致するか
+	Benchmark::Registration overlapTest("Collision/QueryOverlap", Benchmark::Kind::kTest, []() {
+		QueryScene scene(17);
+		std::mt19937 random(3);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		uint32_t mismatchCount = 0;
+		uint32_t resultCount = 0;
+		for (uint32_t round = 0; round < 2; ++round)
+		{
+			for (uint32_t i = 0; i < 300; ++i)
+			{
+				const Vector3 center = { unit(random) * 12.0f, unit(random) * 3.0f, unit(random) * 12.0f };
+				const uint32_t mask = kQueryMasks[i % std::size(kQueryMasks)];
+				const bool isBox = i % 2 == 1;
+
+				//問い合わせと同じ形状のコライダーで総当たり
+				SphereCollider sphere;
+				sphere.SetWorldCenter(center);
+				sphere.SetRadius(0.5f + (unit(random) + 1.0f) * 1.5f);
+				OBBCollider box;
+				const Vector3 halfSize = { 0.5f + (unit(random) + 1.0f), 0.3f + (unit(random) + 1.0f) * 0.5f, 0.5f + (unit(random) + 1.0f) * 1.5f };
+				const Quaternion rotation = Mathf::Normalize(Quaternion{ unit(random), unit(random), unit(random), unit(random) });
+				box.SetWorldCenter(center);
+				box.SetSize(halfSize);
+				box.SetOrientations(Mathf::RotateVector({ 1.0f,0.0f,0.0f }, rotation), Mathf::RotateVector({ 0.0f,1.0f,0.0f }, rotation), Mathf::RotateVector({ 0.0f,0.0f,1.0f }, rotation));
+				std::vector<Collider*> expected{};
+				for (const Collider* collider : scene.GetQueriedColliders(mask))
+				{
+					if (CollisionManager::IsColliding(isBox ? static_cast<const Collider*>(&box) : &sphere, collider))
+					{
+						expected.push_back(const_cast<Collider*>(collider));
+					}
+				}
+
+				std::vector<Collider*> actual{};
+				if (isBox)
+				{
+					scene.GetCollisionManager().OverlapBox(center, halfSize, rotation, mask, actual);
+				}
+				else
+				{
+					scene.GetCollisionManager().OverlapSphere(center, sphere.GetRadius(), mask, actual);
+				}
+				std::sort(expected.begin(), expected.end());
+				std::sort(actual.begin(), actual.end());
+				resultCount += static_cast<uint32_t>(actual.size());
+				mismatchCount += actual == expected ? 0 : 1;
+			}
+			scene.MoveDynamicColliders(random);
+		}
+		bool result = Benchmark::Expect(resultCount > 100, "重なっているコライダーが少ない");
+		result &= Benchmark::Expect(mismatchCount == 0, std::to_string(mismatchCount) + " overlap queries differ from brute force");
+		return result;
+		});
+}
@@ -0,0 +1,280 @@
+/**
+ * @file SkinningBenchmark.cpp
+ * @brief スケルトンとマトリックスパレットの更新、CPUでのスキニングのベンチマーク・テスト
+ * @author 青木智滉
+ * @date
+ */
+
+#include "Benchmark.h"
+#include "PlayerScene.h"
+#include "Engine/3D/Model/AnimationPose.h"
+#include "Engine/3D/Model/SkinningMath.h"
+#include "Engine/Math/MathFunction.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	//ベクトル化する前の計算でスケルトン空間の行列を求める（ジョイントごとにアフィン行列を作り親の行列を掛ける）
+	void CalculateReferenceSkeleton(const Model::Skeleton& skeleton, std::vector<Matrix4x4>& skeletonSpaceMatrices)
+	{
+		skeletonSpaceMatrices.resize(skeleton.joints.size());
+		for (const Model::Joint& joint : skeleton.joints)
+		{
+			const Matrix4x4 localMatrix = Mathf::MakeAffineMatrix(joint.scale, joint.rotate, joint.translate);
+			skeletonSpaceMatrices[joint.index] = joint.parent ? localMatrix * skeletonSpaceMatrices[*joint.parent] : localMatrix;
+		}
+	}
+
+	//ベクトル化する前の計算でメッシュごとのマトリックスパレットを求める（法線用の行列は一般の逆行列の転置）
+	void CalculateReferencePalette(const Model::Skeleton& skeleton, const std::map<std::string, Model::JointWeightData>& skinClusterData, const std::vector<Matrix4x4>& skeletonSpaceMatrices, std::vector<Model::WellForGPU>& palette)
+	{
+		palette.resize(skeleton.joints.size());
+		for (const auto& [jointName, jointWeightData] : skinClusterData)
+		{
+			auto it = skeleton.jointMap.find(jointName);
+			if (it == skeleton.jointMap.end()) continue;
+			Model::WellForGPU& well = palette[it->second];
+			well.skeletonSpaceMatrix = jointWeightData.inverseBindPoseMatrix * skeletonSpaceMatrices[it->second];
+			well.skeletonSpaceInverseTransposeMatrix = Mathf::Transpose(Mathf::Inverse(well.skeletonSpaceMatrix));
+		}
+	}
+
+	//行列の差を行列の大きさで割った値
+	float CalculateRelativeError(const Matrix4x4& actual, const Matrix4x4& expected)
+	{
+		float error = 0.0f;
+		float scale = 1.0f;
+		for (uint32_t i = 0; i < 4; ++i)
+		{
+			for (uint32_t j = 0; j < 4; ++j)
+			{
+				error = std::max(error, std::fabs(actual.m[i][j] - expected.m[i][j]));
+				scale = std::max(scale, std::fabs(expected.m[i][j]));
+			}
+		}
+		return error / scale;
+	}
+
+	//クリップの姿勢をスケルトンに書き込む
+	void ApplyClipPose(Model& model, Animation& animation, AnimationPose& pose, const Animation::AnimationData& animationData, float time)
+	{
+		animation.PlayAnimation(animationData.name, 1.0f, true);
+		animation.SetAnimationTime(time);
+		pose.CopyFromSkeleton(model.GetSkeleton());
+		animation.SamplePose(&model, pose);
+		pose.ApplyToSkeleton(model.GetSkeleton());
+	}
+
+	//ベクトル化したスケルトンとパレットの計算が1ジョイントずつの計算と一致するか（共有したパレットがメッシュごとの逆バインドポーズ行列と一致するかも調べる）
+	Benchmark::Registration skeletonTest("Skinning/SkeletonMatchesScalar", Benchmark::Kind::kTest, []() {
+		const std::shared_ptr<const Model::SharedData>& sharedData = PlayerScene::GetSharedData();
+		const std::vector<Animation::AnimationData>& animationDatas = PlayerScene::GetAnimationDatas();
+		std::unique_ptr<Model> model = PlayerScene::CreateModel();
+		Animation animation{};
+		animation.Initialize(std::make_shared<const std::vector<Animation::AnimationData>>(animationDatas));
+		AnimationPose pose{};
+
+		bool result = Benchmark::Expect(sharedData->paletteInverseBindPoseMatrices.size() == 1, "the Player meshes should share one palette");
+		float skeletonError = 0.0f;
+		float paletteError = 0.0f;
+		std::vector<Matrix4x4> expectedMatrices{};
+		std::vector<Model::WellForGPU> expectedPalette{};
+		std::vector<Model::WellForGPU> actualPalette(model->GetSkeleton().joints.size());
+		for (const Animation::AnimationData& animationData : animationDatas)
+		{
+			for (float time = 0.0f; time < animationData.duration; time += 0.25f)
+			{
+				ApplyClipPose(*model, animation, pose, animationData, time);
+				model->UpdatePose();
+				CalculateReferenceSkeleton(model->GetSkeleton(), expectedMatrices);
+				for (size_t i = 0; i < expectedMatrices.size(); ++i)
+				{
+					skeletonError = std::max(skeletonError, CalculateRelativeError(model->GetSkeletonSpaceMatrices()[i], expectedMatrices[i]));
+				}
+
+				//メッシュごとに自身の逆バインドポーズ行列で求めたパレットと、共有したパレットの参照するジョイントを比べる
+				for (size_t meshIndex = 0; meshIndex < sharedData->skinClusters.size(); ++meshIndex)
+				{
+					const std::map<std::string, Model::JointWeightData>& skinClusterData = sharedData->modelData.skinClusterData[meshIndex];
+					SkinningMath::CalculatePalette(sharedData->paletteInverseBindPoseMatrices[sharedData->skinClusters[meshIndex].paletteIndex], model->GetSkeletonSpaceMatrices(), actualPalette);
+					CalculateReferencePalette(model->GetSkeleton(), skinClusterData, model->GetSkeletonSpaceMatrices(), expectedPalette);
+					for (const auto& [jointName, jointWeightData] : skinClusterData)
+					{
+						const int32_t jointIndex = model->GetSkeleton().jointMap.at(jointName);
+						paletteError = std::max(paletteError, CalculateRelativeError(actualPalette[jointIndex].skeletonSpaceMatrix, expectedPalette[jointIndex].skeletonSpaceMatrix));
+						paletteError = std::max(paletteError, CalculateRelativeError(actualPalette[jointIndex].skeletonSpaceInverseTransposeMatrix, expectedPalette[jointIndex].skeletonSpaceInverseTransposeMatrix));
+					}
+				}
+			}
+		}
+		result &= Benchmark::Expect(skeletonError <= 1e-5f, "skeleton space matrices differ by " + std::to_string(skeletonError));
+		result &= Benchmark::Expect(paletteError <= 1e-4f, "palette differs by " + std::to_string(paletteError));
+		return result;
+		});
+
+	//プレイヤーのスケルトンとパレットの1回の更新にかかる時間
+	Benchmark::Registration skeletonBenchmark("Skinning/Skeleton", Benchmark::Kind::kBenchmark, []() {
+		const std::shared_ptr<const Model::SharedData>& sharedData = PlayerScene::GetSharedData();
+		const std::vector<Animation::AnimationData>& animationDatas = PlayerScene::GetAnimationDatas();
+		std::unique_ptr<Model> model = PlayerScene::CreateModel();
+		Animation animation{};
+		animation.Initialize(std::make_shared<const std::vector<Animation::AnimationData>>(animationDatas));
+		AnimationPose pose{};
+		ApplyClipPose(*model, animation, pose, animationDatas.front(), animationDatas.front().duration * 0.5f);
+
+		//ジョイントごとに計算し、メッシュごとにパレットを作る場合
+		std::vector<Matrix4x4> matrices{};
+		std::vector<Model::WellForGPU> palette{};
+		const double scalar = Benchmark::MeasureMicroseconds(2000, [&]() {
+			CalculateReferenceSkeleton(model->GetSkeleton(), matrices);
+			for (const std::map<std::string, Model::JointWeightData>& skinClusterData : sharedData->modelData.skinClusterData)
+			{
+				CalculateReferencePalette(model->GetSkeleton(), skinClusterData, matrices, palette);
+			}
+			});
+
+		//ベクトル化し、パレットを共有する場合
+		const double vectorized = Benchmark::MeasureMicroseconds(2000, [&]() {
+			model->GetSkeleton();
+			model->UpdatePose();
+			});
+
+		Benchmark::Report("scalar, per-mesh palettes", scalar, "us/update");
+		Benchmark::Report("vectorized, shared palette", vectorized, "us/update");
+		return true;
+		});
+
+	//Skinning.CS.hlslの1頂点分の計算をそのまま移したもの（mulは行ベクトルと行列の積、法線は左上の3x3を使う）
+	VertexDataPosUVNormal SkinVertexLikeShader(const VertexDataPosUVNormal& input, const Model::VertexInfluence& influence, std::span<const Model::WellForGPU> palette)
+	{
+		auto mul4 = [](const Vector4& v, const Matrix4x4& m) {
+			return Vector4{
+				v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + v.w * m.m[3][0],
+				v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + v.w * m.m[3][1],
+				v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + v.w * m.m[3][2],
+				v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + v.w * m.m[3][3] };
+			};
+		auto mul3 = [](const Vector3& v, const Matrix4x4& m) {
+			return Vector3{
+				v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0],
+				v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1],
+				v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] };
+			};
+
+		VertexDataPosUVNormal skinned{};
+		skinned.texcoord = input.texcoord;
+		skinned.position = { 0.0f, 0.0f, 0.0f, 0.0f };
+		skinned.normal = { 0.0f, 0.0f, 0.0f };
+		for (uint32_t k = 0; k < Model::kNumMaxInfluence; ++k)
+		{
+			const Model::WellForGPU& well = palette[influence.jointIndices[k]];
+			const Vector4 position = mul4(input.position, well.skeletonSpaceMatrix);
+			const Vector3 normal = mul3(input.normal, well.skeletonSpaceInverseTransposeMatrix);
+			skinned.position = { skinned.position.x + position.x * influence.weights[k], skinned.position.y + position.y * influence.weights[k],
+				skinned.position.z + position.z * influence.weights[k], skinned.position.w + position.w * influence.weights[k] };
+			skinned.normal = skinned.normal + normal * influence.weights[k];
+		}
+		skinned.position.w = 1.0f;
+		skinned.normal = Mathf::Normalize(skinned.normal);
+		return skinned;
+	}
+
+	//プレイヤーの全てのメッシュについてSkinVerticesの結果がシェーダーの計算と一致するか（全てのクリップの姿勢で調べる）
+	Benchmark::Registration skinningTest("Skinning/VerticesMatchShader", Benchmark::Kind::kTest, []() {
+		const std::shared_ptr<const Model::SharedData>& sharedData = PlayerScene::GetSharedData();
+		const std::vector<Animation::AnimationData>& animationDatas = PlayerScene::GetAnimationDatas();
+		std::unique_ptr<Model> model = PlayerScene::CreateModel();
+		Animation animation{};
+		animation.Initialize(std::make_shared<const std::vector<Animation::AnimationData>>(animationDatas));
+		AnimationPose pose{};
+
+		bool result = true;
+		float positionError = 0.0f;
+		float normalError = 0.0f;
+		size_t skinnedVertexCount = 0;
+		std::vector<Model::WellForGPU> palette(model->GetSkeleton().joints.size());
+		std::vector<VertexDataPosUVNormal> outputVertices{};
+		for (const Animation::AnimationData& animationData : animationDatas)
+		{
+			ApplyClipPose(*model, animation, pose, animationData, animationData.duration * 0.5f);
+			model->UpdatePose();
+			for (size_t meshIndex = 0; meshIndex < sharedData->skinClusters.size(); ++meshIndex)
+			{
+				const Model::SharedSkinCluster& skinCluster = sharedData->skinClusters[meshIndex];
+				const std::span<const VertexDataPosUVNormal> inputVertices = sharedData->meshVertices[meshIndex];
+				if (skinCluster.influences.empty()) continue;
+				SkinningMath::CalculatePalette(sharedData->paletteInverseBindPoseMatrices[skinCluster.paletteIndex], model->GetSkeletonSpaceMatrices(), palette);
+				outputVertices.resize(inputVertices.size());
+				SkinningMath::SkinVertices(inputVertices, skinCluster.influences, palette, outputVertices);
+				for (size_t i = 0; i < inputVertices.size(); ++i)
+				{
+					const VertexDataPosUVNormal expected = SkinVertexLikeShader(inputVertices[i], skinCluster.influences[i], palette);
+					const VertexDataPosUVNormal& actual = outputVertices[i];
+					const float scale = std::max({ 1.0f, std::fabs(expected.position.x), std::fabs(expected.position.y), std::fabs(expected.position.z) });
+					positionError = std::max({ positionError, std::fabs(actual.position.x - expected.position.x) / scale,
+						std::fabs(actual.position.y - expected.position.y) / scale, std::fabs(actual.position.z - expected.position.z) / scale, std::fabs(actual.position.w - 1.0f) });
+					normalError = std::max({ normalError, std::fabs(actual.normal.x - expected.normal.x), std::fabs(actual.normal.y - expected.normal.y), std::fabs(actual.normal.z - expected.normal.z) });
+					result &= actual.texcoord.x == expected.texcoord.x && actual.texcoord.y == expected.texcoord.y;
+				}
+				skinnedVertexCount += inputVertices.size();
+			}
+		}
+		result = Benchmark::Expect(result, "texcoords were not copied");
+		result &= Benchmark::Expect(skinnedVertexCount > 0, "no skinned vertices");
+		result &= Benchmark::Expect(positionError <= 1e-5f, "positions differ from the shader by " + std::to_string(positionError));
+		result &= Benchmark::Expect(normalError <= 1e-5f, "normals differ from the shader by " + std::to_string(normalError));
+		return result;
+		});
+
+	//プレイヤーの全てのメッシュをCPUでスキニングする時間
+	Benchmark::Registration skinningBenchmark("Skinning/Vertices", Benchmark::Kind::kBenchmark, []() {
+		const std::shared_ptr<const Model::SharedData>& sharedData = PlayerScene::GetSharedData();
+		const std::vector<Animation::AnimationData>& animationDatas = PlayerScene::GetAnimationDatas();
+		std::unique_ptr<Model> model = PlayerScene::CreateModel();
+		Animation animation{};
+		animation.Initialize(std::make_shared<const std::vector<Animation::AnimationData>>(animationDatas));
+		AnimationPose pose{};
+		ApplyClipPose(*model, animation, pose, animationDatas.front(), animationDatas.front().duration * 0.5f);
+		model->UpdatePose();
+		std::vector<Model::WellForGPU> palette(model->GetSkeleton().joints.size());
+		SkinningMath::CalculatePalette(sharedData->paletteInverseBindPoseMatrices[0], model->GetSkeletonSpaceMatrices(), palette);
+
+		//スキニングするメッシュと頂点数
+		std::vector<size_t> meshIndices{};
+		size_t vertexCount = 0;
+		for (size_t meshIndex = 0; meshIndex < sharedData->skinClusters.size(); ++meshIndex)
+		{
+			if (sharedData->skinClusters[meshIndex].influences.empty()) continue;
+			meshIndices.push_back(meshIndex);
+			vertexCount += sharedData->meshVertices[meshIndex].size();
+		}
+		std::vector<VertexDataPosUVNormal> outputVertices(vertexCount);
+
+		const double shader = Benchmark::MeasureMicroseconds(20, [&]() {
+			size_t offset = 0;
+			for (size_t meshIndex : meshIndices)
+			{
+				const std::span<const VertexDataPosUVNormal> inputVertices = sharedData->meshVertices[meshIndex];
+				for (size_t i = 0; i < inputVertices.size(); ++i)
+				{
+					outputVertices[offset + i] = SkinVertexLikeShader(inputVertices[i], sharedData->skinClusters[meshIndex].influences[i], palette);
+				}
+				offset += inputVertices.size();
+			}
+			});
+		const double batched = Benchmark::MeasureMicroseconds(20, [&]() {
+			size_t offset = 0;
+			for (size_t meshIndex : meshIndices)
+			{
+				const std::span<const VertexDataPosUVNormal> inputVertices = sharedData->meshVertices[meshIndex];
+				SkinningMath::SkinVertices(inputVertices, sharedData->skinClusters[meshIndex].influences, palette, std::span(outputVertices).subspan(offset, inputVertices.size()));
+				offset += inputVertices.size();
+			}
+			});
+
+		Benchmark::Report("shader port", shader * 1000.0 / vertexCount, "ns/vertex");
+		Benchmark::Report("SkinVertices", batched * 1000.0 / vertexCount, "ns/vertex");
+		return true;
+		});
+}
@@ -0,0 +1,109 @@
+/**
+ * @file TransformBenchmark.cpp
+ * @brief ワールドトランスフォームの更新のベンチマーク・テスト
+ * @author 青木智滉
+ * @date
+ */
+
+#include "Benchmark.h"
+#include "Engine/3D/Transform/WorldTransform.h"
+#include "Engine/Math/MathFunction.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+	//定数バッファの内容がワールド行列と一致するか
+	bool MatchesBuffer(const WorldTransform& worldTransform)
+	{
+		const ConstBuffDataWorldTransform* data = static_cast<const ConstBuffDataWorldTransform*>(worldTransform.GetConstantBuffer()->GetData());
+		return data->world == worldTransform.matWorld_ && data->worldInverseTranspse == Mathf::InverseTranspose(worldTransform.matWorld_);
+	}
+
+	//手順ごとに定数バッファの内容と書き込んだ回数を調べる
+	bool CheckStep(const WorldTransform& worldTransform, const uint32_t expectedMapCount, const char* step)
+	{
+		const uint32_t mapCount = worldTransform.GetConstantBuffer()->GetMapCount();
+		bool result = Benchmark::Expect(MatchesBuffer(worldTransform), std::string(step) + ": constant buffer differs from matWorld_");
+		result &= Benchmark::Expect(mapCount == expectedMapCount, std::string(step) + ": " + std::to_string(mapCount) + " writes, expected " + std::to_string(expectedMapCount));
+		return result;
+	}
+
+	//変わっていない行列は書き込まず、親の移動や外部で書き換えた行列は書き込まれるか
+	Benchmark::Registration bufferTest("Transform/ConstantBufferMatches", Benchmark::Kind::kTest, []() {
+		WorldTransform parent{};
+		WorldTransform child{};
+		parent.Initialize();
+		child.Initialize();
+		child.SetParent(&parent);
+		child.translation_ = { 1.0f, 2.0f, 3.0f };
+		child.rotation_ = { 0.3f, 0.2f, 0.1f };
+		child.UpdateMatrix();
+		bool result = CheckStep(parent, 1, "parent initialized");
+		result &= CheckStep(child, 2, "child moved");
+
+		//変わっていなければ書き込まない
+		parent.UpdateMatrix();
+		child.UpdateMatrix();
+		result &= CheckStep(parent, 1, "parent unchanged");
+		result &= CheckStep(child, 2, "child unchanged");
+
+		//親が動いた場合は子も書き込む
+		parent.translation_ = { 0.0f, 5.0f, 0.0f };
+		parent.UpdateMatrix();
+		child.UpdateMatrix();
+		result &= CheckStep(parent, 2, "parent moved");
+		result &= CheckStep(child, 3, "child follows parent");
+
+		//外部で書き換えた行列を書き込み、次の更新で計算した行列に戻す
+		child.matWorld_ = Mathf::MakeAffineMatrix({ 2.0f, 2.0f, 2.0f }, Vector3{ 0.0f, 1.0f, 0.0f }, { 4.0f, 0.0f, 0.0f });
+		child.TransferMatrix();
+		result &= CheckStep(child, 4, "child edited externally");
+		child.UpdateMatrix();
+		result &= CheckStep(child, 5, "child restored");
+		child.UpdateMatrix();
+		result &= CheckStep(child, 5, "child unchanged after restore");
+		return result;
+		});
+
+	//静止しているトランスフォームと動いているトランスフォームの1フレームの更新時間
+	Benchmark::Registration updateBenchmark("Transform/Update", Benchmark::Kind::kBenchmark, []() {
+		static const uint32_t kTransformCount = 5000;
+		std::vector<std::unique_ptr<WorldTransform>> worldTransforms{};
+		for (uint32_t i = 0; i < kTransformCount; ++i)
+		{
+			std::unique_ptr<WorldTransform> worldTransform = std::make_unique<WorldTransform>();
+			worldTransform->Initialize();
+			worldTransform->translation_ = { i * 0.5f, 0.0f, -(i % 7) * 1.0f };
+			worldTransform->rotation_ = { 0.0f, i * 0.01f, 0.0f };
+			//1割は直前のトランスフォームの子にする
+			if (i % 10 == 9)
+			{
+				worldTransform->SetParent(worldTransforms.back().get());
+			}
+			worldTransforms.push_back(std::move(worldTransform));
+		}
+
+		const double still = Benchmark::MeasureMicroseconds(20, [&]() {
+			for (const std::unique_ptr<WorldTransform>& worldTransform : worldTransforms)
+			{
+				worldTransform->UpdateMatrix();
+			}
+			});
+
+		float angle = 0.0f;
+		const double moving = Benchmark::MeasureMicroseconds(20, [&]() {
+			angle += 0.01f;
+			for (const std::unique_ptr<WorldTransform>& worldTransform : worldTransforms)
+			{
+				worldTransform->rotation_.y = angle;
+				worldTransform->UpdateMatrix();
+			}
+			});
+
+		Benchmark::Report("still", still, "us/5000 transforms");
+		Benchmark::Report("moving", moving, "us/5000 transforms");
+		return true;
+		});
+}
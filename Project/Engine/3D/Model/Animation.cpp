@@ -10,14 +10,127 @@
 #include "Engine/Utilities/GameTimer.h"
 #include <cassert>
 #include <algorithm>
+#include <cmath>
+#include <numbers>
 
-void Animation::Initialize(const std::vector<AnimationData>& animationData)
+void Animation::Initialize(const std::shared_ptr<const std::vector<AnimationData>>& animationDatas)
 {
-    //アニメーションデータの初期化
-    animationDatas_ = animationData;
+    //アニメーションデータを共有する
+    animationDatas_ = animationDatas;
+
+    //キーフレームのカーソルを確保
+    size_t maxChannelCount = 0;
+    if (animationDatas_)
+    {
+        for (const AnimationData& animationData : *animationDatas_)
+        {
+            maxChannelCount = std::max(maxChannelCount, animationData.nodeAnimations.size());
+        }
+    }
+    keyframeCursors_.assign(maxChannelCount * 3, 0);
+
+    //バインドをリセット
+    skeletonBindings_.clear();
 
     //最初のアニメーションを設定
-    animationName_ = animationDatas_.empty() ? "" : animationDatas_[0].name;
+    animationIndex_ = animationDatas_ && !animationDatas_->empty() ? 0 : -1;
+}
+
+void Animation::Resample(AnimationData& animationData, const float sampleRate)
+{
+    //圧縮したデータは元のキーフレームがないので再サンプリングできない
+    assert(!animationData.isCompressed);
+
+    //サンプル数を計算（終端の値も含める）
+    animationData.sampleRate = std::max(sampleRate, 0.0f);
+    animationData.sampleCount = animationData.sampleRate > 0.0f ? static_cast<uint32_t>(std::ceil(animationData.duration * animationData.sampleRate)) + 1 : 0;
+
+    //全てのカーブを再サンプリング
+    animationData.vector3Samples.clear();
+    animationData.quaternionSamples.clear();
+    for (NodeAnimation& nodeAnimation : animationData.nodeAnimations)
+    {
+        ResampleCurve(animationData, nodeAnimation.translate, animationData.vector3Samples);
+        ResampleCurve(animationData, nodeAnimation.rotate, animationData.quaternionSamples);
+        ResampleCurve(animationData, nodeAnimation.scale, animationData.vector3Samples);
+    }
+}
+
+void Animation::Compress(AnimationData& animationData, const float translateTolerance, const float rotateTolerance, const float scaleTolerance)
+{
+    //圧縮済みの場合は何もしない
+    if (animationData.isCompressed) return;
+
+    //許容誤差内で補間できるキーフレームを削る
+    std::vector<KeyframeVector3> vector3Keyframes;
+    std::vector<KeyframeQuaternion> quaternionKeyframes;
+    for (NodeAnimation& nodeAnimation : animationData.nodeAnimations)
+    {
+        ReduceCurve(animationData.vector3Keyframes, nodeAnimation.translate, translateTolerance, vector3Keyframes);
+        ReduceCurve(animationData.quaternionKeyframes, nodeAnimation.rotate, rotateTolerance, quaternionKeyframes);
+        ReduceCurve(animationData.vector3Keyframes, nodeAnimation.scale, scaleTolerance, vector3Keyframes);
+    }
+
+    //移動とスケールそれぞれの値の範囲を求める
+    Vector3 translateMax{}, scaleMax{};
+    auto calculateBounds = [&](const AnimationCurve<Vector3>& curve, Vector3& min, Vector3& max, bool& isFirst) {
+        for (uint32_t i = curve.keyframeOffset; i < curve.keyframeOffset + curve.keyframeCount; ++i)
+        {
+            const Vector3& value = vector3Keyframes[i].value;
+            min = isFirst ? value : Vector3{ std::min(min.x, value.x), std::min(min.y, value.y), std::min(min.z, value.z) };
+            max = isFirst ? value : Vector3{ std::max(max.x, value.x), std::max(max.y, value.y), std::max(max.z, value.z) };
+            isFirst = false;
+        }
+        };
+    bool isFirstTranslate = true, isFirstScale = true;
+    for (const NodeAnimation& nodeAnimation : animationData.nodeAnimations)
+    {
+        calculateBounds(nodeAnimation.translate, animationData.translateMin, translateMax, isFirstTranslate);
+        calculateBounds(nodeAnimation.scale, animationData.scaleMin, scaleMax, isFirstScale);
+    }
+    animationData.translateStep = (translateMax - animationData.translateMin) * (1.0f / kMaxCompressedVector3);
+    animationData.scaleStep = (scaleMax - animationData.scaleMin) * (1.0f / kMaxCompressedVector3);
+
+    //時間と値を量子化する（カーブの範囲は削った後のキーフレームと同じ、回転は移動とスケールの後ろにまとめて確保する）
+    const float timeScale = animationData.duration > 0.0f ? kMaxCompressedTime / animationData.duration : 0.0f;
+    const size_t vector3KeyframeCount = vector3Keyframes.size();
+    std::shared_ptr<std::vector<CompressedKeyframe>> storage = std::make_shared<std::vector<CompressedKeyframe>>(vector3KeyframeCount + quaternionKeyframes.size());
+    std::vector<CompressedKeyframe>& compressedKeyframes = *storage;
+    for (const NodeAnimation& nodeAnimation : animationData.nodeAnimations)
+    {
+        for (uint32_t i = nodeAnimation.translate.keyframeOffset; i < nodeAnimation.translate.keyframeOffset + nodeAnimation.translate.keyframeCount; ++i)
+        {
+            compressedKeyframes[i] = CompressKeyframe(vector3Keyframes[i], timeScale, animationData.translateMin, animationData.translateStep);
+        }
+        for (uint32_t i = nodeAnimation.scale.keyframeOffset; i < nodeAnimation.scale.keyframeOffset + nodeAnimation.scale.keyframeCount; ++i)
+        {
+            compressedKeyframes[i] = CompressKeyframe(vector3Keyframes[i], timeScale, animationData.scaleMin, animationData.scaleStep);
+        }
+        for (uint32_t i = nodeAnimation.rotate.keyframeOffset; i < nodeAnimation.rotate.keyframeOffset + nodeAnimation.rotate.keyframeCount; ++i)
+        {
+            compressedKeyframes[vector3KeyframeCount + i] = CompressKeyframe(quaternionKeyframes[i], timeScale);
+        }
+    }
+    animationData.compressedVector3Keyframes = std::span<const CompressedKeyframe>(compressedKeyframes.data(), vector3KeyframeCount);
+    animationData.compressedQuaternionKeyframes = std::span<const CompressedKeyframe>(compressedKeyframes.data() + vector3KeyframeCount, quaternionKeyframes.size());
+    animationData.compressedStorage = storage;
+
+    //元のキーフレームは使わないので解放する
+    animationData.vector3Keyframes = std::vector<KeyframeVector3>();
+    animationData.quaternionKeyframes = std::vector<KeyframeQuaternion>();
+    animationData.isCompressed = true;
+}
+
+uint32_t Animation::HashName(const std::string_view name)
+{
+    //FNV-1aで32ビットのハッシュを計算
+    uint32_t hash = 2166136261u;
+    for (const char c : name)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
 }
 
 void Animation::UpdateAnimationTime()
@@ -66,7 +179,11 @@ void Animation::ApplyAnimation(Model* model, WorldTransform& worldTransform, con
     UpdateAnimationTime();
 
     //ノードレベルのアニメーションを適用する
-    ApplyNodeAnimation(model, worldTransform, *animationData);
+    Matrix4x4 rootNodeMatrix{};
+    if (CalculateRootNodeMatrix(model, nullptr, 0.0f, rootNodeMatrix))
+    {
+        worldTransform.matWorld_ = rootNodeMatrix * worldTransform.matWorld_;
+    }
 
     //スケルトンレベルのアニメーションを適用する
     ApplySkeletonAnimation(model, *animationData, inPlaceAxis);
@@ -85,16 +202,102 @@ void Animation::ApplyBlendAnimation(Model* model, WorldTransform& worldTransform
     blendAnimation->UpdateAnimationTime();
 
     //ノードのブレンドアニメーションを適用する
-    ApplyBlendedNodeAnimation(model, worldTransform, *currentAnimationData, blendAnimation, blendFactor);
+    Matrix4x4 rootNodeMatrix{};
+    if (CalculateRootNodeMatrix(model, blendAnimation, blendFactor, rootNodeMatrix))
+    {
+        worldTransform.matWorld_ = rootNodeMatrix * worldTransform.matWorld_;
+    }
 
     //スケルトンのブレンドアニメーションを適用する
-    ApplyBlendedSkeletonAnimation(model, *currentAnimationData, blendAnimation, blendFactor, inPlaceAxis);
+    ApplyBlendedSkeletonAnimation(model, blendAnimation, blendFactor, inPlaceAxis);
+}
+
+void Animation::SamplePose(Model* model, AnimationPose& pose, const Vector3& inPlaceAxis)
+{
+    //現在のアニメーションデータを取得
+    const AnimationData* animationData = GetAnimationData();
+    //現在のアニメーションデータがない場合は何もしない
+    if (!animationData) return;
+
+    //ジョイントとチャンネルの対応を取得
+    const SkeletonBinding& binding = GetSkeletonBinding(model, animationIndex_);
+    assert(binding.jointChannels.size() == pose.GetJointCount());
+
+    //姿勢バッファを取得
+    std::vector<Vector3>& translates = pose.GetTranslates();
+    std::vector<Quaternion>& rotates = pose.GetRotates();
+    std::vector<Vector3>& scales = pose.GetScales();
+
+    //チャンネルのある全てのジョイントの姿勢を計算
+    for (size_t jointIndex = 0; jointIndex < binding.jointChannels.size(); ++jointIndex)
+    {
+        //ジョイントに対応するチャンネルがない場合は飛ばす
+        const int32_t channelIndex = binding.jointChannels[jointIndex];
+        if (channelIndex < 0) continue;
+
+        //現在のアニメーション時間に基づいて、変換、回転、スケーリングを計算
+        CalculateNodeTransform(*animationData, channelIndex, translates[jointIndex], rotates[jointIndex], scales[jointIndex]);
+
+        //階層のトップジョイントの場合は位置成分をリセット
+        if (binding.isInPlaceJoints[jointIndex])
+        {
+            translates[jointIndex] = {
+                inPlaceAxis.x != 0.0f ? translates[jointIndex].x : 0.0f,
+                inPlaceAxis.y != 0.0f ? translates[jointIndex].y : 0.0f,
+                inPlaceAxis.z != 0.0f ? translates[jointIndex].z : 0.0f
+            };
+        }
+    }
+}
+
+const bool Animation::CalculateRootNodeMatrix(Model* model, Animation* blendAnimation, const float blendFactor, Matrix4x4& localMatrix)
+{
+    //現在のアニメーションデータを取得
+    const AnimationData* currentAnimationData = GetAnimationData();
+    //現在のアニメーションデータがない場合は何もしない
+    if (!currentAnimationData) return false;
+
+    //ルートノードのチャンネルを取得
+    const SkeletonBinding& binding = GetSkeletonBinding(model, animationIndex_);
+    //ルートノードのアニメーションがない場合は何もしない
+    if (binding.rootNodeChannel < 0) return false;
+
+    //現在のアニメーション時間に基づいて、変換、回転、スケーリングを計算
+    Vector3 currentTranslate{};
+    Quaternion currentRotate{};
+    Vector3 currentScale{};
+    CalculateNodeTransform(*currentAnimationData, binding.rootNodeChannel, currentTranslate, currentRotate, currentScale);
+
+    //ブレンドアニメーションのアニメーションデータが存在する場合
+    const AnimationData* blendAnimationData = blendAnimation ? blendAnimation->GetAnimationData() : nullptr;
+    if (blendAnimationData)
+    {
+        //ブレンドアニメーションのルートノードのチャンネルを取得
+        const SkeletonBinding& blendBinding = blendAnimation->GetSkeletonBinding(model, blendAnimation->animationIndex_);
+        if (blendBinding.rootNodeChannel >= 0)
+        {
+            //ブレンドアニメーションに基づいて、変換、回転、スケーリングを計算
+            Vector3 blendTranslate{};
+            Quaternion blendRotate{};
+            Vector3 blendScale{};
+            blendAnimation->CalculateNodeTransform(*blendAnimationData, blendBinding.rootNodeChannel, blendTranslate, blendRotate, blendScale);
+
+            //現在のアニメーションとブレンドアニメーションを補間する
+            currentTranslate = Mathf::Lerp(currentTranslate, blendTranslate, blendFactor);
+            currentRotate = Mathf::Slerp(currentRotate, blendRotate, blendFactor);
+            currentScale = Mathf::Lerp(currentScale, blendScale, blendFactor);
+        }
+    }
+
+    //計算した変換、回転、スケーリングからローカル行列を作成
+    localMatrix = Mathf::MakeAffineMatrix(currentScale, currentRotate, currentTranslate);
+    return true;
 }
 
 void Animation::PlayAnimation(const std::string& animationName, float speed, bool loop)
 {
-    //アニメーション名を設定
-    animationName_ = animationName; 
+    //アニメーション名からアニメーションの番号を解決
+    animationIndex_ = FindAnimationIndex(animationName);
     //ループフラグを設定
     loop_ = loop; 
     //停止フラグを解除
@@ -157,210 +360,455 @@ const float Animation::GetDuration() const
 
 const Animation::AnimationData* Animation::GetAnimationData() const
 {
-    auto it = std::find_if(animationDatas_.begin(), animationDatas_.end(),
-        [this](const AnimationData& data) { return data.name == animationName_; });
-    return it != animationDatas_.end() ? &(*it) : nullptr;
+    return animationIndex_ >= 0 ? &(*animationDatas_)[animationIndex_] : nullptr;
 }
 
-Vector3 Animation::CalculateValue(const std::vector<KeyframeVector3>& keyframes, float time)
+const int32_t Animation::FindAnimationIndex(const std::string& animationName) const
 {
-    assert(!keyframes.empty());//キーがないものは返す値が分からないのでダメ
-    //キーが2つか、時刻がキーフレーム前なら最初の値とする
-    if (keyframes.size() == 1 || time <= keyframes[0].time)
+    if (!animationDatas_) return -1;
+    auto it = std::find_if(animationDatas_->begin(), animationDatas_->end(),
+        [&animationName](const AnimationData& data) { return data.name == animationName; });
+    return it != animationDatas_->end() ? static_cast<int32_t>(it - animationDatas_->begin()) : -1;
+}
+
+const Animation::SkeletonBinding& Animation::GetSkeletonBinding(Model* model, const int32_t animationIndex)
+{
+    //スケルトンを取得
+    const Model::Skeleton& skeleton = model->GetSkeleton();
+
+    //既にバインドしていればそれを使う（ジョイント数が変わっていれば作り直す）
+    auto it = std::find_if(skeletonBindings_.begin(), skeletonBindings_.end(),
+        [model, animationIndex](const SkeletonBinding& binding) { return binding.model == model && binding.animationIndex == animationIndex; });
+    if (it != skeletonBindings_.end() && it->jointChannels.size() == skeleton.joints.size())
     {
-        return keyframes[0].value;
+        return *it;
+    }
+    SkeletonBinding& binding = it != skeletonBindings_.end() ? *it : skeletonBindings_.emplace_back();
+    binding.model = model;
+    binding.animationIndex = animationIndex;
+
+    //ノード名からチャンネルの番号を探す処理
+    const AnimationData& animationData = (*animationDatas_)[animationIndex];
+    auto findChannel = [&animationData](const std::string& nodeName) {
+        auto channelIt = animationData.channelIndices.find(HashName(nodeName));
+        return channelIt != animationData.channelIndices.end() ? static_cast<int32_t>(channelIt->second) : -1;
+        };
+
+    //ルートノードのチャンネルを探す
+    binding.rootNodeChannel = findChannel(model->GetRootNode().name);
+
+    //ジョイントごとのチャンネルと位置成分を固定するかどうかを求める
+    binding.jointChannels.resize(skeleton.joints.size());
+    binding.isInPlaceJoints.resize(skeleton.joints.size());
+    for (size_t jointIndex = 0; jointIndex < skeleton.joints.size(); ++jointIndex)
+    {
+        const std::string& jointName = skeleton.joints[jointIndex].name;
+        binding.jointChannels[jointIndex] = findChannel(jointName);
+        binding.isInPlaceJoints[jointIndex] = jointName.find("Root") != std::string::npos || jointName.find("Hips") != std::string::npos;
     }
 
-    for (size_t index = 0; index < keyframes.size() - 1; ++index)
+    return binding;
+}
+
+template <typename tKeyframe>
+uint32_t Animation::FindKeyframeIndex(std::span<const tKeyframe> keyframes, const float time, uint32_t& cursor)
+{
+    //最後の区間の番号
+    const uint32_t lastIndex = static_cast<uint32_t>(keyframes.size() - 2);
+
+    //前回の区間から前に進めて探す
+    uint32_t index = std::min(cursor, lastIndex);
+    if (keyframes[index].time <= time)
     {
-        size_t nextIndex = index + 1;
-        //indexとnextIndexの2つのkeyframeを取得して範囲内に時刻があるかを判定
-        if (keyframes[index].time <= time && time <= keyframes[nextIndex].time)
+        for (uint32_t step = 0; step < kMaxCursorSteps && index < lastIndex && keyframes[index + 1].time <= time; ++step)
         {
-            //範囲内を補間する
-            float t = (time - keyframes[index].time) / (keyframes[nextIndex].time - keyframes[index].time);
-            return Mathf::Lerp(keyframes[index].value, keyframes[nextIndex].value, t);
+            ++index;
         }
     }
-    return (*keyframes.rbegin()).value;
+
+    //区間に時刻が含まれていなければ二分探索する（シークやループで時間が飛んだ場合）
+    if (time < keyframes[index].time || (index < lastIndex && keyframes[index + 1].time <= time))
+    {
+        auto it = std::upper_bound(keyframes.begin(), keyframes.end(), time,
+            [](const float value, const tKeyframe& keyframe) { return value < keyframe.time; });
+        index = std::min(static_cast<uint32_t>(std::max<ptrdiff_t>(it - keyframes.begin() - 1, 0)), lastIndex);
+    }
+
+    //カーソルを更新
+    cursor = index;
+    return index;
 }
 
-Quaternion Animation::CalculateValue(const std::vector<KeyframeQuaternion>& keyframes, float time)
+Vector3 Animation::CalculateValue(std::span<const KeyframeVector3> keyframes, float time, uint32_t& cursor)
 {
     assert(!keyframes.empty());//キーがないものは返す値が分からないのでダメ
-    //キーが2つか、時刻がキーフレーム前なら最初の値とする
+    //キーが1つか、時刻がキーフレーム前なら最初の値とする
     if (keyframes.size() == 1 || time <= keyframes[0].time)
     {
         return keyframes[0].value;
     }
+    //時刻が最後のキーフレーム以降なら最後の値とする
+    if (time >= keyframes.back().time)
+    {
+        return keyframes.back().value;
+    }
 
-    for (size_t index = 0; index < keyframes.size() - 1; ++index)
+    //時刻を含む区間を探して補間する
+    uint32_t index = FindKeyframeIndex(keyframes, time, cursor);
+    float t = (time - keyframes[index].time) / (keyframes[index + 1].time - keyframes[index].time);
+    return Mathf::Lerp(keyframes[index].value, keyframes[index + 1].value, t);
+}
+
+Quaternion Animation::CalculateValue(std::span<const KeyframeQuaternion> keyframes, float time, uint32_t& cursor)
+{
+    assert(!keyframes.empty());//キーがないものは返す値が分からないのでダメ
+    //キーが1つか、時刻がキーフレーム前なら最初の値とする
+    if (keyframes.size() == 1 || time <= keyframes[0].time)
     {
-        size_t nextIndex = index + 1;
-        //indexとnextIndexの2つのkeyframeを取得して範囲内に時刻があるかを判定
-        if (keyframes[index].time <= time && time <= keyframes[nextIndex].time)
-        {
-            //範囲内を補間する
-            float t = (time - keyframes[index].time) / (keyframes[nextIndex].time - keyframes[index].time);
-            return Mathf::Slerp(keyframes[index].value, keyframes[nextIndex].value, t);
-        }
+        return keyframes[0].value;
+    }
+    //時刻が最後のキーフレーム以降なら最後の値とする
+    if (time >= keyframes.back().time)
+    {
+        return keyframes.back().value;
     }
-    return (*keyframes.rbegin()).value;
+
+    //時刻を含む区間を探して補間する
+    uint32_t index = FindKeyframeIndex(keyframes, time, cursor);
+    float t = (time - keyframes[index].time) / (keyframes[index + 1].time - keyframes[index].time);
+    return Mathf::Slerp(keyframes[index].value, keyframes[index + 1].value, t);
 }
 
-void Animation::ApplyNodeAnimation(Model* model, WorldTransform& worldTransform, const AnimationData& animationData)
+Vector3 Animation::CalculateCompressedValue(std::span<const CompressedKeyframe> keyframes, float time, uint32_t& cursor, const Vector3& min, const Vector3& step)
 {
-    //ノードアニメーションを適用する
-    if (auto it = animationData.nodeAnimations.find(model->GetRootNode().name); it != animationData.nodeAnimations.end())
+    assert(!keyframes.empty());
+    //キーが1つか、時刻がキーフレーム前なら最初の値とする
+    if (keyframes.size() == 1 || time <= keyframes[0].time)
     {
-        //ノードアニメーションを取得
-        const NodeAnimation& rootNodeAnimation = it->second;
-        //現在のアニメーション時間に基づいて、変換、回転、スケーリングを計算
-        Vector3 translate = CalculateValue(rootNodeAnimation.translate.keyframes, animationTime_);
-        Quaternion rotate = CalculateValue(rootNodeAnimation.rotate.keyframes, animationTime_);
-        Vector3 scale = CalculateValue(rootNodeAnimation.scale.keyframes, animationTime_);
-        //計算した変換、回転、スケーリングからローカル行列を作成
-        Matrix4x4 localMatrix = Mathf::MakeAffineMatrix(scale, rotate, translate);
-        //ワールド行列にローカル行列を適用
-        worldTransform.matWorld_ = localMatrix * worldTransform.matWorld_;
+        return DecompressVector3(keyframes[0], min, step);
     }
+    //時刻が最後のキーフレーム以降なら最後の値とする
+    if (time >= keyframes.back().time)
+    {
+        return DecompressVector3(keyframes.back(), min, step);
+    }
+
+    //時刻を含む区間を探して補間する
+    uint32_t index = FindKeyframeIndex(keyframes, time, cursor);
+    float t = (time - keyframes[index].time) / static_cast<float>(keyframes[index + 1].time - keyframes[index].time);
+    return Mathf::Lerp(DecompressVector3(keyframes[index], min, step), DecompressVector3(keyframes[index + 1], min, step), t);
 }
 
-void Animation::ApplySkeletonAnimation(Model* model, const AnimationData& animationData, const Vector3& inPlaceAxis)
+Quaternion Animation::CalculateCompressedValue(std::span<const CompressedKeyframe> keyframes, float time, uint32_t& cursor)
 {
-    //スケルトンを取得
-    Model::Skeleton& skeleton = model->GetSkeleton();
+    assert(!keyframes.empty());
+    //キーが1つか、時刻がキーフレーム前なら最初の値とする
+    if (keyframes.size() == 1 || time <= keyframes[0].time)
+    {
+        return DecompressQuaternion(keyframes[0]);
+    }
+    //時刻が最後のキーフレーム以降なら最後の値とする
+    if (time >= keyframes.back().time)
+    {
+        return DecompressQuaternion(keyframes.back());
+    }
 
-    //スケルトン内の全ジョイントに対してアニメーションを適用
-    for (Model::Joint& joint : skeleton.joints)
+    //時刻を含む区間を探して補間する
+    uint32_t index = FindKeyframeIndex(keyframes, time, cursor);
+    float t = (time - keyframes[index].time) / static_cast<float>(keyframes[index + 1].time - keyframes[index].time);
+    return Mathf::Slerp(DecompressQuaternion(keyframes[index]), DecompressQuaternion(keyframes[index + 1]), t);
+}
+
+Vector3 Animation::CalculateSampledValue(std::span<const Vector3> samples, const float sampleRate, float time)
+{
+    assert(!samples.empty());
+    //時刻からサンプルの位置を直接計算する
+    const float position = std::max(time * sampleRate, 0.0f);
+    const uint32_t lastIndex = static_cast<uint32_t>(samples.size() - 1);
+    const uint32_t index = position < static_cast<float>(lastIndex) ? static_cast<uint32_t>(position) : lastIndex;
+    if (index == lastIndex)
+    {
+        return samples[lastIndex];
+    }
+    return Mathf::Lerp(samples[index], samples[index + 1], position - static_cast<float>(index));
+}
+
+Quaternion Animation::CalculateSampledValue(std::span<const Quaternion> samples, const float sampleRate, float time)
+{
+    assert(!samples.empty());
+    //時刻からサンプルの位置を直接計算する
+    const float position = std::max(time * sampleRate, 0.0f);
+    const uint32_t lastIndex = static_cast<uint32_t>(samples.size() - 1);
+    const uint32_t index = position < static_cast<float>(lastIndex) ? static_cast<uint32_t>(position) : lastIndex;
+    if (index == lastIndex)
+    {
+        return samples[lastIndex];
+    }
+    return Mathf::Slerp(samples[index], samples[index + 1], position - static_cast<float>(index));
+}
+
+std::span<const Animation::KeyframeVector3> Animation::GetKeyframes(const AnimationData& animationData, const AnimationCurve<Vector3>& curve)
+{
+    return std::span<const KeyframeVector3>(animationData.vector3Keyframes).subspan(curve.keyframeOffset, curve.keyframeCount);
+}
+
+std::span<const Animation::KeyframeQuaternion> Animation::GetKeyframes(const AnimationData& animationData, const AnimationCurve<Quaternion>& curve)
+{
+    return std::span<const KeyframeQuaternion>(animationData.quaternionKeyframes).subspan(curve.keyframeOffset, curve.keyframeCount);
+}
+
+std::span<const Animation::CompressedKeyframe> Animation::GetCompressedKeyframes(const AnimationData& animationData, const AnimationCurve<Vector3>& curve)
+{
+    return animationData.compressedVector3Keyframes.subspan(curve.keyframeOffset, curve.keyframeCount);
+}
+
+std::span<const Animation::CompressedKeyframe> Animation::GetCompressedKeyframes(const AnimationData& animationData, const AnimationCurve<Quaternion>& curve)
+{
+    return animationData.compressedQuaternionKeyframes.subspan(curve.keyframeOffset, curve.keyframeCount);
+}
+
+std::span<const Vector3> Animation::GetSamples(const AnimationData& animationData, const AnimationCurve<Vector3>& curve)
+{
+    return std::span<const Vector3>(animationData.vector3Samples).subspan(curve.sampleOffset, animationData.sampleCount);
+}
+
+std::span<const Quaternion> Animation::GetSamples(const AnimationData& animationData, const AnimationCurve<Quaternion>& curve)
+{
+    return std::span<const Quaternion>(animationData.quaternionSamples).subspan(curve.sampleOffset, animationData.sampleCount);
+}
+
+template <typename tValue>
+void Animation::ResampleCurve(const AnimationData& animationData, AnimationCurve<tValue>& curve, std::vector<tValue>& samples)
+{
+    //サンプルの先頭の位置を設定
+    curve.sampleOffset = static_cast<uint32_t>(samples.size());
+
+    //一定間隔でキーフレームから値を計算する
+    uint32_t cursor = 0;
+    for (uint32_t i = 0; i < animationData.sampleCount; ++i)
     {
-        //ジョイントの名前でアニメーションデータを検索
-        if (auto it = animationData.nodeAnimations.find(joint.name); it != animationData.nodeAnimations.end())
+        samples.push_back(CalculateValue(GetKeyframes(animationData, curve), static_cast<float>(i) / animationData.sampleRate, cursor));
+    }
+}
+
+template <typename tValue>
+void Animation::ReduceCurve(const std::vector<Keyframe<tValue>>& keyframes, AnimationCurve<tValue>& curve, const float tolerance, std::vector<Keyframe<tValue>>& result)
+{
+    //削る前のキーフレームを取得して、削った後のキーフレームの先頭の位置を設定
+    std::span<const Keyframe<tValue>> source = std::span<const Keyframe<tValue>>(keyframes).subspan(curve.keyframeOffset, curve.keyframeCount);
+    curve.keyframeOffset = static_cast<uint32_t>(result.size());
+
+    //全ての値が最初の値と許容誤差内なら一定のトラックとして1つにまとめる
+    if (std::all_of(source.begin(), source.end(), [&](const Keyframe<tValue>& keyframe) { return CalculateError(keyframe.value, source.front().value) <= tolerance; }))
+    {
+        if (!source.empty())
+        {
+            result.push_back(source.front());
+        }
+        curve.keyframeCount = static_cast<uint32_t>(source.empty() ? 0 : 1);
+        return;
+    }
+
+    //残したキーフレームから区間の終点を伸ばしていき、間のキーフレームを補間で再現できなくなったら1つ前のキーフレームを残す
+    result.push_back(source.front());
+    size_t anchor = 0;
+    for (size_t end = 2; end < source.size(); ++end)
+    {
+        const float duration = source[end].time - source[anchor].time;
+        for (size_t i = anchor + 1; i < end; ++i)
         {
-            //ノードアニメーションを取得
-            const NodeAnimation& rootNodeAnimation = it->second;
-            //現在のアニメーション時間に基づいて、変換、回転、スケーリングを計算
-            joint.translate = CalculateValue(rootNodeAnimation.translate.keyframes, animationTime_);
-            joint.rotate = CalculateValue(rootNodeAnimation.rotate.keyframes, animationTime_);
-            joint.scale = CalculateValue(rootNodeAnimation.scale.keyframes, animationTime_);
-
-            //階層のトップジョイントの場合は位置成分をリセット
-            if (joint.name.find("Root") != std::string::npos || joint.name.find("Hips") != std::string::npos)
+            const float t = duration > 0.0f ? (source[i].time - source[anchor].time) / duration : 0.0f;
+            if (CalculateError(Interpolate(source[anchor].value, source[end].value, t), source[i].value) > tolerance)
             {
-                joint.translate = {
-                    inPlaceAxis.x != 0.0f ? joint.translate.x : 0.0f,
-                    inPlaceAxis.y != 0.0f ? joint.translate.y : 0.0f,
-                    inPlaceAxis.z != 0.0f ? joint.translate.z : 0.0f
-                };
+                result.push_back(source[end - 1]);
+                anchor = end - 1;
+                break;
             }
         }
     }
+    result.push_back(source.back());
+    curve.keyframeCount = static_cast<uint32_t>(result.size()) - curve.keyframeOffset;
 }
 
-void Animation::ApplyBlendedNodeAnimation(Model* model, WorldTransform& worldTransform, const AnimationData& currentAnimationData, const Animation* blendAnimation, const float blendFactor)
+float Animation::CalculateError(const Vector3& a, const Vector3& b)
 {
-    //モデルのルートノードの名前で現在のアニメーションデータを検索
-    if (auto it = currentAnimationData.nodeAnimations.find(model->GetRootNode().name); it != currentAnimationData.nodeAnimations.end())
-    {
-        //ノードアニメーションを取得
-        const NodeAnimation& rootNodeAnimation = it->second;
-        //現在のアニメーション時間に基づいて、変換、回転、スケーリングを計算
-        Vector3 currentTranslate = CalculateValue(rootNodeAnimation.translate.keyframes, animationTime_);
-        Quaternion currentRotate = CalculateValue(rootNodeAnimation.rotate.keyframes, animationTime_);
-        Vector3 currentScale = CalculateValue(rootNodeAnimation.scale.keyframes, animationTime_);
+    return Mathf::Length(a - b);
+}
+
+float Animation::CalculateError(const Quaternion& a, const Quaternion& b)
+{
+    //同じ半球に揃えた差の長さから2つの回転の間の角度を求める（小さい角度でもacosより精度が落ちない）
+    const float sign = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w < 0.0f ? -1.0f : 1.0f;
+    const float dx = a.x - sign * b.x, dy = a.y - sign * b.y, dz = a.z - sign * b.z, dw = a.w - sign * b.w;
+    const float chord = std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+    return 4.0f * std::asin(std::min(chord * 0.5f, 1.0f));
+}
 
-        //ブレンドアニメーションが存在する場合
-        if (blendAnimation)
+Vector3 Animation::Interpolate(const Vector3& a, const Vector3& b, const float t)
+{
+    return Mathf::Lerp(a, b, t);
+}
+
+Quaternion Animation::Interpolate(const Quaternion& a, const Quaternion& b, const float t)
+{
+    return Mathf::Slerp(a, b, t);
+}
+
+Animation::CompressedKeyframe Animation::CompressKeyframe(const KeyframeVector3& keyframe, const float timeScale, const Vector3& min, const Vector3& step)
+{
+    //範囲の最小値からの段階数に変換
+    auto quantize = [](const float value, const float min, const float step) {
+        return static_cast<uint16_t>(step > 0.0f ? std::clamp(std::round((value - min) / step), 0.0f, kMaxCompressedVector3) : 0.0f);
+        };
+    CompressedKeyframe result{};
+    result.time = static_cast<uint16_t>(std::clamp(std::round(keyframe.time * timeScale), 0.0f, kMaxCompressedTime));
+    result.value = { quantize(keyframe.value.x, min.x, step.x), quantize(keyframe.value.y, min.y, step.y), quantize(keyframe.value.z, min.z, step.z) };
+    return result;
+}
+
+Animation::CompressedKeyframe Animation::CompressKeyframe(const KeyframeQuaternion& keyframe, const float timeScale)
+{
+    //正規化して絶対値が最大の成分を探す
+    const Quaternion rotate = Mathf::Normalize(keyframe.value);
+    const float components[4] = { rotate.x, rotate.y, rotate.z, rotate.w };
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i)
+    {
+        if (std::fabs(components[i]) > std::fabs(components[largest]))
         {
-            //アニメーションデータを取得
-            const AnimationData* blendAnimationData = blendAnimation->GetAnimationData();
-            //アニメーションデータが存在する場合
-            if (blendAnimationData)
-            {
-                //モデルのルートノードの名前で現在のアニメーションデータを検索
-                if (auto blendIt = blendAnimationData->nodeAnimations.find(model->GetRootNode().name); blendIt != blendAnimationData->nodeAnimations.end())
-                {
-                    //ノードアニメーションを取得
-                    const NodeAnimation& blendNodeAnimation = blendIt->second;
-                    //ブレンドアニメーションに基づいて、変換、回転、スケーリングを計算
-                    Vector3 blendTranslate = CalculateValue(blendNodeAnimation.translate.keyframes, blendAnimation->GetAnimationTime());
-                    Quaternion blendRotate = CalculateValue(blendNodeAnimation.rotate.keyframes, blendAnimation->GetAnimationTime());
-                    Vector3 blendScale = CalculateValue(blendNodeAnimation.scale.keyframes, blendAnimation->GetAnimationTime());
-
-                    //現在のアニメーションとブレンドアニメーションを補間する
-                    currentTranslate = Mathf::Lerp(currentTranslate, blendTranslate, blendFactor);
-                    currentRotate = Mathf::Slerp(currentRotate, blendRotate, blendFactor);
-                    currentScale = Mathf::Lerp(currentScale, blendScale, blendFactor);
-                }
-            }
+            largest = i;
         }
+    }
+
+    //最大の成分が正になるように符号を揃え、残りの3成分を[-1/√2, 1/√2]の範囲で15ビットに量子化する
+    const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+    CompressedKeyframe result{};
+    result.time = static_cast<uint16_t>(std::clamp(std::round(keyframe.time * timeScale), 0.0f, kMaxCompressedTime));
+    uint32_t index = 0;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        if (i == largest) continue;
+        const float normalized = std::clamp(components[i] * sign * std::numbers::sqrt2_v<float>, -1.0f, 1.0f);
+        result.value[index++] = static_cast<uint16_t>(std::round((normalized * 0.5f + 0.5f) * kMaxCompressedQuaternion));
+    }
+
+    //除いた成分の番号を1、2番目の上位ビットに入れる
+    result.value[0] |= static_cast<uint16_t>((largest >> 1) << 15);
+    result.value[1] |= static_cast<uint16_t>((largest & 1) << 15);
+    return result;
+}
+
+Vector3 Animation::DecompressVector3(const CompressedKeyframe& keyframe, const Vector3& min, const Vector3& step)
+{
+    return {
+        min.x + static_cast<float>(keyframe.value[0]) * step.x,
+        min.y + static_cast<float>(keyframe.value[1]) * step.y,
+        min.z + static_cast<float>(keyframe.value[2]) * step.z,
+    };
+}
+
+Quaternion Animation::DecompressQuaternion(const CompressedKeyframe& keyframe)
+{
+    //除いた成分の番号を取り出す
+    const uint32_t largest = ((keyframe.value[0] >> 15) << 1) | (keyframe.value[1] >> 15);
+
+    //残りの3成分を復元し、除いた成分は長さが1になるように求める
+    float components[4]{};
+    float lengthSq = 0.0f;
+    uint32_t index = 0;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        if (i == largest) continue;
+        const float normalized = static_cast<float>(keyframe.value[index++] & 0x7FFF) / kMaxCompressedQuaternion * 2.0f - 1.0f;
+        components[i] = normalized / std::numbers::sqrt2_v<float>;
+        lengthSq += components[i] * components[i];
+    }
+    components[largest] = std::sqrt(std::max(1.0f - lengthSq, 0.0f));
+    return { components[0], components[1], components[2], components[3] };
+}
 
-        //計算した変換、回転、スケーリングからローカル行列を作成
-        Matrix4x4 localMatrix = Mathf::MakeAffineMatrix(currentScale, currentRotate, currentTranslate);
+void Animation::CalculateNodeTransform(const AnimationData& animationData, const uint32_t channelIndex, Vector3& translate, Quaternion& rotate, Vector3& scale)
+{
+    //ノードアニメーションを取得
+    const NodeAnimation& nodeAnimation = animationData.nodeAnimations[channelIndex];
 
-        //ワールド行列にローカル行列を適用
-        worldTransform.matWorld_ = localMatrix * worldTransform.matWorld_;
+    //再サンプリングしている場合はサンプルから計算する
+    if (animationData.sampleCount > 0)
+    {
+        translate = CalculateSampledValue(GetSamples(animationData, nodeAnimation.translate), animationData.sampleRate, animationTime_);
+        rotate = CalculateSampledValue(GetSamples(animationData, nodeAnimation.rotate), animationData.sampleRate, animationTime_);
+        scale = CalculateSampledValue(GetSamples(animationData, nodeAnimation.scale), animationData.sampleRate, animationTime_);
+        return;
     }
+
+    //チャンネルのカーソルを使ってキーフレームから計算する
+    uint32_t* cursors = &keyframeCursors_[channelIndex * 3];
+
+    //圧縮している場合は量子化した時間で量子化したキーフレームから計算する
+    if (animationData.isCompressed)
+    {
+        const float compressedTime = animationData.duration > 0.0f ? animationTime_ * (kMaxCompressedTime / animationData.duration) : 0.0f;
+        translate = CalculateCompressedValue(GetCompressedKeyframes(animationData, nodeAnimation.translate), compressedTime, cursors[0], animationData.translateMin, animationData.translateStep);
+        rotate = CalculateCompressedValue(GetCompressedKeyframes(animationData, nodeAnimation.rotate), compressedTime, cursors[1]);
+        scale = CalculateCompressedValue(GetCompressedKeyframes(animationData, nodeAnimation.scale), compressedTime, cursors[2], animationData.scaleMin, animationData.scaleStep);
+        return;
+    }
+
+    translate = CalculateValue(GetKeyframes(animationData, nodeAnimation.translate), animationTime_, cursors[0]);
+    rotate = CalculateValue(GetKeyframes(animationData, nodeAnimation.rotate), animationTime_, cursors[1]);
+    scale = CalculateValue(GetKeyframes(animationData, nodeAnimation.scale), animationTime_, cursors[2]);
 }
 
-void Animation::ApplyBlendedSkeletonAnimation(Model* model, const AnimationData& currentAnimationData, const Animation* blendAnimation, const float blendFactor, const Vector3& inPlaceAxis)
+void Animation::ApplySkeletonAnimation(Model* model, const AnimationData& animationData, const Vector3& inPlaceAxis)
 {
     //スケルトンを取得
     Model::Skeleton& skeleton = model->GetSkeleton();
+    //ジョイントとチャンネルの対応を取得
+    const SkeletonBinding& binding = GetSkeletonBinding(model, animationIndex_);
 
     //スケルトン内の全ジョイントに対してアニメーションを適用
-    for (Model::Joint& joint : skeleton.joints)
+    for (size_t jointIndex = 0; jointIndex < skeleton.joints.size(); ++jointIndex)
     {
-        //ジョイントの名前で現在のアニメーションデータを検索
-        if (auto it = currentAnimationData.nodeAnimations.find(joint.name); it != currentAnimationData.nodeAnimations.end())
-        {
-            //ノードアニメーションを取得
-            const NodeAnimation& rootNodeAnimation = it->second;
-            //現在のアニメーション時間に基づいて、変換、回転、スケーリングを計算
-            Vector3 currentTranslate = CalculateValue(rootNodeAnimation.translate.keyframes, animationTime_);
-            Quaternion currentRotate = CalculateValue(rootNodeAnimation.rotate.keyframes, animationTime_);
-            Vector3 currentScale = CalculateValue(rootNodeAnimation.scale.keyframes, animationTime_);
-
-            //ブレンドアニメーションが存在する場合
-            if (blendAnimation)
-            {
-                //アニメーションデータを取得
-                const AnimationData* blendAnimationData = blendAnimation->GetAnimationData();
-                //アニメーションデータが存在する場合
-                if (blendAnimationData)
-                {
-                    //モデルのルートノードの名前で現在のアニメーションデータを検索
-                    if (auto blendIt = blendAnimationData->nodeAnimations.find(joint.name); blendIt != blendAnimationData->nodeAnimations.end())
-                    {
-                        //ノードアニメーションを取得
-                        const NodeAnimation& blendNodeAnimation = blendIt->second;
-                        //ブレンドアニメーションに基づいて、変換、回転、スケーリングを計算
-                        Vector3 blendTranslate = CalculateValue(blendNodeAnimation.translate.keyframes, blendAnimation->GetAnimationTime());
-                        Quaternion blendRotate = CalculateValue(blendNodeAnimation.rotate.keyframes, blendAnimation->GetAnimationTime());
-                        Vector3 blendScale = CalculateValue(blendNodeAnimation.scale.keyframes, blendAnimation->GetAnimationTime());
-
-                        //現在のアニメーションとブレンドアニメーションを補間する
-                        currentTranslate = Mathf::Lerp(currentTranslate, blendTranslate, blendFactor);
-                        currentRotate = Mathf::Slerp(currentRotate, blendRotate, blendFactor);
-                        currentScale = Mathf::Lerp(currentScale, blendScale, blendFactor);
-                    }
-                }
-            }
+        //ジョイントに対応するチャンネルがない場合は飛ばす
+        const int32_t channelIndex = binding.jointChannels[jointIndex];
+        if (channelIndex < 0) continue;
 
-            //ジョイントの変換を更新する
-            joint.translate = currentTranslate;
-            joint.rotate = currentRotate;
-            joint.scale = currentScale;
+        //現在のアニメーション時間に基づいて、変換、回転、スケーリングを計算
+        Model::Joint& joint = skeleton.joints[jointIndex];
+        CalculateNodeTransform(animationData, channelIndex, joint.translate, joint.rotate, joint.scale);
 
-            //階層のトップジョイントの場合は位置成分をリセット
-            if (joint.name.find("Root") != std::string::npos || joint.name.find("Hips") != std::string::npos)
-            {
-                joint.translate = {
-                    inPlaceAxis.x != 0.0f ? joint.translate.x : 0.0f,
-                    inPlaceAxis.y != 0.0f ? joint.translate.y : 0.0f,
-                    inPlaceAxis.z != 0.0f ? joint.translate.z : 0.0f
-                };
-            }
+        //階層のトップジョイントの場合は位置成分をリセット
+        if (binding.isInPlaceJoints[jointIndex])
+        {
+            joint.translate = {
+                inPlaceAxis.x != 0.0f ? joint.translate.x : 0.0f,
+                inPlaceAxis.y != 0.0f ? joint.translate.y : 0.0f,
+                inPlaceAxis.z != 0.0f ? joint.translate.z : 0.0f
+            };
         }
     }
-}
\ No newline at end of file
+}
+
+void Animation::ApplyBlendedSkeletonAnimation(Model* model, Animation* blendAnimation, const float blendFactor, const Vector3& inPlaceAxis)
+{
+    //スケルトンを取得
+    Model::Skeleton& skeleton = model->GetSkeleton();
+
+    //現在のスケルトンの姿勢を初期値として現在のアニメーションの姿勢を求める
+    currentPose_.CopyFromSkeleton(skeleton);
+    SamplePose(model, currentPose_, inPlaceAxis);
+
+    //ブレンドアニメーションのアニメーションデータが存在する場合
+    if (blendAnimation && blendAnimation->GetAnimationData())
+    {
+        //現在の姿勢を初期値としてブレンドアニメーションの姿勢を求める（チャンネルのないジョイントは現在の姿勢のまま）
+        blendPose_.Copy(currentPose_);
+        blendAnimation->SamplePose(model, blendPose_, inPlaceAxis);
+
+        //現在のアニメーションとブレンドアニメーションを補間する
+        currentPose_.Blend(currentPose_, blendPose_, blendFactor);
+    }
+
+    //ジョイントの変換を更新する
+    currentPose_.ApplyToSkeleton(skeleton);
+}
@@ -7,8 +7,14 @@
 
 #pragma once
 #include "Model.h"
+#include "AnimationPose.h"
+#include <array>
 #include <map>
+#include <memory>
 #include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -25,11 +31,25 @@ public:
 	using KeyframeVector3 = Keyframe<Vector3>;
 	using KeyframeQuaternion = Keyframe<Quaternion>;
 
-	//AnimationCurve構造体
+	//量子化したKeyframe構造体（時間と値の各成分を16ビットで持つ）
+	struct CompressedKeyframe
+	{
+		//尺を65535等分した時間
+		uint16_t time;
+		//移動とスケールはクリップの範囲で量子化した値、回転は最大の成分を除いた3成分を15ビットずつ（1、2番目の上位ビットに除いた成分の番号）
+		std::array<uint16_t, 3> value;
+	};
+
+	//AnimationCurve構造体（キーフレームはアニメーションデータにまとめて保持し、範囲で参照する）
 	template <typename tValue>
 	struct AnimationCurve
 	{
-		std::vector<Keyframe<tValue>> keyframes;
+		//キーフレームの先頭の位置
+		uint32_t keyframeOffset = 0;
+		//キーフレームの数
+		uint32_t keyframeCount = 0;
+		//再サンプリングした値の先頭の位置
+		uint32_t sampleOffset = 0;
 	};
 
 	//NodeAnimation構造体
@@ -40,22 +60,84 @@ public:
 		AnimationCurve<Vector3> scale;
 	};
 
-	//Animation構造体
+	//Animation構造体（読み込み後は変更せず、同じファイルを使うアニメーションで共有する）
 	struct AnimationData 
 	{
 		//アニメーションの名前
 		std::string name;
 		//アニメーション全体の尺(単位は秒)
 		float duration;
-		//NodeAnimationの集合。Node名でひけるようにしておく
-		std::map<std::string, NodeAnimation> nodeAnimations;
+		//Node名のハッシュからチャンネルの番号をひけるようにしておく
+		std::unordered_map<uint32_t, uint32_t> channelIndices;
+		//NodeAnimationの配列（チャンネルの番号で引く）
+		std::vector<NodeAnimation> nodeAnimations;
+		//全てのチャンネルのキーフレーム（移動とスケール、回転）
+		std::vector<KeyframeVector3> vector3Keyframes;
+		std::vector<KeyframeQuaternion> quaternionKeyframes;
+		//圧縮したかどうか（圧縮した場合は量子化したキーフレームを使い、キーフレームは空になる）
+		bool isCompressed = false;
+		//全てのチャンネルの量子化したキーフレーム（移動とスケール、回転）
+		std::span<const CompressedKeyframe> compressedVector3Keyframes;
+		std::span<const CompressedKeyframe> compressedQuaternionKeyframes;
+		//量子化したキーフレームの保持先（圧縮した配列またはマップしたファイル、コピーしても共有される）
+		std::shared_ptr<const void> compressedStorage;
+		//移動とスケールを量子化した範囲の最小値と1段階あたりの大きさ
+		Vector3 translateMin{};
+		Vector3 translateStep{};
+		Vector3 scaleMin{};
+		Vector3 scaleStep{};
+		//再サンプリングしたレート（0の場合は再サンプリングしていない）
+		float sampleRate = 0.0f;
+		//1つのカーブあたりのサンプル数
+		uint32_t sampleCount = 0;
+		//全てのチャンネルの再サンプリングした値（移動とスケール、回転）
+		std::vector<Vector3> vector3Samples;
+		std::vector<Quaternion> quaternionSamples;
+	};
+
+	//モデルのジョイントとアニメーションのチャンネルの対応
+	struct SkeletonBinding
+	{
+		//バインドしたモデル
+		const Model* model = nullptr;
+		//バインドしたアニメーションの番号
+		int32_t animationIndex = -1;
+		//ルートノードのチャンネルの番号（ない場合は-1）
+		int32_t rootNodeChannel = -1;
+		//ジョイントごとのチャンネルの番号（ない場合は-1）
+		std::vector<int32_t> jointChannels;
+		//ジョイントごとの位置成分を固定するかどうか
+		std::vector<bool> isInPlaceJoints;
 	};
 
 	/// <summary>
 	/// 初期化
 	/// </summary>
+	/// <param name="animationDatas">共有するアニメーションデータ</param>
+	void Initialize(const std::shared_ptr<const std::vector<AnimationData>>& animationDatas);
+
+	/// <summary>
+	/// アニメーションデータを一定間隔で再サンプリングする（キーフレームの検索が不要になる）
+	/// </summary>
+	/// <param name="animationData">アニメーションデータ</param>
+	/// <param name="sampleRate">1秒あたりのサンプル数（0以下の場合は再サンプリングを解除）</param>
+	static void Resample(AnimationData& animationData, const float sampleRate);
+
+	/// <summary>
+	/// アニメーションデータを圧縮する（許容誤差内で補間できるキーフレームと一定のトラックを削り、時間と値を量子化する）
+	/// </summary>
 	/// <param name="animationData">アニメーションデータ</param>
-	void Initialize(const std::vector<AnimationData>& animationData);
+	/// <param name="translateTolerance">移動の許容誤差</param>
+	/// <param name="rotateTolerance">回転の許容誤差（ラジアン）</param>
+	/// <param name="scaleTolerance">スケールの許容誤差</param>
+	static void Compress(AnimationData& animationData, const float translateTolerance = 0.001f, const float rotateTolerance = 0.0005f, const float scaleTolerance = 0.0001f);
+
+	/// <summary>
+	/// Node名のハッシュを計算（チャンネルの検索とベイクしたファイルで使う）
+	/// </summary>
+	/// <param name="name">Node名</param>
+	/// <returns>ハッシュ</returns>
+	static uint32_t HashName(const std::string_view name);
 
 	/// <summary>
 	/// アニメーションの時間を更新
@@ -80,6 +162,24 @@ public:
 	/// <param name="inPlaceAxis">動かす軸</param>
 	void ApplyBlendAnimation(Model* model, WorldTransform& worldTransform, Animation* animation, const float blendFactor, const Vector3& inPlaceAxis = { 1.0f, 1.0f, 1.0f });
 
+	/// <summary>
+	/// 現在のアニメーション時間の姿勢を姿勢バッファに書き込む（チャンネルのないジョイントは書き込まない）
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="pose">書き込み先の姿勢</param>
+	/// <param name="inPlaceAxis">動かす軸</param>
+	void SamplePose(Model* model, AnimationPose& pose, const Vector3& inPlaceAxis = { 1.0f, 1.0f, 1.0f });
+
+	/// <summary>
+	/// 現在のアニメーション時間のルートノードのローカル行列を計算（ワールド行列には適用しない）
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="blendAnimation">ブレンドするアニメーション（ブレンドしない場合はnullptr）</param>
+	/// <param name="blendFactor">ブレンド係数</param>
+	/// <param name="localMatrix">ローカル行列の書き込み先</param>
+	/// <returns>ルートノードのアニメーションがあるかどうか</returns>
+	const bool CalculateRootNodeMatrix(Model* model, Animation* blendAnimation, const float blendFactor, Matrix4x4& localMatrix);
+
 	/// <summary>
 	/// アニメーションを再生
 	/// </summary>
@@ -132,65 +232,258 @@ public:
 	const AnimationData* GetAnimationData() const;
 
 private:
+	/// <summary>
+	/// アニメーションの名前からアニメーションの番号を探す
+	/// </summary>
+	/// <param name="animationName">アニメーションの名前</param>
+	/// <returns>アニメーションの番号（ない場合は-1）</returns>
+	const int32_t FindAnimationIndex(const std::string& animationName) const;
+
+	/// <summary>
+	/// モデルのジョイントとアニメーションのチャンネルの対応を取得（初回のみ名前で検索して作成する）
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="animationIndex">アニメーションの番号</param>
+	/// <returns>ジョイントとチャンネルの対応</returns>
+	const SkeletonBinding& GetSkeletonBinding(Model* model, const int32_t animationIndex);
+
+	//カーソルから前に進めて探すキーフレームの最大数（超えた場合は二分探索する）
+	static const uint32_t kMaxCursorSteps = 4;
+
+	//量子化した時間と値の最大値（回転の成分は15ビット）
+	static constexpr float kMaxCompressedTime = 65535.0f;
+	static constexpr float kMaxCompressedVector3 = 65535.0f;
+	static constexpr float kMaxCompressedQuaternion = 32767.0f;
+
+	/// <summary>
+	/// 時刻を含むキーフレームの区間を探す
+	/// </summary>
+	/// <param name="keyframes">キーフレーム（量子化したキーフレームの場合は時間も量子化した値で渡す）</param>
+	/// <param name="time">アニメーションの時間</param>
+	/// <param name="cursor">前回の区間（探した区間で更新される）</param>
+	/// <returns>区間の先頭のキーフレームの番号</returns>
+	template <typename tKeyframe>
+	static uint32_t FindKeyframeIndex(std::span<const tKeyframe> keyframes, const float time, uint32_t& cursor);
+
 	/// <summary>
 	/// キーフレームを基に値を計算（Vector3）
 	/// </summary>
 	/// <param name="keyframes">キーフレーム</param>
 	/// <param name="time">アニメーションの時間</param>
+	/// <param name="cursor">前回の区間</param>
 	/// <returns>計算された値</returns>
-	Vector3 CalculateValue(const std::vector<KeyframeVector3>& keyframes, float time);
+	static Vector3 CalculateValue(std::span<const KeyframeVector3> keyframes, float time, uint32_t& cursor);
 
 	/// <summary>
 	/// キーフレームを基に値を計算（Quaternion）
 	/// </summary>
 	/// <param name="keyframes">キーフレーム</param>
 	/// <param name="time">アニメーションの時間</param>
+	/// <param name="cursor">前回の区間</param>
 	/// <returns>計算された値</returns>
-	Quaternion CalculateValue(const std::vector<KeyframeQuaternion>& keyframes, float time);
+	static Quaternion CalculateValue(std::span<const KeyframeQuaternion> keyframes, float time, uint32_t& cursor);
 
 	/// <summary>
-	/// ノードアニメーションを適用
+	/// 量子化したキーフレームを基に値を計算（Vector3）
+	/// </summary>
+	/// <param name="keyframes">量子化したキーフレーム</param>
+	/// <param name="time">量子化したアニメーションの時間</param>
+	/// <param name="cursor">前回の区間</param>
+	/// <param name="min">量子化した範囲の最小値</param>
+	/// <param name="step">量子化した1段階あたりの大きさ</param>
+	/// <returns>計算された値</returns>
+	static Vector3 CalculateCompressedValue(std::span<const CompressedKeyframe> keyframes, float time, uint32_t& cursor, const Vector3& min, const Vector3& step);
+
+	/// <summary>
+	/// 量子化したキーフレームを基に値を計算（Quaternion）
+	/// </summary>
+	/// <param name="keyframes">量子化したキーフレーム</param>
+	/// <param name="time">量子化したアニメーションの時間</param>
+	/// <param name="cursor">前回の区間</param>
+	/// <returns>計算された値</returns>
+	static Quaternion CalculateCompressedValue(std::span<const CompressedKeyframe> keyframes, float time, uint32_t& cursor);
+
+	/// <summary>
+	/// 再サンプリングした値を基に値を計算（Vector3）
+	/// </summary>
+	/// <param name="samples">再サンプリングした値</param>
+	/// <param name="sampleRate">1秒あたりのサンプル数</param>
+	/// <param name="time">アニメーションの時間</param>
+	/// <returns>計算された値</returns>
+	static Vector3 CalculateSampledValue(std::span<const Vector3> samples, const float sampleRate, float time);
+
+	/// <summary>
+	/// 再サンプリングした値を基に値を計算（Quaternion）
+	/// </summary>
+	/// <param name="samples">再サンプリングした値</param>
+	/// <param name="sampleRate">1秒あたりのサンプル数</param>
+	/// <param name="time">アニメーションの時間</param>
+	/// <returns>計算された値</returns>
+	static Quaternion CalculateSampledValue(std::span<const Quaternion> samples, const float sampleRate, float time);
+
+	/// <summary>
+	/// カーブのキーフレームを取得（Vector3）
 	/// </summary>
-	/// <param name="model">モデル</param>
-	/// <param name="worldTransform">ワールドトランスフォーム</param>
 	/// <param name="animationData">アニメーションデータ</param>
-	void ApplyNodeAnimation(Model* model, WorldTransform& worldTransform, const AnimationData& animationData);
+	/// <param name="curve">アニメーションカーブ</param>
+	/// <returns>キーフレーム</returns>
+	static std::span<const KeyframeVector3> GetKeyframes(const AnimationData& animationData, const AnimationCurve<Vector3>& curve);
 
 	/// <summary>
-	/// スケルトンアニメーションを適用
+	/// カーブのキーフレームを取得（Quaternion）
 	/// </summary>
-	/// <param name="model">モデル</param>
 	/// <param name="animationData">アニメーションデータ</param>
-	/// <param name="inPlaceAxis">動かす軸</param>
-	void ApplySkeletonAnimation(Model* model, const AnimationData& animationData, const Vector3& inPlaceAxis);
+	/// <param name="curve">アニメーションカーブ</param>
+	/// <returns>キーフレーム</returns>
+	static std::span<const KeyframeQuaternion> GetKeyframes(const AnimationData& animationData, const AnimationCurve<Quaternion>& curve);
+
+	/// <summary>
+	/// カーブの量子化したキーフレームを取得（Vector3）
+	/// </summary>
+	/// <param name="animationData">アニメーションデータ</param>
+	/// <param name="curve">アニメーションカーブ</param>
+	/// <returns>量子化したキーフレーム</returns>
+	static std::span<const CompressedKeyframe> GetCompressedKeyframes(const AnimationData& animationData, const AnimationCurve<Vector3>& curve);
+
+	/// <summary>
+	/// カーブの量子化したキーフレームを取得（Quaternion）
+	/// </summary>
+	/// <param name="animationData">アニメーションデータ</param>
+	/// <param name="curve">アニメーションカーブ</param>
+	/// <returns>量子化したキーフレーム</returns>
+	static std::span<const CompressedKeyframe> GetCompressedKeyframes(const AnimationData& animationData, const AnimationCurve<Quaternion>& curve);
+
+	/// <summary>
+	/// カーブの再サンプリングした値を取得（Vector3）
+	/// </summary>
+	/// <param name="animationData">アニメーションデータ</param>
+	/// <param name="curve">アニメーションカーブ</param>
+	/// <returns>再サンプリングした値</returns>
+	static std::span<const Vector3> GetSamples(const AnimationData& animationData, const AnimationCurve<Vector3>& curve);
+
+	/// <summary>
+	/// カーブの再サンプリングした値を取得（Quaternion）
+	/// </summary>
+	/// <param name="animationData">アニメーションデータ</param>
+	/// <param name="curve">アニメーションカーブ</param>
+	/// <returns>再サンプリングした値</returns>
+	static std::span<const Quaternion> GetSamples(const AnimationData& animationData, const AnimationCurve<Quaternion>& curve);
+
+	/// <summary>
+	/// アニメーションカーブを再サンプリング
+	/// </summary>
+	/// <param name="animationData">アニメーションデータ</param>
+	/// <param name="curve">アニメーションカーブ</param>
+	/// <param name="samples">再サンプリングした値の書き込み先</param>
+	template <typename tValue>
+	static void ResampleCurve(const AnimationData& animationData, AnimationCurve<tValue>& curve, std::vector<tValue>& samples);
+
+	/// <summary>
+	/// 許容誤差内で前後のキーフレームから補間できるキーフレームを削る（全て同じ値の場合は1つにする）
+	/// </summary>
+	/// <param name="keyframes">削る前のキーフレーム</param>
+	/// <param name="curve">アニメーションカーブ（削った後のキーフレームの範囲に更新される）</param>
+	/// <param name="tolerance">許容誤差</param>
+	/// <param name="result">削った後のキーフレームの書き込み先</param>
+	template <typename tValue>
+	static void ReduceCurve(const std::vector<Keyframe<tValue>>& keyframes, AnimationCurve<tValue>& curve, const float tolerance, std::vector<Keyframe<tValue>>& result);
+
+	/// <summary>
+	/// 2つの値の誤差を計算（Vector3は距離、Quaternionは角度）
+	/// </summary>
+	/// <param name="a">値</param>
+	/// <param name="b">値</param>
+	/// <returns>誤差</returns>
+	static float CalculateError(const Vector3& a, const Vector3& b);
+	static float CalculateError(const Quaternion& a, const Quaternion& b);
 
 	/// <summary>
-	/// ブレンドしたノードアニメーションを適用
+	/// 2つの値を補間（Vector3は線形補間、Quaternionは球面線形補間）
+	/// </summary>
+	/// <param name="a">値</param>
+	/// <param name="b">値</param>
+	/// <param name="t">補間係数</param>
+	/// <returns>補間した値</returns>
+	static Vector3 Interpolate(const Vector3& a, const Vector3& b, const float t);
+	static Quaternion Interpolate(const Quaternion& a, const Quaternion& b, const float t);
+
+	/// <summary>
+	/// キーフレームを量子化（Vector3）
+	/// </summary>
+	/// <param name="keyframe">キーフレーム</param>
+	/// <param name="timeScale">時間を量子化する倍率</param>
+	/// <param name="min">量子化する範囲の最小値</param>
+	/// <param name="step">量子化する1段階あたりの大きさ</param>
+	/// <returns>量子化したキーフレーム</returns>
+	static CompressedKeyframe CompressKeyframe(const KeyframeVector3& keyframe, const float timeScale, const Vector3& min, const Vector3& step);
+
+	/// <summary>
+	/// キーフレームを量子化（Quaternion、最大の成分を除いた3成分を保存する）
+	/// </summary>
+	/// <param name="keyframe">キーフレーム</param>
+	/// <param name="timeScale">時間を量子化する倍率</param>
+	/// <returns>量子化したキーフレーム</returns>
+	static CompressedKeyframe CompressKeyframe(const KeyframeQuaternion& keyframe, const float timeScale);
+
+	/// <summary>
+	/// 量子化した値を復元（Vector3）
+	/// </summary>
+	/// <param name="keyframe">量子化したキーフレーム</param>
+	/// <param name="min">量子化した範囲の最小値</param>
+	/// <param name="step">量子化した1段階あたりの大きさ</param>
+	/// <returns>復元した値</returns>
+	static Vector3 DecompressVector3(const CompressedKeyframe& keyframe, const Vector3& min, const Vector3& step);
+
+	/// <summary>
+	/// 量子化した値を復元（Quaternion）
+	/// </summary>
+	/// <param name="keyframe">量子化したキーフレーム</param>
+	/// <returns>復元した値</returns>
+	static Quaternion DecompressQuaternion(const CompressedKeyframe& keyframe);
+
+	/// <summary>
+	/// 現在のアニメーション時間でノードの変換、回転、スケーリングを計算
+	/// </summary>
+	/// <param name="animationData">アニメーションデータ</param>
+	/// <param name="channelIndex">チャンネルの番号</param>
+	/// <param name="translate">変換</param>
+	/// <param name="rotate">回転</param>
+	/// <param name="scale">スケーリング</param>
+	void CalculateNodeTransform(const AnimationData& animationData, const uint32_t channelIndex, Vector3& translate, Quaternion& rotate, Vector3& scale);
+
+	/// <summary>
+	/// スケルトンアニメーションを適用
 	/// </summary>
 	/// <param name="model">モデル</param>
-	/// <param name="worldTransform">ワールドトランスフォーム</param>
-	/// <param name="currentAnimationData">現在のアニメーションデータ</param>
-	/// <param name="blendAnimation">ブレンドするアニメーションデータ</param>
-	/// <param name="blendFactor">ブレンド係数</param>
-	void ApplyBlendedNodeAnimation(Model* model, WorldTransform& worldTransform, const AnimationData& currentAnimationData, const Animation* blendAnimation, const float blendFactor);
+	/// <param name="animationData">アニメーションデータ</param>
+	/// <param name="inPlaceAxis">動かす軸</param>
+	void ApplySkeletonAnimation(Model* model, const AnimationData& animationData, const Vector3& inPlaceAxis);
 
 	/// <summary>
 	/// ブレンドしたスケルトンアニメーションを適用
 	/// </summary>
 	/// <param name="model">モデル</param>
-	/// <param name="worldTransform">ワールドトランスフォーム</param>
-	/// <param name="currentAnimationData">現在のアニメーションデータ</param>
 	/// <param name="blendAnimation">ブレンドするアニメーションデータ</param>
 	/// <param name="blendFactor">ブレンド係数</param>
 	/// <param name="inPlaceAxis">動かす軸</param>
-	void ApplyBlendedSkeletonAnimation(Model* model, const AnimationData& currentAnimationData, const Animation* blendAnimation, const float blendFactor, const Vector3& inPlaceAxis);
+	void ApplyBlendedSkeletonAnimation(Model* model, Animation* blendAnimation, const float blendFactor, const Vector3& inPlaceAxis);
 
 private:
-	//アニメーションデータ
-	std::vector<AnimationData> animationDatas_{};
+	//アニメーションデータ（AnimationManagerが読み込んだものを共有する）
+	std::shared_ptr<const std::vector<AnimationData>> animationDatas_ = nullptr;
+
+	//モデルごとのジョイントとチャンネルの対応
+	std::vector<SkeletonBinding> skeletonBindings_{};
+
+	//再生中のアニメーションの番号（ない場合は-1）
+	int32_t animationIndex_ = -1;
+
+	//ブレンドに使う姿勢バッファ（現在のアニメーション、ブレンドするアニメーション）
+	AnimationPose currentPose_{};
+	AnimationPose blendPose_{};
 
-	//アニメーションの名前
-	std::string animationName_{};
+	//チャンネルごとの前回のキーフレームの区間（移動、回転、スケールの順に3つずつ）
+	std::vector<uint32_t> keyframeCursors_{};
 
 	//アニメーションを停止させるかどうか
 	bool stop_ = false;
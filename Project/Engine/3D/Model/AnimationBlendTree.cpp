@@ -0,0 +1,303 @@
+/**
+ * @file AnimationBlendTree.cpp
+ * @brief 複数のアニメーションを姿勢バッファ上で合成するブレンドツリー
+ * @author 青木智滉
+ * @date
+ */
+
+#include "AnimationBlendTree.h"
+#include "Engine/Math/MathFunction.h"
+#include "Engine/Utilities/GameTimer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+int32_t AnimationBlendTree::AddClipNode(Animation* animation)
+{
+	//ノードを追加
+	Node& node = nodes_.emplace_back();
+	node.type = NodeType::kClip;
+	node.animation = animation;
+
+	//ツリーで使うアニメーションに追加
+	if (animation && std::find(animations_.begin(), animations_.end(), animation) == animations_.end())
+	{
+		animations_.push_back(animation);
+	}
+
+	return static_cast<int32_t>(nodes_.size() - 1);
+}
+
+int32_t AnimationBlendTree::AddBlend1DNode(const std::string& parameterName, std::vector<std::pair<int32_t, float>> children, const bool isSynchronized)
+{
+	//閾値の昇順に並べる
+	std::sort(children.begin(), children.end(), [](const auto& a, const auto& b) { return a.second < b.second; });
+
+	//ノードを追加
+	Node& node = nodes_.emplace_back();
+	node.type = NodeType::kBlend1D;
+	node.parameterName = parameterName;
+	node.isSynchronized = isSynchronized;
+	for (const auto& [child, threshold] : children)
+	{
+		node.children.push_back(child);
+		node.thresholds.push_back(threshold);
+	}
+
+	return static_cast<int32_t>(nodes_.size() - 1);
+}
+
+int32_t AnimationBlendTree::AddLayerNode(const int32_t baseNode, const int32_t layerNode, const std::string& weightParameterName, const std::vector<float>& jointWeights)
+{
+	//ノードを追加
+	Node& node = nodes_.emplace_back();
+	node.type = NodeType::kLayer;
+	node.children = { baseNode, layerNode };
+	node.parameterName = weightParameterName;
+	node.jointWeights = jointWeights;
+	return static_cast<int32_t>(nodes_.size() - 1);
+}
+
+int32_t AnimationBlendTree::AddAdditiveNode(const int32_t baseNode, const int32_t additiveNode, const int32_t referenceNode, const std::string& weightParameterName)
+{
+	//ノードを追加
+	Node& node = nodes_.emplace_back();
+	node.type = NodeType::kAdditive;
+	node.children = { baseNode, additiveNode, referenceNode };
+	node.parameterName = weightParameterName;
+	return static_cast<int32_t>(nodes_.size() - 1);
+}
+
+void AnimationBlendTree::UpdateAnimationTime()
+{
+	//全てのアニメーションの時間を進める
+	for (Animation* animation : animations_)
+	{
+		animation->UpdateAnimationTime();
+	}
+
+	//再生位置を揃える1Dブレンドの子の時間を上書きする
+	for (Node& node : nodes_)
+	{
+		if (node.type == NodeType::kBlend1D && node.isSynchronized)
+		{
+			SynchronizeBlend1DNode(node);
+		}
+	}
+}
+
+void AnimationBlendTree::Evaluate(Model* model, AnimationPose& pose, const Vector3& inPlaceAxis)
+{
+	//ルートノードがない場合は何もしない
+	if (rootNode_ < 0) return;
+
+	//ルートノードから評価する
+	EvaluateNode(rootNode_, model, pose, inPlaceAxis, 0);
+}
+
+void AnimationBlendTree::PlayAnimation(const float speed, const bool loop)
+{
+	//速度とループフラグを設定
+	animationSpeed_ = speed;
+	loop_ = loop;
+	stop_ = false;
+	pause_ = false;
+
+	//全てのアニメーションを最初から再生
+	for (Animation* animation : animations_)
+	{
+		animation->PlayAnimation(speed, loop);
+	}
+
+	//揃えた再生位置をリセット
+	for (Node& node : nodes_)
+	{
+		node.normalizedTime = 0.0f;
+	}
+}
+
+void AnimationBlendTree::StopAnimation()
+{
+	stop_ = true;
+	pause_ = false;
+	for (Animation* animation : animations_)
+	{
+		animation->StopAnimation();
+	}
+}
+
+void AnimationBlendTree::PauseAnimation()
+{
+	pause_ = true;
+	for (Animation* animation : animations_)
+	{
+		animation->PauseAnimation();
+	}
+}
+
+void AnimationBlendTree::ResumeAnimation()
+{
+	pause_ = false;
+	for (Animation* animation : animations_)
+	{
+		animation->ResumeAnimation();
+	}
+}
+
+const bool AnimationBlendTree::GetIsAnimationFinished() const
+{
+	return std::all_of(animations_.begin(), animations_.end(), [](const Animation* animation) { return animation->GetIsAnimationFinished(); });
+}
+
+const float AnimationBlendTree::GetParameter(const std::string& name) const
+{
+	auto it = parameters_.find(name);
+	return it != parameters_.end() ? it->second : 0.0f;
+}
+
+void AnimationBlendTree::EvaluateNode(const int32_t nodeIndex, Model* model, AnimationPose& pose, const Vector3& inPlaceAxis, const uint32_t depth)
+{
+	const Node& node = nodes_[nodeIndex];
+	switch (node.type)
+	{
+	case NodeType::kClip:
+	{
+		//アニメーションの姿勢を書き込む
+		if (node.animation)
+		{
+			node.animation->SamplePose(model, pose, inPlaceAxis);
+		}
+		break;
+	}
+	case NodeType::kBlend1D:
+	{
+		//子がない場合は何もしない
+		if (node.children.empty()) break;
+
+		//補間する区間を求めて、区間の先頭の子を評価
+		float blendFactor = 0.0f;
+		const uint32_t segment = FindBlend1DSegment(node, blendFactor);
+		EvaluateNode(node.children[segment], model, pose, inPlaceAxis, depth + 1);
+
+		//区間の終端の子を評価して補間する
+		if (blendFactor > 0.0f)
+		{
+			AnimationPose& upperPose = GetScratchPose(depth * 2);
+			upperPose.Copy(pose);
+			EvaluateNode(node.children[segment + 1], model, upperPose, inPlaceAxis, depth + 1);
+			pose.Blend(pose, upperPose, blendFactor);
+		}
+		break;
+	}
+	case NodeType::kLayer:
+	{
+		//基本の姿勢を評価
+		EvaluateNode(node.children[0], model, pose, inPlaceAxis, depth + 1);
+
+		//重みがない場合は重ねない
+		const float weight = node.parameterName.empty() ? 1.0f : std::clamp(GetParameter(node.parameterName), 0.0f, 1.0f);
+		if (weight <= 0.0f) break;
+
+		//重ねる姿勢を評価してジョイントごとの重みで補間する
+		AnimationPose& layerPose = GetScratchPose(depth * 2);
+		layerPose.Copy(pose);
+		EvaluateNode(node.children[1], model, layerPose, inPlaceAxis, depth + 1);
+		if (node.jointWeights.empty())
+		{
+			pose.Blend(pose, layerPose, weight);
+		}
+		else
+		{
+			pose.BlendMasked(pose, layerPose, node.jointWeights, weight);
+		}
+		break;
+	}
+	case NodeType::kAdditive:
+	{
+		//基本の姿勢を評価
+		EvaluateNode(node.children[0], model, pose, inPlaceAxis, depth + 1);
+
+		//重みがない場合は加算しない
+		const float weight = node.parameterName.empty() ? 1.0f : GetParameter(node.parameterName);
+		if (weight == 0.0f) break;
+
+		//加算する姿勢と基準の姿勢を評価して差分を求める
+		AnimationPose& additivePose = GetScratchPose(depth * 2);
+		AnimationPose& referencePose = GetScratchPose(depth * 2 + 1);
+		additivePose.Copy(pose);
+		EvaluateNode(node.children[1], model, additivePose, inPlaceAxis, depth + 1);
+		referencePose.Copy(pose);
+		EvaluateNode(node.children[2], model, referencePose, inPlaceAxis, depth + 1);
+		additivePose.MakeAdditive(additivePose, referencePose);
+
+		//差分を加算する
+		pose.AddAdditive(pose, additivePose, weight);
+		break;
+	}
+	}
+}
+
+const uint32_t AnimationBlendTree::FindBlend1DSegment(const Node& node, float& blendFactor) const
+{
+	//範囲外の場合は端の子だけを使う
+	const float value = GetParameter(node.parameterName);
+	const uint32_t lastIndex = static_cast<uint32_t>(node.thresholds.size() - 1);
+	blendFactor = 0.0f;
+	if (value <= node.thresholds.front())
+	{
+		return 0;
+	}
+	if (value >= node.thresholds.back())
+	{
+		return lastIndex;
+	}
+
+	//値を含む区間を探して補間する
+	auto it = std::upper_bound(node.thresholds.begin(), node.thresholds.end(), value);
+	const uint32_t segment = static_cast<uint32_t>(it - node.thresholds.begin() - 1);
+	const float range = node.thresholds[segment + 1] - node.thresholds[segment];
+	blendFactor = range > 0.0f ? (value - node.thresholds[segment]) / range : 0.0f;
+	return segment;
+}
+
+void AnimationBlendTree::SynchronizeBlend1DNode(Node& node)
+{
+	//停止中や子がない場合は何もしない
+	if (stop_ || pause_ || node.children.empty()) return;
+
+	//補間する2つの子がクリップでなければ揃えない
+	float blendFactor = 0.0f;
+	const uint32_t segment = FindBlend1DSegment(node, blendFactor);
+	const Node& lowerNode = nodes_[node.children[segment]];
+	const Node& upperNode = nodes_[node.children[std::min<uint32_t>(segment + 1, static_cast<uint32_t>(node.children.size() - 1))]];
+	if (!lowerNode.animation || !upperNode.animation) return;
+
+	//ブレンドした尺で再生位置を進める
+	const float duration = Mathf::Lerp(lowerNode.animation->GetDuration(), upperNode.animation->GetDuration(), blendFactor);
+	if (duration <= 0.0f) return;
+	node.normalizedTime += animationSpeed_ * GameTimer::GetDeltaTime() / duration;
+	if (node.normalizedTime >= 1.0f)
+	{
+		node.normalizedTime = loop_ ? std::fmod(node.normalizedTime, 1.0f) : 1.0f;
+	}
+
+	//子のクリップの時間を揃えた再生位置に合わせる
+	for (int32_t child : node.children)
+	{
+		Animation* animation = nodes_[child].animation;
+		if (animation)
+		{
+			animation->SetAnimationTime(node.normalizedTime * animation->GetDuration());
+		}
+	}
+}
+
+AnimationPose& AnimationBlendTree::GetScratchPose(const uint32_t index)
+{
+	//足りなければ確保する
+	while (scratchPoses_.size() <= index)
+	{
+		scratchPoses_.push_back(std::make_unique<AnimationPose>());
+	}
+	return *scratchPoses_[index];
+}
@@ -0,0 +1,194 @@
+/**
+ * @file AnimationBlendTree.h
+ * @brief 複数のアニメーションを姿勢バッファ上で合成するブレンドツリー
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Animation.h"
+#include "AnimationPose.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class AnimationBlendTree
+{
+public:
+	//ノードの種類
+	enum class NodeType
+	{
+		kClip,//アニメーションを再生する
+		kBlend1D,//パラメーターの値で隣り合う2つの子を補間する
+		kLayer,//基本の姿勢に別の姿勢をジョイントごとの重みで重ねる
+		kAdditive,//基本の姿勢に基準の姿勢からの差分を加算する
+	};
+
+	//ノード構造体
+	struct Node
+	{
+		//ノードの種類
+		NodeType type = NodeType::kClip;
+		//再生するアニメーション（クリップ）
+		Animation* animation = nullptr;
+		//子ノードの番号（1Dブレンド: 閾値の昇順、レイヤー: 基本・重ねる、加算: 基本・加算・基準）
+		std::vector<int32_t> children{};
+		//子ノードの閾値（1Dブレンド）
+		std::vector<float> thresholds{};
+		//ブレンドの値（1Dブレンド）または重み（レイヤー、加算）のパラメーターの名前
+		std::string parameterName{};
+		//ジョイントごとの重み（レイヤー、空の場合は全てのジョイントに重ねる）
+		std::vector<float> jointWeights{};
+		//子のクリップの再生位置を揃えるかどうか（1Dブレンド）
+		bool isSynchronized = false;
+		//揃えた再生位置（0~1）
+		float normalizedTime = 0.0f;
+	};
+
+	/// <summary>
+	/// アニメーションを再生するノードを追加
+	/// </summary>
+	/// <param name="animation">アニメーション（所有はしない）</param>
+	/// <returns>ノードの番号</returns>
+	int32_t AddClipNode(Animation* animation);
+
+	/// <summary>
+	/// パラメーターの値で子を補間するノードを追加
+	/// </summary>
+	/// <param name="parameterName">ブレンドの値のパラメーターの名前</param>
+	/// <param name="children">子ノードの番号と閾値</param>
+	/// <param name="isSynchronized">子のクリップの再生位置を揃えるかどうか</param>
+	/// <returns>ノードの番号</returns>
+	int32_t AddBlend1DNode(const std::string& parameterName, std::vector<std::pair<int32_t, float>> children, const bool isSynchronized = true);
+
+	/// <summary>
+	/// 基本の姿勢に別の姿勢を重ねるノードを追加
+	/// </summary>
+	/// <param name="baseNode">基本のノードの番号</param>
+	/// <param name="layerNode">重ねるノードの番号</param>
+	/// <param name="weightParameterName">重みのパラメーターの名前</param>
+	/// <param name="jointWeights">ジョイントごとの重み（空の場合は全てのジョイントに重ねる）</param>
+	/// <returns>ノードの番号</returns>
+	int32_t AddLayerNode(const int32_t baseNode, const int32_t layerNode, const std::string& weightParameterName, const std::vector<float>& jointWeights = {});
+
+	/// <summary>
+	/// 基本の姿勢に基準の姿勢からの差分を加算するノードを追加
+	/// </summary>
+	/// <param name="baseNode">基本のノードの番号</param>
+	/// <param name="additiveNode">加算するノードの番号</param>
+	/// <param name="referenceNode">差分の基準のノードの番号</param>
+	/// <param name="weightParameterName">重みのパラメーターの名前</param>
+	/// <returns>ノードの番号</returns>
+	int32_t AddAdditiveNode(const int32_t baseNode, const int32_t additiveNode, const int32_t referenceNode, const std::string& weightParameterName);
+
+	/// <summary>
+	/// アニメーションの時間を更新（同じアニメーションは1回だけ進める）
+	/// </summary>
+	void UpdateAnimationTime();
+
+	/// <summary>
+	/// ルートノードを評価して姿勢バッファに書き込む（モデルには書き込まない）
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="pose">書き込み先の姿勢（チャンネルのないジョイントの初期値を入れておく）</param>
+	/// <param name="inPlaceAxis">動かす軸</param>
+	void Evaluate(Model* model, AnimationPose& pose, const Vector3& inPlaceAxis = { 1.0f, 1.0f, 1.0f });
+
+	/// <summary>
+	/// アニメーションを再生
+	/// </summary>
+	/// <param name="speed">アニメーション速度</param>
+	/// <param name="loop">ループフラグ</param>
+	void PlayAnimation(const float speed, const bool loop);
+
+	/// <summary>
+	/// アニメーションを停止
+	/// </summary>
+	void StopAnimation();
+
+	/// <summary>
+	/// アニメーションを一時停止
+	/// </summary>
+	void PauseAnimation();
+
+	/// <summary>
+	/// アニメーションを再開
+	/// </summary>
+	void ResumeAnimation();
+
+	//全てのアニメーションが終了しているかを取得
+	const bool GetIsAnimationFinished() const;
+
+	//ルートノードを取得・設定
+	const int32_t GetRootNode() const { return rootNode_; };
+	void SetRootNode(const int32_t rootNode) { rootNode_ = rootNode; };
+
+	//パラメーターを取得・設定
+	const float GetParameter(const std::string& name) const;
+	void SetParameter(const std::string& name, const float value) { parameters_[name] = value; };
+
+	//ノードを取得
+	const std::vector<Node>& GetNodes() const { return nodes_; };
+
+private:
+	/// <summary>
+	/// ノードを評価して姿勢バッファに書き込む
+	/// </summary>
+	/// <param name="nodeIndex">ノードの番号</param>
+	/// <param name="model">モデル</param>
+	/// <param name="pose">書き込み先の姿勢</param>
+	/// <param name="inPlaceAxis">動かす軸</param>
+	/// <param name="depth">ノードの深さ（作業用の姿勢バッファの選択に使う）</param>
+	void EvaluateNode(const int32_t nodeIndex, Model* model, AnimationPose& pose, const Vector3& inPlaceAxis, const uint32_t depth);
+
+	/// <summary>
+	/// 1Dブレンドで補間する子の区間とブレンド係数を求める
+	/// </summary>
+	/// <param name="node">ノード</param>
+	/// <param name="blendFactor">ブレンド係数</param>
+	/// <returns>区間の先頭の子の位置</returns>
+	const uint32_t FindBlend1DSegment(const Node& node, float& blendFactor) const;
+
+	/// <summary>
+	/// 1Dブレンドの子のクリップの再生位置を揃える
+	/// </summary>
+	/// <param name="node">ノード</param>
+	void SynchronizeBlend1DNode(Node& node);
+
+	/// <summary>
+	/// 作業用の姿勢バッファを取得
+	/// </summary>
+	/// <param name="index">姿勢バッファの番号</param>
+	/// <returns>姿勢バッファ</returns>
+	AnimationPose& GetScratchPose(const uint32_t index);
+
+private:
+	//ノードの配列
+	std::vector<Node> nodes_{};
+
+	//ルートノードの番号（ない場合は-1）
+	int32_t rootNode_ = -1;
+
+	//パラメーターのマップ
+	std::map<std::string, float> parameters_{};
+
+	//ツリーで使うアニメーション（重複なし）
+	std::vector<Animation*> animations_{};
+
+	//作業用の姿勢バッファ（評価中に参照を保持するので個別に確保する）
+	std::vector<std::unique_ptr<AnimationPose>> scratchPoses_{};
+
+	//アニメーションの速度
+	float animationSpeed_ = 1.0f;
+
+	//ループさせるかどうか
+	bool loop_ = true;
+
+	//アニメーションを一時停止させるかどうか
+	bool pause_ = false;
+
+	//アニメーションを停止させるかどうか
+	bool stop_ = false;
+};
@@ -6,6 +6,11 @@
  */
 
 #include "AnimationManager.h"
+#include "Engine/Utilities/Log.h"
+#include <algorithm>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
 
 AnimationManager* AnimationManager::instance_ = nullptr;
 const std::string AnimationManager::kBaseDirectory = "Application/Resources/Models";
@@ -28,35 +33,87 @@ void AnimationManager::Destroy()
 	}
 }
 
-Animation* AnimationManager::Create(const std::string& fileName)
+Animation* AnimationManager::Create(const std::string& fileName, const float sampleRate, const bool isCompressed)
 {
-	Animation* animation = AnimationManager::GetInstance()->CreateInternal(fileName);
+	Animation* animation = AnimationManager::GetInstance()->CreateInternal(fileName, sampleRate, isCompressed);
 	return animation;
 }
 
-Animation* AnimationManager::CreateInternal(const std::string& fileName)
+void AnimationManager::LoadBakedAnimations(const std::string& bakedFileName, const std::vector<std::string>& fileNames)
 {
-	//同じアニメーションがないかチェック
-	auto it = animationDatas_.find(fileName);
-	if (it != animationDatas_.end())
+	//全て読み込み済みの場合は何もしない
+	AnimationManager* instance = AnimationManager::GetInstance();
 	{
-		Animation* animation = new Animation();
-		animation->Initialize(it->second);
-		return animation;
+		std::lock_guard<std::mutex> lock(instance->mutex_);
+		if (std::all_of(fileNames.begin(), fileNames.end(), [instance](const std::string& fileName) { return instance->animationDatas_.contains({ fileName, 0.0f, true }); }))
+		{
+			return;
+		}
 	}
 
-	//アニメーションデータの読み込み
-	std::vector<Animation::AnimationData> animationDatas = LoadAnimationFile(kBaseDirectory, fileName);
-	//アニメーションデータを保存
-	animationDatas_[fileName] = animationDatas;
+	//読み込めなければベイクし直してから読み込む（それでも失敗した場合はベイク時に読み込んだデータが使われる）
+	if (!instance->LoadBakedFile(bakedFileName, fileNames))
+	{
+		instance->SaveBakedFile(bakedFileName, fileNames);
+		instance->LoadBakedFile(bakedFileName, fileNames);
+	}
+}
 
-	//アニメーションの生成
-	Animation* animation = new Animation();
-	animation->Initialize(animationDatas);
+AssetLoader::Handle AnimationManager::LoadBakedAnimationsAsync(const std::string& bakedFileName, const std::vector<std::string>& fileNames)
+{
+	return AssetLoader::GetInstance()->Request([bakedFileName, fileNames]() {
+		LoadBakedAnimations(bakedFileName, fileNames);
+		return AssetLoader::FinalizeFunction();
+		});
+}
+
+void AnimationManager::BakeAnimations(const std::string& bakedFileName, const std::vector<std::string>& fileNames)
+{
+	AnimationManager::GetInstance()->SaveBakedFile(bakedFileName, fileNames);
+}
 
+Animation* AnimationManager::CreateInternal(const std::string& fileName, const float sampleRate, const bool isCompressed)
+{
+	//アニメーションの生成（アニメーションデータは共有し、再生状態だけを持たせる）
+	Animation* animation = new Animation();
+	animation->Initialize(GetAnimationDatas(fileName, sampleRate, isCompressed));
 	return animation;
 }
 
+std::shared_ptr<const std::vector<Animation::AnimationData>> AnimationManager::GetAnimationDatas(const std::string& fileName, const float sampleRate, const bool isCompressed)
+{
+	//同じアニメーションがないかチェック（再サンプリングする場合は圧縮しない）
+	const float clampedSampleRate = std::max(sampleRate, 0.0f);
+	const std::tuple<std::string, float, bool> key = { fileName, clampedSampleRate, isCompressed && clampedSampleRate == 0.0f };
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = animationDatas_.find(key);
+		if (it != animationDatas_.end())
+		{
+			return it->second;
+		}
+	}
+
+	//アニメーションデータの読み込み（再サンプリングする場合は読み込み済みのデータを元にする）
+	std::vector<Animation::AnimationData> animationDatas = clampedSampleRate > 0.0f ? *GetAnimationDatas(fileName, 0.0f, false) : LoadAnimationFile(kBaseDirectory, fileName);
+	for (Animation::AnimationData& animationData : animationDatas)
+	{
+		if (clampedSampleRate > 0.0f)
+		{
+			Animation::Resample(animationData, clampedSampleRate);
+		}
+		else if (std::get<2>(key))
+		{
+			Animation::Compress(animationData);
+		}
+	}
+
+	//アニメーションデータを保存（並列に読み込まれていた場合は先に保存されたものを使う）
+	std::shared_ptr<const std::vector<Animation::AnimationData>> sharedAnimationDatas = std::make_shared<const std::vector<Animation::AnimationData>>(std::move(animationDatas));
+	std::lock_guard<std::mutex> lock(mutex_);
+	return animationDatas_.emplace(key, sharedAnimationDatas).first->second;
+}
+
 std::vector<Animation::AnimationData> AnimationManager::LoadAnimationFile(const std::string& directoryPath, const std::string& filename)
 {
 	std::vector<Animation::AnimationData> animation{};//今回作るアニメーション
@@ -70,41 +127,219 @@ std::vector<Animation::AnimationData> AnimationManager::LoadAnimationFile(const
 		aiAnimation* animationAssimp = scene->mAnimations[animationIndex];//最初のアニメーションだけ採用。もちろん複数対応することに越したことはない
 		currentAnimationData.name = animationAssimp->mName.C_Str();
 		currentAnimationData.duration = float(animationAssimp->mDuration / animationAssimp->mTicksPerSecond);//時間の単位を秒に変換
+		//チャンネルごとのNode名（ハッシュが衝突していないかを調べるのに使う）
+		std::vector<std::string> channelNodeNames{};
 		//assimpでは個々のNodeのAnimationをchannelと読んでいるのでchannelを回してNodeAnimationの情報を取ってくる
 		for (uint32_t channelIndex = 0; channelIndex < animationAssimp->mNumChannels; ++channelIndex)
 		{
 			aiNodeAnim* nodeAnimationAssimp = animationAssimp->mChannels[channelIndex];
-			Animation::NodeAnimation& nodeAnimation = currentAnimationData.nodeAnimations[nodeAnimationAssimp->mNodeName.C_Str()];
+			//Node名とチャンネルの番号を対応させる（同じNodeのチャンネルは最初のものを使う）
+			const std::string nodeName = nodeAnimationAssimp->mNodeName.C_Str();
+			auto [channelIt, isInserted] = currentAnimationData.channelIndices.emplace(Animation::HashName(nodeName), static_cast<uint32_t>(currentAnimationData.nodeAnimations.size()));
+			if (!isInserted)
+			{
+				//別のNodeとハッシュが衝突した場合はどちらかのチャンネルが再生されなくなるので読み込みを失敗させる
+				if (channelNodeNames[channelIt->second] != nodeName)
+				{
+					MyUtility::Log(std::format("AnimationManager: node name hash collision between \"{}\" and \"{}\" in {}\n", channelNodeNames[channelIt->second], nodeName, filePath));
+					assert(false && "Node name hash collision");
+					return {};
+				}
+				continue;
+			}
+			channelNodeNames.push_back(nodeName);
+			Animation::NodeAnimation& nodeAnimation = currentAnimationData.nodeAnimations.emplace_back();
 			//Translate
+			nodeAnimation.translate.keyframeOffset = static_cast<uint32_t>(currentAnimationData.vector3Keyframes.size());
+			nodeAnimation.translate.keyframeCount = nodeAnimationAssimp->mNumPositionKeys;
 			for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumPositionKeys; ++keyIndex)
 			{
 				aiVectorKey& keyAssimp = nodeAnimationAssimp->mPositionKeys[keyIndex];
 				Animation::KeyframeVector3 keyframe;
 				keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond);//ここも秒に変換
 				keyframe.value = { -keyAssimp.mValue.x,keyAssimp.mValue.y,keyAssimp.mValue.z };//右手->左手
-				nodeAnimation.translate.keyframes.push_back(keyframe);
+				currentAnimationData.vector3Keyframes.push_back(keyframe);
 			}
 			//Rotate
+			nodeAnimation.rotate.keyframeOffset = static_cast<uint32_t>(currentAnimationData.quaternionKeyframes.size());
+			nodeAnimation.rotate.keyframeCount = nodeAnimationAssimp->mNumRotationKeys;
 			for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumRotationKeys; ++keyIndex)
 			{
 				aiQuatKey& keyAssimp = nodeAnimationAssimp->mRotationKeys[keyIndex];
 				Animation::KeyframeQuaternion keyframe;
 				keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond);
 				keyframe.value = { keyAssimp.mValue.x,-keyAssimp.mValue.y,-keyAssimp.mValue.z,keyAssimp.mValue.w };
-				nodeAnimation.rotate.keyframes.push_back(keyframe);
+				currentAnimationData.quaternionKeyframes.push_back(keyframe);
 			}
 			//Scale
+			nodeAnimation.scale.keyframeOffset = static_cast<uint32_t>(currentAnimationData.vector3Keyframes.size());
+			nodeAnimation.scale.keyframeCount = nodeAnimationAssimp->mNumScalingKeys;
 			for (uint32_t keyIndex = 0; keyIndex < nodeAnimationAssimp->mNumScalingKeys; ++keyIndex)
 			{
 				aiVectorKey& keyAssimp = nodeAnimationAssimp->mScalingKeys[keyIndex];
 				Animation::KeyframeVector3 keyframe;
 				keyframe.time = float(keyAssimp.mTime / animationAssimp->mTicksPerSecond);
 				keyframe.value = { keyAssimp.mValue.x,keyAssimp.mValue.y,keyAssimp.mValue.z };
-				nodeAnimation.scale.keyframes.push_back(keyframe);
+				currentAnimationData.vector3Keyframes.push_back(keyframe);
 			}
 		}
-		animation.push_back(currentAnimationData);
+		animation.push_back(std::move(currentAnimationData));
 	}
 	//解析完了
 	return animation;
-}
\ No newline at end of file
+}
+
+bool AnimationManager::LoadBakedFile(const std::string& bakedFileName, const std::vector<std::string>& fileNames)
+{
+	//ベイクしたファイルがないか、元のファイルの方が新しい場合は読み込まない
+	const std::string bakedFilePath = kBaseDirectory + "/" + bakedFileName;
+	std::error_code errorCode;
+	const std::filesystem::file_time_type bakedTime = std::filesystem::last_write_time(bakedFilePath, errorCode);
+	if (errorCode) return false;
+	for (const std::string& fileName : fileNames)
+	{
+		const std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time(kBaseDirectory + "/" + fileName, errorCode);
+		if (!errorCode && sourceTime > bakedTime) return false;
+	}
+
+	//ファイルをマップ（アニメーションデータが全て破棄されるまで保持する）
+	std::shared_ptr<MappedFile> mappedFile = std::make_shared<MappedFile>();
+	if (!mappedFile->Open(bakedFilePath)) return false;
+
+	//先頭から4バイト単位で読み進める（範囲外になる場合はnullptr）
+	const uint8_t* data = mappedFile->GetData();
+	const size_t size = mappedFile->GetSize();
+	size_t offset = 0;
+	auto read = [data, size, &offset](const size_t byteSize) -> const uint8_t* {
+		const size_t alignedSize = (byteSize + 3) & ~size_t(3);
+		if (size - offset < alignedSize) return nullptr;
+		const uint8_t* result = data + offset;
+		offset += alignedSize;
+		return result;
+		};
+
+	//識別子とバージョンを確認
+	const BakedHeader* header = reinterpret_cast<const BakedHeader*>(read(sizeof(BakedHeader)));
+	if (!header || header->magic != kBakedMagic || header->version != kBakedVersion) return false;
+
+	//元のファイルごとにアニメーションデータを作成（全て読めてから登録する）
+	std::map<std::string, std::vector<Animation::AnimationData>> bakedAnimationDatas{};
+	for (uint32_t fileIndex = 0; fileIndex < header->fileCount; ++fileIndex)
+	{
+		const BakedFileHeader* fileHeader = reinterpret_cast<const BakedFileHeader*>(read(sizeof(BakedFileHeader)));
+		const char* fileName = fileHeader ? reinterpret_cast<const char*>(read(fileHeader->nameLength)) : nullptr;
+		if (!fileName) return false;
+		std::vector<Animation::AnimationData>& animationDatas = bakedAnimationDatas[std::string(fileName, fileHeader->nameLength)];
+		for (uint32_t clipIndex = 0; clipIndex < fileHeader->clipCount; ++clipIndex)
+		{
+			//クリップのヘッダーと各配列の位置を取得
+			const BakedClipHeader* clipHeader = reinterpret_cast<const BakedClipHeader*>(read(sizeof(BakedClipHeader)));
+			if (!clipHeader) return false;
+			const char* clipName = reinterpret_cast<const char*>(read(clipHeader->nameLength));
+			const uint32_t* hashes = reinterpret_cast<const uint32_t*>(read(sizeof(uint32_t) * clipHeader->channelCount));
+			const Animation::NodeAnimation* channels = reinterpret_cast<const Animation::NodeAnimation*>(read(sizeof(Animation::NodeAnimation) * clipHeader->channelCount));
+			const Animation::CompressedKeyframe* vector3Keyframes = reinterpret_cast<const Animation::CompressedKeyframe*>(read(sizeof(Animation::CompressedKeyframe) * clipHeader->vector3KeyframeCount));
+			const Animation::CompressedKeyframe* quaternionKeyframes = reinterpret_cast<const Animation::CompressedKeyframe*>(read(sizeof(Animation::CompressedKeyframe) * clipHeader->quaternionKeyframeCount));
+			if (!clipName || !hashes || !channels || !vector3Keyframes || !quaternionKeyframes) return false;
+
+			//チャンネルのテーブルをコピーし、キーフレームはマップしたまま参照する
+			Animation::AnimationData& animationData = animationDatas.emplace_back();
+			animationData.name.assign(clipName, clipHeader->nameLength);
+			animationData.duration = clipHeader->duration;
+			animationData.nodeAnimations.assign(channels, channels + clipHeader->channelCount);
+			for (uint32_t channelIndex = 0; channelIndex < clipHeader->channelCount; ++channelIndex)
+			{
+				animationData.channelIndices.emplace(hashes[channelIndex], channelIndex);
+			}
+			animationData.isCompressed = true;
+			animationData.compressedVector3Keyframes = std::span<const Animation::CompressedKeyframe>(vector3Keyframes, clipHeader->vector3KeyframeCount);
+			animationData.compressedQuaternionKeyframes = std::span<const Animation::CompressedKeyframe>(quaternionKeyframes, clipHeader->quaternionKeyframeCount);
+			animationData.compressedStorage = mappedFile;
+			animationData.translateMin = clipHeader->translateMin;
+			animationData.translateStep = clipHeader->translateStep;
+			animationData.scaleMin = clipHeader->scaleMin;
+			animationData.scaleStep = clipHeader->scaleStep;
+
+			//キーフレームの範囲が配列に収まっているか確認
+			for (const Animation::NodeAnimation& nodeAnimation : animationData.nodeAnimations)
+			{
+				if (nodeAnimation.translate.keyframeOffset + nodeAnimation.translate.keyframeCount > clipHeader->vector3KeyframeCount ||
+					nodeAnimation.scale.keyframeOffset + nodeAnimation.scale.keyframeCount > clipHeader->vector3KeyframeCount ||
+					nodeAnimation.rotate.keyframeOffset + nodeAnimation.rotate.keyframeCount > clipHeader->quaternionKeyframeCount)
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	//必要なファイルが全て含まれているか確認
+	for (const std::string& fileName : fileNames)
+	{
+		if (!bakedAnimationDatas.contains(fileName)) return false;
+	}
+
+	//圧縮したアニメーションデータとして登録
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (auto& [fileName, animationDatas] : bakedAnimationDatas)
+	{
+		animationDatas_[{ fileName, 0.0f, true }] = std::make_shared<const std::vector<Animation::AnimationData>>(std::move(animationDatas));
+	}
+	return true;
+}
+
+void AnimationManager::SaveBakedFile(const std::string& bakedFileName, const std::vector<std::string>& fileNames)
+{
+	//ファイルを開く
+	std::ofstream file(kBaseDirectory + "/" + bakedFileName, std::ios::binary | std::ios::trunc);
+	if (!file) return;
+
+	//4バイト単位に揃えて書き込む処理
+	auto write = [&file](const void* data, const size_t byteSize) {
+		static const char kPadding[4] = {};
+		file.write(static_cast<const char*>(data), byteSize);
+		file.write(kPadding, ((byteSize + 3) & ~size_t(3)) - byteSize);
+		};
+
+	//ヘッダーを書き込む
+	const BakedHeader header = { kBakedMagic, kBakedVersion, static_cast<uint32_t>(fileNames.size()), 0 };
+	write(&header, sizeof(header));
+
+	//元のファイルごとに圧縮したアニメーションデータを書き込む
+	for (const std::string& fileName : fileNames)
+	{
+		std::shared_ptr<const std::vector<Animation::AnimationData>> animationDatas = GetAnimationDatas(fileName, 0.0f, true);
+		const BakedFileHeader fileHeader = { static_cast<uint32_t>(fileName.size()), static_cast<uint32_t>(animationDatas->size()) };
+		write(&fileHeader, sizeof(fileHeader));
+		write(fileName.data(), fileName.size());
+		for (const Animation::AnimationData& animationData : *animationDatas)
+		{
+			//クリップのヘッダーと名前
+			BakedClipHeader clipHeader{};
+			clipHeader.nameLength = static_cast<uint32_t>(animationData.name.size());
+			clipHeader.duration = animationData.duration;
+			clipHeader.channelCount = static_cast<uint32_t>(animationData.nodeAnimations.size());
+			clipHeader.vector3KeyframeCount = static_cast<uint32_t>(animationData.compressedVector3Keyframes.size());
+			clipHeader.quaternionKeyframeCount = static_cast<uint32_t>(animationData.compressedQuaternionKeyframes.size());
+			clipHeader.translateMin = animationData.translateMin;
+			clipHeader.translateStep = animationData.translateStep;
+			clipHeader.scaleMin = animationData.scaleMin;
+			clipHeader.scaleStep = animationData.scaleStep;
+			write(&clipHeader, sizeof(clipHeader));
+			write(animationData.name.data(), animationData.name.size());
+
+			//チャンネルの番号順にNode名のハッシュを並べる
+			std::vector<uint32_t> hashes(animationData.nodeAnimations.size());
+			for (const auto& [hash, channelIndex] : animationData.channelIndices)
+			{
+				hashes[channelIndex] = hash;
+			}
+			write(hashes.data(), sizeof(uint32_t) * hashes.size());
+
+			//チャンネルとキーフレーム
+			write(animationData.nodeAnimations.data(), sizeof(Animation::NodeAnimation) * animationData.nodeAnimations.size());
+			write(animationData.compressedVector3Keyframes.data(), sizeof(Animation::CompressedKeyframe) * animationData.compressedVector3Keyframes.size());
+			write(animationData.compressedQuaternionKeyframes.data(), sizeof(Animation::CompressedKeyframe) * animationData.compressedQuaternionKeyframes.size());
+		}
+	}
+}
@@ -7,9 +7,13 @@
 
 #pragma once
 #include "Animation.h"
+#include "Engine/Utilities/AssetLoader.h"
+#include "Engine/Utilities/MappedFile.h"
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
+#include <mutex>
+#include <tuple>
 
 class AnimationManager
 {
@@ -29,13 +33,71 @@ public:
 	static void Destroy();
 
 	/// <summary>
-	/// アニメーションを作成
+	/// アニメーションを作成（同じファイルのアニメーションデータは共有する）
 	/// </summary>
 	/// <param name="fileName">ファイルの名前</param>
+	/// <param name="sampleRate">再サンプリングする1秒あたりのサンプル数（0の場合は再サンプリングしない）</param>
+	/// <param name="isCompressed">キーフレームを圧縮するかどうか（再サンプリングしない場合のみ）</param>
 	/// <returns>アニメーション</returns>
-	static Animation* Create(const std::string& fileName);
+	static Animation* Create(const std::string& fileName, const float sampleRate = 0.0f, const bool isCompressed = false);
+
+	/// <summary>
+	/// ベイクしたファイルから圧縮したアニメーションデータをまとめて読み込む（ファイルがないか元のファイルより古い場合はベイクし直す）
+	/// </summary>
+	/// <param name="bakedFileName">ベイクしたファイルの名前</param>
+	/// <param name="fileNames">まとめるアニメーションのファイルの名前（読み込んだ後は圧縮を指定したCreateで使われる）</param>
+	static void LoadBakedAnimations(const std::string& bakedFileName, const std::vector<std::string>& fileNames);
+
+	/// <summary>
+	/// ベイクしたファイルの読み込みを要求（GPUリソースを使わないので全てワーカースレッドで行う）
+	/// </summary>
+	/// <param name="bakedFileName">ベイクしたファイルの名前</param>
+	/// <param name="fileNames">まとめるアニメーションのファイルの名前</param>
+	/// <returns>読み込みの完了を待つハンドル</returns>
+	static AssetLoader::Handle LoadBakedAnimationsAsync(const std::string& bakedFileName, const std::vector<std::string>& fileNames);
+
+	/// <summary>
+	/// アニメーションを圧縮して1つのファイルにまとめてベイクする
+	/// </summary>
+	/// <param name="bakedFileName">ベイクしたファイルの名前</param>
+	/// <param name="fileNames">まとめるアニメーションのファイルの名前</param>
+	static void BakeAnimations(const std::string& bakedFileName, const std::vector<std::string>& fileNames);
 
 private:
+	//ベイクしたファイルの識別子（"ANIM"）とバージョン
+	static const uint32_t kBakedMagic = 0x4D494E41;
+	static const uint32_t kBakedVersion = 1;
+
+	//ベイクしたファイルのヘッダー（後ろに元のファイルが続く）
+	struct BakedHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t fileCount;
+		uint32_t reserved;
+	};
+
+	//ベイクした元のファイルのヘッダー（後ろにファイルの名前とクリップが続く）
+	struct BakedFileHeader
+	{
+		uint32_t nameLength;
+		uint32_t clipCount;
+	};
+
+	//ベイクしたクリップのヘッダー（後ろに名前、チャンネルのNode名のハッシュ、チャンネル、移動とスケール、回転のキーフレームが続く）
+	struct BakedClipHeader
+	{
+		uint32_t nameLength;
+		float duration;
+		uint32_t channelCount;
+		uint32_t vector3KeyframeCount;
+		uint32_t quaternionKeyframeCount;
+		Vector3 translateMin;
+		Vector3 translateStep;
+		Vector3 scaleMin;
+		Vector3 scaleStep;
+	};
+
 	AnimationManager() = default;
 	~AnimationManager() = default;
 	AnimationManager(const AnimationManager&) = delete;
@@ -45,8 +107,19 @@ private:
 	/// アニメーションを内部で作成
 	/// </summary>
 	/// <param name="fileName">ファイルの名前</param>
+	/// <param name="sampleRate">再サンプリングする1秒あたりのサンプル数</param>
+	/// <param name="isCompressed">キーフレームを圧縮するかどうか</param>
 	/// <returns>アニメーション</returns>
-	Animation* CreateInternal(const std::string& fileName);
+	Animation* CreateInternal(const std::string& fileName, const float sampleRate, const bool isCompressed);
+
+	/// <summary>
+	/// 共有するアニメーションデータを取得（なければ読み込む）
+	/// </summary>
+	/// <param name="fileName">ファイルの名前</param>
+	/// <param name="sampleRate">再サンプリングする1秒あたりのサンプル数</param>
+	/// <param name="isCompressed">キーフレームを圧縮するかどうか</param>
+	/// <returns>アニメーションデータ</returns>
+	std::shared_ptr<const std::vector<Animation::AnimationData>> GetAnimationDatas(const std::string& fileName, const float sampleRate, const bool isCompressed);
 
 	/// <summary>
 	/// アニメーションファイルの読み込み
@@ -56,9 +129,28 @@ private:
 	/// <returns>読み込んだアニメーションデータ</returns>
 	std::vector<Animation::AnimationData> LoadAnimationFile(const std::string& directoryPath, const std::string& filename);
 
+	/// <summary>
+	/// ベイクしたファイルをマップしてアニメーションデータを登録（キーフレームはマップしたまま使う）
+	/// </summary>
+	/// <param name="bakedFileName">ベイクしたファイルの名前</param>
+	/// <param name="fileNames">含まれている必要があるアニメーションのファイルの名前</param>
+	/// <returns>読み込めたかどうか</returns>
+	bool LoadBakedFile(const std::string& bakedFileName, const std::vector<std::string>& fileNames);
+
+	/// <summary>
+	/// アニメーションを圧縮してベイクしたファイルに書き出す
+	/// </summary>
+	/// <param name="bakedFileName">ベイクしたファイルの名前</param>
+	/// <param name="fileNames">まとめるアニメーションのファイルの名前</param>
+	void SaveBakedFile(const std::string& bakedFileName, const std::vector<std::string>& fileNames);
+
 private:
 	static AnimationManager* instance_;
 
-	std::map<std::string, std::vector<Animation::AnimationData>> animationDatas_{};
+	//ファイルの名前と再サンプリングのレートと圧縮の有無ごとのアニメーションデータ
+	std::map<std::tuple<std::string, float, bool>, std::shared_ptr<const std::vector<Animation::AnimationData>>> animationDatas_{};
+
+	//アニメーションデータの検索と登録を保護する（ワーカースレッドから並列に読み込むため）
+	std::mutex mutex_{};
 };
 
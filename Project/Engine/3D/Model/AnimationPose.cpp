@@ -0,0 +1,213 @@
+/**
+ * @file AnimationPose.cpp
+ * @brief ジョイントごとのローカル姿勢を保持して合成するファイル
+ * @author 青木智滉
+ * @date
+ */
+
+#include "AnimationPose.h"
+#include <cassert>
+#include <cmath>
+
+void AnimationPose::CopyFromSkeleton(const Model::Skeleton& skeleton)
+{
+	//ジョイント数に合わせて確保
+	const uint32_t jointCount = static_cast<uint32_t>(skeleton.joints.size());
+	Resize(jointCount);
+
+	//ジョイントの姿勢をコピー
+	for (uint32_t i = 0; i < jointCount; ++i)
+	{
+		const Model::Joint& joint = skeleton.joints[i];
+		translates_[i] = joint.translate;
+		rotates_[i] = joint.rotate;
+		scales_[i] = joint.scale;
+	}
+}
+
+void AnimationPose::ApplyToSkeleton(Model::Skeleton& skeleton) const
+{
+	assert(skeleton.joints.size() == translates_.size());
+
+	//ジョイントに姿勢を書き込む
+	for (uint32_t i = 0; i < GetJointCount(); ++i)
+	{
+		Model::Joint& joint = skeleton.joints[i];
+		joint.translate = translates_[i];
+		joint.rotate = rotates_[i];
+		joint.scale = scales_[i];
+	}
+}
+
+void AnimationPose::Copy(const AnimationPose& source)
+{
+	translates_ = source.translates_;
+	rotates_ = source.rotates_;
+	scales_ = source.scales_;
+}
+
+void AnimationPose::Blend(const AnimationPose& from, const AnimationPose& to, const float blendFactor)
+{
+	assert(from.GetJointCount() == to.GetJointCount());
+	const uint32_t jointCount = from.GetJointCount();
+	Resize(jointCount);
+
+	//成分ごとに連続した配列をまとめて補間する
+	const float t = blendFactor;
+	const float s = 1.0f - blendFactor;
+	for (uint32_t i = 0; i < jointCount; ++i)
+	{
+		translates_[i].x = s * from.translates_[i].x + t * to.translates_[i].x;
+		translates_[i].y = s * from.translates_[i].y + t * to.translates_[i].y;
+		translates_[i].z = s * from.translates_[i].z + t * to.translates_[i].z;
+	}
+	for (uint32_t i = 0; i < jointCount; ++i)
+	{
+		rotates_[i] = Nlerp(from.rotates_[i], to.rotates_[i], t);
+	}
+	for (uint32_t i = 0; i < jointCount; ++i)
+	{
+		scales_[i].x = s * from.scales_[i].x + t * to.scales_[i].x;
+		scales_[i].y = s * from.scales_[i].y + t * to.scales_[i].y;
+		scales_[i].z = s * from.scales_[i].z + t * to.scales_[i].z;
+	}
+}
+
+void AnimationPose::BlendMasked(const AnimationPose& from, const AnimationPose& to, std::span<const float> jointWeights, const float blendFactor)
+{
+	assert(from.GetJointCount() == to.GetJointCount() && jointWeights.size() == from.GetJointCount());
+	const uint32_t jointCount = from.GetJointCount();
+	Resize(jointCount);
+
+	//ジョイントごとのブレンド係数をマスクの重みから求めて補間する
+	for (uint32_t i = 0; i < jointCount; ++i)
+	{
+		const float t = jointWeights[i] * blendFactor;
+		const float s = 1.0f - t;
+		translates_[i].x = s * from.translates_[i].x + t * to.translates_[i].x;
+		translates_[i].y = s * from.translates_[i].y + t * to.translates_[i].y;
+		translates_[i].z = s * from.translates_[i].z + t * to.translates_[i].z;
+	}
+	for (uint32_t i = 0; i < jointCount; ++i)
+	{
+		rotates_[i] = Nlerp(from.rotates_[i], to.rotates_[i], jointWeights[i] * blendFactor);
+	}
+	for (uint32_t i = 0; i < jointCount; ++i)
+	{
+		const float t = jointWeights[i] * blendFactor;
+		const float s = 1.0f - t;
+		scales_[i].x = s * from.scales_[i].x + t * to.scales_[i].x;
+		scales_[i].y = s * from.scales_[i].y + t * to.scales_[i].y;
+		scales_[i].z = s * from.scales_[i].z + t * to.scales_[i].z;
+	}
+}
+
+void AnimationPose::MakeAdditive(const AnimationPose& source, const AnimationPose& reference)
+{
+	assert(source.GetJointCount() == reference.GetJointCount());
+	const uint32_t jointCount = source.GetJointCount();
+	Resize(jointCount);
+
+	//移動は差、回転は基準の逆回転との積、スケールは比を差分とする
+	for (uint32_t i = 0; i < jointCount; ++i)
+	{
+		translates_[i].x = source.translates_[i].x - reference.translates_[i].x;
+		translates_[i].y = source.translates_[i].y - reference.translates_[i].y;
+		translates_[i].z = source.translates_[i].z - reference.translates_[i].z;
+	}
+	for (uint32_t i = 0; i < jointCount; ++i)
+	{
+		const Quaternion& r = reference.rotates_[i];
+		rotates_[i] = Quaternion{ -r.x, -r.y, -r.z, r.w } * source.rotates_[i];
+	}
+	for (uint32_t i = 0; i < jointCount; ++i)
+	{
+		scales_[i].x = reference.scales_[i].x != 0.0f ? source.scales_[i].x / reference.scales_[i].x : 1.0f;
+		scales_[i].y = reference.scales_[i].y != 0.0f ? source.scales_[i].y / reference.scales_[i].y : 1.0f;
+		scales_[i].z = reference.scales_[i].z != 0.0f ? source.scales_[i].z / reference.scales_[i].z : 1.0f;
+	}
+}
+
+void AnimationPose::AddAdditive(const AnimationPose& base, const AnimationPose& additive, const float weight)
+{
+	assert(base.GetJointCount() == additive.GetJointCount());
+	const uint32_t jointCount = base.GetJointCount();
+	Resize(jointCount);
+
+	//差分に重みを掛けて加算する
+	for (uint32_t i = 0; i < jointCount; ++i)
+	{
+		translates_[i].x = base.translates_[i].x + weight * additive.translates_[i].x;
+		translates_[i].y = base.translates_[i].y + weight * additive.translates_[i].y;
+		translates_[i].z = base.translates_[i].z + weight * additive.translates_[i].z;
+	}
+	const Quaternion identity = { 0.0f, 0.0f, 0.0f, 1.0f };
+	for (uint32_t i = 0; i < jointCount; ++i)
+	{
+		rotates_[i] = base.rotates_[i] * Nlerp(identity, additive.rotates_[i], weight);
+	}
+	for (uint32_t i = 0; i < jointCount; ++i)
+	{
+		scales_[i].x = base.scales_[i].x * (1.0f + weight * (additive.scales_[i].x - 1.0f));
+		scales_[i].y = base.scales_[i].y * (1.0f + weight * (additive.scales_[i].y - 1.0f));
+		scales_[i].z = base.scales_[i].z * (1.0f + weight * (additive.scales_[i].z - 1.0f));
+	}
+}
+
+std::vector<float> AnimationPose::CreateJointMask(const Model::Skeleton& skeleton, const std::string& rootJointName)
+{
+	//全てのジョイントの重みを0で初期化
+	std::vector<float> jointWeights(skeleton.joints.size(), 0.0f);
+
+	//起点となるジョイントがなければそのまま返す
+	auto it = skeleton.jointMap.find(rootJointName);
+	if (it == skeleton.jointMap.end())
+	{
+		return jointWeights;
+	}
+
+	//起点のジョイントから子をたどって重みを1にする
+	std::vector<int32_t> stack = { it->second };
+	while (!stack.empty())
+	{
+		const int32_t jointIndex = stack.back();
+		stack.pop_back();
+		jointWeights[jointIndex] = 1.0f;
+		for (int32_t child : skeleton.joints[jointIndex].children)
+		{
+			stack.push_back(child);
+		}
+	}
+
+	return jointWeights;
+}
+
+void AnimationPose::Resize(const uint32_t jointCount)
+{
+	translates_.resize(jointCount);
+	rotates_.resize(jointCount);
+	scales_.resize(jointCount);
+}
+
+Quaternion AnimationPose::Nlerp(const Quaternion& q0, const Quaternion& q1, const float t)
+{
+	//内積が負なら反対側のクォータニオンと補間して短い方の経路にする
+	const float dot = q0.x * q1.x + q0.y * q1.y + q0.z * q1.z + q0.w * q1.w;
+	const float s = 1.0f - t;
+	const float u = dot < 0.0f ? -t : t;
+	Quaternion result = {
+		s * q0.x + u * q1.x,
+		s * q0.y + u * q1.y,
+		s * q0.z + u * q1.z,
+		s * q0.w + u * q1.w
+	};
+
+	//正規化する
+	const float lengthSq = result.x * result.x + result.y * result.y + result.z * result.z + result.w * result.w;
+	const float inverseLength = lengthSq > 0.0f ? 1.0f / std::sqrt(lengthSq) : 0.0f;
+	result.x *= inverseLength;
+	result.y *= inverseLength;
+	result.z *= inverseLength;
+	result.w *= inverseLength;
+	return result;
+}
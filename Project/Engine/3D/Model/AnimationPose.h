@@ -0,0 +1,115 @@
+/**
+ * @file AnimationPose.h
+ * @brief ジョイントごとのローカル姿勢を保持して合成するファイル
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Model.h"
+#include <span>
+#include <string>
+#include <vector>
+
+class AnimationPose
+{
+public:
+	/// <summary>
+	/// スケルトンのジョイント数に合わせて確保し、スケルトンの姿勢をコピーする
+	/// </summary>
+	/// <param name="skeleton">スケルトン</param>
+	void CopyFromSkeleton(const Model::Skeleton& skeleton);
+
+	/// <summary>
+	/// 姿勢をスケルトンに書き込む
+	/// </summary>
+	/// <param name="skeleton">スケルトン</param>
+	void ApplyToSkeleton(Model::Skeleton& skeleton) const;
+
+	/// <summary>
+	/// 別の姿勢をコピーする
+	/// </summary>
+	/// <param name="source">コピー元の姿勢</param>
+	void Copy(const AnimationPose& source);
+
+	/// <summary>
+	/// 2つの姿勢を補間する（出力先は入力と同じ姿勢でもよい）
+	/// </summary>
+	/// <param name="from">補間元の姿勢</param>
+	/// <param name="to">補間先の姿勢</param>
+	/// <param name="blendFactor">ブレンド係数</param>
+	void Blend(const AnimationPose& from, const AnimationPose& to, const float blendFactor);
+
+	/// <summary>
+	/// ジョイントごとの重みを掛けて2つの姿勢を補間する（出力先は入力と同じ姿勢でもよい）
+	/// </summary>
+	/// <param name="from">補間元の姿勢</param>
+	/// <param name="to">補間先の姿勢</param>
+	/// <param name="jointWeights">ジョイントごとの重み</param>
+	/// <param name="blendFactor">ブレンド係数</param>
+	void BlendMasked(const AnimationPose& from, const AnimationPose& to, std::span<const float> jointWeights, const float blendFactor);
+
+	/// <summary>
+	/// 基準の姿勢からの差分を加算用の姿勢として作成する（出力先は入力と同じ姿勢でもよい）
+	/// </summary>
+	/// <param name="source">元の姿勢</param>
+	/// <param name="reference">基準の姿勢</param>
+	void MakeAdditive(const AnimationPose& source, const AnimationPose& reference);
+
+	/// <summary>
+	/// 加算用の姿勢を重みを掛けて加算する（出力先は入力と同じ姿勢でもよい）
+	/// </summary>
+	/// <param name="base">加算される姿勢</param>
+	/// <param name="additive">加算用の姿勢</param>
+	/// <param name="weight">重み</param>
+	void AddAdditive(const AnimationPose& base, const AnimationPose& additive, const float weight);
+
+	/// <summary>
+	/// 指定したジョイント以下の階層の重みを1、それ以外を0にしたマスクを作成
+	/// </summary>
+	/// <param name="skeleton">スケルトン</param>
+	/// <param name="rootJointName">マスクの起点となるジョイントの名前</param>
+	/// <returns>ジョイントごとの重み</returns>
+	static std::vector<float> CreateJointMask(const Model::Skeleton& skeleton, const std::string& rootJointName);
+
+	//ジョイント数を取得
+	const uint32_t GetJointCount() const { return static_cast<uint32_t>(translates_.size()); };
+
+	//ジョイントごとの移動を取得
+	std::vector<Vector3>& GetTranslates() { return translates_; };
+	const std::vector<Vector3>& GetTranslates() const { return translates_; };
+
+	//ジョイントごとの回転を取得
+	std::vector<Quaternion>& GetRotates() { return rotates_; };
+	const std::vector<Quaternion>& GetRotates() const { return rotates_; };
+
+	//ジョイントごとのスケールを取得
+	std::vector<Vector3>& GetScales() { return scales_; };
+	const std::vector<Vector3>& GetScales() const { return scales_; };
+
+private:
+	/// <summary>
+	/// ジョイント数を変更
+	/// </summary>
+	/// <param name="jointCount">ジョイント数</param>
+	void Resize(const uint32_t jointCount);
+
+	/// <summary>
+	/// 正規化線形補間（短い方の経路で補間する。Slerpより安く、ループをベクトル化しやすい）
+	/// </summary>
+	/// <param name="q0">クォータニオン1</param>
+	/// <param name="q1">クォータニオン2</param>
+	/// <param name="t">補間係数</param>
+	/// <returns>補間されたクォータニオン</returns>
+	static Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, const float t);
+
+private:
+	//ジョイントごとの移動
+	std::vector<Vector3> translates_{};
+
+	//ジョイントごとの回転
+	std::vector<Quaternion> rotates_{};
+
+	//ジョイントごとのスケール
+	std::vector<Vector3> scales_{};
+};
@@ -8,6 +8,7 @@
 #include "Material.h"
 #include "Engine/Base/TextureManager.h"
 #include "Engine/Math/MathFunction.h"
+#include <cassert>
 
 void Material::Initialize(const MaterialData& materialData)
 {
@@ -6,63 +6,54 @@
  */
 
 #include "Mesh.h"
+#include <cstring>
 
 void Mesh::Initialize(const MeshData& meshData, const bool hasSkinCluster)
 {
-    // メッシュデータの初期化
-    meshData_ = meshData;
+    Initialize(meshData.vertices, meshData.indices, meshData.materialIndex, hasSkinCluster);
+}
+
+void Mesh::Initialize(std::span<const VertexDataPosUVNormal> vertices, std::span<const uint32_t> indices, const uint32_t materialIndex, const bool hasSkinCluster)
+{
+    // メッシュデータの情報を設定（頂点とインデックスはモデルデータ側で保持する）
+    verticesSize_ = vertices.size();
+    indicesSize_ = indices.size();
+    materialIndex_ = materialIndex;
 
     // 頂点バッファの作成
-    CreateVertexBuffer(hasSkinCluster);
+    CreateVertexBuffer(vertices, hasSkinCluster);
 
     // インデックスバッファの作成
-    CreateIndexBuffer();
+    CreateIndexBuffer(indices);
 }
 
-void Mesh::CreateVertexBuffer(const bool hasSkinCluster)
+void Mesh::CreateVertexBuffer(std::span<const VertexDataPosUVNormal> vertices, const bool hasSkinCluster)
 {
     if (hasSkinCluster)
     {
-        //スキンクラスターを持っている場合の処理
-        CreateInputVerticesBuffer();
-        CreateOutputVerticesBuffer();
-        CreateVertexBufferViewForSkinCluster();
+        //スキンクラスターを持っている場合の処理（出力用の頂点バッファはモデルごとに作成する）
+        CreateInputVerticesBuffer(vertices);
         CreateSkinningInformationBuffer();
     }
     else
     {
         //スキンクラスターを持っていない場合の処理
-        CreateVertexBufferWithoutSkinCluster();
+        CreateVertexBufferWithoutSkinCluster(vertices);
     }
 }
 
-void Mesh::CreateInputVerticesBuffer()
+void Mesh::CreateInputVerticesBuffer(std::span<const VertexDataPosUVNormal> vertices)
 {
     //InputVerticesBufferの作成
     inputVerticesBuffer_ = std::make_unique<StructuredBuffer>();
-    inputVerticesBuffer_->Create(static_cast<uint32_t>(meshData_.vertices.size()), sizeof(VertexDataPosUVNormal));
+    inputVerticesBuffer_->Create(static_cast<uint32_t>(vertices.size()), sizeof(VertexDataPosUVNormal));
 
     //頂点データのマッピングとコピー
     VertexDataPosUVNormal* inputVertexData = static_cast<VertexDataPosUVNormal*>(inputVerticesBuffer_->Map());
-    std::memcpy(inputVertexData, meshData_.vertices.data(), sizeof(VertexDataPosUVNormal) * meshData_.vertices.size());
+    std::memcpy(inputVertexData, vertices.data(), sizeof(VertexDataPosUVNormal) * vertices.size());
     inputVerticesBuffer_->Unmap();
 }
 
-void Mesh::CreateOutputVerticesBuffer()
-{
-    //OutputVerticesBufferの作成
-    outputVerticesBuffer_ = std::make_unique<RWStructuredBuffer>();
-    outputVerticesBuffer_->Create(static_cast<uint32_t>(meshData_.vertices.size()), sizeof(VertexDataPosUVNormal));
-}
-
-void Mesh::CreateVertexBufferViewForSkinCluster()
-{
-    //頂点バッファビューを作成
-    vertexBufferView_.BufferLocation = outputVerticesBuffer_->GetGpuVirtualAddress();
-    vertexBufferView_.SizeInBytes = static_cast<UINT>(sizeof(VertexDataPosUVNormal) * meshData_.vertices.size());
-    vertexBufferView_.StrideInBytes = sizeof(VertexDataPosUVNormal);
-}
-
 void Mesh::CreateSkinningInformationBuffer()
 {
     //SkinningInformationBufferの作成
@@ -71,40 +62,40 @@ void Mesh::CreateSkinningInformationBuffer()
 
     //スキンニング情報を書き込む
     uint32_t* skinningInformationData = static_cast<uint32_t*>(skinningInformationBuffer_->Map());
-    *skinningInformationData = static_cast<uint32_t>(meshData_.vertices.size());
+    *skinningInformationData = static_cast<uint32_t>(verticesSize_);
     skinningInformationBuffer_->Unmap();
 }
 
-void Mesh::CreateVertexBufferWithoutSkinCluster()
+void Mesh::CreateVertexBufferWithoutSkinCluster(std::span<const VertexDataPosUVNormal> vertices)
 {
     //スキンクラスターを持っていない場合の頂点バッファを作成
     vertexBuffer_ = std::make_unique<UploadBuffer>();
-    vertexBuffer_->Create(sizeof(VertexDataPosUVNormal) * meshData_.vertices.size());
+    vertexBuffer_->Create(sizeof(VertexDataPosUVNormal) * vertices.size());
 
     //頂点バッファビューを作成
     vertexBufferView_.BufferLocation = vertexBuffer_->GetGpuVirtualAddress();
-    vertexBufferView_.SizeInBytes = static_cast<UINT>(sizeof(VertexDataPosUVNormal) * meshData_.vertices.size());
+    vertexBufferView_.SizeInBytes = static_cast<UINT>(sizeof(VertexDataPosUVNormal) * vertices.size());
     vertexBufferView_.StrideInBytes = sizeof(VertexDataPosUVNormal);
 
     //頂点バッファにデータを書き込む
     VertexDataPosUVNormal* vertexData = static_cast<VertexDataPosUVNormal*>(vertexBuffer_->Map());
-    std::memcpy(vertexData, meshData_.vertices.data(), sizeof(VertexDataPosUVNormal) * meshData_.vertices.size());
+    std::memcpy(vertexData, vertices.data(), sizeof(VertexDataPosUVNormal) * vertices.size());
     vertexBuffer_->Unmap();
 }
 
-void Mesh::CreateIndexBuffer()
+void Mesh::CreateIndexBuffer(std::span<const uint32_t> indices)
 {
     //インデックスバッファの作成
     indexBuffer_ = std::make_unique<UploadBuffer>();
-    indexBuffer_->Create(sizeof(uint32_t) * meshData_.indices.size());
+    indexBuffer_->Create(sizeof(uint32_t) * indices.size());
 
     //インデックスバッファビューの作成
     indexBufferView_.BufferLocation = indexBuffer_->GetGpuVirtualAddress();
-    indexBufferView_.SizeInBytes = static_cast<UINT>(sizeof(uint32_t) * meshData_.indices.size());
+    indexBufferView_.SizeInBytes = static_cast<UINT>(sizeof(uint32_t) * indices.size());
     indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
 
     //インデックスバッファにデータを書き込む
     uint32_t* indexData = static_cast<uint32_t*>(indexBuffer_->Map());
-    std::memcpy(indexData, meshData_.indices.data(), sizeof(uint32_t) * meshData_.indices.size());
+    std::memcpy(indexData, indices.data(), sizeof(uint32_t) * indices.size());
     indexBuffer_->Unmap();
 }
\ No newline at end of file
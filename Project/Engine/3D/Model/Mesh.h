@@ -26,33 +26,39 @@ public:
 	};
 
 	/// <summary>
-	/// 初期化
+	/// 初期化（頂点とインデックスはバッファに書き込むだけで保持しない）
 	/// </summary>
 	/// <param name="meshData">メッシュデータ</param>
 	/// <param name="hasSkinCluster">スキンクラスターを持っているか</param>
 	void Initialize(const MeshData& meshData, const bool hasSkinCluster);
 
-	//頂点バッファビューを作成
+	/// <summary>
+	/// 初期化（ベイクしたファイルなどの頂点とインデックスをそのままバッファに書き込む）
+	/// </summary>
+	/// <param name="vertices">頂点</param>
+	/// <param name="indices">インデックス</param>
+	/// <param name="materialIndex">マテリアルのインデックス</param>
+	/// <param name="hasSkinCluster">スキンクラスターを持っているか</param>
+	void Initialize(std::span<const VertexDataPosUVNormal> vertices, std::span<const uint32_t> indices, const uint32_t materialIndex, const bool hasSkinCluster);
+
+	//頂点バッファビューを作成（スキンクラスターを持っている場合はモデルごとの出力用の頂点バッファを使う）
 	const D3D12_VERTEX_BUFFER_VIEW& GetVertexBufferView() const { return vertexBufferView_; };
 
 	//インデックスバッファビューを作成
 	const D3D12_INDEX_BUFFER_VIEW& GetIndexBufferView() const { return indexBufferView_; };
 
 	//マテリアルのインデックスの取得
-	const uint32_t GetMaterialIndex() const { return meshData_.materialIndex; };
+	const uint32_t GetMaterialIndex() const { return materialIndex_; };
 
 	//頂点のサイズを取得
-	const size_t GetVerticesSize() const { return meshData_.vertices.size(); };
+	const size_t GetVerticesSize() const { return verticesSize_; };
 
 	//インデックスのサイズを取得
-	const size_t GetIndicesSize() const { return meshData_.indices.size(); };
+	const size_t GetIndicesSize() const { return indicesSize_; };
 
 	//入力用の頂点バッファを取得
 	StructuredBuffer* GetInputVerticesBuffer() const { return inputVerticesBuffer_.get(); };
 
-	//出力用の頂点バッファを取得
-	RWStructuredBuffer* GetOutputVerticesBuffer() const { return outputVerticesBuffer_.get(); };
-
 	//スキニング用のインフォメーションバッファを取得
 	UploadBuffer* GetSkinningInformationBuffer() const { return skinningInformationBuffer_.get(); };
 
@@ -60,23 +66,15 @@ private:
 	/// <summary>
 	/// 頂点バッファを作成
 	/// </summary>
+	/// <param name="vertices">頂点</param>
 	/// <param name="hasSkinCluster">スキンクラスターを持っているか</param>
-	void CreateVertexBuffer(const bool hasSkinCluster);
+	void CreateVertexBuffer(std::span<const VertexDataPosUVNormal> vertices, const bool hasSkinCluster);
 
 	/// <summary>
 	/// 入力用の頂点バッファを作成
 	/// </summary>
-	void CreateInputVerticesBuffer();
-
-	/// <summary>
-	/// 出力用の頂点バッファを作成
-	/// </summary>
-	void CreateOutputVerticesBuffer();
-
-	/// <summary>
-	/// スキンクラスターを基に頂点バッファビューを作成
-	/// </summary>
-	void CreateVertexBufferViewForSkinCluster();
+	/// <param name="vertices">頂点</param>
+	void CreateInputVerticesBuffer(std::span<const VertexDataPosUVNormal> vertices);
 
 	/// <summary>
 	/// スキニングインフォメーションバッファを作成
@@ -86,22 +84,26 @@ private:
 	/// <summary>
 	/// スキンクラスターを持っていない場合の頂点バッファを作成
 	/// </summary>
-	void CreateVertexBufferWithoutSkinCluster();
+	/// <param name="vertices">頂点</param>
+	void CreateVertexBufferWithoutSkinCluster(std::span<const VertexDataPosUVNormal> vertices);
 
 	/// <summary>
 	/// インデックスバッファを作成
 	/// </summary>
-	void CreateIndexBuffer();
+	/// <param name="indices">インデックス</param>
+	void CreateIndexBuffer(std::span<const uint32_t> indices);
 
 private:
-	MeshData meshData_{};
+	size_t verticesSize_ = 0;
+
+	size_t indicesSize_ = 0;
+
+	uint32_t materialIndex_ = 0;
 
 	std::unique_ptr<UploadBuffer> vertexBuffer_ = nullptr;
 
 	std::unique_ptr<StructuredBuffer> inputVerticesBuffer_ = nullptr;
 
-	std::unique_ptr<RWStructuredBuffer> outputVerticesBuffer_ = nullptr;
-
 	D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
 
 	std::unique_ptr<UploadBuffer> indexBuffer_ = nullptr;
@@ -6,13 +6,93 @@
  */
 
 #include "Model.h"
+#include "SkinningMath.h"
 #include "Engine/Math/MathFunction.h"
 #include <cassert>
+#include <cstring>
 
-void Model::Initialize(const ModelData& modelData, const DrawPass drawPass)
+std::shared_ptr<const Model::SharedData> Model::CreateSharedData(ModelData modelData)
 {
-	//モデルデータの初期化
-	modelData_ = modelData;
+	std::shared_ptr<SharedData> sharedData = std::make_shared<SharedData>();
+	sharedData->modelData = std::move(modelData);
+
+	//メッシュの作成
+	for (size_t i = 0; i < sharedData->modelData.meshData.size(); ++i)
+	{
+		Mesh* mesh = new Mesh();
+		mesh->Initialize(sharedData->modelData.meshData[i], !sharedData->modelData.skinClusterData[i].empty());
+		sharedData->meshes.push_back(std::unique_ptr<Mesh>(mesh));
+		sharedData->meshVertices.push_back(sharedData->modelData.meshData[i].vertices);
+	}
+
+	//バインドポーズのスケルトンの作成
+	CreateSkeleton(sharedData->modelData.rootNode, sharedData->bindPoseSkeleton);
+
+	//親の番号を連続した配列にまとめる（CreateJointで親が先に並んでいる）
+	for (const Joint& joint : sharedData->bindPoseSkeleton.joints)
+	{
+		sharedData->jointParents.push_back(joint.parent ? *joint.parent : -1);
+	}
+
+	//共有するスキンクラスターの作成
+	CreateSharedSkinClusters(*sharedData);
+
+	return sharedData;
+}
+
+std::shared_ptr<const Model::SharedData> Model::CreateSharedData(const BakedModelData& bakedModelData)
+{
+	std::shared_ptr<SharedData> sharedData = std::make_shared<SharedData>();
+	sharedData->storage = bakedModelData.storage;
+	sharedData->modelData.materialData = bakedModelData.materialData;
+	sharedData->modelData.rootNode = bakedModelData.rootNode;
+
+	//バインドポーズのスケルトンの作成（ベイクしたInfluenceのジョイントの番号はこの順番で解決済み）
+	CreateSkeleton(sharedData->modelData.rootNode, sharedData->bindPoseSkeleton);
+	for (const Joint& joint : sharedData->bindPoseSkeleton.joints)
+	{
+		sharedData->jointParents.push_back(joint.parent ? *joint.parent : -1);
+	}
+
+	//MatrixPaletteの逆バインドポーズ行列をコピー
+	for (const std::span<const Matrix4x4>& inverseBindPoseMatrices : bakedModelData.paletteInverseBindPoseMatrices)
+	{
+		sharedData->paletteInverseBindPoseMatrices.emplace_back(inverseBindPoseMatrices.begin(), inverseBindPoseMatrices.end());
+	}
+
+	//メッシュとスキンクラスターの作成（マップしたファイルから直接バッファに書き込む）
+	sharedData->skinClusters.resize(bakedModelData.meshData.size());
+	for (size_t i = 0; i < bakedModelData.meshData.size(); ++i)
+	{
+		const BakedMeshData& meshData = bakedModelData.meshData[i];
+		const bool hasSkinCluster = !meshData.influences.empty();
+		Mesh* mesh = new Mesh();
+		mesh->Initialize(meshData.vertices, meshData.indices, meshData.materialIndex, hasSkinCluster);
+		sharedData->meshes.push_back(std::unique_ptr<Mesh>(mesh));
+		sharedData->meshVertices.push_back(meshData.vertices);
+
+		//スキンクラスターがなければ飛ばす
+		if (!hasSkinCluster)
+		{
+			continue;
+		}
+
+		//influence用のResourceを確保して書き込む
+		SharedSkinCluster& skinCluster = sharedData->skinClusters[i];
+		skinCluster.paletteIndex = meshData.paletteIndex;
+		skinCluster.influences.assign(meshData.influences.begin(), meshData.influences.end());
+		skinCluster.influenceResource = std::make_unique<StructuredBuffer>();
+		skinCluster.influenceResource->Create((uint32_t)meshData.influences.size(), sizeof(VertexInfluence));
+		std::memcpy(skinCluster.influenceResource->Map(), meshData.influences.data(), meshData.influences.size_bytes());
+	}
+
+	return sharedData;
+}
+
+void Model::Initialize(const std::shared_ptr<const SharedData>& sharedData, const DrawPass drawPass)
+{
+	//共有データを設定
+	sharedData_ = sharedData;
 
 	//描画パスを設定
 	drawPass_ = drawPass;
@@ -20,14 +100,14 @@ void Model::Initialize(const ModelData& modelData, const DrawPass drawPass)
 	//使用中のフラグを立てる
 	isInUse_ = true;
 
-	//メッシュの作成
-	CreateMeshes();
-
 	//マテリアルの作成
 	CreateMaterials();
 
 	//スケルトンの作成
-	CreateSkeleton();
+	skeleton_ = sharedData_->bindPoseSkeleton;
+
+	//ジョイントの行列の配列を作成
+	CreateJointMatrices();
 
 	//ジョイントのワールドトランスフォームを作成
 	CreateJointWorldTransforms();
@@ -41,11 +121,14 @@ void Model::Initialize(const ModelData& modelData, const DrawPass drawPass)
 
 void Model::Update(WorldTransform& worldTransform)
 {
-	//スケルトンの更新
-	UpdateSkeleton(worldTransform);
+	//アニメーションの処理などで先に更新されていなければスケルトンとスキンクラスターを更新
+	if (isPoseDirty_)
+	{
+		UpdatePose();
+	}
 
-	//スキンクラスターの更新
-	UpdateSkinClusters();
+	//Scale成分を取り除いてワールド行列を掛ける
+	SkinningMath::CalculateJointWorldMatrices(skeletonSpaceMatrices_, worldTransform.matWorld_, jointWorldTransforms_);
 
 	//マテリアルの更新
 	UpdateMaterials();
@@ -54,6 +137,18 @@ void Model::Update(WorldTransform& worldTransform)
 	ApplyRootTransform(worldTransform);
 }
 
+void Model::UpdatePose()
+{
+	//スケルトンの更新
+	UpdateSkeleton();
+
+	//スキンクラスターの更新
+	UpdateSkinClusters();
+
+	//更新済みにする
+	isPoseDirty_ = false;
+}
+
 void Model::Release()
 {
 	//使用されていない状態のフラグを立てる
@@ -63,8 +158,8 @@ void Model::Release()
 void Model::Acquire()
 {
 	//スケルトンの再初期化
-	skeleton_.Reset();
-	CreateSkeleton();
+	skeleton_ = sharedData_->bindPoseSkeleton;
+	isPoseDirty_ = true;
 
 	//マテリアルの再作成
 	materials_.clear();
@@ -82,31 +177,40 @@ void Model::Draw(const WorldTransform& worldTransform, const Camera& camera)
 	Renderer* renderer_ = Renderer::GetInstance();
 
 	//ソートオブジェクトの追加
-	for (uint32_t i = 0; i < meshes_.size(); ++i)
+	for (uint32_t i = 0; i < sharedData_->meshes.size(); ++i)
 	{
+		//メッシュを取得
+		const Mesh* mesh = sharedData_->meshes[i].get();
+
 		//マテリアルのインデックスを取得
-		uint32_t materialIndex = meshes_[i]->GetMaterialIndex();
+		uint32_t materialIndex = mesh->GetMaterialIndex();
+
+		//スキンクラスターを持っているか
+		const bool hasSkinCluster = !sharedData_->skinClusters[i].influences.empty();
+
+		//頂点バッファビューを取得（スキンクラスターを持っている場合はスキニング後の頂点を使う）
+		const D3D12_VERTEX_BUFFER_VIEW& vertexBufferView = hasSkinCluster ? skinClusters_[i].vertexBufferView : mesh->GetVertexBufferView();
 
 		//オブジェクトの追加
-		renderer_->AddObject(meshes_[i]->GetVertexBufferView(), meshes_[i]->GetIndexBufferView(), materials_[materialIndex]->GetConstantBuffer()->GetGpuVirtualAddress(),
+		renderer_->AddObject(vertexBufferView, mesh->GetIndexBufferView(), materials_[materialIndex]->GetConstantBuffer()->GetGpuVirtualAddress(),
 			worldTransform.GetConstantBuffer()->GetGpuVirtualAddress(), camera.GetConstantBuffer()->GetGpuVirtualAddress(),
-			materials_[materialIndex]->GetTexture()->GetSRVHandle(), materials_[materialIndex]->GetMaskTexture()->GetSRVHandle(), UINT(meshes_[i]->GetIndicesSize()), drawPass_);
+			materials_[materialIndex]->GetTexture()->GetSRVHandle(), materials_[materialIndex]->GetMaskTexture()->GetSRVHandle(), UINT(mesh->GetIndicesSize()), drawPass_);
 
 		//スキンクラスターを持っている場合
-		if (!modelData_.skinClusterData[i].empty())
+		if (hasSkinCluster)
 		{
 			//スキニングオブジェクトの追加
-			renderer_->AddSkinningObject(skinClusters_[i].paletteResource->GetSRVHandle(), meshes_[i]->GetInputVerticesBuffer()->GetSRVHandle(),
-				skinClusters_[i].influenceResource->GetSRVHandle(), meshes_[i]->GetSkinningInformationBuffer()->GetGpuVirtualAddress(),
-				meshes_[i]->GetOutputVerticesBuffer(), UINT(meshes_[i]->GetVerticesSize()));
+			renderer_->AddSkinningObject(skinPalettes_[sharedData_->skinClusters[i].paletteIndex].paletteResource->GetSRVHandle(), mesh->GetInputVerticesBuffer()->GetSRVHandle(),
+				sharedData_->skinClusters[i].influenceResource->GetSRVHandle(), mesh->GetSkinningInformationBuffer()->GetGpuVirtualAddress(),
+				skinClusters_[i].outputVerticesResource.get(), UINT(mesh->GetVerticesSize()));
 		}
 
 		//影を描画する場合
 		if (castShadows_)
 		{
 			//影の追加
-			renderer_->AddShadowObject(meshes_[i]->GetVertexBufferView(), meshes_[i]->GetIndexBufferView(),
-				worldTransform.GetConstantBuffer()->GetGpuVirtualAddress(), UINT(meshes_[i]->GetIndicesSize()));
+			renderer_->AddShadowObject(vertexBufferView, mesh->GetIndexBufferView(),
+				worldTransform.GetConstantBuffer()->GetGpuVirtualAddress(), UINT(mesh->GetIndicesSize()));
 		}
 	}
 
@@ -121,15 +225,16 @@ void Model::Draw(const WorldTransform& worldTransform, const Camera& camera)
 	}
 }
 
-void Model::CreateSkeleton()
+void Model::CreateSkeleton(const Node& rootNode, Skeleton& skeleton)
 {
 	//ジョイントの作成
-	skeleton_.root = CreateJoint(modelData_.rootNode, {}, skeleton_.joints);
+	skeleton.Reset();
+	skeleton.root = CreateJoint(rootNode, {}, skeleton.joints);
 
 	//名前とindexのマッピングを行いアクセスしやすくする
-	for (const Joint& joint : skeleton_.joints)
+	for (const Joint& joint : skeleton.joints)
 	{
-		skeleton_.jointMap.emplace(joint.name, joint.index);
+		skeleton.jointMap.emplace(joint.name, joint.index);
 	}
 }
 
@@ -166,52 +271,48 @@ void Model::CreateJointWorldTransforms()
 	}
 }
 
-void Model::CreateSkinClusters()
+void Model::CreateSharedSkinClusters(SharedData& sharedData)
 {
+	//バインドポーズのスケルトンとモデルデータを取得
+	const Skeleton& skeleton = sharedData.bindPoseSkeleton;
+	const ModelData& modelData = sharedData.modelData;
+
+	//MatrixPaletteごとに逆バインドポーズ行列を設定したジョイント
+	std::vector<std::vector<bool>> paletteUsedJoints;
+
 	//全てのメッシュ分のスキンクラスターを生成
-	skinClusters_.resize(meshes_.size());
-	for (int32_t i = 0; i < meshes_.size(); ++i)
+	sharedData.skinClusters.resize(sharedData.meshes.size());
+	for (size_t i = 0; i < sharedData.meshes.size(); ++i)
 	{
 		//スキンクラスターデータがなければ飛ばす
-		if (modelData_.skinClusterData[i].empty())
+		if (modelData.skinClusterData[i].empty())
 		{
 			continue;
 		}
 
-		//palette用のResourceを確保
-		skinClusters_[i].paletteResource = std::make_unique<StructuredBuffer>();
-		skinClusters_[i].paletteResource->Create(uint32_t(skeleton_.joints.size()), sizeof(WellForGPU));
-		WellForGPU* mappedPalette = static_cast<WellForGPU*>(skinClusters_[i].paletteResource->Map());
-		skinClusters_[i].mappedPalette = { mappedPalette,skeleton_.joints.size() };//spanを使ってアクセスするようにする
-
-		//influence用のResourceを確保。頂点ごとにinfluenced情報を追加できるようにする
-		skinClusters_[i].influenceResource = std::make_unique<StructuredBuffer>();
-		skinClusters_[i].influenceResource->Create((uint32_t)modelData_.meshData[i].vertices.size(), sizeof(VertexInfluence));
-		VertexInfluence* mappedInfluence = static_cast<VertexInfluence*>(skinClusters_[i].influenceResource->Map());
-		std::memset(mappedInfluence, 0, sizeof(VertexInfluence) * modelData_.meshData[i].vertices.size());//0埋め。weightを0にしておく。
-		skinClusters_[i].mappedInfluence = { mappedInfluence, modelData_.meshData[i].vertices.size() };
+		//頂点ごとにinfluenced情報を追加できるようにする
+		SharedSkinCluster& skinCluster = sharedData.skinClusters[i];
+		skinCluster.influences.assign(modelData.meshData[i].vertices.size(), VertexInfluence{});//0埋め。weightを0にしておく。
 
 		//InverseBindPoseMatrixを格納する場所を作成して、単位行列で埋める
-		skinClusters_[i].inverseBindPoseMatrices.resize(skeleton_.joints.size());
-		for (Matrix4x4& inverseBindPoseMatrix : skinClusters_[i].inverseBindPoseMatrices)
-		{
-			inverseBindPoseMatrix = Mathf::MakeIdentity4x4();
-		}
+		std::vector<Matrix4x4> inverseBindPoseMatrices(skeleton.joints.size(), Mathf::MakeIdentity4x4());
+		std::vector<bool> isUsedJoints(skeleton.joints.size(), false);
 
 		//ModelDataを解析してInfluenceを埋める
-		for (const auto& jointWeight : modelData_.skinClusterData[i])//ModelのSkinClusterの情報を解析
+		for (const auto& jointWeight : modelData.skinClusterData[i])//ModelのSkinClusterの情報を解析
 		{
-			auto it = skeleton_.jointMap.find(jointWeight.first);//JointWeight,firstはjoint名なので、skeletonに対象となるjointが含まれているか判断
-			if (it == skeleton_.jointMap.end())//そんな名前のJointは存在しない。なので次に回す
+			auto it = skeleton.jointMap.find(jointWeight.first);//JointWeight,firstはjoint名なので、skeletonに対象となるjointが含まれているか判断
+			if (it == skeleton.jointMap.end())//そんな名前のJointは存在しない。なので次に回す
 			{
 				continue;
 			}
 
 			//(*it).secondにはjointのindexが入っているので、該当のindexのinverseBindPoseMatrixを代入
-			skinClusters_[i].inverseBindPoseMatrices[(*it).second] = jointWeight.second.inverseBindPoseMatrix;
+			inverseBindPoseMatrices[(*it).second] = jointWeight.second.inverseBindPoseMatrix;
+			isUsedJoints[(*it).second] = true;
 			for (const auto& vertexWeight : jointWeight.second.vertexWeights)
 			{
-				auto& currentInfluence = skinClusters_[i].mappedInfluence[vertexWeight.vertexIndex];//該当のvertexIndexのinfluence情報を参照しておく
+				auto& currentInfluence = skinCluster.influences[vertexWeight.vertexIndex];//該当のvertexIndexのinfluence情報を参照しておく
 				for (uint32_t index = 0; index < kNumMaxInfluence; ++index)//空いているところに入れる
 				{
 					if (currentInfluence.weights[index] == 0.0f)//Weight == 0が空いている状態なので、その場所にweightとjointのindexを代入
@@ -223,27 +324,97 @@ void Model::CreateSkinClusters()
 				}
 			}
 		}
+
+		//使っているジョイントの逆バインドポーズ行列が矛盾しないMatrixPaletteを探す
+		uint32_t paletteIndex = 0;
+		for (; paletteIndex < sharedData.paletteInverseBindPoseMatrices.size(); ++paletteIndex)
+		{
+			const std::vector<Matrix4x4>& paletteMatrices = sharedData.paletteInverseBindPoseMatrices[paletteIndex];
+			bool isCompatible = true;
+			for (size_t jointIndex = 0; jointIndex < skeleton.joints.size() && isCompatible; ++jointIndex)
+			{
+				isCompatible = !isUsedJoints[jointIndex] || !paletteUsedJoints[paletteIndex][jointIndex] ||
+					std::memcmp(&paletteMatrices[jointIndex], &inverseBindPoseMatrices[jointIndex], sizeof(Matrix4x4)) == 0;
+			}
+			if (isCompatible)
+			{
+				break;
+			}
+		}
+
+		//見つからなければMatrixPaletteを追加する
+		if (paletteIndex == sharedData.paletteInverseBindPoseMatrices.size())
+		{
+			sharedData.paletteInverseBindPoseMatrices.emplace_back(skeleton.joints.size(), Mathf::MakeIdentity4x4());
+			paletteUsedJoints.emplace_back(skeleton.joints.size(), false);
+		}
+
+		//使っているジョイントの逆バインドポーズ行列をMatrixPaletteにまとめる
+		for (size_t jointIndex = 0; jointIndex < skeleton.joints.size(); ++jointIndex)
+		{
+			if (isUsedJoints[jointIndex])
+			{
+				sharedData.paletteInverseBindPoseMatrices[paletteIndex][jointIndex] = inverseBindPoseMatrices[jointIndex];
+				paletteUsedJoints[paletteIndex][jointIndex] = true;
+			}
+		}
+		skinCluster.paletteIndex = paletteIndex;
+
+		//influence用のResourceを確保して書き込む
+		skinCluster.influenceResource = std::make_unique<StructuredBuffer>();
+		skinCluster.influenceResource->Create((uint32_t)skinCluster.influences.size(), sizeof(VertexInfluence));
+		std::memcpy(skinCluster.influenceResource->Map(), skinCluster.influences.data(), sizeof(VertexInfluence) * skinCluster.influences.size());
 	}
 }
 
-void Model::CreateMeshes()
+void Model::CreateJointMatrices()
 {
-	//メッシュの作成
-	for (int32_t i = 0; i < modelData_.meshData.size(); ++i)
+	//ジョイントごとの行列を単位行列で初期化
+	localMatrices_.assign(skeleton_.joints.size(), Mathf::MakeIdentity4x4());
+	skeletonSpaceMatrices_.assign(skeleton_.joints.size(), Mathf::MakeIdentity4x4());
+}
+
+void Model::CreateSkinClusters()
+{
+	//MatrixPalette用のResourceを確保
+	skinPalettes_.resize(sharedData_->paletteInverseBindPoseMatrices.size());
+	for (SkinPalette& skinPalette : skinPalettes_)
 	{
-		Mesh* mesh = new Mesh();
-		mesh->Initialize(modelData_.meshData[i], !modelData_.skinClusterData[i].empty());
-		meshes_.push_back(std::unique_ptr<Mesh>(mesh));
+		skinPalette.paletteResource = std::make_unique<StructuredBuffer>();
+		skinPalette.paletteResource->Create(uint32_t(skeleton_.joints.size()), sizeof(WellForGPU));
+		WellForGPU* mappedPalette = static_cast<WellForGPU*>(skinPalette.paletteResource->Map());
+		skinPalette.mappedPalette = { mappedPalette,skeleton_.joints.size() };//spanを使ってアクセスするようにする
+	}
+
+	//全てのメッシュ分のスキンクラスターを生成
+	skinClusters_.resize(sharedData_->meshes.size());
+	for (size_t i = 0; i < sharedData_->meshes.size(); ++i)
+	{
+		//スキンクラスターデータがなければ飛ばす
+		if (sharedData_->skinClusters[i].influences.empty())
+		{
+			continue;
+		}
+
+		//スキニング後の頂点を書き込むResourceを確保
+		const size_t verticesSize = sharedData_->meshes[i]->GetVerticesSize();
+		skinClusters_[i].outputVerticesResource = std::make_unique<RWStructuredBuffer>();
+		skinClusters_[i].outputVerticesResource->Create(static_cast<uint32_t>(verticesSize), sizeof(VertexDataPosUVNormal));
+
+		//頂点バッファビューを作成
+		skinClusters_[i].vertexBufferView.BufferLocation = skinClusters_[i].outputVerticesResource->GetGpuVirtualAddress();
+		skinClusters_[i].vertexBufferView.SizeInBytes = static_cast<UINT>(sizeof(VertexDataPosUVNormal) * verticesSize);
+		skinClusters_[i].vertexBufferView.StrideInBytes = sizeof(VertexDataPosUVNormal);
 	}
 }
 
 void Model::CreateMaterials()
 {
 	//マテリアルの作成
-	for (uint32_t i = 0; i < modelData_.materialData.size(); ++i)
+	for (uint32_t i = 0; i < sharedData_->modelData.materialData.size(); ++i)
 	{
 		Material* material = new Material();
-		material->Initialize(modelData_.materialData[i]);
+		material->Initialize(sharedData_->modelData.materialData[i]);
 		materials_.push_back(std::unique_ptr<Material>(material));
 	}
 }
@@ -265,9 +436,10 @@ void Model::CreateBoneVertices(int32_t parentIndex)
 	const Joint& parentJoint = skeleton_.joints[parentIndex];
 	for (int32_t childIndex : parentJoint.children)
 	{
-		const Joint& childJoint = skeleton_.joints[childIndex];
-		boneVertices_.push_back({ parentJoint.skeletonSpaceMatrix.m[3][0],parentJoint.skeletonSpaceMatrix.m[3][1],parentJoint.skeletonSpaceMatrix.m[3][2],1.0f });
-		boneVertices_.push_back({ childJoint.skeletonSpaceMatrix.m[3][0],childJoint.skeletonSpaceMatrix.m[3][1],childJoint.skeletonSpaceMatrix.m[3][2],1.0f });
+		const Matrix4x4& parentMatrix = skeletonSpaceMatrices_[parentIndex];
+		const Matrix4x4& childMatrix = skeletonSpaceMatrices_[childIndex];
+		boneVertices_.push_back({ parentMatrix.m[3][0],parentMatrix.m[3][1],parentMatrix.m[3][2],1.0f });
+		boneVertices_.push_back({ childMatrix.m[3][0],childMatrix.m[3][1],childMatrix.m[3][2],1.0f });
 		CreateBoneVertices(childIndex);
 	}
 }
@@ -303,53 +475,21 @@ void Model::CreateBoneVertexBuffer()
 	boneVertexBuffer_->Unmap();
 }
 
-void Model::UpdateSkeleton(const WorldTransform& worldTransform)
+void Model::UpdateSkeleton()
 {
-	//全てのJointの更新。親が若いので通常ループで処理可能になっている
-	for (Joint& joint : skeleton_.joints)
-	{
-		joint.localMatrix = Mathf::MakeAffineMatrix(joint.scale, joint.rotate, joint.translate);
-		if (joint.parent)//親がいれば親の行列を掛ける
-		{
-			joint.skeletonSpaceMatrix = joint.localMatrix * skeleton_.joints[*joint.parent].skeletonSpaceMatrix;
-		}
-		else//親がいないのでlocalMatrixとskeletonSpaceMatrixは一致する
-		{
-			joint.skeletonSpaceMatrix = joint.localMatrix;
-		}
-		//Scale成分を取り除く
-		Matrix4x4 jointWorldTransform = joint.skeletonSpaceMatrix;
-		for (int i = 0; i < 3; ++i)
-		{
-			float scale = std::sqrt(jointWorldTransform.m[i][0] * jointWorldTransform.m[i][0] +
-				jointWorldTransform.m[i][1] * jointWorldTransform.m[i][1] +
-				jointWorldTransform.m[i][2] * jointWorldTransform.m[i][2]);
-			for (int j = 0; j < 3; ++j)
-			{
-				jointWorldTransform.m[i][j] /= scale;
-			}
-		}
-		//ワールド行列を掛ける
-		jointWorldTransforms_[joint.index].matWorld_ = jointWorldTransform * worldTransform.matWorld_;
-	}
+	//全てのJointのローカル行列をまとめて作成
+	SkinningMath::CalculateLocalMatrices(skeleton_.joints, localMatrices_);
+
+	//親が若いので前から順に親の行列を掛けてスケルトン空間の行列を求める
+	SkinningMath::CalculateSkeletonSpaceMatrices(localMatrices_, sharedData_->jointParents, skeletonSpaceMatrices_);
 }
 
 void Model::UpdateSkinClusters()
 {
-	//スキンクラスターの更新
-	for (int32_t i = 0; i < meshes_.size(); ++i)
+	//MatrixPaletteごとに1回だけ計算する（同じパレットを使うメッシュで共有する）
+	for (size_t i = 0; i < skinPalettes_.size(); ++i)
 	{
-		if (modelData_.skinClusterData[i].empty())
-		{
-			continue;
-		}
-
-		for (size_t jointIndex = 0; jointIndex < skeleton_.joints.size(); ++jointIndex)
-		{
-			assert(jointIndex < skinClusters_[i].inverseBindPoseMatrices.size());
-			skinClusters_[i].mappedPalette[jointIndex].skeletonSpaceMatrix = skinClusters_[i].inverseBindPoseMatrices[jointIndex] * skeleton_.joints[jointIndex].skeletonSpaceMatrix;
-			skinClusters_[i].mappedPalette[jointIndex].skeletonSpaceInverseTransposeMatrix = Mathf::Transpose(Mathf::Inverse(skinClusters_[i].mappedPalette[jointIndex].skeletonSpaceMatrix));
-		}
+		SkinningMath::CalculatePalette(sharedData_->paletteInverseBindPoseMatrices[i], skeletonSpaceMatrices_, skinPalettes_[i].mappedPalette);
 	}
 }
 
@@ -380,7 +520,7 @@ void Model::ApplyRootTransform(WorldTransform& worldTransform)
 	//スキンクラスターを持っていない場合にルートのローカル行列をワールド行列に適用
 	if (boneVertices_.empty())
 	{
-		worldTransform.matWorld_ = modelData_.rootNode.localMatrix * worldTransform.matWorld_;
+		worldTransform.matWorld_ = sharedData_->modelData.rootNode.localMatrix * worldTransform.matWorld_;
 		worldTransform.TransferMatrix();
 	}
 }
\ No newline at end of file
@@ -35,8 +35,8 @@ public:
 		Vector3 scale;//scale
 		Quaternion rotate;//rotate
 		Vector3 translate;//translate
-		Matrix4x4 localMatrix;//LocalMatrix
-		Matrix4x4 skeletonSpaceMatrix;//SkeletonSpaceでの変換行列
+		Matrix4x4 localMatrix;//LocalMatrix（バインドポーズの値。毎フレームの値はModelがまとめて持つ）
+		Matrix4x4 skeletonSpaceMatrix;//SkeletonSpaceでの変換行列（同上。GetSkeletonSpaceMatricesで取得する）
 		std::string name;//名前
 		std::vector<int32_t> children;//子JointのIndexのリスト。いなければ空
 		int32_t index;//自身のIndex
@@ -87,16 +87,30 @@ public:
 		Matrix4x4 skeletonSpaceInverseTransposeMatrix;//法線用
 	};
 
-	//スキンクラスターのデータをまとめた構造体
+	//MatrixPaletteをまとめた構造体（モデルごとに持ち、逆バインドポーズ行列が同じメッシュで共有する）
+	struct SkinPalette
+	{
+		std::unique_ptr<StructuredBuffer> paletteResource;
+		std::span<WellForGPU> mappedPalette;
+	};
+
+	//スキンクラスターのデータをまとめた構造体（モデルごとに持つ）
 	struct SkinCluster
 	{
-		std::vector<Matrix4x4> inverseBindPoseMatrices;
+		//スキニング後の頂点
+		std::unique_ptr<RWStructuredBuffer> outputVerticesResource;
+		D3D12_VERTEX_BUFFER_VIEW vertexBufferView;
+	};
+
+	//スキンクラスターの変更されないデータをまとめた構造体（同じモデルで共有する）
+	struct SharedSkinCluster
+	{
+		//使用するMatrixPaletteの番号
+		uint32_t paletteIndex = 0;
 		//Influence
 		std::unique_ptr<StructuredBuffer> influenceResource;
-		std::span<VertexInfluence> mappedInfluence;
-		//MatrixPalette
-		std::unique_ptr<StructuredBuffer> paletteResource;
-		std::span<WellForGPU> mappedPalette;
+		//CPUでのスキニング用のInfluence（アップロードヒープから読み戻さないように別に持つ）
+		std::vector<VertexInfluence> influences;
 	};
 
 	//モデルデータをまとめた構造体
@@ -108,12 +122,71 @@ public:
 		Node rootNode;
 	};
 
+	//ベイクしたファイルのメッシュのデータ（マップしたファイルを参照する）
+	struct BakedMeshData
+	{
+		std::span<const VertexDataPosUVNormal> vertices;
+		std::span<const uint32_t> indices;
+		uint32_t materialIndex;
+		//ジョイントの番号を解決済みのInfluence（スキンクラスターを持っていない場合は空）
+		std::span<const VertexInfluence> influences;
+		//使用するMatrixPaletteの番号
+		uint32_t paletteIndex;
+	};
+
+	//ベイクしたファイルのモデルデータ
+	struct BakedModelData
+	{
+		std::vector<BakedMeshData> meshData;
+		//MatrixPaletteごとの逆バインドポーズ行列
+		std::vector<std::span<const Matrix4x4>> paletteInverseBindPoseMatrices;
+		std::vector<Material::MaterialData> materialData;
+		Node rootNode;
+		//頂点などの参照先（マップしたファイル）
+		std::shared_ptr<const void> storage;
+	};
+
+	//同じモデルの全てのインスタンスで共有する変更されないデータ
+	struct SharedData
+	{
+		//モデルデータ（頂点、インデックス、スキンクラスター、ノード階層。ベイクしたファイルから作成した場合はマテリアルとノード階層のみ）
+		ModelData modelData;
+		//メッシュごとのスキニング前の頂点（モデルデータの頂点またはマップしたファイルを参照する）
+		std::vector<std::span<const VertexDataPosUVNormal>> meshVertices;
+		//頂点などの参照先を保持する（ベイクしたファイルから作成した場合はマップしたファイル）
+		std::shared_ptr<const void> storage;
+		//メッシュ（頂点バッファとインデックスバッファ）
+		std::vector<std::unique_ptr<Mesh>> meshes;
+		//メッシュごとのスキンクラスター（スキンクラスターを持っていない場合は空）
+		std::vector<SharedSkinCluster> skinClusters;
+		//MatrixPaletteごとの逆バインドポーズ行列（メッシュ間で矛盾しなければ1つにまとめる）
+		std::vector<std::vector<Matrix4x4>> paletteInverseBindPoseMatrices;
+		//バインドポーズのスケルトン
+		Skeleton bindPoseSkeleton;
+		//ジョイントごとの親の番号（いなければ-1、親が先に並んでいる）
+		std::vector<int32_t> jointParents;
+	};
+
 	/// <summary>
-	/// 初期化
+	/// モデルデータから共有データを作成
 	/// </summary>
 	/// <param name="modelData">モデルデータ</param>
+	/// <returns>共有データ</returns>
+	static std::shared_ptr<const SharedData> CreateSharedData(ModelData modelData);
+
+	/// <summary>
+	/// ベイクしたファイルのモデルデータから共有データを作成（頂点とインデックスはそのままバッファに書き込む）
+	/// </summary>
+	/// <param name="bakedModelData">ベイクしたファイルのモデルデータ</param>
+	/// <returns>共有データ</returns>
+	static std::shared_ptr<const SharedData> CreateSharedData(const BakedModelData& bakedModelData);
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="sharedData">共有データ</param>
 	/// <param name="drawPass">描画の種類</param>
-	void Initialize(const ModelData& modelData, const DrawPass drawPass);
+	void Initialize(const std::shared_ptr<const SharedData>& sharedData, const DrawPass drawPass);
 
 	/// <summary>
 	/// 更新
@@ -121,6 +194,11 @@ public:
 	/// <param name="worldTransform">ワールドトランスフォーム</param>
 	void Update(WorldTransform& worldTransform);
 
+	/// <summary>
+	/// スケルトン空間の行列とマトリックスパレットの更新（ワールド行列を使わないので他のモデルと並列に呼べる）
+	/// </summary>
+	void UpdatePose();
+
 	/// <summary>
 	/// 描画
 	/// </summary>
@@ -156,22 +234,23 @@ public:
 	void SetIsInUse(const bool isInUse) { isInUse_ = isInUse; };
 
 	//メッシュの数を取得
-	const size_t GetNumMeshes() { return meshes_.size(); };
+	const size_t GetNumMeshes() { return sharedData_->meshes.size(); };
 
 	//マテリアルの数を取得
 	const size_t GetNumMaterials() { return materials_.size(); };
 
 	//メッシュを取得
-	Mesh* GetMesh(size_t index) { return meshes_[index].get(); };
+	const Mesh* GetMesh(size_t index) { return sharedData_->meshes[index].get(); };
 
 	//マテリアルを取得
 	Material* GetMaterial(size_t index) { return materials_[index].get(); };
 
-	//スケルトンを取得
-	Skeleton& GetSkeleton() { return skeleton_; };
+	//スケルトンを取得（書き換えられる可能性があるので姿勢を更新が必要な状態にする）
+	Skeleton& GetSkeleton() { isPoseDirty_ = true; return skeleton_; };
+	const Skeleton& GetSkeleton() const { return skeleton_; };
 
 	//Rootのノードを取得
-	const Node& GetRootNode() const { return modelData_.rootNode; };
+	const Node& GetRootNode() const { return sharedData_->modelData.rootNode; };
 
 	//ジョイントのワールドトランスフォームを取得
 	const WorldTransform& GetJointWorldTransform(const std::string& name) const;
@@ -179,11 +258,16 @@ public:
 	//ジョイントのワールドトランスフォームをまとめて取得
 	const std::vector<WorldTransform>& GetJointWorldTransforms() const { return jointWorldTransforms_; };
 
+	//ジョイントのスケルトン空間の行列をまとめて取得
+	const std::vector<Matrix4x4>& GetSkeletonSpaceMatrices() const { return skeletonSpaceMatrices_; };
+
 private:
 	/// <summary>
 	/// スケルトンを作成
 	/// </summary>
-	void CreateSkeleton();
+	/// <param name="rootNode">ルートのノード</param>
+	/// <param name="skeleton">スケルトン</param>
+	static void CreateSkeleton(const Node& rootNode, Skeleton& skeleton);
 
 	/// <summary>
 	/// ジョイントを作成
@@ -192,7 +276,13 @@ private:
 	/// <param name="parent">親のインデックス</param>
 	/// <param name="joints">ジョイントの配列</param>
 	/// <returns>自分のインデックス</returns>
-	int32_t CreateJoint(const Node& node, const std::optional<int32_t>& parent, std::vector<Joint>& joints);
+	static int32_t CreateJoint(const Node& node, const std::optional<int32_t>& parent, std::vector<Joint>& joints);
+
+	/// <summary>
+	/// 共有するスキンクラスターを作成
+	/// </summary>
+	/// <param name="sharedData">共有データ</param>
+	static void CreateSharedSkinClusters(SharedData& sharedData);
 
 	/// <summary>
 	/// ジョイントのワールドトランスフォームを作成
@@ -200,14 +290,14 @@ private:
 	void CreateJointWorldTransforms();
 
 	/// <summary>
-	/// スキンクラスターを作成
+	/// ジョイントの行列の配列を作成
 	/// </summary>
-	void CreateSkinClusters();
+	void CreateJointMatrices();
 
 	/// <summary>
-	/// メッシュを作成
+	/// スキンクラスターを作成
 	/// </summary>
-	void CreateMeshes();
+	void CreateSkinClusters();
 
 	/// <summary>
 	/// マテリアルを作成
@@ -238,8 +328,7 @@ private:
 	/// <summary>
 	/// スケルトンの更新
 	/// </summary>
-	/// <param name="worldTransform">ワールドトランスフォーム</param>
-	void UpdateSkeleton(const WorldTransform& worldTransform);
+	void UpdateSkeleton();
 
 	/// <summary>
 	/// スキンクラスターの更新
@@ -253,17 +342,21 @@ private:
 	void ApplyRootTransform(WorldTransform& worldTransform);
 
 private:
-	//モデルデータ
-	ModelData modelData_{};
+	//同じモデルで共有するデータ
+	std::shared_ptr<const SharedData> sharedData_ = nullptr;
 
 	//スケルトン
 	Skeleton skeleton_{};
 
+	//ジョイントごとのローカル行列とスケルトン空間の行列
+	std::vector<Matrix4x4> localMatrices_{};
+	std::vector<Matrix4x4> skeletonSpaceMatrices_{};
+
 	//スキンクラスター
 	std::vector<SkinCluster> skinClusters_{};
 
-	//メッシュ
-	std::vector<std::unique_ptr<Mesh>> meshes_{};
+	//MatrixPalette
+	std::vector<SkinPalette> skinPalettes_{};
 
 	//マテリアル
 	std::vector<std::unique_ptr<Material>> materials_{};
@@ -291,5 +384,8 @@ private:
 
 	//現在使われているかどうか
 	bool isInUse_ = false;
+
+	//ジョイントが書き換えられてスケルトン空間の行列とパレットの更新が必要かどうか
+	bool isPoseDirty_ = true;
 };
 
@@ -6,10 +6,13 @@
  */
 
 #include "ModelManager.h"
+#include "Engine/Base/TextureManager.h"
 #include "Engine/Math/MathFunction.h"
+#include <fstream>
 
 ModelManager* ModelManager::instance_ = nullptr;
 const std::string ModelManager::kBaseDirectory = "Application/Resources/Models";
+const std::string ModelManager::kBakedFileExtension = ".model";
 
 ModelManager* ModelManager::GetInstance()
 {
@@ -35,6 +38,11 @@ Model* ModelManager::CreateFromModelFile(const std::string& modelName, DrawPass
 	return model;
 }
 
+AssetLoader::Handle ModelManager::LoadAsync(const std::string& modelName)
+{
+	return ModelManager::GetInstance()->LoadAsyncInternal(modelName);
+}
+
 Model* ModelManager::CreateInternal(const std::string& modelName, DrawPass drawPass)
 {
 	//既存のモデルから再利用可能なものを探す
@@ -44,6 +52,14 @@ Model* ModelManager::CreateInternal(const std::string& modelName, DrawPass drawP
 		return reusableModel;
 	}
 
+	//読み込み中であれば完了を待つ（待機中に共有データが保存される）
+	auto pendingIt = pendingModels_.find(modelName);
+	if (pendingIt != pendingModels_.end())
+	{
+		const AssetLoader::Handle handle = pendingIt->second;
+		AssetLoader::GetInstance()->Wait(handle);
+	}
+
 	//モデルデータが存在するか確認
 	auto modelDataIt = modelDatas_.find(modelName);
 	if (modelDataIt != modelDatas_.end())
@@ -51,16 +67,68 @@ Model* ModelManager::CreateInternal(const std::string& modelName, DrawPass drawP
 		return CreateModelFromData(modelDataIt->second, modelName, drawPass);
 	}
 
-	//モデルファイルを探索してロード
-	std::string fileName = FindModelFile(modelName);
-
-	//モデルデータを読み込み
-	Model::ModelData modelData = LoadModelFile(kBaseDirectory + "/" + modelName, fileName);
-	//モデルデータを保存
-	modelDatas_[modelName] = modelData;
+	//モデルファイルを読み込み、同じモデルで共有するデータを作成して保存
+	LoadSharedData(modelName)();
 
 	//モデルを生成して返す
-	return CreateModelFromData(modelData, modelName, drawPass);
+	return CreateModelFromData(modelDatas_[modelName], modelName, drawPass);
+}
+
+AssetLoader::Handle ModelManager::LoadAsyncInternal(const std::string& modelName)
+{
+	//読み込み済みであれば何もしない
+	if (modelDatas_.contains(modelName))
+	{
+		return AssetLoader::Handle();
+	}
+
+	//読み込み中であれば同じハンドルを返す
+	auto pendingIt = pendingModels_.find(modelName);
+	if (pendingIt != pendingModels_.end())
+	{
+		return pendingIt->second;
+	}
+
+	//ワーカースレッドで読み込みを行う
+	AssetLoader::Handle handle = AssetLoader::GetInstance()->Request([this, modelName]() { return LoadSharedData(modelName); });
+	pendingModels_[modelName] = handle;
+	return handle;
+}
+
+AssetLoader::FinalizeFunction ModelManager::LoadSharedData(const std::string& modelName)
+{
+	//モデルファイルを探索
+	const std::string fileName = FindModelFile(modelName);
+
+	//ベイクしたファイルがあれば、マップしたデータからGPUリソースを作成する
+	std::shared_ptr<Model::BakedModelData> bakedModelData = std::make_shared<Model::BakedModelData>();
+	if (LoadBakedModelFile(modelName, fileName, *bakedModelData))
+	{
+		return [this, modelName, bakedModelData]() {
+			RegisterSharedData(modelName, Model::CreateSharedData(*bakedModelData));
+			};
+	}
+
+	//ないか古い場合はモデルファイルを読み込み、GPUリソースを作成してからベイクし直す
+	std::shared_ptr<Model::ModelData> modelData = std::make_shared<Model::ModelData>(LoadModelFile(kBaseDirectory + "/" + modelName, fileName));
+	return [this, modelName, modelData]() {
+		std::shared_ptr<const Model::SharedData> sharedData = Model::CreateSharedData(std::move(*modelData));
+		SaveBakedModelFile(modelName, *sharedData);
+		RegisterSharedData(modelName, sharedData);
+		};
+}
+
+void ModelManager::RegisterSharedData(const std::string& modelName, const std::shared_ptr<const Model::SharedData>& sharedData)
+{
+	//共有データを保存
+	modelDatas_[modelName] = sharedData;
+	pendingModels_.erase(modelName);
+
+	//マテリアルのテクスチャの読み込みを要求（モデルの生成時に完了を待つ）
+	for (const Material::MaterialData& materialData : sharedData->modelData.materialData)
+	{
+		TextureManager::LoadAsync(materialData.textureFilePath);
+	}
 }
 
 Model* ModelManager::FindReusableModel(const std::string& modelName)
@@ -84,10 +152,10 @@ Model* ModelManager::FindReusableModel(const std::string& modelName)
 	return nullptr;
 }
 
-Model* ModelManager::CreateModelFromData(const Model::ModelData& modelData, const std::string& modelName, DrawPass drawPass)
+Model* ModelManager::CreateModelFromData(const std::shared_ptr<const Model::SharedData>& sharedData, const std::string& modelName, DrawPass drawPass)
 {
 	Model* model = new Model();
-	model->Initialize(modelData, drawPass);
+	model->Initialize(sharedData, drawPass);
 	models_[modelName].emplace_back(std::unique_ptr<Model>(model));
 	return model;
 }
@@ -136,6 +204,7 @@ Model::ModelData ModelManager::LoadModelFile(const std::string& directoryPath, c
 			modelData.meshData[meshIndex].vertices[vertexIndex].texcoord = { texcoord.x,texcoord.y };
 		}
 		//Indexを解析する
+		modelData.meshData[meshIndex].indices.reserve(mesh->mNumFaces * 3);
 		for (uint32_t faceIndex = 0; faceIndex < mesh->mNumFaces; ++faceIndex)
 		{
 			aiFace& face = mesh->mFaces[faceIndex];
@@ -215,4 +284,184 @@ Model::Node ModelManager::ReadNode(aiNode* node)
 		result.children[childIndex] = ReadNode(node->mChildren[childIndex]);
 	}
 	return result;
-}
\ No newline at end of file
+}
+
+bool ModelManager::LoadBakedModelFile(const std::string& modelName, const std::string& fileName, Model::BakedModelData& bakedModelData)
+{
+	//ベイクしたファイルがないか、元のファイルの方が新しい場合は読み込まない
+	const std::string bakedFilePath = kBaseDirectory + "/" + modelName + "/" + modelName + kBakedFileExtension;
+	std::error_code errorCode;
+	const std::filesystem::file_time_type bakedTime = std::filesystem::last_write_time(bakedFilePath, errorCode);
+	if (errorCode) return false;
+	const std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time(kBaseDirectory + "/" + modelName + "/" + fileName, errorCode);
+	if (!errorCode && sourceTime > bakedTime) return false;
+
+	//ファイルをマップ（共有データが破棄されるまで保持する）
+	std::shared_ptr<MappedFile> mappedFile = std::make_shared<MappedFile>();
+	if (!mappedFile->Open(bakedFilePath)) return false;
+
+	//先頭から4バイト単位で読み進める（範囲外になる場合はnullptr）
+	const uint8_t* data = mappedFile->GetData();
+	const size_t size = mappedFile->GetSize();
+	size_t offset = 0;
+	auto read = [data, size, &offset](const size_t byteSize) -> const uint8_t* {
+		const size_t alignedSize = (byteSize + 3) & ~size_t(3);
+		if (size - offset < alignedSize) return nullptr;
+		const uint8_t* result = data + offset;
+		offset += alignedSize;
+		return result;
+		};
+
+	//識別子とバージョンを確認
+	const BakedHeader* header = reinterpret_cast<const BakedHeader*>(read(sizeof(BakedHeader)));
+	if (!header || header->magic != kBakedMagic || header->version != kBakedVersion) return false;
+	bakedModelData = Model::BakedModelData{};
+	bakedModelData.storage = mappedFile;
+
+	//メッシュ（頂点、インデックス、Influenceはマップしたまま参照する）
+	for (uint32_t meshIndex = 0; meshIndex < header->meshCount; ++meshIndex)
+	{
+		const BakedMeshHeader* meshHeader = reinterpret_cast<const BakedMeshHeader*>(read(sizeof(BakedMeshHeader)));
+		if (!meshHeader) return false;
+		const VertexDataPosUVNormal* vertices = reinterpret_cast<const VertexDataPosUVNormal*>(read(sizeof(VertexDataPosUVNormal) * meshHeader->vertexCount));
+		const uint32_t* indices = reinterpret_cast<const uint32_t*>(read(sizeof(uint32_t) * meshHeader->indexCount));
+		const Model::VertexInfluence* influences = reinterpret_cast<const Model::VertexInfluence*>(read(sizeof(Model::VertexInfluence) * meshHeader->influenceCount));
+		if (!vertices || !indices || !influences) return false;
+		if ((meshHeader->influenceCount != 0 && (meshHeader->influenceCount != meshHeader->vertexCount || meshHeader->paletteIndex >= header->paletteCount)) || meshHeader->materialIndex >= header->materialCount) return false;
+		Model::BakedMeshData& meshData = bakedModelData.meshData.emplace_back();
+		meshData.vertices = std::span<const VertexDataPosUVNormal>(vertices, meshHeader->vertexCount);
+		meshData.indices = std::span<const uint32_t>(indices, meshHeader->indexCount);
+		meshData.materialIndex = meshHeader->materialIndex;
+		meshData.influences = std::span<const Model::VertexInfluence>(influences, meshHeader->influenceCount);
+		meshData.paletteIndex = meshHeader->paletteIndex;
+	}
+
+	//MatrixPaletteごとの逆バインドポーズ行列
+	for (uint32_t paletteIndex = 0; paletteIndex < header->paletteCount; ++paletteIndex)
+	{
+		const Matrix4x4* inverseBindPoseMatrices = reinterpret_cast<const Matrix4x4*>(read(sizeof(Matrix4x4) * header->jointCount));
+		if (!inverseBindPoseMatrices) return false;
+		bakedModelData.paletteInverseBindPoseMatrices.emplace_back(inverseBindPoseMatrices, header->jointCount);
+	}
+
+	//マテリアル
+	for (uint32_t materialIndex = 0; materialIndex < header->materialCount; ++materialIndex)
+	{
+		const BakedMaterialHeader* materialHeader = reinterpret_cast<const BakedMaterialHeader*>(read(sizeof(BakedMaterialHeader)));
+		const char* texturePath = materialHeader ? reinterpret_cast<const char*>(read(materialHeader->texturePathLength)) : nullptr;
+		if (!texturePath) return false;
+		Material::MaterialData& materialData = bakedModelData.materialData.emplace_back();
+		materialData.color = materialHeader->color;
+		materialData.textureFilePath.assign(texturePath, materialHeader->texturePathLength);
+	}
+
+	//ノード（親から順に並んでいるので、子を読み終わっていない親をスタックに積んで階層を作る）
+	std::vector<std::pair<Model::Node*, uint32_t>> parents{};
+	for (uint32_t nodeIndex = 0; nodeIndex < header->nodeCount; ++nodeIndex)
+	{
+		const BakedNodeHeader* nodeHeader = reinterpret_cast<const BakedNodeHeader*>(read(sizeof(BakedNodeHeader)));
+		const char* name = nodeHeader ? reinterpret_cast<const char*>(read(nodeHeader->nameLength)) : nullptr;
+		if (!name || (nodeIndex != 0 && parents.empty())) return false;
+		Model::Node& node = parents.empty() ? bakedModelData.rootNode : parents.back().first->children.emplace_back();
+		node.scale = nodeHeader->scale;
+		node.rotate = nodeHeader->rotate;
+		node.translate = nodeHeader->translate;
+		node.localMatrix = nodeHeader->localMatrix;
+		node.name.assign(name, nodeHeader->nameLength);
+		node.children.reserve(nodeHeader->childCount);
+
+		//親の残りの子の数を減らし、子を持つ場合は積む
+		if (!parents.empty())
+		{
+			--parents.back().second;
+		}
+		if (nodeHeader->childCount != 0)
+		{
+			parents.emplace_back(&node, nodeHeader->childCount);
+		}
+		while (!parents.empty() && parents.back().second == 0)
+		{
+			parents.pop_back();
+		}
+	}
+	return parents.empty();
+}
+
+void ModelManager::SaveBakedModelFile(const std::string& modelName, const Model::SharedData& sharedData)
+{
+	//ファイルを開く
+	std::ofstream file(kBaseDirectory + "/" + modelName + "/" + modelName + kBakedFileExtension, std::ios::binary | std::ios::trunc);
+	if (!file) return;
+
+	//4バイト単位に揃えて書き込む処理
+	auto write = [&file](const void* data, const size_t byteSize) {
+		static const char kPadding[4] = {};
+		file.write(static_cast<const char*>(data), byteSize);
+		file.write(kPadding, ((byteSize + 3) & ~size_t(3)) - byteSize);
+		};
+
+	//ノードを親から順に並べる
+	std::vector<const Model::Node*> nodes{};
+	std::vector<const Model::Node*> stack = { &sharedData.modelData.rootNode };
+	while (!stack.empty())
+	{
+		const Model::Node* node = stack.back();
+		stack.pop_back();
+		nodes.push_back(node);
+		for (auto it = node->children.rbegin(); it != node->children.rend(); ++it)
+		{
+			stack.push_back(&*it);
+		}
+	}
+
+	//ヘッダー
+	BakedHeader header{};
+	header.magic = kBakedMagic;
+	header.version = kBakedVersion;
+	header.meshCount = static_cast<uint32_t>(sharedData.meshes.size());
+	header.paletteCount = static_cast<uint32_t>(sharedData.paletteInverseBindPoseMatrices.size());
+	header.materialCount = static_cast<uint32_t>(sharedData.modelData.materialData.size());
+	header.nodeCount = static_cast<uint32_t>(nodes.size());
+	header.jointCount = static_cast<uint32_t>(sharedData.bindPoseSkeleton.joints.size());
+	write(&header, sizeof(header));
+
+	//メッシュ
+	for (size_t meshIndex = 0; meshIndex < sharedData.meshes.size(); ++meshIndex)
+	{
+		const std::span<const VertexDataPosUVNormal> vertices = sharedData.meshVertices[meshIndex];
+		const std::vector<uint32_t>& indices = sharedData.modelData.meshData[meshIndex].indices;
+		const Model::SharedSkinCluster& skinCluster = sharedData.skinClusters[meshIndex];
+		BakedMeshHeader meshHeader{};
+		meshHeader.vertexCount = static_cast<uint32_t>(vertices.size());
+		meshHeader.indexCount = static_cast<uint32_t>(indices.size());
+		meshHeader.materialIndex = sharedData.meshes[meshIndex]->GetMaterialIndex();
+		meshHeader.influenceCount = static_cast<uint32_t>(skinCluster.influences.size());
+		meshHeader.paletteIndex = skinCluster.paletteIndex;
+		write(&meshHeader, sizeof(meshHeader));
+		write(vertices.data(), vertices.size_bytes());
+		write(indices.data(), sizeof(uint32_t) * indices.size());
+		write(skinCluster.influences.data(), sizeof(Model::VertexInfluence) * skinCluster.influences.size());
+	}
+
+	//MatrixPaletteごとの逆バインドポーズ行列
+	for (const std::vector<Matrix4x4>& inverseBindPoseMatrices : sharedData.paletteInverseBindPoseMatrices)
+	{
+		write(inverseBindPoseMatrices.data(), sizeof(Matrix4x4) * inverseBindPoseMatrices.size());
+	}
+
+	//マテリアル
+	for (const Material::MaterialData& materialData : sharedData.modelData.materialData)
+	{
+		const BakedMaterialHeader materialHeader = { materialData.color, static_cast<uint32_t>(materialData.textureFilePath.size()) };
+		write(&materialHeader, sizeof(materialHeader));
+		write(materialData.textureFilePath.data(), materialData.textureFilePath.size());
+	}
+
+	//ノード
+	for (const Model::Node* node : nodes)
+	{
+		const BakedNodeHeader nodeHeader = { node->scale, node->rotate, node->translate, node->localMatrix, static_cast<uint32_t>(node->name.size()), static_cast<uint32_t>(node->children.size()) };
+		write(&nodeHeader, sizeof(nodeHeader));
+		write(node->name.data(), node->name.size());
+	}
+}
@@ -7,6 +7,8 @@
 
 #pragma once
 #include "Model.h"
+#include "Engine/Utilities/AssetLoader.h"
+#include "Engine/Utilities/MappedFile.h"
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
@@ -37,7 +39,63 @@ public:
 	/// <returns>モデル</returns>
 	static Model* CreateFromModelFile(const std::string& modelName, DrawPass drawPass);
 
+	/// <summary>
+	/// モデルファイルの読み込みを要求（解析はワーカースレッドで行い、GPUリソースの作成は待機したスレッドで行う）
+	/// </summary>
+	/// <param name="modelName">モデルの名前</param>
+	/// <returns>読み込みの完了を待つハンドル</returns>
+	static AssetLoader::Handle LoadAsync(const std::string& modelName);
+
 private:
+	//ベイクしたファイルの拡張子
+	static const std::string kBakedFileExtension;
+
+	//ベイクしたファイルの識別子（"MODL"）とバージョン
+	static const uint32_t kBakedMagic = 0x4C444F4D;
+	static const uint32_t kBakedVersion = 1;
+
+	//ベイクしたファイルのヘッダー（後ろにメッシュ、MatrixPalette、マテリアル、ノードが続く）
+	struct BakedHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t meshCount;
+		uint32_t paletteCount;
+		uint32_t materialCount;
+		uint32_t nodeCount;
+		uint32_t jointCount;
+		uint32_t reserved;
+	};
+
+	//ベイクしたメッシュのヘッダー（後ろに頂点、インデックス、Influenceが続く）
+	struct BakedMeshHeader
+	{
+		uint32_t vertexCount;
+		uint32_t indexCount;
+		uint32_t materialIndex;
+		uint32_t influenceCount;
+		uint32_t paletteIndex;
+		uint32_t reserved;
+	};
+
+	//ベイクしたマテリアルのヘッダー（後ろにテクスチャのファイルパスが続く）
+	struct BakedMaterialHeader
+	{
+		Vector4 color;
+		uint32_t texturePathLength;
+	};
+
+	//ベイクしたノードのヘッダー（後ろに名前が続き、親から順に並べる）
+	struct BakedNodeHeader
+	{
+		Vector3 scale;
+		Quaternion rotate;
+		Vector3 translate;
+		Matrix4x4 localMatrix;
+		uint32_t nameLength;
+		uint32_t childCount;
+	};
+
 	ModelManager() = default;
 	~ModelManager() = default;
 	ModelManager(const ModelManager&) = delete;
@@ -51,6 +109,27 @@ private:
 	/// <returns>モデル</returns>
 	Model* CreateInternal(const std::string& modelName, DrawPass drawPass);
 
+	/// <summary>
+	/// モデルファイルの読み込みを内部で要求
+	/// </summary>
+	/// <param name="modelName">モデルの名前</param>
+	/// <returns>読み込みの完了を待つハンドル</returns>
+	AssetLoader::Handle LoadAsyncInternal(const std::string& modelName);
+
+	/// <summary>
+	/// モデルファイルを読み込んで解析する（メンバ変数を変更しないのでワーカースレッドで実行できる）
+	/// </summary>
+	/// <param name="modelName">モデルの名前</param>
+	/// <returns>共有データを作成して保存する完了処理</returns>
+	AssetLoader::FinalizeFunction LoadSharedData(const std::string& modelName);
+
+	/// <summary>
+	/// 共有データを保存し、マテリアルのテクスチャの読み込みを要求
+	/// </summary>
+	/// <param name="modelName">モデルの名前</param>
+	/// <param name="sharedData">共有データ</param>
+	void RegisterSharedData(const std::string& modelName, const std::shared_ptr<const Model::SharedData>& sharedData);
+
 	/// <summary>
 	/// 再利用できるモデルを探す
 	/// </summary>
@@ -59,13 +138,13 @@ private:
 	Model* FindReusableModel(const std::string& modelName);
 
 	/// <summary>
-	/// モデルデータからモデルを生成
+	/// 共有データからモデルを生成
 	/// </summary>
-	/// <param name="modelData">モデルデータ</param>
+	/// <param name="sharedData">共有データ</param>
 	/// <param name="modelName">モデルの名前</param>
 	/// <param name="drawPass">描画の種類</param>
 	/// <returns>モデル</returns>
-	Model* CreateModelFromData(const Model::ModelData& modelData, const std::string& modelName, DrawPass drawPass);
+	Model* CreateModelFromData(const std::shared_ptr<const Model::SharedData>& sharedData, const std::string& modelName, DrawPass drawPass);
 
 	/// <summary>
 	/// モデルファイルを探す
@@ -84,11 +163,29 @@ private:
 
 	Model::Node ReadNode(aiNode* node);
 
+	/// <summary>
+	/// ベイクしたファイルをマップして読み込む（GPUリソースは作成しない）
+	/// </summary>
+	/// <param name="modelName">モデルの名前</param>
+	/// <param name="fileName">元のモデルファイルの名前</param>
+	/// <param name="bakedModelData">マップしたファイルを参照するモデルデータの書き込み先</param>
+	/// <returns>読み込めたか（ないか元のファイルより古い場合はfalse）</returns>
+	bool LoadBakedModelFile(const std::string& modelName, const std::string& fileName, Model::BakedModelData& bakedModelData);
+
+	/// <summary>
+	/// 共有データをベイクしたファイルに書き出す（ジョイントの番号とMatrixPaletteは解決済みのものを書き出す）
+	/// </summary>
+	/// <param name="modelName">モデルの名前</param>
+	/// <param name="sharedData">モデルファイルから作成した共有データ</param>
+	void SaveBakedModelFile(const std::string& modelName, const Model::SharedData& sharedData);
+
 private:
 	static ModelManager* instance_;
 
-	std::map<std::string, Model::ModelData> modelDatas_{};
+	std::map<std::string, std::shared_ptr<const Model::SharedData>> modelDatas_{};
 
 	std::map<std::string, std::vector<std::unique_ptr<Model>>> models_{};
+
+	std::map<std::string, AssetLoader::Handle> pendingModels_{};
 };
 
@@ -0,0 +1,387 @@
+/**
+ * @file SkinningMath.cpp
+ * @brief スケルトンとスキンクラスターの行列をまとめて計算する関数群
+ * @author 青木智滉
+ * @date
+ */
+
+#include "SkinningMath.h"
+#include <cassert>
+#include <cmath>
+
+//x64ではSSE2が必ず使えるのでSIMDで計算する
+#if defined(_M_X64) || defined(__SSE2__)
+#define SKINNING_MATH_USE_SSE
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	/// <summary>
+	/// ジョイントの拡縮、回転、移動からローカル行列を作成（Mathf::MakeAffineMatrixと同じ結果を行列の積なしで求める）
+	/// </summary>
+	inline void MakeLocalMatrix(const Model::Joint& joint, Matrix4x4& result)
+	{
+		const Quaternion& q = joint.rotate;
+		const Vector3& s = joint.scale;
+		result.m[0][0] = s.x * (q.w * q.w + q.x * q.x - q.y * q.y - q.z * q.z);
+		result.m[0][1] = s.x * 2.0f * (q.x * q.y + q.w * q.z);
+		result.m[0][2] = s.x * 2.0f * (q.x * q.z - q.w * q.y);
+		result.m[0][3] = 0.0f;
+		result.m[1][0] = s.y * 2.0f * (q.x * q.y - q.w * q.z);
+		result.m[1][1] = s.y * (q.w * q.w - q.x * q.x + q.y * q.y - q.z * q.z);
+		result.m[1][2] = s.y * 2.0f * (q.y * q.z + q.w * q.x);
+		result.m[1][3] = 0.0f;
+		result.m[2][0] = s.z * 2.0f * (q.x * q.z + q.w * q.y);
+		result.m[2][1] = s.z * 2.0f * (q.y * q.z - q.w * q.x);
+		result.m[2][2] = s.z * (q.w * q.w - q.x * q.x - q.y * q.y + q.z * q.z);
+		result.m[2][3] = 0.0f;
+		result.m[3][0] = joint.translate.x;
+		result.m[3][1] = joint.translate.y;
+		result.m[3][2] = joint.translate.z;
+		result.m[3][3] = 1.0f;
+	}
+
+#ifdef SKINNING_MATH_USE_SSE
+	inline __m128 LoadRow(const Matrix4x4& m, const int row) { return _mm_loadu_ps(m.m[row]); };
+	inline void StoreRow(Matrix4x4& m, const int row, const __m128 v) { _mm_storeu_ps(m.m[row], v); };
+	inline __m128 Splat(const __m128 v, const int i)
+	{
+		switch (i)
+		{
+		case 0: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+		case 1: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+		case 2: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+		default: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+		}
+	};
+
+	//行ベクトルの3成分に行列の上3行を掛ける（w成分は無視する）
+	inline __m128 TransformRow(const __m128 row, const __m128 b0, const __m128 b1, const __m128 b2)
+	{
+		return _mm_add_ps(_mm_add_ps(_mm_mul_ps(Splat(row, 0), b0), _mm_mul_ps(Splat(row, 1), b1)), _mm_mul_ps(Splat(row, 2), b2));
+	}
+
+	//左の行列がアフィン行列（4列目が(0,0,0,1)）の場合の積
+	inline void MultiplyAffine(const __m128 a[4], const Matrix4x4& b, __m128 result[4])
+	{
+		const __m128 b0 = LoadRow(b, 0);
+		const __m128 b1 = LoadRow(b, 1);
+		const __m128 b2 = LoadRow(b, 2);
+		const __m128 b3 = LoadRow(b, 3);
+		result[0] = TransformRow(a[0], b0, b1, b2);
+		result[1] = TransformRow(a[1], b0, b1, b2);
+		result[2] = TransformRow(a[2], b0, b1, b2);
+		result[3] = _mm_add_ps(TransformRow(a[3], b0, b1, b2), b3);
+	}
+
+	//外積（w成分は0になる）
+	inline __m128 Cross(const __m128 a, const __m128 b)
+	{
+		const __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+		return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+	}
+
+	//3成分の内積
+	inline float Dot3(const __m128 a, const __m128 b)
+	{
+		const __m128 m = _mm_mul_ps(a, b);
+		return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(m, Splat(m, 1)), Splat(m, 2)));
+	}
+
+	//w成分を置き換える
+	inline __m128 SetW(const __m128 v, const float w)
+	{
+		const __m128 zw = _mm_unpackhi_ps(v, _mm_set1_ps(w));
+		return _mm_shuffle_ps(v, zw, _MM_SHUFFLE(1, 0, 1, 0));
+	}
+#else
+	//左の行列がアフィン行列（4列目が(0,0,0,1)）の場合の積
+	inline void MultiplyAffine(const Matrix4x4& a, const Matrix4x4& b, Matrix4x4& result)
+	{
+		for (int r = 0; r < 4; ++r)
+		{
+			for (int c = 0; c < 4; ++c)
+			{
+				result.m[r][c] = a.m[r][0] * b.m[0][c] + a.m[r][1] * b.m[1][c] + a.m[r][2] * b.m[2][c] + (r == 3 ? b.m[3][c] : 0.0f);
+			}
+		}
+	}
+#endif
+}
+
+namespace SkinningMath
+{
+	void CalculateLocalMatrices(std::span<const Model::Joint> joints, std::span<Matrix4x4> localMatrices)
+	{
+		assert(joints.size() == localMatrices.size());
+		const size_t jointCount = joints.size();
+		size_t i = 0;
+
+#ifdef SKINNING_MATH_USE_SSE
+		//4ジョイント分の成分を1つのレジスタにまとめて計算する
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 two = _mm_set1_ps(2.0f);
+		for (; i + 4 <= jointCount; i += 4)
+		{
+			const Model::Joint* j = &joints[i];
+			const __m128 qx = _mm_setr_ps(j[0].rotate.x, j[1].rotate.x, j[2].rotate.x, j[3].rotate.x);
+			const __m128 qy = _mm_setr_ps(j[0].rotate.y, j[1].rotate.y, j[2].rotate.y, j[3].rotate.y);
+			const __m128 qz = _mm_setr_ps(j[0].rotate.z, j[1].rotate.z, j[2].rotate.z, j[3].rotate.z);
+			const __m128 qw = _mm_setr_ps(j[0].rotate.w, j[1].rotate.w, j[2].rotate.w, j[3].rotate.w);
+			const __m128 sx = _mm_setr_ps(j[0].scale.x, j[1].scale.x, j[2].scale.x, j[3].scale.x);
+			const __m128 sy = _mm_setr_ps(j[0].scale.y, j[1].scale.y, j[2].scale.y, j[3].scale.y);
+			const __m128 sz = _mm_setr_ps(j[0].scale.z, j[1].scale.z, j[2].scale.z, j[3].scale.z);
+			__m128 tx = _mm_setr_ps(j[0].translate.x, j[1].translate.x, j[2].translate.x, j[3].translate.x);
+			__m128 ty = _mm_setr_ps(j[0].translate.y, j[1].translate.y, j[2].translate.y, j[3].translate.y);
+			__m128 tz = _mm_setr_ps(j[0].translate.z, j[1].translate.z, j[2].translate.z, j[3].translate.z);
+
+			//回転行列の成分にスケールを掛ける（Mathf::MakeRotateMatrixと同じ式）
+			const __m128 xx = _mm_mul_ps(qx, qx), yy = _mm_mul_ps(qy, qy), zz = _mm_mul_ps(qz, qz), ww = _mm_mul_ps(qw, qw);
+			const __m128 xy = _mm_mul_ps(qx, qy), xz = _mm_mul_ps(qx, qz), yz = _mm_mul_ps(qy, qz);
+			const __m128 wx = _mm_mul_ps(qw, qx), wy = _mm_mul_ps(qw, qy), wz = _mm_mul_ps(qw, qz);
+			__m128 r00 = _mm_mul_ps(sx, _mm_sub_ps(_mm_sub_ps(_mm_add_ps(ww, xx), yy), zz));
+			__m128 r01 = _mm_mul_ps(sx, _mm_mul_ps(two, _mm_add_ps(xy, wz)));
+			__m128 r02 = _mm_mul_ps(sx, _mm_mul_ps(two, _mm_sub_ps(xz, wy)));
+			__m128 r10 = _mm_mul_ps(sy, _mm_mul_ps(two, _mm_sub_ps(xy, wz)));
+			__m128 r11 = _mm_mul_ps(sy, _mm_sub_ps(_mm_add_ps(_mm_sub_ps(ww, xx), yy), zz));
+			__m128 r12 = _mm_mul_ps(sy, _mm_mul_ps(two, _mm_add_ps(yz, wx)));
+			__m128 r20 = _mm_mul_ps(sz, _mm_mul_ps(two, _mm_add_ps(xz, wy)));
+			__m128 r21 = _mm_mul_ps(sz, _mm_mul_ps(two, _mm_sub_ps(yz, wx)));
+			__m128 r22 = _mm_mul_ps(sz, _mm_add_ps(_mm_sub_ps(_mm_sub_ps(ww, xx), yy), zz));
+
+			//成分ごとのレジスタを転置してジョイントごとの行にする
+			__m128 w0 = zero, w1 = zero, w2 = zero, w3 = one;
+			_MM_TRANSPOSE4_PS(r00, r01, r02, w0);
+			_MM_TRANSPOSE4_PS(r10, r11, r12, w1);
+			_MM_TRANSPOSE4_PS(r20, r21, r22, w2);
+			_MM_TRANSPOSE4_PS(tx, ty, tz, w3);
+			const __m128 rows[4][4] = {
+				{ r00, r10, r20, tx },
+				{ r01, r11, r21, ty },
+				{ r02, r12, r22, tz },
+				{ w0, w1, w2, w3 },
+			};
+			for (int k = 0; k < 4; ++k)
+			{
+				for (int row = 0; row < 4; ++row)
+				{
+					StoreRow(localMatrices[i + k], row, rows[k][row]);
+				}
+			}
+		}
+#endif
+
+		//残りのジョイントを1つずつ計算する
+		for (; i < jointCount; ++i)
+		{
+			MakeLocalMatrix(joints[i], localMatrices[i]);
+		}
+	}
+
+	void CalculateSkeletonSpaceMatrices(std::span<const Matrix4x4> localMatrices, std::span<const int32_t> parents, std::span<Matrix4x4> skeletonSpaceMatrices)
+	{
+		assert(localMatrices.size() == parents.size() && localMatrices.size() == skeletonSpaceMatrices.size());
+
+		//親が先に並んでいるので前から順に親の行列を掛ける
+		for (size_t i = 0; i < localMatrices.size(); ++i)
+		{
+			const int32_t parent = parents[i];
+			if (parent < 0)
+			{
+				skeletonSpaceMatrices[i] = localMatrices[i];
+				continue;
+			}
+			assert(static_cast<size_t>(parent) < i);
+
+#ifdef SKINNING_MATH_USE_SSE
+			const __m128 local[4] = { LoadRow(localMatrices[i], 0), LoadRow(localMatrices[i], 1), LoadRow(localMatrices[i], 2), LoadRow(localMatrices[i], 3) };
+			__m128 result[4];
+			MultiplyAffine(local, skeletonSpaceMatrices[parent], result);
+			for (int row = 0; row < 4; ++row)
+			{
+				StoreRow(skeletonSpaceMatrices[i], row, result[row]);
+			}
+#else
+			MultiplyAffine(localMatrices[i], skeletonSpaceMatrices[parent], skeletonSpaceMatrices[i]);
+#endif
+		}
+	}
+
+	void CalculateJointWorldMatrices(std::span<const Matrix4x4> skeletonSpaceMatrices, const Matrix4x4& worldMatrix, std::span<WorldTransform> jointWorldTransforms)
+	{
+		assert(skeletonSpaceMatrices.size() == jointWorldTransforms.size());
+
+		for (size_t i = 0; i < skeletonSpaceMatrices.size(); ++i)
+		{
+			const Matrix4x4& m = skeletonSpaceMatrices[i];
+#ifdef SKINNING_MATH_USE_SSE
+			//上3行の長さをまとめて求めてスケール成分を取り除く
+			__m128 rows[4] = { LoadRow(m, 0), LoadRow(m, 1), LoadRow(m, 2), LoadRow(m, 3) };
+			const __m128 inverseScale = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_setr_ps(Dot3(rows[0], rows[0]), Dot3(rows[1], rows[1]), Dot3(rows[2], rows[2]), 1.0f)));
+			rows[0] = _mm_mul_ps(rows[0], Splat(inverseScale, 0));
+			rows[1] = _mm_mul_ps(rows[1], Splat(inverseScale, 1));
+			rows[2] = _mm_mul_ps(rows[2], Splat(inverseScale, 2));
+
+			//ワールド行列を掛ける
+			__m128 result[4];
+			MultiplyAffine(rows, worldMatrix, result);
+			for (int row = 0; row < 4; ++row)
+			{
+				StoreRow(jointWorldTransforms[i].matWorld_, row, result[row]);
+			}
+#else
+			//Scale成分を取り除く
+			Matrix4x4 jointWorldTransform = m;
+			for (int r = 0; r < 3; ++r)
+			{
+				const float scale = std::sqrt(m.m[r][0] * m.m[r][0] + m.m[r][1] * m.m[r][1] + m.m[r][2] * m.m[r][2]);
+				for (int c = 0; c < 3; ++c)
+				{
+					jointWorldTransform.m[r][c] /= scale;
+				}
+			}
+			//ワールド行列を掛ける
+			MultiplyAffine(jointWorldTransform, worldMatrix, jointWorldTransforms[i].matWorld_);
+#endif
+		}
+	}
+
+	void CalculatePalette(std::span<const Matrix4x4> inverseBindPoseMatrices, std::span<const Matrix4x4> skeletonSpaceMatrices, std::span<Model::WellForGPU> palette)
+	{
+		assert(inverseBindPoseMatrices.size() >= skeletonSpaceMatrices.size() && palette.size() >= skeletonSpaceMatrices.size());
+
+		for (size_t i = 0; i < skeletonSpaceMatrices.size(); ++i)
+		{
+			//逆バインドポーズ行列とスケルトン空間の行列を掛ける
+			const Matrix4x4& inverseBindPoseMatrix = inverseBindPoseMatrices[i];
+#ifdef SKINNING_MATH_USE_SSE
+			const __m128 inverseBindPose[4] = { LoadRow(inverseBindPoseMatrix, 0), LoadRow(inverseBindPoseMatrix, 1), LoadRow(inverseBindPoseMatrix, 2), LoadRow(inverseBindPoseMatrix, 3) };
+			__m128 m[4];
+			MultiplyAffine(inverseBindPose, skeletonSpaceMatrices[i], m);
+
+			//上3x3の逆転置行列は行同士の外積を行列式で割ったものになる
+			const __m128 c0 = Cross(m[1], m[2]);
+			const __m128 c1 = Cross(m[2], m[0]);
+			const __m128 c2 = Cross(m[0], m[1]);
+			const float determinant = Dot3(m[0], c0);
+			const __m128 inverseDeterminant = _mm_set1_ps(determinant != 0.0f ? 1.0f / determinant : 0.0f);
+			const __m128 n0 = _mm_mul_ps(c0, inverseDeterminant);
+			const __m128 n1 = _mm_mul_ps(c1, inverseDeterminant);
+			const __m128 n2 = _mm_mul_ps(c2, inverseDeterminant);
+
+			//パレットへは書き込みのみ行う（アップロードヒープからの読み戻しをしない）
+			Model::WellForGPU& well = palette[i];
+			for (int row = 0; row < 4; ++row)
+			{
+				StoreRow(well.skeletonSpaceMatrix, row, m[row]);
+			}
+			StoreRow(well.skeletonSpaceInverseTransposeMatrix, 0, SetW(n0, -Dot3(n0, m[3])));
+			StoreRow(well.skeletonSpaceInverseTransposeMatrix, 1, SetW(n1, -Dot3(n1, m[3])));
+			StoreRow(well.skeletonSpaceInverseTransposeMatrix, 2, SetW(n2, -Dot3(n2, m[3])));
+			StoreRow(well.skeletonSpaceInverseTransposeMatrix, 3, _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+#else
+			Matrix4x4 m{};
+			MultiplyAffine(inverseBindPoseMatrix, skeletonSpaceMatrices[i], m);
+
+			//上3x3の逆転置行列は行同士の外積を行列式で割ったものになる
+			const float (*a)[4] = m.m;
+			float n[3][3] = {
+				{ a[1][1] * a[2][2] - a[1][2] * a[2][1], a[1][2] * a[2][0] - a[1][0] * a[2][2], a[1][0] * a[2][1] - a[1][1] * a[2][0] },
+				{ a[2][1] * a[0][2] - a[2][2] * a[0][1], a[2][2] * a[0][0] - a[2][0] * a[0][2], a[2][0] * a[0][1] - a[2][1] * a[0][0] },
+				{ a[0][1] * a[1][2] - a[0][2] * a[1][1], a[0][2] * a[1][0] - a[0][0] * a[1][2], a[0][0] * a[1][1] - a[0][1] * a[1][0] },
+			};
+			const float determinant = a[0][0] * n[0][0] + a[0][1] * n[0][1] + a[0][2] * n[0][2];
+			const float inverseDeterminant = determinant != 0.0f ? 1.0f / determinant : 0.0f;
+
+			//パレットへは書き込みのみ行う（アップロードヒープからの読み戻しをしない）
+			Model::WellForGPU& well = palette[i];
+			well.skeletonSpaceMatrix = m;
+			for (int r = 0; r < 3; ++r)
+			{
+				for (int c = 0; c < 3; ++c)
+				{
+					well.skeletonSpaceInverseTransposeMatrix.m[r][c] = n[r][c] * inverseDeterminant;
+				}
+				well.skeletonSpaceInverseTransposeMatrix.m[r][3] = -(n[r][0] * a[3][0] + n[r][1] * a[3][1] + n[r][2] * a[3][2]) * inverseDeterminant;
+			}
+			well.skeletonSpaceInverseTransposeMatrix.m[3][0] = 0.0f;
+			well.skeletonSpaceInverseTransposeMatrix.m[3][1] = 0.0f;
+			well.skeletonSpaceInverseTransposeMatrix.m[3][2] = 0.0f;
+			well.skeletonSpaceInverseTransposeMatrix.m[3][3] = 1.0f;
+#endif
+		}
+	}
+
+	void SkinVertices(std::span<const VertexDataPosUVNormal> inputVertices, std::span<const Model::VertexInfluence> influences, std::span<const Model::WellForGPU> palette, std::span<VertexDataPosUVNormal> outputVertices)
+	{
+		assert(inputVertices.size() == influences.size() && inputVertices.size() == outputVertices.size());
+
+		for (size_t i = 0; i < inputVertices.size(); ++i)
+		{
+			const VertexDataPosUVNormal& input = inputVertices[i];
+			const Model::VertexInfluence& influence = influences[i];
+			VertexDataPosUVNormal& output = outputVertices[i];
+			output.texcoord = input.texcoord;
+
+#ifdef SKINNING_MATH_USE_SSE
+			//4つのジョイントの行列で変換した位置と法線を重みで合成する
+			const __m128 inputPosition = _mm_loadu_ps(&input.position.x);
+			const __m128 inputPositionW = Splat(inputPosition, 3);
+			const __m128 inputNormal = _mm_setr_ps(input.normal.x, input.normal.y, input.normal.z, 0.0f);
+			__m128 position = _mm_setzero_ps();
+			__m128 normal = _mm_setzero_ps();
+			for (uint32_t k = 0; k < Model::kNumMaxInfluence; ++k)
+			{
+				const Model::WellForGPU& well = palette[influence.jointIndices[k]];
+				const __m128 weight = _mm_set1_ps(influence.weights[k]);
+				const Matrix4x4& m = well.skeletonSpaceMatrix;
+				const Matrix4x4& n = well.skeletonSpaceInverseTransposeMatrix;
+				const __m128 p = _mm_add_ps(TransformRow(inputPosition, LoadRow(m, 0), LoadRow(m, 1), LoadRow(m, 2)), _mm_mul_ps(inputPositionW, LoadRow(m, 3)));
+				position = _mm_add_ps(position, _mm_mul_ps(p, weight));
+				normal = _mm_add_ps(normal, _mm_mul_ps(TransformRow(inputNormal, LoadRow(n, 0), LoadRow(n, 1), LoadRow(n, 2)), weight));
+			}
+
+			//wには確実に1を入れる
+			_mm_storeu_ps(&output.position.x, SetW(position, 1.0f));
+
+			//法線を正規化する（4成分目は使わない）
+			const float lengthSq = Dot3(normal, normal);
+			alignas(16) float unitNormal[4];
+			_mm_store_ps(unitNormal, _mm_mul_ps(normal, _mm_set1_ps(lengthSq > 0.0f ? 1.0f / std::sqrt(lengthSq) : 0.0f)));
+			output.normal = { unitNormal[0], unitNormal[1], unitNormal[2] };
+#else
+			//4つのジョイントの行列で変換した位置と法線を重みで合成する
+			const Vector4& p = input.position;
+			const Vector3& v = input.normal;
+			Vector4 position = { 0.0f, 0.0f, 0.0f, 0.0f };
+			Vector3 normal = { 0.0f, 0.0f, 0.0f };
+			for (uint32_t k = 0; k < Model::kNumMaxInfluence; ++k)
+			{
+				const Model::WellForGPU& well = palette[influence.jointIndices[k]];
+				const float weight = influence.weights[k];
+				const float (*m)[4] = well.skeletonSpaceMatrix.m;
+				const float (*n)[4] = well.skeletonSpaceInverseTransposeMatrix.m;
+				position.x += (p.x * m[0][0] + p.y * m[1][0] + p.z * m[2][0] + p.w * m[3][0]) * weight;
+				position.y += (p.x * m[0][1] + p.y * m[1][1] + p.z * m[2][1] + p.w * m[3][1]) * weight;
+				position.z += (p.x * m[0][2] + p.y * m[1][2] + p.z * m[2][2] + p.w * m[3][2]) * weight;
+				normal.x += (v.x * n[0][0] + v.y * n[1][0] + v.z * n[2][0]) * weight;
+				normal.y += (v.x * n[0][1] + v.y * n[1][1] + v.z * n[2][1]) * weight;
+				normal.z += (v.x * n[0][2] + v.y * n[1][2] + v.z * n[2][2]) * weight;
+			}
+
+			//wには確実に1を入れる
+			position.w = 1.0f;
+			output.position = position;
+
+			//法線を正規化する
+			const float lengthSq = normal.x * normal.x + normal.y * normal.y + normal.z * normal.z;
+			const float inverseLength = lengthSq > 0.0f ? 1.0f / std::sqrt(lengthSq) : 0.0f;
+			output.normal = { normal.x * inverseLength, normal.y * inverseLength, normal.z * inverseLength };
+#endif
+		}
+	}
+}
@@ -0,0 +1,53 @@
+/**
+ * @file SkinningMath.h
+ * @brief スケルトンとスキンクラスターの行列をまとめて計算する関数群
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Model.h"
+#include <span>
+
+namespace SkinningMath
+{
+	/// <summary>
+	/// ジョイントの拡縮、回転、移動からローカル行列をまとめて作成（4ジョイントずつ計算する）
+	/// </summary>
+	/// <param name="joints">ジョイントの配列</param>
+	/// <param name="localMatrices">ローカル行列の書き込み先</param>
+	void CalculateLocalMatrices(std::span<const Model::Joint> joints, std::span<Matrix4x4> localMatrices);
+
+	/// <summary>
+	/// 親から順に並んだジョイントのスケルトン空間の行列を計算
+	/// </summary>
+	/// <param name="localMatrices">ローカル行列</param>
+	/// <param name="parents">親のジョイントの番号（いなければ-1、自身より小さい番号であること）</param>
+	/// <param name="skeletonSpaceMatrices">スケルトン空間の行列の書き込み先</param>
+	void CalculateSkeletonSpaceMatrices(std::span<const Matrix4x4> localMatrices, std::span<const int32_t> parents, std::span<Matrix4x4> skeletonSpaceMatrices);
+
+	/// <summary>
+	/// スケルトン空間の行列からスケールを取り除いてワールド行列を掛ける
+	/// </summary>
+	/// <param name="skeletonSpaceMatrices">スケルトン空間の行列</param>
+	/// <param name="worldMatrix">ワールド行列</param>
+	/// <param name="jointWorldTransforms">ジョイントのワールドトランスフォームの書き込み先</param>
+	void CalculateJointWorldMatrices(std::span<const Matrix4x4> skeletonSpaceMatrices, const Matrix4x4& worldMatrix, std::span<WorldTransform> jointWorldTransforms);
+
+	/// <summary>
+	/// マトリックスパレットを計算（法線用の逆転置行列はアフィン行列の構造から求める）
+	/// </summary>
+	/// <param name="inverseBindPoseMatrices">逆バインドポーズ行列</param>
+	/// <param name="skeletonSpaceMatrices">スケルトン空間の行列</param>
+	/// <param name="palette">パレットの書き込み先（書き込みのみ行う）</param>
+	void CalculatePalette(std::span<const Matrix4x4> inverseBindPoseMatrices, std::span<const Matrix4x4> skeletonSpaceMatrices, std::span<Model::WellForGPU> palette);
+
+	/// <summary>
+	/// CPUでスキニングを行う（Skinning.CS.hlslと同じ計算を頂点ごとに行う）
+	/// </summary>
+	/// <param name="inputVertices">スキニング前の頂点</param>
+	/// <param name="influences">頂点ごとのInfluence</param>
+	/// <param name="palette">マトリックスパレット</param>
+	/// <param name="outputVertices">スキニング後の頂点の書き込み先</param>
+	void SkinVertices(std::span<const VertexDataPosUVNormal> inputVertices, std::span<const Model::VertexInfluence> influences, std::span<const Model::WellForGPU> palette, std::span<VertexDataPosUVNormal> outputVertices);
+}
@@ -12,42 +12,77 @@ void WorldTransform::Initialize()
 {
 	constBuff_ = std::make_unique<UploadBuffer>();
 	constBuff_->Create(sizeof(ConstBuffDataWorldTransform));
+	isCachedMatrixTransferred_ = false;
 	UpdateMatrix();
 }
 
 void WorldTransform::TransferMatrix()
 {
+	//前回計算した行列を書き込み済みで、その行列から変わっていなければ書き込まない
+	const bool isCachedMatrix = isMatrixCached_ && matWorld_ == cachedMatWorld_;
+	if (isCachedMatrix && isCachedMatrixTransferred_) return;
+
 	ConstBuffDataWorldTransform* worldTransformData = static_cast<ConstBuffDataWorldTransform*>(constBuff_->Map());
 	worldTransformData->world = matWorld_;
-	worldTransformData->worldInverseTranspse = Mathf::Transpose(Mathf::Inverse(matWorld_));
+	worldTransformData->worldInverseTranspse = Mathf::InverseTranspose(matWorld_);
 	constBuff_->Unmap();
+	isCachedMatrixTransferred_ = isCachedMatrix;
 }
 
 void WorldTransform::UpdateMatrix()
 {
-	//回転のタイプに応じて行列の計算を変える
+	//行列の計算に使う値が前回から変わっていなければ前回の行列を使う
+	const bool isDirty = !isMatrixCached_ ||
+		rotationType_ != cachedRotationType_ ||
+		scale_ != cachedScale_ ||
+		translation_ != cachedTranslation_ ||
+		originOffset_ != cachedOriginOffsetSource_ ||
+		(rotationType_ == RotationType::Euler ? rotation_ != cachedRotation_ : quaternion_ != cachedQuaternion_) ||
+		parent_ != cachedParent_ ||
+		(parent_ && parent_->matWorld_ != cachedParentMatrix_);
+	if (!isDirty)
+	{
+		matWorld_ = cachedMatWorld_;
+		TransferMatrix();
+		return;
+	}
+
+	//回転のタイプに応じて回転行列の計算を変える
+	Matrix4x4 rotateMatrix{};
 	switch (rotationType_)
 	{
 	case RotationType::Euler:
-		//原点オフセットを回転させる
-		cachedOriginOffset_ = Mathf::TransformNormal(originOffset_, Mathf::MakeRotateMatrix(rotation_));
-		//アフィン行列の計算
-		matWorld_ = Mathf::MakeAffineMatrix(scale_, rotation_, translation_ + cachedOriginOffset_);
+		rotateMatrix = Mathf::MakeRotateMatrix(rotation_);
 		break;
 	case RotationType::Quaternion:
-		//原点オフセットを回転させる
-		cachedOriginOffset_ = Mathf::RotateVector(originOffset_, quaternion_);
-		//アフィン行列の計算
-		matWorld_ = Mathf::MakeAffineMatrix(scale_, quaternion_, translation_ + cachedOriginOffset_);
+		rotateMatrix = Mathf::MakeRotateMatrix(quaternion_);
 		break;
 	}
 
+	//原点オフセットを回転させる
+	cachedOriginOffset_ = Mathf::TransformNormal(originOffset_, rotateMatrix);
+	//アフィン行列の計算
+	matWorld_ = Mathf::MakeAffineMatrix(scale_, rotateMatrix, translation_ + cachedOriginOffset_);
+
 	//親がいる場合は親の行列をかける
 	if (parent_)
 	{
 		matWorld_ = matWorld_ * parent_->matWorld_;
+		cachedParentMatrix_ = parent_->matWorld_;
 	}
 
+	//計算に使った値を保存
+	cachedScale_ = scale_;
+	cachedRotation_ = rotation_;
+	cachedQuaternion_ = quaternion_;
+	cachedTranslation_ = translation_;
+	cachedOriginOffsetSource_ = originOffset_;
+	cachedRotationType_ = rotationType_;
+	cachedParent_ = parent_;
+	cachedMatWorld_ = matWorld_;
+	isMatrixCached_ = true;
+	isCachedMatrixTransferred_ = false;
+
 	//行列の転送
 	TransferMatrix();
 }
@@ -29,12 +29,12 @@ public:
 	void Initialize();
 
 	/// <summary>
-	/// 行列を書き込む
+	/// 行列を書き込む（前回計算した行列を書き込み済みの場合は書き込まない）
 	/// </summary>
 	void TransferMatrix();
 
 	/// <summary>
-	/// 行列の更新
+	/// 行列の更新（スケール・回転・座標・親の行列が前回から変わっていない場合は再計算しない）
 	/// </summary>
 	void UpdateMatrix();
 
@@ -70,6 +70,7 @@ public:
 			matWorld_ = rhs.matWorld_;
 			parent_ = rhs.parent_;
 			rotationType_ = rhs.rotationType_;
+			isMatrixCached_ = false;
 		}
 		return *this;
 	}
@@ -105,5 +106,24 @@ private:
 
 	//キャッシュされたオフセット
 	Vector3 cachedOriginOffset_{};
+
+	//前回行列を計算したときの値
+	Vector3 cachedScale_{};
+	Vector3 cachedRotation_{};
+	Quaternion cachedQuaternion_{};
+	Vector3 cachedTranslation_{};
+	Vector3 cachedOriginOffsetSource_{};
+	RotationType cachedRotationType_ = RotationType::Euler;
+	const WorldTransform* cachedParent_ = nullptr;
+	Matrix4x4 cachedParentMatrix_{};
+
+	//前回計算したワールド行列（外部で書き換えられても再計算せずに戻せるように）
+	Matrix4x4 cachedMatWorld_{};
+
+	//キャッシュが有効かどうか
+	bool isMatrixCached_ = false;
+
+	//前回計算したワールド行列を定数バッファに書き込み済みかどうか
+	bool isCachedMatrixTransferred_ = false;
 };
 
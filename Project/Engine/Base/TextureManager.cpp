@@ -35,6 +35,11 @@ void TextureManager::Load(const std::string& filePath)
 	TextureManager::GetInstance()->LoadInternal(filePath);
 }
 
+AssetLoader::Handle TextureManager::LoadAsync(const std::string& filename)
+{
+	return TextureManager::GetInstance()->LoadAsyncInternal(filename);
+}
+
 void TextureManager::Initialize()
 {
 	LoadInternal("white.png");
@@ -53,30 +58,68 @@ const Texture* TextureManager::FindTexture(const std::string& name) const
 
 void TextureManager::LoadInternal(const std::string& filename)
 {
+	//読み込み中であれば完了を待つ
+	auto pendingIt = pendingTextures_.find(filename);
+	if (pendingIt != pendingTextures_.end())
+	{
+		const AssetLoader::Handle handle = pendingIt->second;
+		AssetLoader::GetInstance()->Wait(handle);
+	}
+
 	auto it = textures_.find(filename);
 	if (it != textures_.end())
 	{
 		return;
 	}
 
-	//テクスチャを読み込む
-	std::string filePath = kBaseDirectory + "/" + filename;
-	if (filename.find("Application/Resources/Models") != std::string::npos)
+	//テクスチャを読み込んで作成
+	CreateTexture(filename, LoadTexture(GetFilePath(filename)));
+}
+
+AssetLoader::Handle TextureManager::LoadAsyncInternal(const std::string& filename)
+{
+	//読み込み済みであれば何もしない
+	if (textures_.contains(filename))
+	{
+		return AssetLoader::Handle();
+	}
+
+	//読み込み中であれば同じハンドルを返す
+	auto pendingIt = pendingTextures_.find(filename);
+	if (pendingIt != pendingTextures_.end())
 	{
-		filePath = filename;
+		return pendingIt->second;
 	}
-	else if (filename.find("Application/Resources/Images") != std::string::npos)
+
+	//ワーカースレッドでデコードし、テクスチャの作成は完了処理で行う
+	const std::string filePath = GetFilePath(filename);
+	AssetLoader::Handle handle = AssetLoader::GetInstance()->Request([this, filename, filePath]() -> AssetLoader::FinalizeFunction {
+		std::shared_ptr<DirectX::ScratchImage> mipImages = std::make_shared<DirectX::ScratchImage>(LoadTexture(filePath));
+		return [this, filename, mipImages]() { CreateTexture(filename, *mipImages); };
+		});
+	pendingTextures_[filename] = handle;
+	return handle;
+}
+
+std::string TextureManager::GetFilePath(const std::string& filename) const
+{
+	//モデルや画像のディレクトリを含む場合はそのまま使う
+	if (filename.find("Application/Resources/Models") != std::string::npos || filename.find("Application/Resources/Images") != std::string::npos)
 	{
-		filePath = filename;
+		return filename;
 	}
-	DirectX::ScratchImage mipImages = LoadTexture(filePath);
+	return kBaseDirectory + "/" + filename;
+}
 
+void TextureManager::CreateTexture(const std::string& filename, const DirectX::ScratchImage& mipImages)
+{
 	//テクスチャの作成
 	std::unique_ptr<Texture> texture = std::make_unique<Texture>();
 	texture->Create(mipImages);
 
 	//コンテナに追加
 	textures_[filename] = std::move(texture);
+	pendingTextures_.erase(filename);
 }
 
 DirectX::ScratchImage TextureManager::LoadTexture(const std::string& filePath) {
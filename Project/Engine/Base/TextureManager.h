@@ -7,6 +7,7 @@
 
 #pragma once
 #include "Texture.h"
+#include "Engine/Utilities/AssetLoader.h"
 
 class TextureManager
 {
@@ -31,6 +32,13 @@ public:
 	/// <param name="filename">ファイルの名前</param>
 	static void Load(const std::string& filename);
 
+	/// <summary>
+	/// 読み込みを要求（デコードとミップマップの作成はワーカースレッドで行い、GPUリソースの作成は待機したスレッドで行う）
+	/// </summary>
+	/// <param name="filename">ファイルの名前</param>
+	/// <returns>読み込みの完了を待つハンドル</returns>
+	static AssetLoader::Handle LoadAsync(const std::string& filename);
+
 	/// <summary>
 	/// 初期化
 	/// </summary>
@@ -56,15 +64,38 @@ private:
 	void LoadInternal(const std::string& filePath);
 
 	/// <summary>
-	/// テクスチャを読み込む
+	/// 読み込みを内部で要求
+	/// </summary>
+	/// <param name="filename">ファイルの名前</param>
+	/// <returns>読み込みの完了を待つハンドル</returns>
+	AssetLoader::Handle LoadAsyncInternal(const std::string& filename);
+
+	/// <summary>
+	/// ファイルの名前からファイルパスを取得
+	/// </summary>
+	/// <param name="filename">ファイルの名前</param>
+	/// <returns>ファイルパス</returns>
+	std::string GetFilePath(const std::string& filename) const;
+
+	/// <summary>
+	/// テクスチャを読み込む（メンバ変数を変更しないのでワーカースレッドで実行できる）
 	/// </summary>
 	/// <param name="filePath">ファイルパス</param>
 	/// <returns>スクラッチイメージ</returns>
 	DirectX::ScratchImage LoadTexture(const std::string& filePath);
 
+	/// <summary>
+	/// テクスチャを作成してコンテナに追加
+	/// </summary>
+	/// <param name="filename">ファイルの名前</param>
+	/// <param name="mipImages">ミップマップ付きのデータ</param>
+	void CreateTexture(const std::string& filename, const DirectX::ScratchImage& mipImages);
+
 private:
 	static TextureManager* instance_;
 
 	std::unordered_map<std::string, std::unique_ptr<Texture>> textures_{};
+
+	std::unordered_map<std::string, AssetLoader::Handle> pendingTextures_{};
 };
 
@@ -13,37 +13,93 @@
 
 void AnimatorComponent::Update()
 {
+    //アニメーションの並列処理で姿勢が更新されていなければここで更新する
+    if (!isPoseUpdated_)
+    {
+        UpdatePose();
+    }
+    isPoseUpdated_ = false;
+
+    //モデルがない場合は何もしない
+    ModelComponent* modelComponent = GetModelComponent();
+    if (!modelComponent)
+    {
+        return;
+    }
+
+    //ルートノードのアニメーションをワールド行列に適用
+    if (isPoseApplied_ && hasRootNodeMatrix_)
+    {
+        TransformComponent* transformComponent = GetTransformComponent();
+        transformComponent->worldTransform_.matWorld_ = rootNodeMatrix_ * transformComponent->worldTransform_.matWorld_;
+    }
+
+    //モデルの更新（モデルコンポーネント自身の更新では行わないのでここで1回だけ行う）
+    modelComponent->UpdateModel();
+}
+
+void AnimatorComponent::UpdatePose()
+{
+    //姿勢の更新済みフラグを立てる
+    isPoseUpdated_ = true;
+    isPoseApplied_ = false;
+    hasRootNodeMatrix_ = false;
+
+    //モデルを取得（アニメーションがなくても先にモデルの更新を引き受けておく）
+    ModelComponent* modelComponent = GetModelComponent();
+    if (!modelComponent)
+    {
+        return;
+    }
+    Model* model = modelComponent->GetModel();
+
     //現在のアニメーションがない場合は何もしない
     if (currentAnimation_.empty())
     {
         return;
     }
 
-    //現在のアニメーションを取得
-    Animation* currentAnimation = animations_[currentAnimation_].get();
-    if (!currentAnimation)
+    //現在のアニメーションまたはブレンドツリーを取得
+    Animation* currentAnimation = GetAnimation(currentAnimation_);
+    AnimationBlendTree* currentBlendTree = GetBlendTree(currentAnimation_);
+    if (!currentAnimation && !currentBlendTree)
     {
         return;
     }
 
-    //モデルを取得
-    ModelComponent* modelComponent = owner_->GetComponent<ModelComponent>();
-    if (!modelComponent)
+    //次のアニメーションまたはブレンドツリーを取得
+    Animation* nextAnimation = !nextAnimation_.empty() ? GetAnimation(nextAnimation_) : nullptr;
+    AnimationBlendTree* nextBlendTree = !nextAnimation_.empty() ? GetBlendTree(nextAnimation_) : nullptr;
+    const bool hasNextAnimation = (nextAnimation || nextBlendTree) && isBlending_;
+
+    //現在のスケルトンの姿勢を初期値として現在のアニメーションの姿勢を求める
+    currentPose_.CopyFromSkeleton(model->GetSkeleton());
+    EvaluatePose(currentAnimation_, model, currentPose_);
+
+    //次のアニメーションがある場合は現在の姿勢を初期値として求めて補間する（チャンネルのないジョイントは現在の姿勢のまま）
+    if (hasNextAnimation)
     {
-        return;
+        nextPose_.Copy(currentPose_);
+        EvaluatePose(nextAnimation_, model, nextPose_);
+        currentPose_.Blend(currentPose_, nextPose_, blendFactor_);
     }
 
-    //次のアニメーションを取得
-    Animation* nextAnimation = !nextAnimation_.empty() ? animations_[nextAnimation_].get() : nullptr;
-    //次のアニメーションがある場合
-    if (nextAnimation && isBlending_)
+    //ジョイントに姿勢を書き込む
+    currentPose_.ApplyToSkeleton(model->GetSkeleton());
+
+    //アニメーション同士の場合はルートノードのローカル行列を求めておく（ワールド行列への適用は更新処理で行う）
+    if (currentAnimation && (!hasNextAnimation || nextAnimation))
     {
-        //トランスフォームを取得
-        TransformComponent* transformComponent = owner_->GetComponent<TransformComponent>();
+        hasRootNodeMatrix_ = currentAnimation->CalculateRootNodeMatrix(model, hasNextAnimation ? nextAnimation : nullptr, blendFactor_, rootNodeMatrix_);
+    }
 
-        //ブレンドしたアニメーションを適用
-        currentAnimation->ApplyBlendAnimation(modelComponent->GetModel(), transformComponent->worldTransform_, nextAnimation, blendFactor_, inPlaceAxis_);
+    //スケルトン空間の行列とマトリックスパレットを更新
+    model->UpdatePose();
+    isPoseApplied_ = true;
 
+    //次のアニメーションがある場合
+    if (hasNextAnimation)
+    {
         //ブレンドファクターを更新
         blendFactor_ += GameTimer::GetDeltaTime() / blendDuration_;
         blendFactor_ = std::min<float>(blendFactor_, 1.0f); //1.0f を超えないようにする
@@ -68,18 +124,9 @@ void AnimatorComponent::Update()
     }
     else
     {
-        //トランスフォームを取得
-        TransformComponent* transformComponent = owner_->GetComponent<TransformComponent>();
-
-        //アニメーションの適用
-        currentAnimation->ApplyAnimation(modelComponent->GetModel(), transformComponent->worldTransform_, inPlaceAxis_);
-
         //アニメーションブレンドの終了フラグを立てる
         isBlendingCompleted_ = true;
     }
-
-    //モデルの更新
-    modelComponent->Update();
 }
 
 void AnimatorComponent::AddAnimation(const std::string& animationName, Animation* animation)
@@ -88,17 +135,31 @@ void AnimatorComponent::AddAnimation(const std::string& animationName, Animation
     animations_[animationName] = std::unique_ptr<Animation>(animation);
 }
 
+void AnimatorComponent::AddBlendTree(const std::string& blendTreeName, AnimationBlendTree* blendTree)
+{
+    //ブレンドツリーをマップに追加
+    blendTrees_[blendTreeName] = std::unique_ptr<AnimationBlendTree>(blendTree);
+}
+
 void AnimatorComponent::PlayAnimation(const std::string& animationName, const float speed, const bool loop, const Vector3& inPlaceAxis)
 {
-    //アニメーションが存在するかチェック
-    auto it = animations_.find(animationName);
-    if (it != animations_.end())
+    //アニメーションまたはブレンドツリーが存在するかチェック
+    Animation* animation = GetAnimation(animationName);
+    AnimationBlendTree* blendTree = GetBlendTree(animationName);
+    if (animation || blendTree)
     {
         //固定する軸を設定
         inPlaceAxis_ = inPlaceAxis;
 
         //アニメーションの再生
-        it->second->PlayAnimation(speed, loop);
+        if (animation)
+        {
+            animation->PlayAnimation(speed, loop);
+        }
+        else
+        {
+            blendTree->PlayAnimation(speed, loop);
+        }
 
         //アニメーションブレンドをしない場合
         if (!isBlending_)
@@ -153,6 +214,16 @@ void AnimatorComponent::StopAnimation()
     {
         nextAnimation->second->StopAnimation();
     }
+
+    //ブレンドツリーも同様に処理
+    for (const std::string& name : { currentAnimation_, nextAnimation_ })
+    {
+        AnimationBlendTree* blendTree = GetBlendTree(name);
+        if (blendTree)
+        {
+            blendTree->StopAnimation();
+        }
+    }
 }
 
 void AnimatorComponent::PauseAnimation()
@@ -170,6 +241,16 @@ void AnimatorComponent::PauseAnimation()
     {
         nextAnimation->second->PauseAnimation();
     }
+
+    //ブレンドツリーも同様に処理
+    for (const std::string& name : { currentAnimation_, nextAnimation_ })
+    {
+        AnimationBlendTree* blendTree = GetBlendTree(name);
+        if (blendTree)
+        {
+            blendTree->PauseAnimation();
+        }
+    }
 }
 
 void AnimatorComponent::ResumeAnimation()
@@ -187,6 +268,16 @@ void AnimatorComponent::ResumeAnimation()
     {
         nextAnimation->second->ResumeAnimation();
     }
+
+    //ブレンドツリーも同様に処理
+    for (const std::string& name : { currentAnimation_, nextAnimation_ })
+    {
+        AnimationBlendTree* blendTree = GetBlendTree(name);
+        if (blendTree)
+        {
+            blendTree->ResumeAnimation();
+        }
+    }
 }
 
 const bool AnimatorComponent::GetIsBlendingCompleted() const
@@ -196,6 +287,12 @@ const bool AnimatorComponent::GetIsBlendingCompleted() const
 
 const bool AnimatorComponent::GetIsAnimationFinished(const std::string& animationName) const
 {
+    //ブレンドツリーの場合は全てのアニメーションが終了しているかを返す
+    if (AnimationBlendTree* blendTree = GetBlendTree(animationName))
+    {
+        return blendTree->GetIsAnimationFinished();
+    }
+
     Animation* animation = GetAnimation(animationName);
     return animation ? animation->GetIsAnimationFinished() : true;
 }
@@ -389,4 +486,56 @@ Animation* AnimatorComponent::GetAnimation(const std::string& animationName) con
         return it->second.get();
     }
     return nullptr;
-}
\ No newline at end of file
+}
+
+AnimationBlendTree* AnimatorComponent::GetBlendTree(const std::string& blendTreeName) const
+{
+    auto it = blendTrees_.find(blendTreeName);
+    if (it != blendTrees_.end())
+    {
+        return it->second.get();
+    }
+    return nullptr;
+}
+
+void AnimatorComponent::EvaluatePose(const std::string& animationName, Model* model, AnimationPose& pose)
+{
+    //ブレンドツリーの場合はツリーを評価する
+    if (AnimationBlendTree* blendTree = GetBlendTree(animationName))
+    {
+        blendTree->UpdateAnimationTime();
+        blendTree->Evaluate(model, pose, inPlaceAxis_);
+        return;
+    }
+
+    //アニメーションの場合はアニメーションの姿勢を書き込む
+    if (Animation* animation = GetAnimation(animationName))
+    {
+        animation->UpdateAnimationTime();
+        animation->SamplePose(model, pose, inPlaceAxis_);
+    }
+}
+
+ModelComponent* AnimatorComponent::GetModelComponent()
+{
+    //見つかったモデルはこのアニメーターがルートノードの行列を適用してから更新する
+    if (!modelComponent_)
+    {
+        modelComponent_ = owner_->GetComponent<ModelComponent>();
+        if (modelComponent_)
+        {
+            modelComponent_->SetIsUpdatedByAnimator(true);
+        }
+    }
+    return modelComponent_;
+}
+
+TransformComponent* AnimatorComponent::GetTransformComponent()
+{
+    //コンポーネントのアドレスは持ち主が破棄されるまで変わらないので一度見つけたものを使い続ける
+    if (!transformComponent_)
+    {
+        transformComponent_ = owner_->GetComponent<TransformComponent>();
+    }
+    return transformComponent_;
+}
@@ -7,8 +7,12 @@
 
 #pragma once
 #include "Engine/3D/Model/Animation.h"
+#include "Engine/3D/Model/AnimationBlendTree.h"
 #include "Engine/Components/Base/Component.h"
 
+class ModelComponent;
+class TransformComponent;
+
 class AnimatorComponent : public Component
 {
 public:
@@ -18,10 +22,15 @@ public:
 	void Initialize() override {};
 
 	/// <summary>
-	/// 更新
+	/// 更新（ルートノードのアニメーションの適用とモデルの更新を行う）
 	/// </summary>
 	void Update() override;
 
+	/// <summary>
+	/// アニメーションの時間を進めて姿勢とマトリックスパレットを更新（ワールド行列を使わないので他のアニメーターと並列に呼べる）
+	/// </summary>
+	void UpdatePose();
+
 	/// <summary>
 	/// アニメーションを追加
 	/// </summary>
@@ -29,6 +38,13 @@ public:
 	/// <param name="animation">アニメーション</param>
 	void AddAnimation(const std::string& animationName, Animation* animation);
 
+	/// <summary>
+	/// ブレンドツリーを追加（再生やブレンドはアニメーションと同じように名前で行う）
+	/// </summary>
+	/// <param name="blendTreeName">ブレンドツリーの名前</param>
+	/// <param name="blendTree">ブレンドツリー</param>
+	void AddBlendTree(const std::string& blendTreeName, AnimationBlendTree* blendTree);
+
 	/// <summary>
 	/// アニメーションを再生
 	/// </summary>
@@ -110,13 +126,44 @@ public:
 	//指定したアニメーションを取得
 	Animation* GetAnimation(const std::string& animationName) const;
 
+	//指定したブレンドツリーを取得
+	AnimationBlendTree* GetBlendTree(const std::string& blendTreeName) const;
+
 	//指定したアニメーションをまとめて取得
 	const std::map<std::string, std::unique_ptr<Animation>>& GetAnimations() const { return animations_; };
 
+private:
+	/// <summary>
+	/// アニメーションまたはブレンドツリーの時間を進めて姿勢バッファに書き込む
+	/// </summary>
+	/// <param name="animationName">アニメーションまたはブレンドツリーの名前</param>
+	/// <param name="model">モデル</param>
+	/// <param name="pose">書き込み先の姿勢（チャンネルのないジョイントの初期値を入れておく）</param>
+	void EvaluatePose(const std::string& animationName, Model* model, AnimationPose& pose);
+
+	/// <summary>
+	/// 持ち主のモデルコンポーネントを取得（初めて見つかったときにモデルの更新を引き受ける）
+	/// </summary>
+	/// <returns>モデルコンポーネント</returns>
+	ModelComponent* GetModelComponent();
+
+	/// <summary>
+	/// 持ち主のトランスフォームコンポーネントを取得（見つかった後は持ち主を参照せずに返す）
+	/// </summary>
+	/// <returns>トランスフォームコンポーネント</returns>
+	TransformComponent* GetTransformComponent();
+
 private:
 	//アニメーションのマップ
 	std::map<std::string, std::unique_ptr<Animation>> animations_{};
 
+	//ブレンドツリーのマップ
+	std::map<std::string, std::unique_ptr<AnimationBlendTree>> blendTrees_{};
+
+	//ブレンドツリーの合成に使う姿勢バッファ（現在のアニメーション、次のアニメーション）
+	AnimationPose currentPose_{};
+	AnimationPose nextPose_{};
+
 	//現在のアニメーションの名前
 	std::string currentAnimation_{};
 
@@ -137,5 +184,23 @@ private:
 
 	//固定する軸
 	Vector3 inPlaceAxis_ = { 1.0f,1.0f,1.0f };
+
+	//ルートノードのローカル行列
+	Matrix4x4 rootNodeMatrix_{};
+
+	//ルートノードのアニメーションがあるかどうか
+	bool hasRootNodeMatrix_ = false;
+
+	//このフレームの姿勢を更新済みかどうか
+	bool isPoseUpdated_ = false;
+
+	//モデルに姿勢を適用したかどうか
+	bool isPoseApplied_ = false;
+
+	//持ち主のモデルコンポーネント
+	ModelComponent* modelComponent_ = nullptr;
+
+	//持ち主のトランスフォームコンポーネント
+	TransformComponent* transformComponent_ = nullptr;
 };
 
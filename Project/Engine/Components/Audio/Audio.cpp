@@ -51,15 +51,63 @@ void Audio::Initialize()
 
 uint32_t Audio::LoadAudioFile(const std::string& filename)
 {
+	//読み込み中であれば完了を待つ
+	auto pendingIt = pendingSoundDatas_.find(filename);
+	if (pendingIt != pendingSoundDatas_.end())
+	{
+		const AssetLoader::Handle handle = pendingIt->second;
+		AssetLoader::GetInstance()->Wait(handle);
+	}
+
 	//同じ音声データがないか探す
-	for (SoundData& soundData : soundDatas_)
+	const int32_t audioHandle = FindSoundData(filename);
+	if (audioHandle >= 0)
+	{
+		return audioHandle;
+	}
+
+	//デコードして登録
+	return RegisterSoundData(filename, DecodeAudioFile(filename));
+}
+
+AssetLoader::Handle Audio::LoadAudioFileAsync(const std::string& filename)
+{
+	//読み込み済みであれば何もしない
+	if (FindSoundData(filename) >= 0)
+	{
+		return AssetLoader::Handle();
+	}
+
+	//読み込み中であれば同じハンドルを返す
+	auto pendingIt = pendingSoundDatas_.find(filename);
+	if (pendingIt != pendingSoundDatas_.end())
+	{
+		return pendingIt->second;
+	}
+
+	//ワーカースレッドでデコードし、登録は完了処理で行う
+	AssetLoader::Handle handle = AssetLoader::GetInstance()->Request([this, filename]() -> AssetLoader::FinalizeFunction {
+		std::shared_ptr<SoundData> soundData = std::make_shared<SoundData>(DecodeAudioFile(filename));
+		return [this, filename, soundData]() { RegisterSoundData(filename, std::move(*soundData)); };
+		});
+	pendingSoundDatas_[filename] = handle;
+	return handle;
+}
+
+int32_t Audio::FindSoundData(const std::string& filename) const
+{
+	for (const SoundData& soundData : soundDatas_)
 	{
 		if (soundData.name == filename)
 		{
 			return soundData.audioHandle;
 		}
 	}
+	return -1;
+}
 
+Audio::SoundData Audio::DecodeAudioFile(const std::string& filename) const
+{
 	//ファイルパスの設定
 	std::string filePath = kBaseDirectory + "/" + filename;
 	if (filename.find("Application/Resources/Sounds") != std::string::npos)
@@ -111,16 +159,25 @@ uint32_t Audio::LoadAudioFile(const std::string& filename)
 		pMFSample->Release();
 	}
 
-	audioHandle_++;
-	soundDatas_[audioHandle_].wfex = *waveFormat;
-	soundDatas_[audioHandle_].pBuffer = mediaData;
-	soundDatas_[audioHandle_].bufferSize = mediaData.size();
-	soundDatas_[audioHandle_].name = filename;
-	soundDatas_[audioHandle_].audioHandle = audioHandle_;
+	SoundData soundData{};
+	soundData.wfex = *waveFormat;
+	soundData.pBuffer = std::move(mediaData);
+	soundData.bufferSize = soundData.pBuffer.size();
 	CoTaskMemFree(waveFormat);
 	pMFMediaType->Release();
 	pMFSourceReader->Release();
 
+	return soundData;
+}
+
+uint32_t Audio::RegisterSoundData(const std::string& filename, SoundData&& soundData)
+{
+	audioHandle_++;
+	soundDatas_[audioHandle_] = std::move(soundData);
+	soundDatas_[audioHandle_].name = filename;
+	soundDatas_[audioHandle_].audioHandle = audioHandle_;
+	pendingSoundDatas_.erase(filename);
+
 	return audioHandle_;
 }
 
@@ -6,10 +6,13 @@
  */
 
 #pragma once
+#include "Engine/Utilities/AssetLoader.h"
 #include <array>
 #include <vector>
 #include <set>
 #include <fstream>
+#include <string>
+#include <unordered_map>
 #include <wrl.h>
 #include <xaudio2.h>
 #include <mfapi.h>
@@ -118,6 +121,13 @@ public:
 	/// <returns>オーディオハンドル</returns>
 	uint32_t LoadAudioFile(const std::string& filename);
 
+	/// <summary>
+	/// 音声データの読み込みを要求（デコードはワーカースレッドで行い、LoadAudioFileでハンドルを取得する）
+	/// </summary>
+	/// <param name="filename">ファイルの名前</param>
+	/// <returns>読み込みの完了を待つハンドル</returns>
+	AssetLoader::Handle LoadAudioFileAsync(const std::string& filename);
+
 	/// <summary>
 	/// サウンドデータを解放
 	/// </summary>
@@ -145,6 +155,28 @@ private:
 	Audio(const Audio&) = delete;
 	const Audio& operator = (const Audio&) = delete;
 
+	/// <summary>
+	/// 音声データを探す
+	/// </summary>
+	/// <param name="filename">ファイルの名前</param>
+	/// <returns>オーディオハンドル（ない場合は-1）</returns>
+	int32_t FindSoundData(const std::string& filename) const;
+
+	/// <summary>
+	/// 音声ファイルをPCMにデコード（メンバ変数を変更しないのでワーカースレッドで実行できる）
+	/// </summary>
+	/// <param name="filename">ファイルの名前</param>
+	/// <returns>名前とハンドルを設定していない音声データ</returns>
+	SoundData DecodeAudioFile(const std::string& filename) const;
+
+	/// <summary>
+	/// デコードした音声データを登録
+	/// </summary>
+	/// <param name="filename">ファイルの名前</param>
+	/// <param name="soundData">音声データ</param>
+	/// <returns>オーディオハンドル</returns>
+	uint32_t RegisterSoundData(const std::string& filename, SoundData&& soundData);
+
 private:
 	ComPtr<IXAudio2> xAudio2_ = nullptr;
 
@@ -154,6 +186,8 @@ private:
 
 	std::set<Voice*> sourceVoices_{};
 
+	std::unordered_map<std::string, AssetLoader::Handle> pendingSoundDatas_{};
+
 	int32_t audioHandle_ = -1;
 
 	int32_t voiceHandle_ = -1;
@@ -6,8 +6,30 @@
  */
 
 #pragma once
+#include <atomic>
+#include <cstdint>
+
 class GameObject;
 
+class ComponentTypeId
+{
+public:
+	/// <summary>
+	/// 型ごとの番号を取得（初めて取得した順に0から振られる）
+	/// </summary>
+	/// <returns>型ごとの番号</returns>
+	template<class Type>
+	static uint32_t Get()
+	{
+		static const uint32_t id = counter_.fetch_add(1);
+		return id;
+	}
+
+private:
+	//次に振る番号
+	static inline std::atomic<uint32_t> counter_ = 0;
+};
+
 class Component
 {
 public:
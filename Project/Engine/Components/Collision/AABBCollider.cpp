@@ -15,7 +15,7 @@ void AABBCollider::Update()
 	if (!isWorldCenterSet_)
 	{
 		//トランスフォームコンポーネントからワールド座標を計算
-		TransformComponent* transformComponent = owner_->GetComponent<TransformComponent>();
+		TransformComponent* transformComponent = GetTransformComponent();
 		worldCenter_ = transformComponent->GetWorldPosition() + center_;
 	}
 }
@@ -12,6 +12,11 @@
 class AABBCollider : public Collider
 {
 public:
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	AABBCollider() : Collider(ColliderType::kAABB) {};
+
 	/// <summary>
 	/// 初期化
 	/// </summary>
@@ -28,6 +33,9 @@ public:
 	/// <param name="camera">カメラ</param>
 	void Draw(const Camera& camera) override;
 
+	//ワールド座標系の境界ボックスを取得
+	Bounds GetWorldBounds() const override { return { worldCenter_ + min_, worldCenter_ + max_ }; };
+
 	//ワールド座標系の中心点を取得・設定
 	const Vector3& GetWorldCenter() const { return worldCenter_; };
 	void SetWorldCenter(const Vector3& worldCenter)
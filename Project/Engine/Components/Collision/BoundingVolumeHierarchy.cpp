@@ -0,0 +1,149 @@
+/**
+ * @file BoundingVolumeHierarchy.cpp
+ * @brief コライダーの境界ボリューム階層を管理するファイル
+ * @author 青木智滉
+ * @date
+ */
+
+#include "BoundingVolumeHierarchy.h"
+#include <algorithm>
+
+namespace
+{
+	//軸のインデックスから成分を取得
+	float GetAxisValue(const Vector3& v, int axis)
+	{
+		return axis == 0 ? v.x : axis == 1 ? v.y : v.z;
+	}
+
+	//2つの境界ボックスを合成
+	Collider::Bounds Merge(const Collider::Bounds& bounds1, const Collider::Bounds& bounds2)
+	{
+		return {
+			{ std::min<float>(bounds1.min.x, bounds2.min.x), std::min<float>(bounds1.min.y, bounds2.min.y), std::min<float>(bounds1.min.z, bounds2.min.z) },
+			{ std::max<float>(bounds1.max.x, bounds2.max.x), std::max<float>(bounds1.max.y, bounds2.max.y), std::max<float>(bounds1.max.z, bounds2.max.z) },
+		};
+	}
+}
+
+void BoundingVolumeHierarchy::Build(const std::vector<Collider*>& colliders)
+{
+	//前回のデータをクリア
+	Clear();
+
+	//葉にするコライダーの境界ボックスを計算
+	std::vector<uint32_t> indices{};
+	colliderBounds_.resize(colliders.size());
+	leafNodes_.assign(colliders.size(), -1);
+	for (uint32_t i = 0; i < static_cast<uint32_t>(colliders.size()); ++i)
+	{
+		if (colliders[i])
+		{
+			colliderBounds_[i] = colliders[i]->GetWorldBounds();
+			indices.push_back(i);
+		}
+	}
+
+	//コライダーが存在しない場合は何もしない
+	if (indices.empty())
+	{
+		return;
+	}
+
+	//葉の数をNとするとノードの数は2N-1
+	nodes_.reserve(indices.size() * 2 - 1);
+	BuildRecursive(indices.data(), indices.data() + indices.size(), -1);
+}
+
+void BoundingVolumeHierarchy::Remove(uint32_t colliderIndex)
+{
+	//葉が存在しない場合は何もしない
+	if (colliderIndex >= leafNodes_.size() || leafNodes_[colliderIndex] < 0)
+	{
+		return;
+	}
+
+	//葉を空にする
+	int32_t nodeIndex = leafNodes_[colliderIndex];
+	leafNodes_[colliderIndex] = -1;
+	nodes_[nodeIndex].isEmpty = true;
+
+	//祖先ノードの境界ボックスを更新
+	for (int32_t parent = nodes_[nodeIndex].parent; parent >= 0; parent = nodes_[parent].parent)
+	{
+		RefitNode(parent);
+	}
+}
+
+void BoundingVolumeHierarchy::Clear()
+{
+	nodes_.clear();
+	leafNodes_.clear();
+	colliderBounds_.clear();
+}
+
+int32_t BoundingVolumeHierarchy::BuildRecursive(uint32_t* begin, uint32_t* end, int32_t parent)
+{
+	//ノードを追加
+	const int32_t nodeIndex = static_cast<int32_t>(nodes_.size());
+	nodes_.emplace_back();
+	nodes_[nodeIndex].parent = parent;
+
+	//コライダーが1つの場合は葉にする
+	if (end - begin == 1)
+	{
+		nodes_[nodeIndex].bounds = colliderBounds_[*begin];
+		nodes_[nodeIndex].colliderIndex = *begin;
+		leafNodes_[*begin] = nodeIndex;
+		return nodeIndex;
+	}
+
+	//中心点の範囲が最も広い軸を選ぶ
+	Vector3 centerMin = (colliderBounds_[*begin].min + colliderBounds_[*begin].max) * 0.5f;
+	Vector3 centerMax = centerMin;
+	for (uint32_t* it = begin; it != end; ++it)
+	{
+		Vector3 center = (colliderBounds_[*it].min + colliderBounds_[*it].max) * 0.5f;
+		centerMin = { std::min<float>(centerMin.x, center.x), std::min<float>(centerMin.y, center.y), std::min<float>(centerMin.z, center.z) };
+		centerMax = { std::max<float>(centerMax.x, center.x), std::max<float>(centerMax.y, center.y), std::max<float>(centerMax.z, center.z) };
+	}
+	Vector3 extent = centerMax - centerMin;
+	const int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+	//中央値で2分割
+	uint32_t* middle = begin + (end - begin) / 2;
+	std::nth_element(begin, middle, end, [&](uint32_t a, uint32_t b) {
+		return GetAxisValue(colliderBounds_[a].min, axis) + GetAxisValue(colliderBounds_[a].max, axis) <
+			GetAxisValue(colliderBounds_[b].min, axis) + GetAxisValue(colliderBounds_[b].max, axis);
+		});
+
+	//子ノードを構築（構築中にnodes_が再確保されないようにreserve済み）
+	const int32_t left = BuildRecursive(begin, middle, nodeIndex);
+	const int32_t right = BuildRecursive(middle, end, nodeIndex);
+	nodes_[nodeIndex].left = left;
+	nodes_[nodeIndex].right = right;
+	RefitNode(nodeIndex);
+	return nodeIndex;
+}
+
+void BoundingVolumeHierarchy::RefitNode(int32_t nodeIndex)
+{
+	Node& node = nodes_[nodeIndex];
+	const Node& left = nodes_[node.left];
+	const Node& right = nodes_[node.right];
+
+	//空でない子ノードの境界ボックスを合成
+	node.isEmpty = left.isEmpty && right.isEmpty;
+	if (left.isEmpty)
+	{
+		node.bounds = right.bounds;
+	}
+	else if (right.isEmpty)
+	{
+		node.bounds = left.bounds;
+	}
+	else
+	{
+		node.bounds = Merge(left.bounds, right.bounds);
+	}
+}
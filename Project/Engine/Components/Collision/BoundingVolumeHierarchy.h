@@ -0,0 +1,134 @@
+/**
+ * @file BoundingVolumeHierarchy.h
+ * @brief コライダーの境界ボリューム階層を管理するファイル
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Collider.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class BoundingVolumeHierarchy
+{
+public:
+	/// <summary>
+	/// 構築
+	/// </summary>
+	/// <param name="colliders">コライダーの配列（nullptrは無視する）</param>
+	void Build(const std::vector<Collider*>& colliders);
+
+	/// <summary>
+	/// コライダーを取り除き、祖先ノードの境界ボックスを更新
+	/// </summary>
+	/// <param name="colliderIndex">構築時のコライダーのインデックス</param>
+	void Remove(uint32_t colliderIndex);
+
+	/// <summary>
+	/// 境界ボックスと重なる葉を列挙
+	/// </summary>
+	/// <typeparam name="Callback">void(uint32_t colliderIndex)</typeparam>
+	/// <param name="bounds">境界ボックス</param>
+	/// <param name="callback">重なった葉のコライダーのインデックスを受け取る関数</param>
+	template <typename Callback>
+	void Query(const Collider::Bounds& bounds, Callback&& callback) const;
+
+	/// <summary>
+	/// 条件を満たすノードだけを辿って葉を列挙
+	/// </summary>
+	/// <typeparam name="NodeTest">bool(const Collider::Bounds& bounds)</typeparam>
+	/// <typeparam name="Callback">void(uint32_t colliderIndex)</typeparam>
+	/// <param name="nodeTest">ノードの境界ボックスを辿るか判定する関数</param>
+	/// <param name="callback">条件を満たした葉のコライダーのインデックスを受け取る関数</param>
+	template <typename NodeTest, typename Callback>
+	void Traverse(NodeTest&& nodeTest, Callback&& callback) const;
+
+	/// <summary>
+	/// クリア
+	/// </summary>
+	void Clear();
+
+private:
+	//探索用のスタックの最大サイズ（中央値で分割するため深さは葉の数の対数に収まる）
+	static const uint32_t kMaxStackSize = 64;
+
+	//ノード
+	struct Node
+	{
+		Collider::Bounds bounds{};
+		int32_t parent = -1;
+		int32_t left = -1;
+		int32_t right = -1;
+		uint32_t colliderIndex = 0;
+		bool isEmpty = false;
+	};
+
+	/// <summary>
+	/// 再帰的にノードを構築
+	/// </summary>
+	/// <param name="begin">コライダーのインデックスの先頭</param>
+	/// <param name="end">コライダーのインデックスの終端</param>
+	/// <param name="parent">親ノード</param>
+	/// <returns>作成したノードのインデックス</returns>
+	int32_t BuildRecursive(uint32_t* begin, uint32_t* end, int32_t parent);
+
+	/// <summary>
+	/// 子ノードの境界ボックスから境界ボックスを再計算
+	/// </summary>
+	/// <param name="nodeIndex">ノードのインデックス</param>
+	void RefitNode(int32_t nodeIndex);
+
+private:
+	//ノードの配列（0番がルート）
+	std::vector<Node> nodes_{};
+
+	//コライダーのインデックスから葉ノードを引くための配列
+	std::vector<int32_t> leafNodes_{};
+
+	//構築時に使用する境界ボックス
+	std::vector<Collider::Bounds> colliderBounds_{};
+};
+
+
+template <typename Callback>
+void BoundingVolumeHierarchy::Query(const Collider::Bounds& bounds, Callback&& callback) const
+{
+	//境界ボックスが重なっているノードだけを辿る
+	Traverse([&](const Collider::Bounds& nodeBounds) { return nodeBounds.Overlaps(bounds); }, callback);
+}
+
+template <typename NodeTest, typename Callback>
+void BoundingVolumeHierarchy::Traverse(NodeTest&& nodeTest, Callback&& callback) const
+{
+	//空の場合は何もしない
+	if (nodes_.empty())
+	{
+		return;
+	}
+
+	//ルートから条件を満たすノードだけを辿る（コールバック中に再度呼ばれても良いようにスタックはローカルに持つ）
+	std::array<int32_t, kMaxStackSize> stack{};
+	uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		const Node& node = nodes_[stack[--stackSize]];
+
+		if (node.isEmpty || !nodeTest(node.bounds))
+		{
+			continue;
+		}
+
+		//葉の場合はコールバックを呼ぶ
+		if (node.left < 0)
+		{
+			callback(node.colliderIndex);
+			continue;
+		}
+
+		stack[stackSize++] = node.left;
+		stack[stackSize++] = node.right;
+	}
+}
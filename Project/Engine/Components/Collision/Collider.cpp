@@ -8,6 +8,11 @@
 #include "Collider.h"
 #include "Engine/3D/Primitive/LineRenderer.h"
 #include "Engine/Framework/Object/GameObject.h"
+#include "Engine/Components/Transform/TransformComponent.h"
+#include <algorithm>
+
+//IDの発行用カウンターの定義
+uint32_t Collider::counter_ = 0;
 
 void Collider::Initialize()
 {
@@ -25,6 +30,20 @@ void Collider::Draw(const Camera& camera)
 	lineRenderer->SetCamera(&camera);
 }
 
+Collider::Bounds Collider::GetSweptBounds() const
+{
+	//今回の境界ボックスと前回の位置の境界ボックスを合わせる
+	Bounds bounds = GetWorldBounds();
+	bounds.min = { std::min(bounds.min.x, bounds.min.x - sweep_.x), std::min(bounds.min.y, bounds.min.y - sweep_.y), std::min(bounds.min.z, bounds.min.z - sweep_.z) };
+	bounds.max = { std::max(bounds.max.x, bounds.max.x - sweep_.x), std::max(bounds.max.y, bounds.max.y - sweep_.y), std::max(bounds.max.z, bounds.max.z - sweep_.z) };
+	return bounds;
+}
+
+bool Collider::GetIsSweeping() const
+{
+	return sweep_.x != 0.0f || sweep_.y != 0.0f || sweep_.z != 0.0f;
+}
+
 void Collider::OnCollision(GameObject* other)
 {
 	owner_->OnCollision(other);
@@ -38,4 +57,14 @@ void Collider::OnCollisionEnter(GameObject* other)
 void Collider::OnCollisionExit(GameObject* other)
 {
 	owner_->OnCollisionExit(other);
+}
+
+TransformComponent* Collider::GetTransformComponent()
+{
+	//コンポーネントのアドレスは持ち主が破棄されるまで変わらないので一度見つけたものを使い続ける
+	if (!transformComponent_)
+	{
+		transformComponent_ = owner_->GetComponent<TransformComponent>();
+	}
+	return transformComponent_;
 }
\ No newline at end of file
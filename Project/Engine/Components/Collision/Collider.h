@@ -7,12 +7,34 @@
 
 #pragma once
 #include "Engine/Components/Base/RenderComponent.h"
+#include "CollisionConfig.h"
+#include "Engine/Math/Vector3.h"
 #include <cstdint>
-#include <set>
+
+class TransformComponent;
 
 class Collider : public RenderComponent
 {
 public:
+	//ワールド座標系の境界ボックス
+	struct Bounds
+	{
+		Vector3 min{};
+		Vector3 max{};
+
+		//境界ボックス同士が重なっているか
+		bool Overlaps(const Bounds& other) const
+		{
+			if (max.x < other.min.x || min.x > other.max.x) return false;
+
+			if (max.y < other.min.y || min.y > other.max.y) return false;
+
+			if (max.z < other.min.z || min.z > other.max.z) return false;
+
+			return true;
+		}
+	};
+
 	/// <summary>
 	/// デストラクタ
 	/// </summary>
@@ -34,6 +56,24 @@ public:
 	/// <param name="camera">カメラ</param>
 	void Draw(const Camera& camera) override;
 
+	/// <summary>
+	/// ワールド座標系の境界ボックスを取得
+	/// </summary>
+	/// <returns>境界ボックス</returns>
+	virtual Bounds GetWorldBounds() const = 0;
+
+	/// <summary>
+	/// 前回の位置から今回の位置までを覆う境界ボックスを取得
+	/// </summary>
+	/// <returns>境界ボックス</returns>
+	virtual Bounds GetSweptBounds() const;
+
+	/// <summary>
+	/// 前回のフレームから移動しているか
+	/// </summary>
+	/// <returns>移動しているかどうか</returns>
+	virtual bool GetIsSweeping() const;
+
 	/// <summary>
 	/// 衝突処理
 	/// </summary>
@@ -53,23 +93,17 @@ public:
 	void OnCollisionExit(GameObject* other);
 
 	/// <summary>
-	/// 現在衝突しているコライダーを追加
+	/// 衝突属性と衝突マスクから判定を行う相手か確認
 	/// </summary>
-	/// <param name="collider">コライダー</param>
-	void AddCollision(Collider* collider) { currentCollisions_.insert(collider); };
+	/// <param name="collider">相手のコライダー</param>
+	/// <returns>判定を行う相手か</returns>
+	const bool CanCollideWith(const Collider* collider) const
+	{
+		return (collisionAttribute_ & collider->collisionMask_) != 0 && (collider->collisionAttribute_ & collisionMask_) != 0;
+	};
 
-	/// <summary>
-	/// 現在衝突しているコライダーを削除
-	/// </summary>
-	/// <param name="collider">コライダー</param>
-	void RemoveCollision(Collider* collider) { currentCollisions_.erase(collider); };
-
-	/// <summary>
-	/// 同じ相手と衝突しているか確認
-	/// </summary>
-	/// <param name="collider">衝突相手</param>
-	/// <returns>同じ相手と衝突しているか</returns>
-	const bool IsCollidingWith(Collider* collider) const { return currentCollisions_.find(collider) != currentCollisions_.end(); };
+	//IDを取得
+	const uint32_t GetId() const { return id_; };
 
 	//衝突属性を取得・設定
 	const uint32_t GetCollisionAttribute() const { return collisionAttribute_; };
@@ -79,15 +113,49 @@ public:
 	const uint32_t GetCollisionMask() const { return collisionMask_; };
 	void SetCollisionMask(uint32_t collisionMask) { collisionMask_ = collisionMask; };
 
+	//形状の種類を取得
+	const ColliderType GetColliderType() const { return colliderType_; };
+
 	//コライダーを有効にするかを取得・設定
 	const bool GetCollisionEnabled() const { return collisionEnabled_; };
 	void SetCollisionEnabled(const bool collisionEnabled) { collisionEnabled_ = collisionEnabled; };
 
+	//静的なコライダーかどうかを取得・設定
+	const bool GetIsStatic() const { return isStatic_; };
+	void SetIsStatic(const bool isStatic) { isStatic_ = isStatic; };
+
+	//連続的な衝突判定を行うかを取得・設定（高速に動くコライダーのすり抜けを防ぐ）
+	const bool GetIsContinuous() const { return isContinuous_; };
+	void SetIsContinuous(const bool isContinuous) { isContinuous_ = isContinuous; };
+
+	//前回の位置からの移動量を取得・設定（連続的な衝突判定を行う場合に衝突マネージャーが設定する）
+	const Vector3& GetSweep() const { return sweep_; };
+	void SetSweep(const Vector3& sweep) { sweep_ = sweep; };
+
 	//デバッグ描画をするかどうかを設定
 	void SetDebugDrawEnabled(const bool debugDrawEnabled) { debugDrawEnabled_ = debugDrawEnabled; };
 
 protected:
-	std::set<Collider*> currentCollisions_;
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	/// <param name="colliderType">形状の種類</param>
+	Collider(const ColliderType colliderType) : id_(++counter_), colliderType_(colliderType) {};
+
+	/// <summary>
+	/// 持ち主のトランスフォームコンポーネントを取得（見つかった後は持ち主を参照せずに返す）
+	/// </summary>
+	/// <returns>トランスフォームコンポーネント</returns>
+	TransformComponent* GetTransformComponent();
+
+protected:
+	//IDの発行用カウンター
+	static uint32_t counter_;
+
+	//衝突情報のキーに使う一意なID
+	const uint32_t id_;
+
+	const ColliderType colliderType_;
 
 	uint32_t collisionAttribute_ = 0xffffffff;
 
@@ -95,6 +163,15 @@ protected:
 
 	bool collisionEnabled_ = true;
 
+	bool isStatic_ = false;
+
+	bool isContinuous_ = false;
+
+	Vector3 sweep_{};
+
 	bool debugDrawEnabled_ = false;
+
+	//持ち主のトランスフォームコンポーネント
+	TransformComponent* transformComponent_ = nullptr;
 };
 
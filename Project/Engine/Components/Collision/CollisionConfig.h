@@ -11,4 +11,13 @@
 //形状
 const uint32_t kCollisionPrimitiveSphere = 0b1;
 const uint32_t kCollisionPrimitiveAABB = kCollisionPrimitiveSphere << 1;
-const uint32_t kCollisionPrimitiveOBB = kCollisionPrimitiveAABB << 1;
\ No newline at end of file
+const uint32_t kCollisionPrimitiveOBB = kCollisionPrimitiveAABB << 1;
+
+//コライダーの形状の種類
+enum class ColliderType
+{
+	kSphere,
+	kAABB,
+	kOBB,
+	kCount
+};
\ No newline at end of file
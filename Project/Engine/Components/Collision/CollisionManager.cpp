@@ -7,149 +7,1005 @@
 
 #include "CollisionManager.h"
 #include "CollisionConfig.h"
+#include "NarrowPhaseBatch.h"
 #include "Engine/Math/MathFunction.h"
+#include "Engine/Framework/Object/GameObject.h"
+#include "Engine/Utilities/JobSystem.h"
 #include <algorithm>
 
+template <typename Type1, typename Type2, bool (*Function)(const Type1*, const Type2*)>
+bool CollisionManager::InvokeNarrowPhase(const Collider* collider1, const Collider* collider2)
+{
+	return Function(static_cast<const Type1*>(collider1), static_cast<const Type2*>(collider2));
+}
+
+template <typename Type1, typename Type2, bool (*Function)(const Type1*, const Type2*)>
+bool CollisionManager::InvokeNarrowPhaseSwapped(const Collider* collider1, const Collider* collider2)
+{
+	return Function(static_cast<const Type1*>(collider2), static_cast<const Type2*>(collider1));
+}
+
+const CollisionManager::NarrowPhaseFunction CollisionManager::kNarrowPhaseTable[static_cast<size_t>(ColliderType::kCount)][static_cast<size_t>(ColliderType::kCount)] = {
+	//Sphere
+	{
+		&InvokeNarrowPhase<SphereCollider, SphereCollider, &CheckSphereSphereCollision>,
+		&InvokeNarrowPhase<SphereCollider, AABBCollider, &CheckSphereAABBCollision>,
+		&InvokeNarrowPhase<SphereCollider, OBBCollider, &CheckSphereOBBCollision>,
+	},
+	//AABB
+	{
+		&InvokeNarrowPhaseSwapped<SphereCollider, AABBCollider, &CheckSphereAABBCollision>,
+		&InvokeNarrowPhase<AABBCollider, AABBCollider, &CheckAABBAABBCollision>,
+		&InvokeNarrowPhase<AABBCollider, OBBCollider, &CheckAABBOBBCollision>,
+	},
+	//OBB
+	{
+		&InvokeNarrowPhaseSwapped<SphereCollider, OBBCollider, &CheckSphereOBBCollision>,
+		&InvokeNarrowPhaseSwapped<AABBCollider, OBBCollider, &CheckAABBOBBCollision>,
+		&InvokeNarrowPhase<OBBCollider, OBBCollider, &CheckOBBOBBCollision>,
+	},
+};
+
+template <typename Type1, typename Type2>
+bool CollisionManager::InvokeSweptNarrowPhase(const Collider* collider1, const Collider* collider2)
+{
+	//今回の姿勢で衝突していれば判定を終える
+	const Type1* typedCollider1 = static_cast<const Type1*>(collider1);
+	const Type2* typedCollider2 = static_cast<const Type2*>(collider2);
+	const auto shape1 = MakeShape(typedCollider1);
+	const auto shape2 = MakeShape(typedCollider2);
+	if (CheckCollision(shape1, shape2))
+	{
+		return true;
+	}
+
+	//相対的な移動量と回転による端の移動量が2つの形状の厚みを超えないように分割数を決める
+	const float distance = Mathf::Length(collider1->GetSweep() - collider2->GetSweep()) + GetRotationSweepLength(collider1) + GetRotationSweepLength(collider2);
+	const float thickness = GetThickness(shape1) + GetThickness(shape2);
+	const float requiredStepCount = thickness > 0.0f ? std::ceil(distance / thickness) : static_cast<float>(kMaxSweepSteps);
+	const uint32_t stepCount = requiredStepCount < static_cast<float>(kMaxSweepSteps) ? std::max(static_cast<uint32_t>(requiredStepCount), 1u) : kMaxSweepSteps;
+
+	//前回の姿勢から今回の姿勢までを補間した形状で判定（コライダーは複製せず形状の値だけを動かす）
+	auto sweptShape1 = shape1;
+	auto sweptShape2 = shape2;
+	for (uint32_t step = 1; step < stepCount; ++step)
+	{
+		const float remaining = 1.0f - static_cast<float>(step) / static_cast<float>(stepCount);
+		SetSweptPose(shape1, typedCollider1, remaining, sweptShape1);
+		SetSweptPose(shape2, typedCollider2, remaining, sweptShape2);
+		if (CheckCollision(sweptShape1, sweptShape2))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+template <typename Type1, typename Type2>
+bool CollisionManager::InvokeSweptNarrowPhaseSwapped(const Collider* collider1, const Collider* collider2)
+{
+	return InvokeSweptNarrowPhase<Type1, Type2>(collider2, collider1);
+}
+
+const CollisionManager::NarrowPhaseFunction CollisionManager::kSweptNarrowPhaseTable[static_cast<size_t>(ColliderType::kCount)][static_cast<size_t>(ColliderType::kCount)] = {
+	//Sphere
+	{
+		&InvokeSweptNarrowPhase<SphereCollider, SphereCollider>,
+		&InvokeSweptNarrowPhase<SphereCollider, AABBCollider>,
+		&InvokeSweptNarrowPhase<SphereCollider, OBBCollider>,
+	},
+	//AABB
+	{
+		&InvokeSweptNarrowPhaseSwapped<SphereCollider, AABBCollider>,
+		&InvokeSweptNarrowPhase<AABBCollider, AABBCollider>,
+		&InvokeSweptNarrowPhase<AABBCollider, OBBCollider>,
+	},
+	//OBB
+	{
+		&InvokeSweptNarrowPhaseSwapped<SphereCollider, OBBCollider>,
+		&InvokeSweptNarrowPhaseSwapped<AABBCollider, OBBCollider>,
+		&InvokeSweptNarrowPhase<OBBCollider, OBBCollider>,
+	},
+};
+
 void CollisionManager::ClearColliderList()
 {
 	//コライダーリストをクリア
 	colliders_.clear();
+	isDynamicBVHDirty_ = true;
 }
 
 void CollisionManager::SetColliderList(Collider* collider)
 {
+	//nullチェック
+	if (!collider)
+	{
+		return;
+	}
+
+	//静的なコライダーはBVHに登録し、以降は毎フレーム登録し直す必要はない
+	if (collider->GetIsStatic())
+	{
+		if (staticColliderIndices_.emplace(collider->GetId(), static_cast<uint32_t>(staticColliders_.size())).second)
+		{
+			staticColliders_.push_back(collider);
+			isStaticBVHDirty_ = true;
+		}
+		return;
+	}
+
 	//コライダーリストに登録
 	colliders_.push_back(collider);
+	isDynamicBVHDirty_ = true;
 }
 
 void CollisionManager::CheckAllCollisions()
 {
-	//リスト内のペアを総当たり
-	std::list<Collider*>::iterator itrA = colliders_.begin();
-	for (; itrA != colliders_.end(); ++itrA)
+	//静的なコライダーが追加されていればBVHを構築し直す
+	if (isStaticBVHDirty_)
 	{
-		//イテレータAからコライダーAを取得する
-		Collider* colliderA = *itrA;
-		//イテレータBはイテレータAの次の要素から回す(重複判定を回避)
-		std::list<Collider*>::iterator itrB = itrA;
-		itrB++;
-		for (; itrB != colliders_.end(); ++itrB)
-		{
-			//イテレータBからコライダーBを取得する
-			Collider* colliderB = *itrB;
-			//ベアの当たり判定
-			CheckCollisionPair(colliderA, colliderB);
-		}
+		RebuildStaticBVH();
+	}
+
+	//今回登録されている動的なコライダーをIDで引けるようにする
+	colliderIds_.clear();
+	for (uint32_t i = 0; i < static_cast<uint32_t>(colliders_.size()); ++i)
+	{
+		colliderIds_.emplace_back(colliders_[i]->GetId(), i);
 	}
+	std::sort(colliderIds_.begin(), colliderIds_.end());
+
+	//連続的な衝突判定を行うコライダーの移動量を更新（ブロードフェーズは移動範囲を覆う境界ボックスで判定する）
+	UpdateSweeps();
+
+	//ブロードフェーズで動的なコライダー同士の衝突候補のペアを収集
+	candidatePairs_.clear();
+	broadPhase_->CollectPairs(colliders_, candidatePairs_);
+
+	//動的なコライダーと静的なコライダーの衝突候補のペアをBVHから収集
+	CollectStaticPairs();
+
+	//詳細判定
+	CollectContacts();
+
+	//前回の衝突情報と比較してイベントを作成し、呼び出す
+	BuildContactEvents();
+	DispatchContactEvents();
+
+	//今回の衝突情報を保存
+	previousContacts_.swap(currentContacts_);
+
+	//破壊されたオブジェクトの静的なコライダーを取り除く
+	RemoveDestroyedStaticColliders();
+
+	//問い合わせ用のBVHは次の問い合わせ時に現在の位置で構築し直す
+	isDynamicBVHDirty_ = true;
 }
 
-void CollisionManager::CheckCollisionPair(Collider* collider1, Collider* collider2)
+bool CollisionManager::Raycast(const Vector3& origin, const Vector3& direction, float maxDistance, uint32_t mask, RaycastHit& hit)
 {
-	//nullチェック
-	if (!collider1 || !collider2)
+	//向きを正規化
+	const float length = Mathf::Length(direction);
+	if (length == 0.0f)
 	{
-		return;
+		return false;
 	}
+	const Vector3 normalizedDirection = direction / length;
+
+	//最も近い当たりを探す（見つかるたびに探索する距離を縮める）
+	bool isHit = false;
+	float closestDistance = maxDistance;
+	QueryColliders(mask,
+		[&](const Collider::Bounds& bounds) {
+			float distance = 0.0f;
+			int32_t hitAxis = -1;
+			return IntersectRayBox(origin, normalizedDirection, bounds.min, bounds.max, closestDistance, distance, hitAxis);
+		},
+		[&](Collider* collider) {
+			RaycastHit colliderHit{};
+			if (RaycastCollider(collider, origin, normalizedDirection, closestDistance, colliderHit))
+			{
+				hit = colliderHit;
+				closestDistance = colliderHit.distance;
+				isHit = true;
+			}
+		});
+
+	return isHit;
+}
 
-	//衝突フィルタリング
-	if ((collider1->GetCollisionAttribute() & collider2->GetCollisionMask()) == 0 ||
-		(collider2->GetCollisionAttribute() & collider1->GetCollisionMask()) == 0)
+bool CollisionManager::SphereCast(const Vector3& origin, float radius, const Vector3& direction, float maxDistance, uint32_t mask, RaycastHit& hit)
+{
+	//向きを正規化
+	const float length = Mathf::Length(direction);
+	if (length == 0.0f)
 	{
-		return;
+		return false;
 	}
+	const Vector3 normalizedDirection = direction / length;
+
+	//最も近い当たりを探す（境界ボックスは半径分広げてレイで判定する）
+	bool isHit = false;
+	float closestDistance = maxDistance;
+	const Vector3 extent = { radius, radius, radius };
+	QueryColliders(mask,
+		[&](const Collider::Bounds& bounds) {
+			float distance = 0.0f;
+			int32_t hitAxis = -1;
+			return IntersectRayBox(origin, normalizedDirection, bounds.min - extent, bounds.max + extent, closestDistance, distance, hitAxis);
+		},
+		[&](Collider* collider) {
+			//最近接点の接平面に球が触れるまで進めることを繰り返す（形状は接平面の向こう側にあるので、それまでは当たらない）
+			float distance = 0.0f;
+			for (uint32_t i = 0; i < kMaxSphereCastIterations && distance <= closestDistance; ++i)
+			{
+				const Vector3 center = origin + normalizedDirection * distance;
+				const Vector3 closestPoint = GetClosestPoint(collider, center);
+				const Vector3 difference = center - closestPoint;
+				const float differenceLength = Mathf::Length(difference);
+				const float gap = differenceLength - radius;
+				if (gap <= 1.0e-4f)
+				{
+					//始点で既に重なっている場合は進行方向の逆を法線にする
+					hit.collider = collider;
+					hit.point = closestPoint;
+					hit.normal = differenceLength > 0.0f ? difference / differenceLength : normalizedDirection * -1.0f;
+					hit.distance = distance;
+					closestDistance = distance;
+					isHit = true;
+					return;
+				}
+
+				//接平面から離れる向きに進む場合は当たらない
+				const float approachSpeed = -Mathf::Dot(normalizedDirection, difference) / differenceLength;
+				if (approachSpeed <= 0.0f)
+				{
+					return;
+				}
+				distance += gap / approachSpeed;
+			}
+		});
+
+	return isHit;
+}
 
-	//衝突判定が無効化された場合
-	if (!collider1->GetCollisionEnabled() || !collider2->GetCollisionEnabled())
+void CollisionManager::OverlapSphere(const Vector3& center, float radius, uint32_t mask, std::vector<Collider*>& results)
+{
+	//問い合わせ用の球を設定
+	querySphere_.SetWorldCenter(center);
+	querySphere_.SetRadius(radius);
+
+	//境界ボックスが重なるコライダーを詳細判定
+	const Collider::Bounds queryBounds = querySphere_.GetWorldBounds();
+	QueryColliders(mask,
+		[&](const Collider::Bounds& bounds) { return bounds.Overlaps(queryBounds); },
+		[&](Collider* collider) {
+			if (IsColliding(&querySphere_, collider))
+			{
+				results.push_back(collider);
+			}
+		});
+}
+
+void CollisionManager::OverlapBox(const Vector3& center, const Vector3& halfSize, const Quaternion& rotation, uint32_t mask, std::vector<Collider*>& results)
+{
+	//問い合わせ用の箱を設定
+	queryBox_.SetWorldCenter(center);
+	queryBox_.SetSize(halfSize);
+	queryBox_.SetOrientations(
+		Mathf::RotateVector({ 1.0f,0.0f,0.0f }, rotation),
+		Mathf::RotateVector({ 0.0f,1.0f,0.0f }, rotation),
+		Mathf::RotateVector({ 0.0f,0.0f,1.0f }, rotation));
+
+	//境界ボックスが重なるコライダーを詳細判定
+	const Collider::Bounds queryBounds = queryBox_.GetWorldBounds();
+	QueryColliders(mask,
+		[&](const Collider::Bounds& bounds) { return bounds.Overlaps(queryBounds); },
+		[&](Collider* collider) {
+			if (IsColliding(&queryBox_, collider))
+			{
+				results.push_back(collider);
+			}
+		});
+}
+
+void CollisionManager::RebuildStaticBVH()
+{
+	//取り除かれたコライダーを詰める
+	staticColliders_.erase(std::remove(staticColliders_.begin(), staticColliders_.end(), nullptr), staticColliders_.end());
+	staticColliderIndices_.clear();
+	for (uint32_t i = 0; i < static_cast<uint32_t>(staticColliders_.size()); ++i)
+	{
+		staticColliderIndices_[staticColliders_[i]->GetId()] = i;
+	}
+
+	//BVHを構築
+	staticBVH_.Build(staticColliders_);
+	isStaticBVHDirty_ = false;
+}
+
+void CollisionManager::RebuildDynamicBVH()
+{
+	dynamicBVH_.Build(colliders_);
+	isDynamicBVHDirty_ = false;
+}
+
+template <typename NodeTest, typename Callback>
+void CollisionManager::QueryColliders(uint32_t mask, NodeTest&& nodeTest, Callback&& callback)
+{
+	//動的なコライダーのBVHを必要に応じて構築
+	if (isDynamicBVHDirty_)
 	{
-		if (collider1->IsCollidingWith(collider2))
+		RebuildDynamicBVH();
+	}
+
+	//有効で衝突属性がマスクと一致するコライダーだけを渡す
+	auto filter = [&](Collider* collider) {
+		if (collider && collider->GetCollisionEnabled() && (collider->GetCollisionAttribute() & mask) != 0)
 		{
-			collider1->RemoveCollision(collider2);
-			collider2->RemoveCollision(collider1);
-			collider1->OnCollisionExit(collider2->owner_);
-			collider2->OnCollisionExit(collider1->owner_);
+			callback(collider);
 		}
-		return;
+		};
+	staticBVH_.Traverse(nodeTest, [&](uint32_t index) { filter(staticColliders_[index]); });
+	dynamicBVH_.Traverse(nodeTest, [&](uint32_t index) { filter(colliders_[index]); });
+}
+
+void CollisionManager::CollectStaticPairs()
+{
+	const uint32_t staticOffset = static_cast<uint32_t>(colliders_.size());
+	for (uint32_t dynamicIndex = 0; dynamicIndex < staticOffset; ++dynamicIndex)
+	{
+		//無効なコライダーは判定しない
+		Collider* collider = colliders_[dynamicIndex];
+		if (!collider->GetCollisionEnabled())
+		{
+			continue;
+		}
+
+		//境界ボックスが重なる静的なコライダーを探す
+		staticBVH_.Query(collider->GetSweptBounds(), [&](uint32_t staticIndex) {
+			Collider* staticCollider = staticColliders_[staticIndex];
+			if (staticCollider->GetCollisionEnabled() && collider->CanCollideWith(staticCollider))
+			{
+				candidatePairs_.emplace_back(dynamicIndex, staticOffset + staticIndex);
+			}
+			});
+	}
+}
+
+void CollisionManager::UpdateSweeps()
+{
+	currentPoses_.clear();
+	for (Collider* collider : colliders_)
+	{
+		//連続的な衝突判定を行わないコライダーは移動量を持たない
+		if (!collider->GetIsContinuous())
+		{
+			continue;
+		}
+
+		//衝突判定が無効な間は追跡せず、有効になった瞬間の姿勢から移動量を計算する
+		OBBCollider* obb = collider->GetColliderType() == ColliderType::kOBB ? static_cast<OBBCollider*>(collider) : nullptr;
+		if (!collider->GetCollisionEnabled())
+		{
+			collider->SetSweep({ 0.0f,0.0f,0.0f });
+			if (obb)
+			{
+				obb->SetSweepRotation(Mathf::IdentityQuaternion());
+			}
+			continue;
+		}
+
+		//前回の姿勢からの移動量と回転を設定
+		const Collider::Bounds bounds = collider->GetWorldBounds();
+		const SweepPose pose = { (bounds.min + bounds.max) * 0.5f, obb ? GetOrientationRotation(obb) : Mathf::IdentityQuaternion() };
+		auto it = previousPoses_.find(collider->GetId());
+		collider->SetSweep(it != previousPoses_.end() ? pose.center - it->second.center : Vector3{ 0.0f,0.0f,0.0f });
+		if (obb)
+		{
+			obb->SetSweepRotation(it != previousPoses_.end() ? Mathf::Normalize(pose.rotation * Mathf::Conjugate(it->second.rotation)) : Mathf::IdentityQuaternion());
+		}
+		currentPoses_[collider->GetId()] = pose;
 	}
 
-	bool isColliding = false;
+	//今回の姿勢を次のフレームのために保存
+	previousPoses_.swap(currentPoses_);
+}
 
-	//衝突判定
-	if (dynamic_cast<SphereCollider*>(collider1) && dynamic_cast<SphereCollider*>(collider2))
+void CollisionManager::CollectContacts()
+{
+	//衝突候補のペアを形状の組み合わせごとに振り分ける
+	for (auto& pairsByType : candidatePairsByType_)
 	{
-		isColliding = CheckSphereSphereCollision(static_cast<SphereCollider*>(collider1), static_cast<SphereCollider*>(collider2));
+		for (std::vector<IBroadPhase::CandidatePair>& pairs : pairsByType)
+		{
+			pairs.clear();
+		}
 	}
-	else if (dynamic_cast<AABBCollider*>(collider1) && dynamic_cast<AABBCollider*>(collider2))
+	sweptCandidatePairs_.clear();
+	for (const IBroadPhase::CandidatePair& pair : candidatePairs_)
 	{
-		isColliding = CheckAABBAABBCollision(static_cast<AABBCollider*>(collider1), static_cast<AABBCollider*>(collider2));
+		//衝突判定が無効化されている場合は判定しない
+		const Collider* collider1 = GetCollider(pair.first);
+		const Collider* collider2 = GetCollider(pair.second);
+		if (!collider1->GetCollisionEnabled() || !collider2->GetCollisionEnabled())
+		{
+			continue;
+		}
+
+		//どちらかが移動している連続的な衝突判定のペアは移動を考慮して判定する
+		if (collider1->GetIsSweeping() || collider2->GetIsSweeping())
+		{
+			sweptCandidatePairs_.push_back(pair);
+			continue;
+		}
+
+		//形状の種類の順に並べる
+		const size_t type1 = static_cast<size_t>(collider1->GetColliderType());
+		const size_t type2 = static_cast<size_t>(collider2->GetColliderType());
+		if (type1 <= type2)
+		{
+			candidatePairsByType_[type1][type2].emplace_back(pair.first, pair.second);
+		}
+		else
+		{
+			candidatePairsByType_[type2][type1].emplace_back(pair.second, pair.first);
+		}
 	}
-	else if (dynamic_cast<OBBCollider*>(collider1) && dynamic_cast<OBBCollider*>(collider2))
+
+	//一定数のペアごとに作業単位に分ける
+	contactChunks_.clear();
+	for (size_t type1 = 0; type1 < static_cast<size_t>(ColliderType::kCount); ++type1)
 	{
-		isColliding = CheckOBBOBBCollision(static_cast<OBBCollider*>(collider1), static_cast<OBBCollider*>(collider2));
+		for (size_t type2 = type1; type2 < static_cast<size_t>(ColliderType::kCount); ++type2)
+		{
+			AddContactChunks(candidatePairsByType_[type1][type2], kContactCollectTable[type1][type2]);
+		}
 	}
-	else if (dynamic_cast<SphereCollider*>(collider1) && dynamic_cast<AABBCollider*>(collider2))
+	AddContactChunks(sweptCandidatePairs_, &CollisionManager::CollectSweptContacts);
+
+	//作業単位ごとに並列に詳細判定し、スレッドごとの書き込み先に衝突しているペアを収集
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	threadContacts_.resize(jobSystem->GetThreadCount());
+	for (std::vector<Contact>& contacts : threadContacts_)
 	{
-		isColliding = CheckSphereAABBCollision(static_cast<SphereCollider*>(collider1), static_cast<AABBCollider*>(collider2));
+		contacts.clear();
 	}
-	else if (dynamic_cast<AABBCollider*>(collider1) && dynamic_cast<SphereCollider*>(collider2))
+	jobSystem->ParallelFor(static_cast<uint32_t>(contactChunks_.size()), 1, [this](uint32_t begin, uint32_t end, uint32_t threadIndex) {
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			const ContactChunk& chunk = contactChunks_[i];
+			(this->*chunk.function)(chunk.pairs, chunk.count, threadContacts_[threadIndex]);
+		}
+		});
+
+	//スレッドごとの結果をまとめ、キーでソートしてスレッドの割り当てに依存しない順番にする
+	currentContacts_.clear();
+	for (const std::vector<Contact>& contacts : threadContacts_)
 	{
-		isColliding = CheckSphereAABBCollision(static_cast<SphereCollider*>(collider2), static_cast<AABBCollider*>(collider1));
+		currentContacts_.insert(currentContacts_.end(), contacts.begin(), contacts.end());
 	}
-	else if (dynamic_cast<SphereCollider*>(collider1) && dynamic_cast<OBBCollider*>(collider2))
+	std::sort(currentContacts_.begin(), currentContacts_.end(), [](const Contact& a, const Contact& b) { return a.key < b.key; });
+}
+
+void CollisionManager::AddContactChunks(const std::vector<IBroadPhase::CandidatePair>& pairs, ContactCollectFunction function)
+{
+	const uint32_t pairCount = static_cast<uint32_t>(pairs.size());
+	for (uint32_t begin = 0; begin < pairCount; begin += kContactChunkSize)
 	{
-		isColliding = CheckSphereOBBCollision(static_cast<SphereCollider*>(collider1), static_cast<OBBCollider*>(collider2));
+		const uint32_t end = std::min(begin + kContactChunkSize, pairCount);
+		contactChunks_.push_back({ pairs.data() + begin, end - begin, function });
 	}
-	else if (dynamic_cast<OBBCollider*>(collider1) && dynamic_cast<SphereCollider*>(collider2))
+}
+
+template <typename Type1, typename Type2, typename Lanes1, typename Lanes2, uint32_t (*Test)(const Lanes1&, const Lanes2&)>
+void CollisionManager::CollectBatchContacts(const IBroadPhase::CandidatePair* pairs, size_t count, std::vector<Contact>& contacts) const
+{
+	Lanes1 lanes1{};
+	Lanes2 lanes2{};
+	for (size_t begin = 0; begin < count; begin += NarrowPhaseBatch::kLaneCount)
 	{
-		isColliding = CheckSphereOBBCollision(static_cast<SphereCollider*>(collider2), static_cast<OBBCollider*>(collider1));
+		//レーンに読み込む（端数のレーンには前回の値が残るが結果はマスクする）
+		const uint32_t laneCount = static_cast<uint32_t>(std::min<size_t>(NarrowPhaseBatch::kLaneCount, count - begin));
+		for (uint32_t lane = 0; lane < laneCount; ++lane)
+		{
+			NarrowPhaseBatch::Load(lanes1, lane, static_cast<const Type1*>(GetCollider(pairs[begin + lane].first)));
+			NarrowPhaseBatch::Load(lanes2, lane, static_cast<const Type2*>(GetCollider(pairs[begin + lane].second)));
+		}
+
+		//まとめて判定し、衝突しているペアを追加
+		const uint32_t mask = Test(lanes1, lanes2) & ((1u << laneCount) - 1);
+		for (uint32_t lane = 0; lane < laneCount; ++lane)
+		{
+			if (mask & (1u << lane))
+			{
+				AddContact(pairs[begin + lane].first, pairs[begin + lane].second, contacts);
+			}
+		}
 	}
-	else if (dynamic_cast<AABBCollider*>(collider1) && dynamic_cast<OBBCollider*>(collider2))
+}
+
+void CollisionManager::CollectScalarContacts(const IBroadPhase::CandidatePair* pairs, size_t count, std::vector<Contact>& contacts) const
+{
+	for (size_t i = 0; i < count; ++i)
 	{
-		isColliding = CheckAABBOBBCollision(static_cast<AABBCollider*>(collider1), static_cast<OBBCollider*>(collider2));
+		if (IsColliding(GetCollider(pairs[i].first), GetCollider(pairs[i].second)))
+		{
+			AddContact(pairs[i].first, pairs[i].second, contacts);
+		}
 	}
-	else if (dynamic_cast<OBBCollider*>(collider1) && dynamic_cast<AABBCollider*>(collider2))
+}
+
+void CollisionManager::CollectSweptContacts(const IBroadPhase::CandidatePair* pairs, size_t count, std::vector<Contact>& contacts) const
+{
+	for (size_t i = 0; i < count; ++i)
 	{
-		isColliding = CheckAABBOBBCollision(static_cast<AABBCollider*>(collider2), static_cast<OBBCollider*>(collider1));
+		//形状の組み合わせから移動を考慮した衝突判定関数を引いて判定
+		const Collider* collider1 = GetCollider(pairs[i].first);
+		const Collider* collider2 = GetCollider(pairs[i].second);
+		const size_t type1 = static_cast<size_t>(collider1->GetColliderType());
+		const size_t type2 = static_cast<size_t>(collider2->GetColliderType());
+		if (kSweptNarrowPhaseTable[type1][type2](collider1, collider2))
+		{
+			AddContact(pairs[i].first, pairs[i].second, contacts);
+		}
 	}
+}
+
+const CollisionManager::ContactCollectFunction CollisionManager::kContactCollectTable[static_cast<size_t>(ColliderType::kCount)][static_cast<size_t>(ColliderType::kCount)] = {
+	//Sphere
+	{
+		&CollisionManager::CollectBatchContacts<SphereCollider, SphereCollider, NarrowPhaseBatch::SphereLanes, NarrowPhaseBatch::SphereLanes, &NarrowPhaseBatch::TestSphereSphere>,
+		&CollisionManager::CollectScalarContacts,
+		&CollisionManager::CollectBatchContacts<SphereCollider, OBBCollider, NarrowPhaseBatch::SphereLanes, NarrowPhaseBatch::OBBLanes, &NarrowPhaseBatch::TestSphereOBB>,
+	},
+	//AABB（AABB同士は比較だけで済み、レーンに並べ直す方が遅いので1ペアずつ判定する）
+	{
+		nullptr,
+		&CollisionManager::CollectScalarContacts,
+		&CollisionManager::CollectScalarContacts,
+	},
+	//OBB
+	{
+		nullptr,
+		nullptr,
+		&CollisionManager::CollectBatchContacts<OBBCollider, OBBCollider, NarrowPhaseBatch::OBBLanes, NarrowPhaseBatch::OBBLanes, &NarrowPhaseBatch::TestOBBOBB>,
+	},
+};
 
-	if (isColliding)
+void CollisionManager::AddContact(uint32_t index1, uint32_t index2, std::vector<Contact>& contacts) const
+{
+	//インデックスは登録順に並べる
+	contacts.push_back({ MakeContactKey(GetCollider(index1), GetCollider(index2)), std::min(index1, index2), std::max(index1, index2) });
+}
+
+void CollisionManager::BuildContactEvents()
+{
+	//キーでソートされた前回と今回の衝突情報を先頭から突き合わせる
+	contactEvents_.clear();
+	size_t previous = 0;
+	size_t current = 0;
+	while (previous < previousContacts_.size() || current < currentContacts_.size())
 	{
-		if (!collider1->IsCollidingWith(collider2))
+		//今回だけ衝突している場合は当たった瞬間
+		if (previous == previousContacts_.size() || (current < currentContacts_.size() && currentContacts_[current].key < previousContacts_[previous].key))
 		{
-			collider1->AddCollision(collider2);
-			collider2->AddCollision(collider1);
-			collider1->OnCollisionEnter(collider2->owner_);
-			collider2->OnCollisionEnter(collider1->owner_);
+			contactEvents_.push_back({ currentContacts_[current].index1, currentContacts_[current].index2, ContactEventType::kEnter });
+			++current;
+		}
+		//前回だけ衝突していた場合は離れた瞬間
+		else if (current == currentContacts_.size() || previousContacts_[previous].key < currentContacts_[current].key)
+		{
+			//今回登録されていないコライダーとの衝突情報は破棄する
+			uint32_t index1 = 0;
+			uint32_t index2 = 0;
+			if (FindColliderIndex(static_cast<uint32_t>(previousContacts_[previous].key >> 32), index1) &&
+				FindColliderIndex(static_cast<uint32_t>(previousContacts_[previous].key), index2))
+			{
+				contactEvents_.push_back({ std::min(index1, index2), std::max(index1, index2), ContactEventType::kExit });
+			}
+			++previous;
+		}
+		//両方で衝突している場合は衝突中
+		else
+		{
+			contactEvents_.push_back({ currentContacts_[current].index1, currentContacts_[current].index2, ContactEventType::kStay });
+			++previous;
+			++current;
 		}
-		collider1->OnCollision(collider2->owner_);
-		collider2->OnCollision(collider1->owner_);
 	}
-	else
+
+	//登録順に並べる
+	std::sort(contactEvents_.begin(), contactEvents_.end(), [](const ContactEvent& a, const ContactEvent& b) {
+		return a.index1 != b.index1 ? a.index1 < b.index1 : a.index2 < b.index2;
+		});
+}
+
+void CollisionManager::DispatchContactEvents()
+{
+	for (const ContactEvent& contactEvent : contactEvents_)
 	{
-		if (collider1->IsCollidingWith(collider2))
+		Collider* collider1 = GetCollider(contactEvent.index1);
+		Collider* collider2 = GetCollider(contactEvent.index2);
+		switch (contactEvent.type)
 		{
-			collider1->RemoveCollision(collider2);
-			collider2->RemoveCollision(collider1);
+		case ContactEventType::kEnter:
+			collider1->OnCollisionEnter(collider2->owner_);
+			collider2->OnCollisionEnter(collider1->owner_);
+			collider1->OnCollision(collider2->owner_);
+			collider2->OnCollision(collider1->owner_);
+			break;
+		case ContactEventType::kStay:
+			collider1->OnCollision(collider2->owner_);
+			collider2->OnCollision(collider1->owner_);
+			break;
+		case ContactEventType::kExit:
 			collider1->OnCollisionExit(collider2->owner_);
 			collider2->OnCollisionExit(collider1->owner_);
+			break;
 		}
 	}
 }
 
-bool CollisionManager::CheckSphereSphereCollision(const SphereCollider* sphere1, const SphereCollider* sphere2)
+bool CollisionManager::FindColliderIndex(uint32_t colliderId, uint32_t& index) const
+{
+	//動的なコライダー
+	auto it = std::lower_bound(colliderIds_.begin(), colliderIds_.end(), std::pair<uint32_t, uint32_t>(colliderId, 0));
+	if (it != colliderIds_.end() && it->first == colliderId)
+	{
+		index = it->second;
+		return true;
+	}
+
+	//静的なコライダー
+	if (auto staticIt = staticColliderIndices_.find(colliderId); staticIt != staticColliderIndices_.end())
+	{
+		index = static_cast<uint32_t>(colliders_.size()) + staticIt->second;
+		return true;
+	}
+
+	return false;
+}
+
+uint64_t CollisionManager::MakeContactKey(const Collider* collider1, const Collider* collider2)
+{
+	//小さい方のIDを上位に詰める
+	const uint64_t id1 = std::min(collider1->GetId(), collider2->GetId());
+	const uint64_t id2 = std::max(collider1->GetId(), collider2->GetId());
+	return (id1 << 32) | id2;
+}
+
+void CollisionManager::RemoveDestroyedStaticColliders()
+{
+	for (uint32_t staticIndex = 0; staticIndex < static_cast<uint32_t>(staticColliders_.size()); ++staticIndex)
+	{
+		//破壊フラグが立っていなければ何もしない
+		Collider* staticCollider = staticColliders_[staticIndex];
+		if (!staticCollider || !staticCollider->owner_->GetIsDestroy())
+		{
+			continue;
+		}
+
+		//BVHから取り除き、祖先ノードの境界ボックスを更新（衝突情報は次のフレームで破棄される）
+		staticBVH_.Remove(staticIndex);
+		staticColliderIndices_.erase(staticCollider->GetId());
+		staticColliders_[staticIndex] = nullptr;
+	}
+}
+
+Collider* CollisionManager::GetCollider(uint32_t index) const
 {
-	float distance = Mathf::Length(sphere1->GetWorldCenter() - sphere2->GetWorldCenter());
+	const uint32_t staticOffset = static_cast<uint32_t>(colliders_.size());
+	return index < staticOffset ? colliders_[index] : staticColliders_[index - staticOffset];
+}
 
-	float radiusSum = sphere1->GetRadius() + sphere2->GetRadius();
+bool CollisionManager::IsColliding(const Collider* collider1, const Collider* collider2)
+{
+	//衝突判定が無効化されている場合は衝突していない
+	if (!collider1->GetCollisionEnabled() || !collider2->GetCollisionEnabled())
+	{
+		return false;
+	}
 
-	return distance <= radiusSum;
+	//形状の組み合わせから衝突判定関数を引いて判定
+	const size_t type1 = static_cast<size_t>(collider1->GetColliderType());
+	const size_t type2 = static_cast<size_t>(collider2->GetColliderType());
+	return kNarrowPhaseTable[type1][type2](collider1, collider2);
+}
+
+bool CollisionManager::IntersectRayBox(const Vector3& origin, const Vector3& direction, const Vector3& boxMin, const Vector3& boxMax, float maxDistance, float& distance, int32_t& hitAxis)
+{
+	const float origins[3] = { origin.x, origin.y, origin.z };
+	const float directions[3] = { direction.x, direction.y, direction.z };
+	const float mins[3] = { boxMin.x, boxMin.y, boxMin.z };
+	const float maxs[3] = { boxMax.x, boxMax.y, boxMax.z };
+
+	//各軸のスラブに入る距離の最大値と出る距離の最小値を求める
+	float tMin = 0.0f;
+	float tMax = maxDistance;
+	hitAxis = -1;
+	for (int32_t axis = 0; axis < 3; ++axis)
+	{
+		//軸と平行な場合はスラブの内側にあるかだけを確認
+		if (std::abs(directions[axis]) < 1.0e-8f)
+		{
+			if (origins[axis] < mins[axis] || origins[axis] > maxs[axis])
+			{
+				return false;
+			}
+			continue;
+		}
+
+		const float inverseDirection = 1.0f / directions[axis];
+		float t1 = (mins[axis] - origins[axis]) * inverseDirection;
+		float t2 = (maxs[axis] - origins[axis]) * inverseDirection;
+		if (t1 > t2)
+		{
+			std::swap(t1, t2);
+		}
+		if (t1 > tMin)
+		{
+			tMin = t1;
+			hitAxis = axis;
+		}
+		tMax = std::min(tMax, t2);
+		if (tMin > tMax)
+		{
+			return false;
+		}
+	}
+
+	distance = tMin;
+	return true;
+}
+
+bool CollisionManager::RaycastCollider(Collider* collider, const Vector3& origin, const Vector3& direction, float maxDistance, RaycastHit& hit)
+{
+	switch (collider->GetColliderType())
+	{
+	case ColliderType::kSphere:
+	{
+		//球の方程式を解く
+		const SphereCollider* sphere = static_cast<const SphereCollider*>(collider);
+		const Vector3 m = origin - sphere->GetWorldCenter();
+		const float b = Mathf::Dot(m, direction);
+		const float c = Mathf::Dot(m, m) - sphere->GetRadius() * sphere->GetRadius();
+		if (c > 0.0f && b > 0.0f)
+		{
+			return false;
+		}
+		const float discriminant = b * b - c;
+		if (discriminant < 0.0f)
+		{
+			return false;
+		}
+		const float distance = std::max(-b - std::sqrt(discriminant), 0.0f);
+		if (distance > maxDistance)
+		{
+			return false;
+		}
+		hit.collider = collider;
+		hit.distance = distance;
+		hit.point = origin + direction * distance;
+		hit.normal = c > 0.0f ? Mathf::Normalize(hit.point - sphere->GetWorldCenter()) : direction * -1.0f;
+		return true;
+	}
+	case ColliderType::kAABB:
+	{
+		//ワールド座標系のままスラブ法で判定
+		const AABBCollider* aabb = static_cast<const AABBCollider*>(collider);
+		float distance = 0.0f;
+		int32_t hitAxis = -1;
+		if (!IntersectRayBox(origin, direction, aabb->GetWorldCenter() + aabb->GetMin(), aabb->GetWorldCenter() + aabb->GetMax(), maxDistance, distance, hitAxis))
+		{
+			return false;
+		}
+		const Vector3 axes[3] = { { 1.0f,0.0f,0.0f }, { 0.0f,1.0f,0.0f }, { 0.0f,0.0f,1.0f } };
+		const float directions[3] = { direction.x, direction.y, direction.z };
+		hit.collider = collider;
+		hit.distance = distance;
+		hit.point = origin + direction * distance;
+		hit.normal = hitAxis >= 0 ? axes[hitAxis] * (directions[hitAxis] < 0.0f ? 1.0f : -1.0f) : direction * -1.0f;
+		return true;
+	}
+	case ColliderType::kOBB:
+	{
+		//OBBの座標系に変換してスラブ法で判定
+		const OBBCollider* obb = static_cast<const OBBCollider*>(collider);
+		const Vector3 offset = origin - obb->GetWorldCenter();
+		const Vector3 localOrigin = { Mathf::Dot(offset, obb->GetOrientation(0)), Mathf::Dot(offset, obb->GetOrientation(1)), Mathf::Dot(offset, obb->GetOrientation(2)) };
+		const Vector3 localDirection = { Mathf::Dot(direction, obb->GetOrientation(0)), Mathf::Dot(direction, obb->GetOrientation(1)), Mathf::Dot(direction, obb->GetOrientation(2)) };
+		float distance = 0.0f;
+		int32_t hitAxis = -1;
+		if (!IntersectRayBox(localOrigin, localDirection, obb->GetSize() * -1.0f, obb->GetSize(), maxDistance, distance, hitAxis))
+		{
+			return false;
+		}
+		const float localDirections[3] = { localDirection.x, localDirection.y, localDirection.z };
+		hit.collider = collider;
+		hit.distance = distance;
+		hit.point = origin + direction * distance;
+		hit.normal = hitAxis >= 0 ? obb->GetOrientation(hitAxis) * (localDirections[hitAxis] < 0.0f ? 1.0f : -1.0f) : direction * -1.0f;
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+Vector3 CollisionManager::GetClosestPoint(const Collider* collider, const Vector3& point)
+{
+	switch (collider->GetColliderType())
+	{
+	case ColliderType::kSphere:
+	{
+		//中心から点の方向に半径分進めた点
+		const SphereCollider* sphere = static_cast<const SphereCollider*>(collider);
+		const Vector3 difference = point - sphere->GetWorldCenter();
+		const float distance = Mathf::Length(difference);
+		return distance <= sphere->GetRadius() ? point : sphere->GetWorldCenter() + difference * (sphere->GetRadius() / distance);
+	}
+	case ColliderType::kAABB:
+	{
+		//各軸で範囲内に収める
+		const AABBCollider* aabb = static_cast<const AABBCollider*>(collider);
+		const Vector3 min = aabb->GetWorldCenter() + aabb->GetMin();
+		const Vector3 max = aabb->GetWorldCenter() + aabb->GetMax();
+		return { std::clamp(point.x, min.x, max.x), std::clamp(point.y, min.y, max.y), std::clamp(point.z, min.z, max.z) };
+	}
+	case ColliderType::kOBB:
+	{
+		//OBBの各軸に投影して範囲内に収める
+		const OBBCollider* obb = static_cast<const OBBCollider*>(collider);
+		const Vector3 offset = point - obb->GetWorldCenter();
+		const float sizes[3] = { obb->GetSize().x, obb->GetSize().y, obb->GetSize().z };
+		Vector3 closestPoint = obb->GetWorldCenter();
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			const float distance = std::clamp(Mathf::Dot(offset, obb->GetOrientation(i)), -sizes[i], sizes[i]);
+			closestPoint = closestPoint + obb->GetOrientation(i) * distance;
+		}
+		return closestPoint;
+	}
+	default:
+		return point;
+	}
+}
+
+CollisionManager::SphereShape CollisionManager::MakeShape(const SphereCollider* sphere)
+{
+	return { sphere->GetWorldCenter(), sphere->GetRadius() };
+}
+
+CollisionManager::AABBShape CollisionManager::MakeShape(const AABBCollider* aabb)
+{
+	return { aabb->GetWorldCenter(), aabb->GetMin(), aabb->GetMax() };
+}
+
+CollisionManager::OBBShape CollisionManager::MakeShape(const OBBCollider* obb)
+{
+	return { obb->GetWorldCenter(), { obb->GetOrientation(0), obb->GetOrientation(1), obb->GetOrientation(2) }, obb->GetSize() };
+}
+
+void CollisionManager::SetSweptPose(const SphereShape& shape, const SphereCollider* sphere, float remaining, SphereShape& sweptShape)
+{
+	sweptShape.center = shape.center - sphere->GetSweep() * remaining;
+}
+
+void CollisionManager::SetSweptPose(const AABBShape& shape, const AABBCollider* aabb, float remaining, AABBShape& sweptShape)
+{
+	sweptShape.center = shape.center - aabb->GetSweep() * remaining;
+}
+
+void CollisionManager::SetSweptPose(const OBBShape& shape, const OBBCollider* obb, float remaining, OBBShape& sweptShape)
+{
+	sweptShape.center = shape.center - obb->GetSweep() * remaining;
+
+	//回転していない場合は今回の向きのまま
+	if (!obb->GetIsRotating())
+	{
+		return;
+	}
+
+	//今回の向きから前回の向きへの回転を割合で補間して軸を戻す
+	const Quaternion rotation = Mathf::Slerp(Mathf::IdentityQuaternion(), Mathf::Conjugate(obb->GetSweepRotation()), remaining);
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		sweptShape.orientations[i] = Mathf::RotateVector(shape.orientations[i], rotation);
+	}
+}
+
+float CollisionManager::GetRotationSweepLength(const Collider* collider)
+{
+	//回転するのはOBBだけ
+	if (collider->GetColliderType() != ColliderType::kOBB)
+	{
+		return 0.0f;
+	}
+
+	//回転角と中心から頂点までの距離から端が動く弧の長さを求める
+	const OBBCollider* obb = static_cast<const OBBCollider*>(collider);
+	const float angle = 2.0f * std::acos(std::min(std::abs(obb->GetSweepRotation().w), 1.0f));
+	return angle * Mathf::Length(obb->GetSize());
+}
+
+Quaternion CollisionManager::GetOrientationRotation(const OBBCollider* obb)
+{
+	//軸を行に並べた回転行列から求める（GetRotationは行ベクトルの行列に対して逆回転を返すので共役を取る）
+	Matrix4x4 rotateMatrix = Mathf::MakeIdentity4x4();
+	for (uint32_t i = 0; i < 3; ++i)
+	{
+		const Vector3& axis = obb->GetOrientation(i);
+		rotateMatrix.m[i][0] = axis.x;
+		rotateMatrix.m[i][1] = axis.y;
+		rotateMatrix.m[i][2] = axis.z;
+	}
+	return Mathf::Conjugate(Mathf::GetRotation(rotateMatrix));
+}
+
+bool CollisionManager::CheckSphereSphereCollision(const SphereCollider* sphere1, const SphereCollider* sphere2)
+{
+	return CheckCollision(MakeShape(sphere1), MakeShape(sphere2));
 }
 
 bool CollisionManager::CheckAABBAABBCollision(const AABBCollider* aabb1, const AABBCollider* aabb2)
 {
-	Vector3 min1 = aabb1->GetWorldCenter() + aabb1->GetMin();
-	Vector3 max1 = aabb1->GetWorldCenter() + aabb1->GetMax();
-	Vector3 min2 = aabb2->GetWorldCenter() + aabb2->GetMin();
-	Vector3 max2 = aabb2->GetWorldCenter() + aabb2->GetMax();
+	return CheckCollision(MakeShape(aabb1), MakeShape(aabb2));
+}
+
+bool CollisionManager::CheckOBBOBBCollision(const OBBCollider* obb1, const OBBCollider* obb2)
+{
+	return CheckCollision(MakeShape(obb1), MakeShape(obb2));
+}
+
+bool CollisionManager::CheckSphereAABBCollision(const SphereCollider* sphere1, const AABBCollider* aabb1)
+{
+	return CheckCollision(MakeShape(sphere1), MakeShape(aabb1));
+}
+
+bool CollisionManager::CheckSphereOBBCollision(const SphereCollider* sphere1, const OBBCollider* obb1)
+{
+	return CheckCollision(MakeShape(sphere1), MakeShape(obb1));
+}
+
+bool CollisionManager::CheckAABBOBBCollision(const AABBCollider* aabb1, const OBBCollider* obb1)
+{
+	return CheckCollision(MakeShape(aabb1), MakeShape(obb1));
+}
+
+float CollisionManager::GetThickness(const SphereShape& sphere)
+{
+	return sphere.radius;
+}
+
+float CollisionManager::GetThickness(const AABBShape& aabb)
+{
+	const Vector3 size = aabb.max - aabb.min;
+	return std::min({ size.x, size.y, size.z }) * 0.5f;
+}
+
+float CollisionManager::GetThickness(const OBBShape& obb)
+{
+	return std::min({ obb.size.x, obb.size.y, obb.size.z });
+}
+
+bool CollisionManager::CheckCollision(const SphereShape& sphere1, const SphereShape& sphere2)
+{
+	//平方根を取らずに距離の二乗で比較
+	Vector3 difference = sphere1.center - sphere2.center;
+
+	float radiusSum = sphere1.radius + sphere2.radius;
+
+	return Mathf::Dot(difference, difference) <= radiusSum * radiusSum;
+}
+
+bool CollisionManager::CheckCollision(const AABBShape& aabb1, const AABBShape& aabb2)
+{
+	Vector3 min1 = aabb1.center + aabb1.min;
+	Vector3 max1 = aabb1.center + aabb1.max;
+	Vector3 min2 = aabb2.center + aabb2.min;
+	Vector3 max2 = aabb2.center + aabb2.max;
 
 	if (max1.x < min2.x || min1.x > max2.x) return false;
 
@@ -160,23 +1016,23 @@ bool CollisionManager::CheckAABBAABBCollision(const AABBCollider* aabb1, const A
 	return true;
 }
 
-bool CollisionManager::CheckOBBOBBCollision(const OBBCollider* obb1, const OBBCollider* obb2)
+bool CollisionManager::CheckCollision(const OBBShape& obb1, const OBBShape& obb2)
 {
-	Vector3 NAe1 = obb1->GetOrientation(0);
-	Vector3 Ae1 = NAe1 * obb1->GetSize().x;
-	Vector3 NAe2 = obb1->GetOrientation(1);
-	Vector3 Ae2 = NAe2 * obb1->GetSize().y;
-	Vector3 NAe3 = obb1->GetOrientation(2);
-	Vector3 Ae3 = NAe3 * obb1->GetSize().z;
-
-	Vector3 NBe1 = obb2->GetOrientation(0);
-	Vector3 Be1 = NBe1 * obb2->GetSize().x;
-	Vector3 NBe2 = obb2->GetOrientation(1);
-	Vector3 Be2 = NBe2 * obb2->GetSize().y;
-	Vector3 NBe3 = obb2->GetOrientation(2);
-	Vector3 Be3 = NBe3 * obb2->GetSize().z;
-
-	Vector3 Interval = obb1->GetWorldCenter() - obb2->GetWorldCenter();
+	Vector3 NAe1 = obb1.orientations[0];
+	Vector3 Ae1 = NAe1 * obb1.size.x;
+	Vector3 NAe2 = obb1.orientations[1];
+	Vector3 Ae2 = NAe2 * obb1.size.y;
+	Vector3 NAe3 = obb1.orientations[2];
+	Vector3 Ae3 = NAe3 * obb1.size.z;
+
+	Vector3 NBe1 = obb2.orientations[0];
+	Vector3 Be1 = NBe1 * obb2.size.x;
+	Vector3 NBe2 = obb2.orientations[1];
+	Vector3 Be2 = NBe2 * obb2.size.y;
+	Vector3 NBe3 = obb2.orientations[2];
+	Vector3 Be3 = NBe3 * obb2.size.z;
+
+	Vector3 Interval = obb1.center - obb2.center;
 
 	auto LenSegOnSeparateAxis = [](const Vector3* Sep, const Vector3* e1, const Vector3* e2, const Vector3* e3) -> float {
 		float r1 = fabs(Mathf::Dot(*Sep, *e1));
@@ -332,20 +1188,20 @@ bool CollisionManager::CheckOBBOBBCollision(const OBBCollider* obb1, const OBBCo
 	return true;
 }
 
-bool CollisionManager::CheckSphereAABBCollision(const SphereCollider* sphere1, const AABBCollider* aabb1)
+bool CollisionManager::CheckCollision(const SphereShape& sphere1, const AABBShape& aabb1)
 {
 	//最近接点を求める
 	Vector3 closestPoint{
-		std::clamp(sphere1->GetWorldCenter().x,aabb1->GetWorldCenter().x + aabb1->GetMin().x,aabb1->GetWorldCenter().x + aabb1->GetMax().x),
-		std::clamp(sphere1->GetWorldCenter().y,aabb1->GetWorldCenter().y + aabb1->GetMin().y,aabb1->GetWorldCenter().y + aabb1->GetMax().y),
-		std::clamp(sphere1->GetWorldCenter().z,aabb1->GetWorldCenter().z + aabb1->GetMin().z,aabb1->GetWorldCenter().z + aabb1->GetMax().z)
+		std::clamp(sphere1.center.x,aabb1.center.x + aabb1.min.x,aabb1.center.x + aabb1.max.x),
+		std::clamp(sphere1.center.y,aabb1.center.y + aabb1.min.y,aabb1.center.y + aabb1.max.y),
+		std::clamp(sphere1.center.z,aabb1.center.z + aabb1.min.z,aabb1.center.z + aabb1.max.z)
 	};
 
 	//最近接点と球の中心との距離を求める
-	float distance = Mathf::Length(closestPoint - sphere1->GetWorldCenter());
+	float distance = Mathf::Length(closestPoint - sphere1.center);
 
 	//距離が半径よりも小さければ衝突
-	if (distance <= sphere1->GetRadius())
+	if (distance <= sphere1.radius)
 	{
 		return true;
 	}
@@ -353,11 +1209,11 @@ bool CollisionManager::CheckSphereAABBCollision(const SphereCollider* sphere1, c
 	return false;
 }
 
-bool CollisionManager::CheckSphereOBBCollision(const SphereCollider* sphere1, const OBBCollider* obb1)
+bool CollisionManager::CheckCollision(const SphereShape& sphere1, const OBBShape& obb1)
 {
-	Vector3 sphereCenter = sphere1->GetWorldCenter();
-	Vector3 obbCenter = obb1->GetWorldCenter();
-	Vector3 obbSize = obb1->GetSize();
+	Vector3 sphereCenter = sphere1.center;
+	Vector3 obbCenter = obb1.center;
+	Vector3 obbSize = obb1.size;
 
 	//球体の中心からOBB中心へのベクトル
 	Vector3 d = sphereCenter - obbCenter;
@@ -367,7 +1223,7 @@ bool CollisionManager::CheckSphereOBBCollision(const SphereCollider* sphere1, co
 	float axisSizes[3] = { obbSize.x, obbSize.y, obbSize.z };
 	for (int i = 0; i < 3; ++i)
 	{
-		axes[i] = obb1->GetOrientation(i);
+		axes[i] = obb1.orientations[i];
 	}
 
 	//最近接点を計算
@@ -382,19 +1238,19 @@ bool CollisionManager::CheckSphereOBBCollision(const SphereCollider* sphere1, co
 	//最近接点と球体の中心との距離を計算
 	Vector3 v = closestPoint - sphereCenter;
 	float distanceSquared = Mathf::Dot(v, v);
-	float radiusSquared = sphere1->GetRadius() * sphere1->GetRadius();
+	float radiusSquared = sphere1.radius * sphere1.radius;
 
 	return distanceSquared <= radiusSquared;
 }
 
-bool CollisionManager::CheckAABBOBBCollision(const AABBCollider* aabb1, const OBBCollider* obb1)
+bool CollisionManager::CheckCollision(const AABBShape& aabb1, const OBBShape& obb1)
 {
-	Vector3 aabbCenter = (aabb1->GetWorldCenter() + aabb1->GetMin() + aabb1->GetWorldCenter() + aabb1->GetMax()) * 0.5f;
+	Vector3 aabbCenter = (aabb1.center + aabb1.min + aabb1.center + aabb1.max) * 0.5f;
 
 	float aabbHalfSize[3] = {
-	0.5f * (aabb1->GetMax().x - aabb1->GetMin().x),
-	0.5f * (aabb1->GetMax().y - aabb1->GetMin().y),
-	0.5f * (aabb1->GetMax().z - aabb1->GetMin().z),
+	0.5f * (aabb1.max.x - aabb1.min.x),
+	0.5f * (aabb1.max.y - aabb1.min.y),
+	0.5f * (aabb1.max.z - aabb1.min.z),
 	};
 
 	Vector3 NAe1 = { 1.0f,0.0f,0.0f };
@@ -404,14 +1260,14 @@ bool CollisionManager::CheckAABBOBBCollision(const AABBCollider* aabb1, const OB
 	Vector3 NAe3 = { 0.0f,0.0f,1.0f };
 	Vector3 Ae3 = NAe3 * aabbHalfSize[2];
 
-	Vector3 NBe1 = obb1->GetOrientation(0);
-	Vector3 Be1 = NBe1 * obb1->GetSize().x;
-	Vector3 NBe2 = obb1->GetOrientation(1);
-	Vector3 Be2 = NBe2 * obb1->GetSize().y;
-	Vector3 NBe3 = obb1->GetOrientation(2);
-	Vector3 Be3 = NBe3 * obb1->GetSize().z;
+	Vector3 NBe1 = obb1.orientations[0];
+	Vector3 Be1 = NBe1 * obb1.size.x;
+	Vector3 NBe2 = obb1.orientations[1];
+	Vector3 Be2 = NBe2 * obb1.size.y;
+	Vector3 NBe3 = obb1.orientations[2];
+	Vector3 Be3 = NBe3 * obb1.size.z;
 
-	Vector3 Interval = aabbCenter - obb1->GetWorldCenter();
+	Vector3 Interval = aabbCenter - obb1.center;
 
 	auto LenSegOnSeparateAxis = [](const Vector3* Sep, const Vector3* e1, const Vector3* e2, const Vector3* e3) -> float {
 		float r1 = fabs(Mathf::Dot(*Sep, *e1));
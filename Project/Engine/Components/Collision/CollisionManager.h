@@ -9,18 +9,32 @@
 #include "SphereCollider.h"
 #include "AABBCollider.h"
 #include "OBBCollider.h"
-#include <list>
+#include "SweepAndPruneBroadPhase.h"
+#include "BoundingVolumeHierarchy.h"
+#include "Engine/Math/Quaternion.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 class CollisionManager
 {
 public:
+	//レイキャストの結果
+	struct RaycastHit
+	{
+		Collider* collider = nullptr;//当たったコライダー
+		Vector3 point{};             //当たった位置
+		Vector3 normal{};            //当たった面の法線
+		float distance = 0.0f;       //始点からの距離
+	};
+
 	/// <summary>
-	/// コライダーのリストをクリア
+	/// コライダーのリストをクリア（静的なコライダーは残る）
 	/// </summary>
 	void ClearColliderList();
 
 	/// <summary>
-	/// コライダーのリストに追加
+	/// コライダーのリストに追加（静的なコライダーは一度登録すればBVHに保持される）
 	/// </summary>
 	/// <param name="collider">コライダー</param>
 	void SetColliderList(Collider* collider);
@@ -30,13 +44,61 @@ public:
 	/// </summary>
 	void CheckAllCollisions();
 
-private:
 	/// <summary>
-	/// コライダーのペアを確認
+	/// ブロードフェーズを設定
+	/// </summary>
+	/// <param name="broadPhase">ブロードフェーズ</param>
+	void SetBroadPhase(std::unique_ptr<IBroadPhase> broadPhase) { broadPhase_ = std::move(broadPhase); };
+
+	/// <summary>
+	/// レイと最初に当たるコライダーを探す
+	/// </summary>
+	/// <param name="origin">始点</param>
+	/// <param name="direction">向き</param>
+	/// <param name="maxDistance">最大距離</param>
+	/// <param name="mask">対象にする衝突属性のマスク</param>
+	/// <param name="hit">当たった場合の結果</param>
+	/// <returns>当たったかどうか</returns>
+	bool Raycast(const Vector3& origin, const Vector3& direction, float maxDistance, uint32_t mask, RaycastHit& hit);
+
+	/// <summary>
+	/// 球を移動させて最初に当たるコライダーを探す
+	/// </summary>
+	/// <param name="origin">球の中心の始点</param>
+	/// <param name="radius">球の半径</param>
+	/// <param name="direction">向き</param>
+	/// <param name="maxDistance">最大距離</param>
+	/// <param name="mask">対象にする衝突属性のマスク</param>
+	/// <param name="hit">当たった場合の結果</param>
+	/// <returns>当たったかどうか</returns>
+	bool SphereCast(const Vector3& origin, float radius, const Vector3& direction, float maxDistance, uint32_t mask, RaycastHit& hit);
+
+	/// <summary>
+	/// 球と重なっているコライダーを探す
+	/// </summary>
+	/// <param name="center">球の中心</param>
+	/// <param name="radius">球の半径</param>
+	/// <param name="mask">対象にする衝突属性のマスク</param>
+	/// <param name="results">重なっているコライダーの追加先</param>
+	void OverlapSphere(const Vector3& center, float radius, uint32_t mask, std::vector<Collider*>& results);
+
+	/// <summary>
+	/// 箱と重なっているコライダーを探す
 	/// </summary>
-	/// <param name="colliderA">コライダー1</param>
-	/// <param name="colliderB">コライダー2</param>
-	void CheckCollisionPair(Collider* colliderA, Collider* colliderB);
+	/// <param name="center">箱の中心</param>
+	/// <param name="halfSize">箱の各軸の半分の大きさ</param>
+	/// <param name="rotation">箱の回転</param>
+	/// <param name="mask">対象にする衝突属性のマスク</param>
+	/// <param name="results">重なっているコライダーの追加先</param>
+	void OverlapBox(const Vector3& center, const Vector3& halfSize, const Quaternion& rotation, uint32_t mask, std::vector<Collider*>& results);
+
+	/// <summary>
+	/// コライダーのペアが衝突しているか判定
+	/// </summary>
+	/// <param name="collider1">コライダー1</param>
+	/// <param name="collider2">コライダー2</param>
+	/// <returns>衝突しているかどうか</returns>
+	static bool IsColliding(const Collider* collider1, const Collider* collider2);
 
 	/// <summary>
 	/// 球と球の衝突判定
@@ -44,7 +106,7 @@ private:
 	/// <param name="sphere1">球1</param>
 	/// <param name="sphere2">球2</param>
 	/// <returns>衝突しているかどうか</returns>
-	bool CheckSphereSphereCollision(const SphereCollider* sphere1, const SphereCollider* sphere2);
+	static bool CheckSphereSphereCollision(const SphereCollider* sphere1, const SphereCollider* sphere2);
 	
 	/// <summary>
 	/// AABBとAABBの衝突判定
@@ -52,7 +114,7 @@ private:
 	/// <param name="aabb1">AABB1</param>
 	/// <param name="aabb2">AABB2</param>
 	/// <returns>衝突しているかどうか</returns>
-	bool CheckAABBAABBCollision(const AABBCollider* aabb1, const AABBCollider* aabb2);
+	static bool CheckAABBAABBCollision(const AABBCollider* aabb1, const AABBCollider* aabb2);
 
 	/// <summary>
 	/// OBBとOBBの衝突判定
@@ -60,7 +122,7 @@ private:
 	/// <param name="obb1">OBB1</param>
 	/// <param name="obb2">OBB2</param>
 	/// <returns>衝突しているかどうか</returns>
-	bool CheckOBBOBBCollision(const OBBCollider* obb1, const OBBCollider* obb2);
+	static bool CheckOBBOBBCollision(const OBBCollider* obb1, const OBBCollider* obb2);
 
 	/// <summary>
 	/// 球とAABBの衝突判定
@@ -68,7 +130,7 @@ private:
 	/// <param name="sphere1">球</param>
 	/// <param name="aabb1">AABB</param>
 	/// <returns>衝突しているかどうか</returns>
-	bool CheckSphereAABBCollision(const SphereCollider* sphere1, const AABBCollider* aabb1);
+	static bool CheckSphereAABBCollision(const SphereCollider* sphere1, const AABBCollider* aabb1);
 	
 	/// <summary>
 	/// 球とOBBの衝突判定
@@ -76,7 +138,7 @@ private:
 	/// <param name="sphere1">球</param>
 	/// <param name="obb1">OBB</param>
 	/// <returns>衝突しているかどうか</returns>
-	bool CheckSphereOBBCollision(const SphereCollider* sphere1, const OBBCollider* obb1);
+	static bool CheckSphereOBBCollision(const SphereCollider* sphere1, const OBBCollider* obb1);
 
 	/// <summary>
 	/// AABBとOBBの衝突判定
@@ -84,9 +146,478 @@ private:
 	/// <param name="aabb1">AABB</param>
 	/// <param name="obb1">OBB</param>
 	/// <returns>衝突しているかどうか</returns>
-	bool CheckAABBOBBCollision(const AABBCollider* aabb1, const OBBCollider* obb1);
+	static bool CheckAABBOBBCollision(const AABBCollider* aabb1, const OBBCollider* obb1);
+
+private:
+	//詳細判定に使う球（補間する際にコライダーを複製しないように必要な値だけを持つ）
+	struct SphereShape
+	{
+		Vector3 center;
+		float radius;
+	};
+
+	//詳細判定に使うAABB
+	struct AABBShape
+	{
+		Vector3 center;
+		Vector3 min;//中心からの最小点
+		Vector3 max;//中心からの最大点
+	};
+
+	//詳細判定に使うOBB
+	struct OBBShape
+	{
+		Vector3 center;
+		Vector3 orientations[3];
+		Vector3 size;
+	};
+
+	//連続的な衝突判定で前回のフレームから引き継ぐ姿勢
+	struct SweepPose
+	{
+		Vector3 center;
+		Quaternion rotation;//OBBの向き（それ以外は単位クォータニオン）
+	};
+
+	//衝突しているペア
+	struct Contact
+	{
+		uint64_t key;   //コライダーのIDを詰めたキー
+		uint32_t index1;//今回のインデックス（前回の衝突情報では使用しない）
+		uint32_t index2;
+	};
+
+	//衝突イベントの種類
+	enum class ContactEventType
+	{
+		kEnter,
+		kStay,
+		kExit,
+	};
+
+	//衝突イベント
+	struct ContactEvent
+	{
+		uint32_t index1;
+		uint32_t index2;
+		ContactEventType type;
+	};
+
+	//衝突候補のペアを詳細判定する関数
+	using ContactCollectFunction = void (CollisionManager::*)(const IBroadPhase::CandidatePair* pairs, size_t count, std::vector<Contact>& contacts) const;
+
+	//詳細判定の作業単位
+	struct ContactChunk
+	{
+		const IBroadPhase::CandidatePair* pairs;//衝突候補のペアの先頭
+		uint32_t count;                         //ペアの数
+		ContactCollectFunction function;        //詳細判定する関数
+	};
 
 private:
-	std::list<Collider*> colliders_{};
+	/// <summary>
+	/// 静的なコライダーのBVHを構築し直す
+	/// </summary>
+	void RebuildStaticBVH();
+
+	/// <summary>
+	/// 動的なコライダーと静的なコライダーの衝突候補を収集
+	/// </summary>
+	void CollectStaticPairs();
+
+	/// <summary>
+	/// 問い合わせ用に動的なコライダーのBVHを構築
+	/// </summary>
+	void RebuildDynamicBVH();
+
+	/// <summary>
+	/// 条件を満たす境界ボックスを持つコライダーを静的・動的なBVHから列挙
+	/// </summary>
+	/// <typeparam name="NodeTest">bool(const Collider::Bounds& bounds)</typeparam>
+	/// <typeparam name="Callback">void(Collider* collider)</typeparam>
+	/// <param name="mask">対象にする衝突属性のマスク</param>
+	/// <param name="nodeTest">境界ボックスを辿るか判定する関数</param>
+	/// <param name="callback">有効で衝突属性がマスクと一致するコライダーを受け取る関数</param>
+	template <typename NodeTest, typename Callback>
+	void QueryColliders(uint32_t mask, NodeTest&& nodeTest, Callback&& callback);
+
+	/// <summary>
+	/// 連続的な衝突判定を行うコライダーの前回の位置からの移動量を更新
+	/// </summary>
+	void UpdateSweeps();
+
+	/// <summary>
+	/// 衝突候補のペアを詳細判定し、衝突しているペアを収集（ワーカースレッドで並列に判定する）
+	/// </summary>
+	void CollectContacts();
+
+	/// <summary>
+	/// 衝突候補のペアを作業単位に分けて追加
+	/// </summary>
+	/// <param name="pairs">衝突候補のペア</param>
+	/// <param name="function">詳細判定する関数</param>
+	void AddContactChunks(const std::vector<IBroadPhase::CandidatePair>& pairs, ContactCollectFunction function);
+
+	/// <summary>
+	/// 同じ形状の組み合わせの衝突候補のペアをまとめて詳細判定し、衝突しているペアを収集
+	/// </summary>
+	/// <param name="pairs">衝突候補のペア（形状の種類の順に並んでいる）</param>
+	/// <param name="count">ペアの数</param>
+	/// <param name="contacts">衝突しているペアの書き込み先</param>
+	template <typename Type1, typename Type2, typename Lanes1, typename Lanes2, uint32_t (*Test)(const Lanes1&, const Lanes2&)>
+	void CollectBatchContacts(const IBroadPhase::CandidatePair* pairs, size_t count, std::vector<Contact>& contacts) const;
+
+	/// <summary>
+	/// 衝突候補のペアを1ペアずつ詳細判定し、衝突しているペアを収集
+	/// </summary>
+	/// <param name="pairs">衝突候補のペア</param>
+	/// <param name="count">ペアの数</param>
+	/// <param name="contacts">衝突しているペアの書き込み先</param>
+	void CollectScalarContacts(const IBroadPhase::CandidatePair* pairs, size_t count, std::vector<Contact>& contacts) const;
+
+	/// <summary>
+	/// 前回の位置から今回の位置までの移動を考慮して衝突候補のペアを詳細判定し、衝突しているペアを収集
+	/// </summary>
+	/// <param name="pairs">衝突候補のペア</param>
+	/// <param name="count">ペアの数</param>
+	/// <param name="contacts">衝突しているペアの書き込み先</param>
+	void CollectSweptContacts(const IBroadPhase::CandidatePair* pairs, size_t count, std::vector<Contact>& contacts) const;
+
+	/// <summary>
+	/// 衝突しているペアを追加
+	/// </summary>
+	/// <param name="index1">コライダー1のインデックス</param>
+	/// <param name="index2">コライダー2のインデックス</param>
+	/// <param name="contacts">書き込み先</param>
+	void AddContact(uint32_t index1, uint32_t index2, std::vector<Contact>& contacts) const;
+
+	/// <summary>
+	/// 前回と今回の衝突しているペアを比較してイベントを作成
+	/// </summary>
+	void BuildContactEvents();
+
+	/// <summary>
+	/// 衝突イベントを登録順に呼び出す
+	/// </summary>
+	void DispatchContactEvents();
+
+	/// <summary>
+	/// 今回登録されているコライダーのインデックスをIDから探す
+	/// </summary>
+	/// <param name="colliderId">コライダーのID</param>
+	/// <param name="index">見つかったインデックス</param>
+	/// <returns>見つかったかどうか</returns>
+	bool FindColliderIndex(uint32_t colliderId, uint32_t& index) const;
+
+	/// <summary>
+	/// コライダーのペアからキーを作成
+	/// </summary>
+	/// <param name="collider1">コライダー1</param>
+	/// <param name="collider2">コライダー2</param>
+	/// <returns>ペアのキー</returns>
+	static uint64_t MakeContactKey(const Collider* collider1, const Collider* collider2);
+
+	/// <summary>
+	/// 破壊されたゲームオブジェクトの静的なコライダーを取り除く
+	/// </summary>
+	void RemoveDestroyedStaticColliders();
+
+	/// <summary>
+	/// インデックスからコライダーを取得（動的なコライダーの後に静的なコライダーが続く）
+	/// </summary>
+	/// <param name="index">インデックス</param>
+	/// <returns>コライダー</returns>
+	Collider* GetCollider(uint32_t index) const;
+
+	/// <summary>
+	/// 形状ごとの衝突判定関数を共通の引数で呼び出す
+	/// </summary>
+	/// <typeparam name="Type1">コライダー1の型</typeparam>
+	/// <typeparam name="Type2">コライダー2の型</typeparam>
+	/// <typeparam name="Function">衝突判定関数</typeparam>
+	/// <param name="collider1">コライダー1</param>
+	/// <param name="collider2">コライダー2</param>
+	/// <returns>衝突しているかどうか</returns>
+	template <typename Type1, typename Type2, bool (*Function)(const Type1*, const Type2*)>
+	static bool InvokeNarrowPhase(const Collider* collider1, const Collider* collider2);
+
+	/// <summary>
+	/// 引数を入れ替えて形状ごとの衝突判定関数を呼び出す
+	/// </summary>
+	/// <typeparam name="Type1">コライダー2の型</typeparam>
+	/// <typeparam name="Type2">コライダー1の型</typeparam>
+	/// <typeparam name="Function">衝突判定関数</typeparam>
+	/// <param name="collider1">コライダー1</param>
+	/// <param name="collider2">コライダー2</param>
+	/// <returns>衝突しているかどうか</returns>
+	template <typename Type1, typename Type2, bool (*Function)(const Type1*, const Type2*)>
+	static bool InvokeNarrowPhaseSwapped(const Collider* collider1, const Collider* collider2);
+
+	/// <summary>
+	/// 前回の姿勢から今回の姿勢までを補間した形状で衝突判定を行う
+	/// </summary>
+	/// <typeparam name="Type1">コライダー1の型</typeparam>
+	/// <typeparam name="Type2">コライダー2の型</typeparam>
+	/// <param name="collider1">コライダー1</param>
+	/// <param name="collider2">コライダー2</param>
+	/// <returns>移動中に衝突したかどうか</returns>
+	template <typename Type1, typename Type2>
+	static bool InvokeSweptNarrowPhase(const Collider* collider1, const Collider* collider2);
+
+	/// <summary>
+	/// 引数を入れ替えて、前回の姿勢から今回の姿勢までを補間した形状で衝突判定を行う
+	/// </summary>
+	/// <typeparam name="Type1">コライダー2の型</typeparam>
+	/// <typeparam name="Type2">コライダー1の型</typeparam>
+	/// <param name="collider1">コライダー1</param>
+	/// <param name="collider2">コライダー2</param>
+	/// <returns>移動中に衝突したかどうか</returns>
+	template <typename Type1, typename Type2>
+	static bool InvokeSweptNarrowPhaseSwapped(const Collider* collider1, const Collider* collider2);
+
+	/// <summary>
+	/// コライダーから詳細判定に使う形状を作成
+	/// </summary>
+	/// <param name="sphere">球</param>
+	/// <returns>形状</returns>
+	static SphereShape MakeShape(const SphereCollider* sphere);
+
+	/// <summary>
+	/// コライダーから詳細判定に使う形状を作成
+	/// </summary>
+	/// <param name="aabb">AABB</param>
+	/// <returns>形状</returns>
+	static AABBShape MakeShape(const AABBCollider* aabb);
+
+	/// <summary>
+	/// コライダーから詳細判定に使う形状を作成
+	/// </summary>
+	/// <param name="obb">OBB</param>
+	/// <returns>形状</returns>
+	static OBBShape MakeShape(const OBBCollider* obb);
+
+	/// <summary>
+	/// 前回の位置までの割合だけ戻した形状を設定
+	/// </summary>
+	/// <param name="shape">今回の形状</param>
+	/// <param name="sphere">球</param>
+	/// <param name="remaining">前回の位置に戻す割合</param>
+	/// <param name="sweptShape">補間した形状の書き込み先</param>
+	static void SetSweptPose(const SphereShape& shape, const SphereCollider* sphere, float remaining, SphereShape& sweptShape);
+
+	/// <summary>
+	/// 前回の位置までの割合だけ戻した形状を設定
+	/// </summary>
+	/// <param name="shape">今回の形状</param>
+	/// <param name="aabb">AABB</param>
+	/// <param name="remaining">前回の位置に戻す割合</param>
+	/// <param name="sweptShape">補間した形状の書き込み先</param>
+	static void SetSweptPose(const AABBShape& shape, const AABBCollider* aabb, float remaining, AABBShape& sweptShape);
+
+	/// <summary>
+	/// 前回の位置と向きまでの割合だけ戻した形状を設定（向きは球面線形補間する）
+	/// </summary>
+	/// <param name="shape">今回の形状</param>
+	/// <param name="obb">OBB</param>
+	/// <param name="remaining">前回の位置と向きに戻す割合</param>
+	/// <param name="sweptShape">補間した形状の書き込み先</param>
+	static void SetSweptPose(const OBBShape& shape, const OBBCollider* obb, float remaining, OBBShape& sweptShape);
+
+	/// <summary>
+	/// 回転によって形状の端が動く長さを取得
+	/// </summary>
+	/// <param name="collider">コライダー</param>
+	/// <returns>端が動く長さ（回転しない形状は0）</returns>
+	static float GetRotationSweepLength(const Collider* collider);
+
+	/// <summary>
+	/// OBBの軸から向きを表すクォータニオンを取得
+	/// </summary>
+	/// <param name="obb">OBB</param>
+	/// <returns>クォータニオン</returns>
+	static Quaternion GetOrientationRotation(const OBBCollider* obb);
+
+	/// <summary>
+	/// 球と球の衝突判定
+	/// </summary>
+	/// <param name="sphere1">球1</param>
+	/// <param name="sphere2">球2</param>
+	/// <returns>衝突しているかどうか</returns>
+	static bool CheckCollision(const SphereShape& sphere1, const SphereShape& sphere2);
+
+	/// <summary>
+	/// AABBとAABBの衝突判定
+	/// </summary>
+	/// <param name="aabb1">AABB1</param>
+	/// <param name="aabb2">AABB2</param>
+	/// <returns>衝突しているかどうか</returns>
+	static bool CheckCollision(const AABBShape& aabb1, const AABBShape& aabb2);
+
+	/// <summary>
+	/// OBBとOBBの衝突判定
+	/// </summary>
+	/// <param name="obb1">OBB1</param>
+	/// <param name="obb2">OBB2</param>
+	/// <returns>衝突しているかどうか</returns>
+	static bool CheckCollision(const OBBShape& obb1, const OBBShape& obb2);
+
+	/// <summary>
+	/// 球とAABBの衝突判定
+	/// </summary>
+	/// <param name="sphere1">球</param>
+	/// <param name="aabb1">AABB</param>
+	/// <returns>衝突しているかどうか</returns>
+	static bool CheckCollision(const SphereShape& sphere1, const AABBShape& aabb1);
+
+	/// <summary>
+	/// 球とOBBの衝突判定
+	/// </summary>
+	/// <param name="sphere1">球</param>
+	/// <param name="obb1">OBB</param>
+	/// <returns>衝突しているかどうか</returns>
+	static bool CheckCollision(const SphereShape& sphere1, const OBBShape& obb1);
+
+	/// <summary>
+	/// AABBとOBBの衝突判定
+	/// </summary>
+	/// <param name="aabb1">AABB</param>
+	/// <param name="obb1">OBB</param>
+	/// <returns>衝突しているかどうか</returns>
+	static bool CheckCollision(const AABBShape& aabb1, const OBBShape& obb1);
+
+	/// <summary>
+	/// 箱とレイの交差判定（スラブ法）
+	/// </summary>
+	/// <param name="origin">始点（箱の座標系）</param>
+	/// <param name="direction">向き（箱の座標系）</param>
+	/// <param name="boxMin">箱の最小点</param>
+	/// <param name="boxMax">箱の最大点</param>
+	/// <param name="maxDistance">最大距離</param>
+	/// <param name="distance">当たった距離</param>
+	/// <param name="hitAxis">当たった面の軸（始点が箱の内側の場合は-1）</param>
+	/// <returns>当たったかどうか</returns>
+	static bool IntersectRayBox(const Vector3& origin, const Vector3& direction, const Vector3& boxMin, const Vector3& boxMax, float maxDistance, float& distance, int32_t& hitAxis);
+
+	/// <summary>
+	/// コライダーとレイの交差判定
+	/// </summary>
+	/// <param name="collider">コライダー</param>
+	/// <param name="origin">始点</param>
+	/// <param name="direction">向き（正規化済み）</param>
+	/// <param name="maxDistance">最大距離</param>
+	/// <param name="hit">当たった場合の結果</param>
+	/// <returns>当たったかどうか</returns>
+	static bool RaycastCollider(Collider* collider, const Vector3& origin, const Vector3& direction, float maxDistance, RaycastHit& hit);
+
+	/// <summary>
+	/// コライダー上で点に最も近い点を取得
+	/// </summary>
+	/// <param name="collider">コライダー</param>
+	/// <param name="point">点</param>
+	/// <returns>最近接点</returns>
+	static Vector3 GetClosestPoint(const Collider* collider, const Vector3& point);
+
+	/// <summary>
+	/// 形状の最も薄い方向の半分の厚みを取得
+	/// </summary>
+	/// <param name="sphere">球</param>
+	/// <returns>厚み</returns>
+	static float GetThickness(const SphereShape& sphere);
+
+	/// <summary>
+	/// 形状の最も薄い方向の半分の厚みを取得
+	/// </summary>
+	/// <param name="aabb">AABB</param>
+	/// <returns>厚み</returns>
+	static float GetThickness(const AABBShape& aabb);
+
+	/// <summary>
+	/// 形状の最も薄い方向の半分の厚みを取得
+	/// </summary>
+	/// <param name="obb">OBB</param>
+	/// <returns>厚み</returns>
+	static float GetThickness(const OBBShape& obb);
+
+	//衝突判定関数
+	using NarrowPhaseFunction = bool (*)(const Collider*, const Collider*);
+
+	//形状の組み合わせごとの衝突判定関数のテーブル
+	static const NarrowPhaseFunction kNarrowPhaseTable[static_cast<size_t>(ColliderType::kCount)][static_cast<size_t>(ColliderType::kCount)];
+
+	//形状の組み合わせごとの移動を考慮した衝突判定関数のテーブル
+	static const NarrowPhaseFunction kSweptNarrowPhaseTable[static_cast<size_t>(ColliderType::kCount)][static_cast<size_t>(ColliderType::kCount)];
+
+	//移動を考慮した衝突判定で補間する最大の分割数
+	static const uint32_t kMaxSweepSteps = 16;
+
+	//形状の組み合わせごとの詳細判定関数のテーブル（形状の種類の順に並んだ組み合わせのみ）
+	static const ContactCollectFunction kContactCollectTable[static_cast<size_t>(ColliderType::kCount)][static_cast<size_t>(ColliderType::kCount)];
+
+	//球を移動させる判定で距離を詰める最大の回数
+	static const uint32_t kMaxSphereCastIterations = 32;
+
+	//詳細判定の作業単位あたりのペアの数
+	static const uint32_t kContactChunkSize = 64;
+
+	//動的なコライダーの配列
+	std::vector<Collider*> colliders_{};
+
+	//動的なコライダーのIDとインデックス（IDでソート済み）
+	std::vector<std::pair<uint32_t, uint32_t>> colliderIds_{};
+
+	//静的なコライダーの配列（取り除かれたものはnullptr）
+	std::vector<Collider*> staticColliders_{};
+
+	//静的なコライダーのIDから配列のインデックスを引くためのマップ
+	std::unordered_map<uint32_t, uint32_t> staticColliderIndices_{};
+
+	//静的なコライダーのBVH
+	BoundingVolumeHierarchy staticBVH_{};
+
+	//静的なコライダーのBVHを構築し直す必要があるか
+	bool isStaticBVHDirty_ = false;
+
+	//問い合わせ用の動的なコライダーのBVH
+	BoundingVolumeHierarchy dynamicBVH_{};
+
+	//問い合わせ用の動的なコライダーのBVHを構築し直す必要があるか
+	bool isDynamicBVHDirty_ = true;
+
+	//重なり判定の問い合わせに使う球と箱
+	SphereCollider querySphere_{};
+	OBBCollider queryBox_{};
+
+	//ブロードフェーズ
+	std::unique_ptr<IBroadPhase> broadPhase_ = std::make_unique<SweepAndPruneBroadPhase>();
+
+	//衝突候補のペア
+	std::vector<IBroadPhase::CandidatePair> candidatePairs_{};
+
+	//形状の組み合わせごとに振り分けた衝突候補のペア
+	std::vector<IBroadPhase::CandidatePair> candidatePairsByType_[static_cast<size_t>(ColliderType::kCount)][static_cast<size_t>(ColliderType::kCount)]{};
+
+	//移動を考慮して判定する衝突候補のペア
+	std::vector<IBroadPhase::CandidatePair> sweptCandidatePairs_{};
+
+	//連続的な衝突判定を行うコライダーのIDと前回の姿勢
+	std::unordered_map<uint32_t, SweepPose> previousPoses_{};
+
+	//連続的な衝突判定を行うコライダーのIDと今回の姿勢
+	std::unordered_map<uint32_t, SweepPose> currentPoses_{};
+
+	//詳細判定の作業単位
+	std::vector<ContactChunk> contactChunks_{};
+
+	//スレッドごとの衝突しているペアの書き込み先
+	std::vector<std::vector<Contact>> threadContacts_{};
+
+	//今回衝突しているペア（キーでソート済み）
+	std::vector<Contact> currentContacts_{};
+
+	//前回衝突していたペア（キーでソート済み）
+	std::vector<Contact> previousContacts_{};
+
+	//衝突イベント
+	std::vector<ContactEvent> contactEvents_{};
 };
 
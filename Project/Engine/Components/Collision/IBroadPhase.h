@@ -0,0 +1,31 @@
+/**
+ * @file IBroadPhase.h
+ * @brief ブロードフェーズの基底クラスを管理するファイル
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Collider.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class IBroadPhase
+{
+public:
+	//衝突候補のペア（コライダー配列のインデックス、first < second）
+	using CandidatePair = std::pair<uint32_t, uint32_t>;
+
+	/// <summary>
+	/// デストラクタ
+	/// </summary>
+	virtual ~IBroadPhase() = default;
+
+	/// <summary>
+	/// 衝突候補のペアを収集
+	/// </summary>
+	/// <param name="colliders">コライダーの配列</param>
+	/// <param name="pairs">衝突候補のペアの追加先</param>
+	virtual void CollectPairs(const std::vector<Collider*>& colliders, std::vector<CandidatePair>& pairs) = 0;
+};
@@ -0,0 +1,208 @@
+/**
+ * @file NarrowPhaseBatch.cpp
+ * @brief 複数の衝突候補ペアをまとめて詳細判定する関数群
+ * @author 青木智滉
+ * @date
+ */
+
+#include "NarrowPhaseBatch.h"
+
+//x64ではSSE2が必ず使えるのでSIMDで判定する
+#if defined(_M_X64) || defined(__SSE2__)
+#define NARROW_PHASE_BATCH_USE_SSE
+#include <emmintrin.h>
+#else
+#include <cmath>
+#endif
+
+namespace
+{
+	//全てのレーンを表すビットマスク
+	const uint32_t kAllLanes = (1u << NarrowPhaseBatch::kLaneCount) - 1;
+
+	//各軸以外の2本の軸
+	const uint32_t kOtherAxes[3][2] = { { 1, 2 }, { 0, 2 }, { 0, 1 } };
+
+#ifdef NARROW_PHASE_BATCH_USE_SSE
+	//4レーン分の値
+	struct Lanes
+	{
+		__m128 v;
+	};
+
+	inline Lanes LoadLanes(const float* p) { return { _mm_load_ps(p) }; };
+	inline Lanes operator+(const Lanes& a, const Lanes& b) { return { _mm_add_ps(a.v, b.v) }; };
+	inline Lanes operator-(const Lanes& a, const Lanes& b) { return { _mm_sub_ps(a.v, b.v) }; };
+	inline Lanes operator*(const Lanes& a, const Lanes& b) { return { _mm_mul_ps(a.v, b.v) }; };
+	inline Lanes operator-(const Lanes& a) { return { _mm_sub_ps(_mm_setzero_ps(), a.v) }; };
+	inline Lanes Abs(const Lanes& a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; };
+	inline Lanes Sqrt(const Lanes& a) { return { _mm_sqrt_ps(a.v) }; };
+	inline Lanes Min(const Lanes& a, const Lanes& b) { return { _mm_min_ps(a.v, b.v) }; };
+	inline Lanes Max(const Lanes& a, const Lanes& b) { return { _mm_max_ps(a.v, b.v) }; };
+	inline uint32_t LessEqualMask(const Lanes& a, const Lanes& b) { return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(a.v, b.v))); };
+	inline uint32_t GreaterMask(const Lanes& a, const Lanes& b) { return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpgt_ps(a.v, b.v))); };
+#else
+	//4レーン分の値（SIMDが使えない環境ではレーンごとに計算）
+	struct Lanes
+	{
+		float v[NarrowPhaseBatch::kLaneCount];
+	};
+
+	template <typename Function>
+	inline Lanes Map(Function function)
+	{
+		Lanes result{};
+		for (uint32_t i = 0; i < NarrowPhaseBatch::kLaneCount; ++i)
+		{
+			result.v[i] = function(i);
+		}
+		return result;
+	}
+
+	template <typename Function>
+	inline uint32_t MakeMask(Function function)
+	{
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < NarrowPhaseBatch::kLaneCount; ++i)
+		{
+			mask |= function(i) ? (1u << i) : 0u;
+		}
+		return mask;
+	}
+
+	inline Lanes LoadLanes(const float* p) { return Map([&](uint32_t i) { return p[i]; }); };
+	inline Lanes operator+(const Lanes& a, const Lanes& b) { return Map([&](uint32_t i) { return a.v[i] + b.v[i]; }); };
+	inline Lanes operator-(const Lanes& a, const Lanes& b) { return Map([&](uint32_t i) { return a.v[i] - b.v[i]; }); };
+	inline Lanes operator*(const Lanes& a, const Lanes& b) { return Map([&](uint32_t i) { return a.v[i] * b.v[i]; }); };
+	inline Lanes operator-(const Lanes& a) { return Map([&](uint32_t i) { return -a.v[i]; }); };
+	inline Lanes Abs(const Lanes& a) { return Map([&](uint32_t i) { return std::fabs(a.v[i]); }); };
+	inline Lanes Sqrt(const Lanes& a) { return Map([&](uint32_t i) { return std::sqrt(a.v[i]); }); };
+	inline Lanes Min(const Lanes& a, const Lanes& b) { return Map([&](uint32_t i) { return a.v[i] < b.v[i] ? a.v[i] : b.v[i]; }); };
+	inline Lanes Max(const Lanes& a, const Lanes& b) { return Map([&](uint32_t i) { return a.v[i] > b.v[i] ? a.v[i] : b.v[i]; }); };
+	inline uint32_t LessEqualMask(const Lanes& a, const Lanes& b) { return MakeMask([&](uint32_t i) { return a.v[i] <= b.v[i]; }); };
+	inline uint32_t GreaterMask(const Lanes& a, const Lanes& b) { return MakeMask([&](uint32_t i) { return a.v[i] > b.v[i]; }); };
+#endif
+
+	//4レーン分のベクトル
+	struct Vector3Lanes
+	{
+		Lanes x;
+		Lanes y;
+		Lanes z;
+	};
+
+	inline Vector3Lanes LoadVector(const float* x, const float* y, const float* z) { return { LoadLanes(x), LoadLanes(y), LoadLanes(z) }; };
+	inline Vector3Lanes operator-(const Vector3Lanes& a, const Vector3Lanes& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; };
+	inline Vector3Lanes operator+(const Vector3Lanes& a, const Vector3Lanes& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; };
+	inline Vector3Lanes operator*(const Vector3Lanes& a, const Lanes& s) { return { a.x * s, a.y * s, a.z * s }; };
+	inline Lanes Dot(const Vector3Lanes& a, const Vector3Lanes& b) { return a.x * b.x + a.y * b.y + a.z * b.z; };
+	inline Vector3Lanes Cross(const Vector3Lanes& a, const Vector3Lanes& b)
+	{
+		return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+	};
+
+	/// <summary>
+	/// 分離軸に投影した3本の軸の長さの和を計算
+	/// </summary>
+	inline Lanes ProjectExtents(const Vector3Lanes& axis, const Vector3Lanes& e1, const Vector3Lanes& e2, const Vector3Lanes& e3)
+	{
+		return Abs(Dot(axis, e1)) + Abs(Dot(axis, e2)) + Abs(Dot(axis, e3));
+	}
+
+	/// <summary>
+	/// 分離軸に投影した2本の軸の長さの和を計算
+	/// </summary>
+	inline Lanes ProjectExtents(const Vector3Lanes& axis, const Vector3Lanes& e1, const Vector3Lanes& e2)
+	{
+		return Abs(Dot(axis, e1)) + Abs(Dot(axis, e2));
+	}
+}
+
+namespace NarrowPhaseBatch
+{
+	uint32_t TestSphereSphere(const SphereLanes& spheres1, const SphereLanes& spheres2)
+	{
+		//中心間の距離の二乗と半径の和の二乗を比較
+		Vector3Lanes difference = LoadVector(spheres1.centerX, spheres1.centerY, spheres1.centerZ) - LoadVector(spheres2.centerX, spheres2.centerY, spheres2.centerZ);
+		Lanes radiusSum = LoadLanes(spheres1.radius) + LoadLanes(spheres2.radius);
+		return LessEqualMask(Dot(difference, difference), radiusSum * radiusSum);
+	}
+
+	uint32_t TestSphereOBB(const SphereLanes& spheres, const OBBLanes& obbs)
+	{
+		Vector3Lanes sphereCenter = LoadVector(spheres.centerX, spheres.centerY, spheres.centerZ);
+		Vector3Lanes obbCenter = LoadVector(obbs.centerX, obbs.centerY, obbs.centerZ);
+
+		//球体の中心からOBB中心へのベクトル
+		Vector3Lanes d = sphereCenter - obbCenter;
+
+		//各軸に投影してOBBの範囲に収めた最近接点を計算
+		Vector3Lanes closestPoint = obbCenter;
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			Vector3Lanes axis = LoadVector(obbs.axisX[i], obbs.axisY[i], obbs.axisZ[i]);
+			Lanes size = LoadLanes(obbs.size[i]);
+			Lanes clampedDistance = Max(-size, Min(Dot(d, axis), size));
+			closestPoint = closestPoint + axis * clampedDistance;
+		}
+
+		//最近接点と球体の中心との距離の二乗を半径の二乗と比較
+		Vector3Lanes v = closestPoint - sphereCenter;
+		Lanes radius = LoadLanes(spheres.radius);
+		return LessEqualMask(Dot(v, v), radius * radius);
+	}
+
+	uint32_t TestOBBOBB(const OBBLanes& obbs1, const OBBLanes& obbs2)
+	{
+		//各OBBの軸方向ベクトルと、サイズを掛けた軸ベクトル
+		Vector3Lanes NA[3];
+		Vector3Lanes A[3];
+		Vector3Lanes NB[3];
+		Vector3Lanes B[3];
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			NA[i] = LoadVector(obbs1.axisX[i], obbs1.axisY[i], obbs1.axisZ[i]);
+			A[i] = NA[i] * LoadLanes(obbs1.size[i]);
+			NB[i] = LoadVector(obbs2.axisX[i], obbs2.axisY[i], obbs2.axisZ[i]);
+			B[i] = NB[i] * LoadLanes(obbs2.size[i]);
+		}
+
+		Vector3Lanes interval = LoadVector(obbs1.centerX, obbs1.centerY, obbs1.centerZ) - LoadVector(obbs2.centerX, obbs2.centerY, obbs2.centerZ);
+
+		//分離軸が見つかったレーン
+		uint32_t separated = 0;
+
+		//分離軸 : Ae1～Ae3
+		for (uint32_t i = 0; i < 3 && separated != kAllLanes; ++i)
+		{
+			Lanes rA = Sqrt(Dot(A[i], A[i]));
+			Lanes rB = ProjectExtents(NA[i], B[0], B[1], B[2]);
+			Lanes L = Abs(Dot(interval, NA[i]));
+			separated |= GreaterMask(L, rA + rB);
+		}
+
+		//分離軸 : Be1～Be3
+		for (uint32_t i = 0; i < 3 && separated != kAllLanes; ++i)
+		{
+			Lanes rA = ProjectExtents(NB[i], A[0], A[1], A[2]);
+			Lanes rB = Sqrt(Dot(B[i], B[i]));
+			Lanes L = Abs(Dot(interval, NB[i]));
+			separated |= GreaterMask(L, rA + rB);
+		}
+
+		//分離軸 : C11～C33
+		for (uint32_t i = 0; i < 3 && separated != kAllLanes; ++i)
+		{
+			for (uint32_t j = 0; j < 3 && separated != kAllLanes; ++j)
+			{
+				Vector3Lanes cross = Cross(NA[i], NB[j]);
+				Lanes rA = ProjectExtents(cross, A[kOtherAxes[i][0]], A[kOtherAxes[i][1]]);
+				Lanes rB = ProjectExtents(cross, B[kOtherAxes[j][0]], B[kOtherAxes[j][1]]);
+				Lanes L = Abs(Dot(interval, cross));
+				separated |= GreaterMask(L, rA + rB);
+			}
+		}
+
+		return ~separated & kAllLanes;
+	}
+}
@@ -0,0 +1,100 @@
+/**
+ * @file NarrowPhaseBatch.h
+ * @brief 複数の衝突候補ペアをまとめて詳細判定する関数群
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "SphereCollider.h"
+#include "OBBCollider.h"
+#include <cstdint>
+
+namespace NarrowPhaseBatch
+{
+	//一度に判定するペアの数
+	static const uint32_t kLaneCount = 4;
+
+	//球をレーンごとに並べたデータ
+	struct SphereLanes
+	{
+		alignas(16) float centerX[kLaneCount];
+		alignas(16) float centerY[kLaneCount];
+		alignas(16) float centerZ[kLaneCount];
+		alignas(16) float radius[kLaneCount];
+	};
+
+	//OBBをレーンごとに並べたデータ
+	struct OBBLanes
+	{
+		alignas(16) float centerX[kLaneCount];
+		alignas(16) float centerY[kLaneCount];
+		alignas(16) float centerZ[kLaneCount];
+		alignas(16) float axisX[3][kLaneCount];
+		alignas(16) float axisY[3][kLaneCount];
+		alignas(16) float axisZ[3][kLaneCount];
+		alignas(16) float size[3][kLaneCount];
+	};
+
+	/// <summary>
+	/// 球のデータをレーンに読み込む
+	/// </summary>
+	/// <param name="lanes">書き込み先</param>
+	/// <param name="lane">レーン番号</param>
+	/// <param name="sphere">球のコライダー</param>
+	inline void Load(SphereLanes& lanes, uint32_t lane, const SphereCollider* sphere)
+	{
+		const Vector3& center = sphere->GetWorldCenter();
+		lanes.centerX[lane] = center.x;
+		lanes.centerY[lane] = center.y;
+		lanes.centerZ[lane] = center.z;
+		lanes.radius[lane] = sphere->GetRadius();
+	}
+
+	/// <summary>
+	/// OBBのデータをレーンに読み込む
+	/// </summary>
+	/// <param name="lanes">書き込み先</param>
+	/// <param name="lane">レーン番号</param>
+	/// <param name="obb">OBBのコライダー</param>
+	inline void Load(OBBLanes& lanes, uint32_t lane, const OBBCollider* obb)
+	{
+		const Vector3& center = obb->GetWorldCenter();
+		lanes.centerX[lane] = center.x;
+		lanes.centerY[lane] = center.y;
+		lanes.centerZ[lane] = center.z;
+		const float size[3] = { obb->GetSize().x, obb->GetSize().y, obb->GetSize().z };
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			const Vector3& axis = obb->GetOrientation(i);
+			lanes.axisX[i][lane] = axis.x;
+			lanes.axisY[i][lane] = axis.y;
+			lanes.axisZ[i][lane] = axis.z;
+			lanes.size[i][lane] = size[i];
+		}
+	}
+
+	/// <summary>
+	/// 球と球の衝突判定をまとめて行う
+	/// </summary>
+	/// <param name="spheres1">球1</param>
+	/// <param name="spheres2">球2</param>
+	/// <returns>衝突しているレーンのビットマスク</returns>
+	uint32_t TestSphereSphere(const SphereLanes& spheres1, const SphereLanes& spheres2);
+
+	/// <summary>
+	/// 球とOBBの衝突判定をまとめて行う
+	/// </summary>
+	/// <param name="spheres">球</param>
+	/// <param name="obbs">OBB</param>
+	/// <returns>衝突しているレーンのビットマスク</returns>
+	uint32_t TestSphereOBB(const SphereLanes& spheres, const OBBLanes& obbs);
+
+	/// <summary>
+	/// OBBとOBBの衝突判定をまとめて行う
+	/// </summary>
+	/// <param name="obbs1">OBB1</param>
+	/// <param name="obbs2">OBB2</param>
+	/// <returns>衝突しているレーンのビットマスク</returns>
+	uint32_t TestOBBOBB(const OBBLanes& obbs1, const OBBLanes& obbs2);
+}
@@ -10,13 +10,14 @@
 #include "Engine/Framework/Object/GameObject.h"
 #include "Engine/Components/Transform/TransformComponent.h"
 #include "Engine/Math/MathFunction.h"
+#include <algorithm>
 
 void OBBCollider::Update()
 {
 	if (!isWorldCenterSet_)
 	{
 		//トランスフォームコンポーネントからワールド座標を計算
-		TransformComponent* transformComponent = owner_->GetComponent<TransformComponent>();
+		TransformComponent* transformComponent = GetTransformComponent();
 		worldCenter_ = transformComponent->GetWorldPosition() + center_;
 	}
 
@@ -26,6 +27,42 @@ void OBBCollider::Update()
 	orientations_[2] = Mathf::Normalize(orientations_[2]);
 }
 
+Collider::Bounds OBBCollider::GetWorldBounds() const
+{
+	//各軸を投影した長さの合計が境界ボックスの半分の大きさになる
+	Vector3 extent{};
+	for (int i = 0; i < 3; ++i)
+	{
+		const float halfSize = i == 0 ? size_.x : i == 1 ? size_.y : size_.z;
+		extent.x += std::abs(orientations_[i].x) * halfSize;
+		extent.y += std::abs(orientations_[i].y) * halfSize;
+		extent.z += std::abs(orientations_[i].z) * halfSize;
+	}
+	return { worldCenter_ - extent, worldCenter_ + extent };
+}
+
+Collider::Bounds OBBCollider::GetSweptBounds() const
+{
+	//回転していない場合は移動量だけを考慮する
+	Bounds bounds = Collider::GetSweptBounds();
+	if (!GetIsRotating())
+	{
+		return bounds;
+	}
+
+	//回転中の向きでも収まるように、前回と今回の中心から外接球の半径だけ広げる
+	const float radius = Mathf::Length(size_);
+	const Vector3 previousCenter = worldCenter_ - sweep_;
+	bounds.min = { std::min({ bounds.min.x, worldCenter_.x - radius, previousCenter.x - radius }), std::min({ bounds.min.y, worldCenter_.y - radius, previousCenter.y - radius }), std::min({ bounds.min.z, worldCenter_.z - radius, previousCenter.z - radius }) };
+	bounds.max = { std::max({ bounds.max.x, worldCenter_.x + radius, previousCenter.x + radius }), std::max({ bounds.max.y, worldCenter_.y + radius, previousCenter.y + radius }), std::max({ bounds.max.z, worldCenter_.z + radius, previousCenter.z + radius }) };
+	return bounds;
+}
+
+bool OBBCollider::GetIsSweeping() const
+{
+	return Collider::GetIsSweeping() || GetIsRotating();
+}
+
 void OBBCollider::Draw(const Camera& camera)
 {
 	if (debugDrawEnabled_)
@@ -8,10 +8,16 @@
 #pragma once
 #include "Collider.h"
 #include "Engine/Math/Vector3.h"
+#include "Engine/Math/Quaternion.h"
 
 class OBBCollider : public Collider
 {
 public:
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	OBBCollider() : Collider(ColliderType::kOBB) {};
+
 	/// <summary>
 	/// 初期化
 	/// </summary>
@@ -28,6 +34,24 @@ public:
 	/// <param name="camera">カメラ</param>
 	void Draw(const Camera& camera) override;
 
+	/// <summary>
+	/// ワールド座標系の境界ボックスを取得
+	/// </summary>
+	/// <returns>境界ボックス</returns>
+	Bounds GetWorldBounds() const override;
+
+	/// <summary>
+	/// 前回の姿勢から今回の姿勢までを覆う境界ボックスを取得
+	/// </summary>
+	/// <returns>境界ボックス</returns>
+	Bounds GetSweptBounds() const override;
+
+	/// <summary>
+	/// 前回のフレームから移動または回転しているか
+	/// </summary>
+	/// <returns>移動または回転しているかどうか</returns>
+	bool GetIsSweeping() const override;
+
 	//ワールド座標系の中心点を取得・設定
 	const Vector3& GetWorldCenter() const { return worldCenter_; };
 	void SetWorldCenter(const Vector3& worldCenter)
@@ -64,6 +88,13 @@ public:
     const Vector3& GetSize() const { return size_; };
     void SetSize(const Vector3& size) { size_ = size; };
 
+	//前回の向きから今回の向きへの回転を取得・設定（連続的な衝突判定を行う場合に衝突マネージャーが設定する）
+	const Quaternion& GetSweepRotation() const { return sweepRotation_; };
+	void SetSweepRotation(const Quaternion& sweepRotation) { sweepRotation_ = sweepRotation; };
+
+	//前回のフレームから回転しているかを取得
+	const bool GetIsRotating() const { return sweepRotation_.x != 0.0f || sweepRotation_.y != 0.0f || sweepRotation_.z != 0.0f; };
+
 private:
     //ワールド座標の中心点
     Vector3 worldCenter_{};
@@ -77,6 +108,9 @@ private:
     //座標軸方向の長さの半分。中心から面までの距離
 	Vector3 size_ = { 1.0f,1.0f,1.0f };
 
+    //前回の向きから今回の向きへの回転
+	Quaternion sweepRotation_ = { 0.0f,0.0f,0.0f,1.0f };
+
     //ワールド座標系の中心座標が設定されているかどうか
     bool isWorldCenterSet_ = false;
 };
@@ -16,7 +16,7 @@ void SphereCollider::Update()
     if (!isWorldCenterSet_)
     {
         //トランスフォームコンポーネントからワールド座標を計算
-        TransformComponent* transformComponent = owner_->GetComponent<TransformComponent>();
+        TransformComponent* transformComponent = GetTransformComponent();
         worldCenter_ = transformComponent->GetWorldPosition() + center_;
     }
 }
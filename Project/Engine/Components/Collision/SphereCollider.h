@@ -12,6 +12,11 @@
 class SphereCollider : public Collider
 {
 public:
+	/// <summary>
+	/// コンストラクタ
+	/// </summary>
+	SphereCollider() : Collider(ColliderType::kSphere) {};
+
 	/// <summary>
 	/// 初期化
 	/// </summary>
@@ -28,6 +33,13 @@ public:
 	/// <param name="camera">カメラ</param>
 	void Draw(const Camera& camera) override;
 
+	//ワールド座標系の境界ボックスを取得
+	Bounds GetWorldBounds() const override
+	{
+		Vector3 extent = { radius_, radius_, radius_ };
+		return { worldCenter_ - extent, worldCenter_ + extent };
+	};
+
 	//ワールド座標系の中心点を取得・設定
 	const Vector3& GetWorldCenter() const { return worldCenter_; };
 	void SetWorldCenter(const Vector3& worldCenter)
@@ -0,0 +1,87 @@
+/**
+ * @file SweepAndPruneBroadPhase.cpp
+ * @brief 境界ボックスをソートして掃引するブロードフェーズを管理するファイル
+ * @author 青木智滉
+ * @date
+ */
+
+#include "SweepAndPruneBroadPhase.h"
+#include <algorithm>
+
+namespace
+{
+	//軸のインデックスから成分を取得
+	float GetAxisValue(const Vector3& v, int axis)
+	{
+		return axis == 0 ? v.x : axis == 1 ? v.y : v.z;
+	}
+}
+
+void SweepAndPruneBroadPhase::CollectPairs(const std::vector<Collider*>& colliders, std::vector<CandidatePair>& pairs)
+{
+	//境界ボックスを計算し、有効なコライダーのみを掃引対象にする
+	bounds_.resize(colliders.size());
+	sortedIndices_.clear();
+	for (uint32_t i = 0; i < static_cast<uint32_t>(colliders.size()); ++i)
+	{
+		bounds_[i] = colliders[i]->GetSweptBounds();
+		if (colliders[i]->GetCollisionEnabled())
+		{
+			sortedIndices_.push_back(i);
+		}
+	}
+
+	//最も散らばっている軸の最小値でソート
+	const int axis = SelectSweepAxis();
+	std::sort(sortedIndices_.begin(), sortedIndices_.end(), [&](uint32_t a, uint32_t b) {
+		return GetAxisValue(bounds_[a].min, axis) < GetAxisValue(bounds_[b].min, axis);
+		});
+
+	//掃引して区間が重なっているものだけを詳しく調べる
+	for (size_t i = 0; i < sortedIndices_.size(); ++i)
+	{
+		const uint32_t indexA = sortedIndices_[i];
+		const float maxA = GetAxisValue(bounds_[indexA].max, axis);
+		for (size_t j = i + 1; j < sortedIndices_.size(); ++j)
+		{
+			const uint32_t indexB = sortedIndices_[j];
+
+			//掃引軸で離れたらそれ以降は重ならない
+			if (GetAxisValue(bounds_[indexB].min, axis) > maxA)
+			{
+				break;
+			}
+
+			//境界ボックスと衝突フィルタリング
+			if (!bounds_[indexA].Overlaps(bounds_[indexB]) || !colliders[indexA]->CanCollideWith(colliders[indexB]))
+			{
+				continue;
+			}
+
+			pairs.emplace_back(std::min(indexA, indexB), std::max(indexA, indexB));
+		}
+	}
+}
+
+int SweepAndPruneBroadPhase::SelectSweepAxis() const
+{
+	//中心点の分散が最も大きい軸を選ぶ
+	Vector3 sum{};
+	Vector3 sumSquared{};
+	for (uint32_t index : sortedIndices_)
+	{
+		Vector3 center = (bounds_[index].min + bounds_[index].max) * 0.5f;
+		sum += center;
+		sumSquared += center * center;
+	}
+
+	if (sortedIndices_.empty())
+	{
+		return 0;
+	}
+
+	const float count = static_cast<float>(sortedIndices_.size());
+	Vector3 variance = sumSquared / count - (sum / count) * (sum / count);
+	if (variance.x >= variance.y && variance.x >= variance.z) return 0;
+	return variance.y >= variance.z ? 1 : 2;
+}
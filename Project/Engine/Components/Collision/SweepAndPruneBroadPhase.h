@@ -0,0 +1,34 @@
+/**
+ * @file SweepAndPruneBroadPhase.h
+ * @brief 境界ボックスをソートして掃引するブロードフェーズを管理するファイル
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "IBroadPhase.h"
+
+class SweepAndPruneBroadPhase : public IBroadPhase
+{
+public:
+	/// <summary>
+	/// 衝突候補のペアを収集
+	/// </summary>
+	/// <param name="colliders">コライダーの配列</param>
+	/// <param name="pairs">衝突候補のペアの追加先</param>
+	void CollectPairs(const std::vector<Collider*>& colliders, std::vector<CandidatePair>& pairs) override;
+
+private:
+	/// <summary>
+	/// 掃引する軸を選択
+	/// </summary>
+	/// <returns>軸のインデックス</returns>
+	int SelectSweepAxis() const;
+
+private:
+	//境界ボックス
+	std::vector<Collider::Bounds> bounds_{};
+
+	//掃引軸の最小値でソートしたインデックス
+	std::vector<uint32_t> sortedIndices_{};
+};
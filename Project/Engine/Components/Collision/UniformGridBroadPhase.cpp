@@ -0,0 +1,129 @@
+/**
+ * @file UniformGridBroadPhase.cpp
+ * @brief 均一グリッド（空間ハッシュ）によるブロードフェーズを管理するファイル
+ * @author 青木智滉
+ * @date
+ */
+
+#include "UniformGridBroadPhase.h"
+#include <algorithm>
+#include <cmath>
+
+void UniformGridBroadPhase::CollectPairs(const std::vector<Collider*>& colliders, std::vector<CandidatePair>& pairs)
+{
+	//バケットを初期化（確保したメモリは使いまわす）
+	buckets_.resize(kBucketCount);
+	for (size_t bucketIndex : usedBuckets_)
+	{
+		buckets_[bucketIndex].clear();
+	}
+	usedBuckets_.clear();
+	largeColliders_.clear();
+	activeColliders_.clear();
+
+	//境界ボックスを計算
+	bounds_.resize(colliders.size());
+	const float inverseCellSize = 1.0f / cellSize_;
+	for (uint32_t i = 0; i < static_cast<uint32_t>(colliders.size()); ++i)
+	{
+		bounds_[i] = colliders[i]->GetSweptBounds();
+		if (!colliders[i]->GetCollisionEnabled())
+		{
+			continue;
+		}
+		activeColliders_.push_back(i);
+
+		//境界ボックスが含まれるセルの範囲を計算
+		const Vector3& min = bounds_[i].min;
+		const Vector3& max = bounds_[i].max;
+		const int32_t minX = static_cast<int32_t>(std::floor(min.x * inverseCellSize));
+		const int32_t minY = static_cast<int32_t>(std::floor(min.y * inverseCellSize));
+		const int32_t minZ = static_cast<int32_t>(std::floor(min.z * inverseCellSize));
+		const int32_t maxX = static_cast<int32_t>(std::floor(max.x * inverseCellSize));
+		const int32_t maxY = static_cast<int32_t>(std::floor(max.y * inverseCellSize));
+		const int32_t maxZ = static_cast<int32_t>(std::floor(max.z * inverseCellSize));
+
+		//セルをまたぎすぎる大きなコライダーは別で管理する
+		const int64_t cellCount = int64_t(maxX - minX + 1) * int64_t(maxY - minY + 1) * int64_t(maxZ - minZ + 1);
+		if (cellCount > kMaxCellsPerCollider)
+		{
+			largeColliders_.push_back(i);
+			continue;
+		}
+
+		//セルに対応するバケットに登録
+		for (int32_t z = minZ; z <= maxZ; ++z)
+		{
+			for (int32_t y = minY; y <= maxY; ++y)
+			{
+				for (int32_t x = minX; x <= maxX; ++x)
+				{
+					const size_t bucketIndex = ComputeBucketIndex(x, y, z);
+					std::vector<uint32_t>& bucket = buckets_[bucketIndex];
+					//同じバケットに同じコライダーを重複して登録しない
+					if (!bucket.empty() && bucket.back() == i)
+					{
+						continue;
+					}
+					if (bucket.empty())
+					{
+						usedBuckets_.push_back(bucketIndex);
+					}
+					bucket.push_back(i);
+				}
+			}
+		}
+	}
+
+	//今回追加するペアの開始位置
+	const size_t firstPair = pairs.size();
+
+	//同じバケットに入っているコライダー同士を判定
+	for (size_t bucketIndex : usedBuckets_)
+	{
+		const std::vector<uint32_t>& bucket = buckets_[bucketIndex];
+		for (size_t i = 0; i < bucket.size(); ++i)
+		{
+			for (size_t j = i + 1; j < bucket.size(); ++j)
+			{
+				TryAddPair(colliders, bucket[i], bucket[j], pairs);
+			}
+		}
+	}
+
+	//大きなコライダーは全ての有効なコライダーと判定
+	for (uint32_t largeIndex : largeColliders_)
+	{
+		for (uint32_t otherIndex : activeColliders_)
+		{
+			//大きなコライダー同士は片方からのみ判定する
+			if (otherIndex == largeIndex || (otherIndex < largeIndex && std::binary_search(largeColliders_.begin(), largeColliders_.end(), otherIndex)))
+			{
+				continue;
+			}
+			TryAddPair(colliders, largeIndex, otherIndex, pairs);
+		}
+	}
+
+	//複数のセルで見つかった重複ペアを取り除く
+	std::sort(pairs.begin() + firstPair, pairs.end());
+	pairs.erase(std::unique(pairs.begin() + firstPair, pairs.end()), pairs.end());
+}
+
+size_t UniformGridBroadPhase::ComputeBucketIndex(int32_t x, int32_t y, int32_t z)
+{
+	//大きな素数を掛け合わせてハッシュ化
+	const uint32_t hash = (static_cast<uint32_t>(x) * 73856093u) ^ (static_cast<uint32_t>(y) * 19349663u) ^ (static_cast<uint32_t>(z) * 83492791u);
+	return hash % kBucketCount;
+}
+
+void UniformGridBroadPhase::TryAddPair(const std::vector<Collider*>& colliders, uint32_t indexA, uint32_t indexB, std::vector<CandidatePair>& pairs) const
+{
+	//境界ボックスと衝突フィルタリング
+	if (!bounds_[indexA].Overlaps(bounds_[indexB]) || !colliders[indexA]->CanCollideWith(colliders[indexB]))
+	{
+		return;
+	}
+
+	pairs.emplace_back(std::min(indexA, indexB), std::max(indexA, indexB));
+}
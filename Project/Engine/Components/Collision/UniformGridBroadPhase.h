@@ -0,0 +1,68 @@
+/**
+ * @file UniformGridBroadPhase.h
+ * @brief 均一グリッド（空間ハッシュ）によるブロードフェーズを管理するファイル
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "IBroadPhase.h"
+
+class UniformGridBroadPhase : public IBroadPhase
+{
+public:
+	/// <summary>
+	/// 衝突候補のペアを収集
+	/// </summary>
+	/// <param name="colliders">コライダーの配列</param>
+	/// <param name="pairs">衝突候補のペアの追加先</param>
+	void CollectPairs(const std::vector<Collider*>& colliders, std::vector<CandidatePair>& pairs) override;
+
+	//セルの大きさを取得・設定
+	const float GetCellSize() const { return cellSize_; };
+	void SetCellSize(const float cellSize) { cellSize_ = cellSize; };
+
+private:
+	/// <summary>
+	/// セル座標からバケットのインデックスを計算
+	/// </summary>
+	/// <param name="x">セルのX座標</param>
+	/// <param name="y">セルのY座標</param>
+	/// <param name="z">セルのZ座標</param>
+	/// <returns>バケットのインデックス</returns>
+	static size_t ComputeBucketIndex(int32_t x, int32_t y, int32_t z);
+
+	/// <summary>
+	/// 2つのコライダーが衝突候補であればペアに追加
+	/// </summary>
+	/// <param name="colliders">コライダーの配列</param>
+	/// <param name="indexA">インデックス1</param>
+	/// <param name="indexB">インデックス2</param>
+	/// <param name="pairs">衝突候補のペアの追加先</param>
+	void TryAddPair(const std::vector<Collider*>& colliders, uint32_t indexA, uint32_t indexB, std::vector<CandidatePair>& pairs) const;
+
+private:
+	//バケットの数
+	static const size_t kBucketCount = 4096;
+
+	//1つのコライダーが登録できるセルの最大数（これを超えるものは全てのコライダーと判定する）
+	static const int32_t kMaxCellsPerCollider = 64;
+
+	//セルの大きさ
+	float cellSize_ = 8.0f;
+
+	//境界ボックス
+	std::vector<Collider::Bounds> bounds_{};
+
+	//バケットごとのコライダーのインデックス
+	std::vector<std::vector<uint32_t>> buckets_{};
+
+	//コライダーが入っているバケット
+	std::vector<size_t> usedBuckets_{};
+
+	//セルに収まらない大きなコライダー
+	std::vector<uint32_t> largeColliders_{};
+
+	//有効なコライダー
+	std::vector<uint32_t> activeColliders_{};
+};
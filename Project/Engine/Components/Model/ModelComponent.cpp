@@ -25,12 +25,29 @@ void ModelComponent::Initialize()
 
 void ModelComponent::Update()
 {
-	TransformComponent* transformComponent = owner_->GetComponent<TransformComponent>();
+	//アニメーターがルートノードの行列を適用してから更新する
+	if (isUpdatedByAnimator_) return;
+	UpdateModel();
+}
+
+void ModelComponent::UpdateModel()
+{
+	TransformComponent* transformComponent = GetTransformComponent();
 	model_->Update(transformComponent->worldTransform_);
 }
 
 void ModelComponent::Draw(const Camera& camera)
 {
-	TransformComponent* transformComponent = owner_->GetComponent<TransformComponent>();
+	TransformComponent* transformComponent = GetTransformComponent();
 	model_->Draw(transformComponent->worldTransform_, camera);
+}
+
+TransformComponent* ModelComponent::GetTransformComponent()
+{
+	//コンポーネントのアドレスは持ち主が破棄されるまで変わらないので一度見つけたものを使い続ける
+	if (!transformComponent_)
+	{
+		transformComponent_ = owner_->GetComponent<TransformComponent>();
+	}
+	return transformComponent_;
 }
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include "Engine/3D/Transform/WorldTransform.h"
 #include "Engine/Components/Base/RenderComponent.h"
 
+class TransformComponent;
+
 class ModelComponent : public RenderComponent
 {
 public:
@@ -24,10 +26,15 @@ public:
 	void Initialize() override;
 
 	/// <summary>
-	/// 更新
+	/// 更新（アニメーターが更新する場合は何もしない）
 	/// </summary>
 	void Update() override;
 
+	/// <summary>
+	/// モデルの更新（アニメーターがルートノードの行列を適用した後に呼ぶ）
+	/// </summary>
+	void UpdateModel();
+
 	/// <summary>
 	/// 描画
 	/// </summary>
@@ -36,9 +43,26 @@ public:
 
 	//モデルを取得・設定
 	Model* GetModel() const { return model_; };
-	void SetModel(Model* model) { model_->Release(); model_ = model; };
+	void SetModel(Model* model) { if (model_) model_->Release(); model_ = model; };
+
+	//アニメーターが更新するかどうかを取得・設定
+	const bool GetIsUpdatedByAnimator() const { return isUpdatedByAnimator_; };
+	void SetIsUpdatedByAnimator(const bool isUpdatedByAnimator) { isUpdatedByAnimator_ = isUpdatedByAnimator; };
+
+private:
+	/// <summary>
+	/// 持ち主のトランスフォームコンポーネントを取得（見つかった後は持ち主を参照せずに返す）
+	/// </summary>
+	/// <returns>トランスフォームコンポーネント</returns>
+	TransformComponent* GetTransformComponent();
 
 private:
 	Model* model_ = nullptr;
+
+	//持ち主のトランスフォームコンポーネント
+	TransformComponent* transformComponent_ = nullptr;
+
+	//アニメーターが更新するかどうか（更新の順番によらず1フレームに1回だけ更新されるように）
+	bool isUpdatedByAnimator_ = false;
 };
 
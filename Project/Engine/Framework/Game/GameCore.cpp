@@ -9,6 +9,9 @@
 #include "Engine/Utilities/GlobalVariables.h"
 #include "Engine/Utilities/RandomGenerator.h"
 #include "Engine/Utilities/GameTimer.h"
+#include "Engine/Utilities/JobSystem.h"
+#include "Engine/Utilities/AssetLoader.h"
+#include "Engine/Framework/Object/GameObjectPool.h"
 
 void GameCore::Initialize()
 {
@@ -72,6 +75,9 @@ void GameCore::Initialize()
 	//RandomGeneratorの初期化
 	RandomGenerator::Initialize();
 
+	//JobSystemの初期化
+	JobSystem::GetInstance()->Initialize();
+
 	//GlovalVariablesの読み込み
 	GlobalVariables::GetInstance()->LoadFiles();
 }
@@ -96,6 +102,15 @@ void GameCore::Finalize()
 	//SceneManagerの解放
 	SceneManager::Destroy();
 
+	//GameObjectPoolの解放（全てのゲームオブジェクトが破棄された後に行う）
+	GameObjectPool::Destroy();
+
+	//AssetLoaderの解放（ワーカースレッドの読み込みを待つのでJobSystemより先に行う）
+	AssetLoader::Destroy();
+
+	//JobSystemの解放
+	JobSystem::Destroy();
+
 	//LightManagerの解放
 	LightManager::Destroy();
 
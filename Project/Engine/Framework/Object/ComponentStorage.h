@@ -0,0 +1,232 @@
+/**
+ * @file ComponentStorage.h
+ * @brief 同じ種類のコンポーネントを連続したメモリにまとめて確保・更新するストレージ
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "Engine/Components/Base/Component.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+class IComponentStorage
+{
+public:
+	/// <summary>
+	/// デストラクタ
+	/// </summary>
+	virtual ~IComponentStorage() = default;
+
+	/// <summary>
+	/// 持ち主が有効なコンポーネントをメモリ順にまとめて更新
+	/// </summary>
+	virtual void Update() = 0;
+
+	/// <summary>
+	/// コンポーネントを破棄して領域を返却
+	/// </summary>
+	/// <param name="index">確保したときの番号</param>
+	virtual void Free(const uint32_t index) = 0;
+
+	/// <summary>
+	/// 持ち主の有効フラグを反映（まとめて更新するときに持ち主を参照しなくて済むように）
+	/// </summary>
+	/// <param name="index">確保したときの番号</param>
+	/// <param name="isActive">持ち主が有効かどうか</param>
+	virtual void SetIsActive(const uint32_t index, const bool isActive) = 0;
+};
+
+//コンポーネントの削除処理（ストレージで確保したものはストレージに返却する）
+struct ComponentDeleter
+{
+	//確保したストレージ（nullptrの場合はnewで確保したもの）
+	IComponentStorage* storage = nullptr;
+	//ストレージで確保したときの番号（返却するときにアドレスから探さなくて済むように）
+	uint32_t index = 0;
+
+	void operator()(Component* component) const
+	{
+		if (storage)
+		{
+			storage->Free(index);
+		}
+		else
+		{
+			delete component;
+		}
+	}
+};
+
+template<class Type>
+class ComponentStorage : public IComponentStorage
+{
+public:
+	//1つのチャンクに入るコンポーネントの数
+	static const uint32_t kChunkSize = 64;
+
+	/// <summary>
+	/// デストラクタ
+	/// </summary>
+	~ComponentStorage() override;
+
+	/// <summary>
+	/// コンポーネントを確保して生成（アドレスは返却するまで変わらない）
+	/// </summary>
+	/// <param name="index">確保した番号（返却と有効フラグの反映に使う）</param>
+	/// <returns>生成したコンポーネント</returns>
+	Type* Allocate(uint32_t& index);
+
+	/// <summary>
+	/// コンポーネントを破棄して領域を返却
+	/// </summary>
+	/// <param name="index">確保したときの番号</param>
+	void Free(const uint32_t index) override;
+
+	/// <summary>
+	/// 持ち主の有効フラグを反映（まとめて更新するときに持ち主を参照しなくて済むように）
+	/// </summary>
+	/// <param name="index">確保したときの番号</param>
+	/// <param name="isActive">持ち主が有効かどうか</param>
+	void SetIsActive(const uint32_t index, const bool isActive) override;
+
+	/// <summary>
+	/// 持ち主が有効なコンポーネントをメモリ順にまとめて更新
+	/// </summary>
+	void Update() override;
+
+	/// <summary>
+	/// 生きている全てのコンポーネントをメモリ順に処理
+	/// </summary>
+	/// <param name="function">コンポーネントを受け取る関数</param>
+	template<class Function>
+	void ForEach(Function&& function);
+
+	//生きているコンポーネントの数を取得
+	const uint32_t GetSize() const { return size_; };
+
+private:
+	//チャンク構造体
+	struct Chunk
+	{
+		//コンポーネントの領域
+		alignas(Type) std::byte data[sizeof(Type) * kChunkSize];
+		//生きているかどうか
+		std::array<bool, kChunkSize> isAlive{};
+		//持ち主が有効かどうか
+		std::array<bool, kChunkSize> isActive{};
+	};
+
+	/// <summary>
+	/// 番号からコンポーネントの領域を取得
+	/// </summary>
+	/// <param name="index">番号</param>
+	/// <returns>コンポーネントの領域</returns>
+	Type* GetSlot(const uint32_t index) const { return reinterpret_cast<Type*>(chunks_[index / kChunkSize]->data) + index % kChunkSize; };
+
+private:
+	//チャンク（確保したチャンクは移動しない）
+	std::vector<std::unique_ptr<Chunk>> chunks_{};
+
+	//空いている番号
+	std::vector<uint32_t> freeIndices_{};
+
+	//使用した番号の数
+	uint32_t capacity_ = 0;
+
+	//生きているコンポーネントの数
+	uint32_t size_ = 0;
+};
+
+
+template<class Type>
+ComponentStorage<Type>::~ComponentStorage()
+{
+	//コンポーネントは持ち主のゲームオブジェクトが先に返却していること
+	assert(size_ == 0);
+}
+
+template<class Type>
+Type* ComponentStorage<Type>::Allocate(uint32_t& index)
+{
+	//空いている番号があれば再利用し、なければ末尾を使う
+	if (!freeIndices_.empty())
+	{
+		index = freeIndices_.back();
+		freeIndices_.pop_back();
+	}
+	else
+	{
+		//チャンクが足りなければ追加
+		index = capacity_++;
+		if (index / kChunkSize >= chunks_.size())
+		{
+			chunks_.push_back(std::make_unique<Chunk>());
+		}
+	}
+
+	//領域にコンポーネントを生成
+	Type* component = new (GetSlot(index)) Type();
+	chunks_[index / kChunkSize]->isAlive[index % kChunkSize] = true;
+	chunks_[index / kChunkSize]->isActive[index % kChunkSize] = true;
+	++size_;
+	return component;
+}
+
+template<class Type>
+void ComponentStorage<Type>::Free(const uint32_t index)
+{
+	assert(index < capacity_ && chunks_[index / kChunkSize]->isAlive[index % kChunkSize] && "このストレージで確保したコンポーネントではありません");
+
+	//破棄して番号を返却
+	GetSlot(index)->~Type();
+	chunks_[index / kChunkSize]->isAlive[index % kChunkSize] = false;
+	freeIndices_.push_back(index);
+	--size_;
+}
+
+template<class Type>
+void ComponentStorage<Type>::SetIsActive(const uint32_t index, const bool isActive)
+{
+	assert(index < capacity_ && chunks_[index / kChunkSize]->isAlive[index % kChunkSize] && "このストレージで確保したコンポーネントではありません");
+	chunks_[index / kChunkSize]->isActive[index % kChunkSize] = isActive;
+}
+
+template<class Type>
+void ComponentStorage<Type>::Update()
+{
+	for (uint32_t chunkIndex = 0; chunkIndex < chunks_.size(); ++chunkIndex)
+	{
+		Chunk& chunk = *chunks_[chunkIndex];
+		Type* first = reinterpret_cast<Type*>(chunk.data);
+		const uint32_t count = std::min(kChunkSize, capacity_ - chunkIndex * kChunkSize);
+		for (uint32_t localIndex = 0; localIndex < count; ++localIndex)
+		{
+			//持ち主が無効な場合は更新しない（持ち主のフラグはチャンクに写してあるので参照しない）
+			if (!chunk.isAlive[localIndex] || !chunk.isActive[localIndex]) continue;
+
+			//型が確定しているので仮想関数を経由せずに呼び出す
+			first[localIndex].Type::Update();
+		}
+	}
+}
+
+template<class Type>
+template<class Function>
+void ComponentStorage<Type>::ForEach(Function&& function)
+{
+	for (uint32_t index = 0; index < capacity_; ++index)
+	{
+		const Chunk& chunk = *chunks_[index / kChunkSize];
+		if (chunk.isAlive[index % kChunkSize])
+		{
+			function(*GetSlot(index));
+		}
+	}
+}
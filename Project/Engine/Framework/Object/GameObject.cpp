@@ -6,22 +6,70 @@
  */
 
 #include "GameObject.h"
+#include "GameObjectManager.h"
+#include "GameObjectPool.h"
+
+void* GameObject::operator new(const size_t size)
+{
+	return GameObjectPool::GetInstance()->Allocate(size);
+}
+
+void GameObject::operator delete(void* pointer, const size_t size)
+{
+	GameObjectPool::GetInstance()->Free(pointer, size);
+}
 
 void GameObject::Update()
 {
-	for (const std::unique_ptr<Component>& component : components_)
+	//更新中にコンポーネントが追加されてもよいように番号でアクセスする
+	for (size_t i = 0; i < updateComponents_.size(); ++i)
 	{
-		component->Update();
+		updateComponents_[i]->Update();
 	}
 }
 
 void GameObject::Draw(const Camera& camera)
 {
-	for (const auto& component : components_)
+	for (RenderComponent* renderComponent : renderComponents_)
+	{
+		renderComponent->Draw(camera);
+	}
+}
+
+void GameObject::SetIsActive(const bool isActive)
+{
+	//変わっていなければ何もしない
+	if (isActive_ == isActive) return;
+	isActive_ = isActive;
+
+	//ストレージで確保したコンポーネントはストレージ側のフラグで更新を飛ばすので反映する
+	for (const std::unique_ptr<Component, ComponentDeleter>& component : components_)
 	{
-		if (auto* renderComponent = dynamic_cast<RenderComponent*>(component.get()))
+		const ComponentDeleter& deleter = component.get_deleter();
+		if (deleter.storage)
 		{
-			renderComponent->Draw(camera);
+			deleter.storage->SetIsActive(deleter.index, isActive);
 		}
 	}
+}
+
+void GameObject::SetName(const std::string& name)
+{
+	//名前を変更してゲームオブジェクトマネージャーの名前の索引に反映する
+	const std::string oldName = name_;
+	name_ = name;
+	if (gameObjectManager_)
+	{
+		gameObjectManager_->OnGameObjectRenamed(this, oldName);
+	}
+}
+
+IComponentStorage* GameObject::FindComponentStorage(const uint32_t typeId) const
+{
+	//ストレージを使わない場合は今まで通りnewで確保する
+	if (!useComponentStorage_ || !gameObjectManager_)
+	{
+		return nullptr;
+	}
+	return gameObjectManager_->GetComponentStorage(typeId);
 }
\ No newline at end of file
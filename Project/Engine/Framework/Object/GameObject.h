@@ -8,16 +8,42 @@
 #pragma once
 #include "Engine/Components/Base/Component.h"
 #include "Engine/Components/Base/RenderComponent.h"
+#include "Engine/Framework/Object/ComponentStorage.h"
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 class GameObjectManager;
 
+//ゲームオブジェクトのハンドル（破棄されたゲームオブジェクトのハンドルからは取得できない）
+struct GameObjectHandle
+{
+	//スロットの番号
+	uint32_t index = UINT32_MAX;
+	//スロットの世代
+	uint32_t generation = 0;
+};
+
 class GameObject
 {
 public:
+	/// <summary>
+	/// ゲームオブジェクトプールから確保
+	/// </summary>
+	/// <param name="size">派生クラスの大きさ</param>
+	/// <returns>確保したメモリ</returns>
+	static void* operator new(const size_t size);
+
+	/// <summary>
+	/// ゲームオブジェクトプールに返却
+	/// </summary>
+	/// <param name="pointer">返却するメモリ</param>
+	/// <param name="size">派生クラスの大きさ</param>
+	static void operator delete(void* pointer, const size_t size);
+
 	/// <summary>
 	/// デストラクタ
 	/// </summary>
@@ -64,11 +90,11 @@ public:
 
 	//名前の取得・設定
 	const std::string& GetName() const { return name_; };
-	void SetName(const std::string& name) { name_ = name; };
+	void SetName(const std::string& name);
 
 	//アクティブ状態の取得・設定
 	const bool GetIsActive() const { return isActive_; };
-	void SetIsActive(bool isActive) { isActive_ = isActive; };
+	void SetIsActive(const bool isActive);
 
 	//描画フラグの取得・設定
 	const bool GetIsVisible() const { return isVisible_; };
@@ -82,6 +108,14 @@ public:
 	const bool GetIsDestroy() const { return isDestroy_; };
 	void SetIsDestroy(bool isDestroy) { isDestroy_ = isDestroy; };
 
+	//コンポーネントをストレージで確保するかどうかの取得・設定（コンポーネントを追加する前に設定する）
+	const bool GetUseComponentStorage() const { return useComponentStorage_; };
+	void SetUseComponentStorage(const bool useComponentStorage) { useComponentStorage_ = useComponentStorage; };
+
+	//ハンドルの取得・設定
+	const GameObjectHandle& GetHandle() const { return handle_; };
+	void SetHandle(const GameObjectHandle& handle) { handle_ = handle; };
+
 	//ゲームオブジェクトマネージャーを設定
 	void SetGameObjectManager(GameObjectManager* gameObjectManager) { gameObjectManager_ = gameObjectManager; };
 
@@ -101,12 +135,15 @@ protected:
 	//ゲームオブジェクトマネージャー
 	GameObjectManager* gameObjectManager_ = nullptr;
 
-	//コンポーネント
-	std::list<std::unique_ptr<Component>> components_{};
+	//コンポーネント（ストレージで確保したものはストレージでまとめて更新される）
+	std::list<std::unique_ptr<Component, ComponentDeleter>> components_{};
 
 	//名前
 	std::string name_{};
 
+	//ハンドル
+	GameObjectHandle handle_{};
+
 	//描画フラグ
 	bool isVisible_ = true;
 
@@ -118,30 +155,117 @@ protected:
 
 	//破壊フラグ
 	bool isDestroy_ = false;
+
+	//コンポーネントをストレージで確保するかどうか（まとめて更新すると自分の行列を更新直後に読めなくなるので、数が多く静的なものだけ有効にする）
+	bool useComponentStorage_ = false;
+
+private:
+	//型ごとのコンポーネントのキャッシュ
+	struct ComponentSlot
+	{
+		//見つかったコンポーネント（取得した型のポインタ）
+		void* component = nullptr;
+		//検索済みかどうか
+		bool isResolved = false;
+	};
+
+	/// <summary>
+	/// コンポーネントを先頭から検索
+	/// </summary>
+	/// <returns>最初に見つかったコンポーネント</returns>
+	template<class Type>
+	Type* FindComponent() const;
+
+	/// <summary>
+	/// 型ごとのキャッシュを取得（足りなければ拡張する）
+	/// </summary>
+	/// <param name="typeId">型ごとの番号</param>
+	/// <returns>キャッシュ</returns>
+	ComponentSlot& GetComponentSlot(const uint32_t typeId)
+	{
+		if (typeId >= componentSlots_.size())
+		{
+			componentSlots_.resize(typeId + 1);
+		}
+		return componentSlots_[typeId];
+	};
+
+	/// <summary>
+	/// ゲームオブジェクトマネージャーに登録された型ごとのストレージを取得
+	/// </summary>
+	/// <param name="typeId">型ごとの番号</param>
+	/// <returns>ストレージ（使わない場合や登録されていない場合はnullptr）</returns>
+	IComponentStorage* FindComponentStorage(const uint32_t typeId) const;
+
+	//型の番号ごとのコンポーネントのキャッシュ
+	std::vector<ComponentSlot> componentSlots_{};
+
+	//ゲームオブジェクトが更新するコンポーネント（追加した順、ストレージで確保したものは含まない）
+	std::vector<Component*> updateComponents_{};
+
+	//描画コンポーネント（追加した順）
+	std::vector<RenderComponent*> renderComponents_{};
 };
 
 
 template<class Type>
 Type* GameObject::AddComponent()
 {
-	Type* component = new Type();
+	//ストレージが登録されている型であればストレージで確保する
+	IComponentStorage* storage = FindComponentStorage(ComponentTypeId::Get<Type>());
+	uint32_t storageIndex = 0;
+	Type* component = storage ? static_cast<ComponentStorage<Type>*>(storage)->Allocate(storageIndex) : new Type();
 	component->Initialize();
 	component->owner_ = this;
-	components_.push_back(std::unique_ptr<Type>(component));
+	components_.push_back(std::unique_ptr<Component, ComponentDeleter>(component, ComponentDeleter{ storage, storageIndex }));
+
+	//ストレージで確保したものはゲームオブジェクトマネージャーがまとめて更新する（無効な場合はストレージに伝える）
+	if (!storage)
+	{
+		updateComponents_.push_back(component);
+	}
+	else if (!isActive_)
+	{
+		storage->SetIsActive(storageIndex, false);
+	}
+
+	//描画コンポーネントであれば描画用の配列に追加
+	if constexpr (std::is_base_of_v<RenderComponent, Type>)
+	{
+		renderComponents_.push_back(component);
+	}
+
+	//見つからなかったキャッシュは追加したコンポーネントで見つかる可能性があるので無効にする
+	for (ComponentSlot& slot : componentSlots_)
+	{
+		if (!slot.component)
+		{
+			slot.isResolved = false;
+		}
+	}
+
+	//追加した型のキャッシュを登録（先に追加された派生クラスがあればそちらを優先する）
+	ComponentSlot& slot = GetComponentSlot(ComponentTypeId::Get<Type>());
+	if (!slot.isResolved)
+	{
+		slot.component = FindComponent<Type>();
+		slot.isResolved = true;
+	}
 	return component;
 }
 
 template<class Type>
 Type* GameObject::GetComponent()
 {
-	for (const auto& component : components_)
+	//キャッシュがあればそれを返す
+	ComponentSlot& slot = GetComponentSlot(ComponentTypeId::Get<Type>());
+	if (!slot.isResolved)
 	{
-		if (auto* specificComponent = dynamic_cast<Type*>(component.get()))
-		{
-			return specificComponent;
-		}
+		//基底クラスなどで取得した場合は初回だけ検索する（見つからなかった結果も保持する）
+		slot.component = FindComponent<Type>();
+		slot.isResolved = true;
 	}
-	return nullptr;
+	return static_cast<Type*>(slot.component);
 }
 
 template <typename Type>
@@ -156,4 +280,17 @@ std::vector<Type*> GameObject::GetComponents()
 		}
 	}
 	return result;
+}
+
+template<class Type>
+Type* GameObject::FindComponent() const
+{
+	for (const auto& component : components_)
+	{
+		if (auto* specificComponent = dynamic_cast<Type*>(component.get()))
+		{
+			return specificComponent;
+		}
+	}
+	return nullptr;
 }
\ No newline at end of file
@@ -6,7 +6,11 @@
  */
 
 #include "GameObjectManager.h"
+#include "Engine/Components/Animator/AnimatorComponent.h"
+#include "Engine/Utilities/JobSystem.h"
+#include <algorithm>
 #include <cassert>
+#include <unordered_set>
 
 //実体定義
 GameObjectManager* GameObjectManager::instance_ = nullptr;
@@ -37,7 +41,13 @@ GameObject* GameObjectManager::CreateGameObject(const std::string& objectName)
 
 void GameObjectManager::Clear()
 {
-	//ゲームオブジェクトをクリア
+	//名前の索引とハンドルから削除してゲームオブジェクトをクリア
+	std::vector<GameObject*> clearedObjects;
+	for (const std::unique_ptr<GameObject>& gameObject : gameObjects_)
+	{
+		clearedObjects.push_back(gameObject.get());
+	}
+	UnregisterGameObjects(clearedObjects);
 	gameObjects_.clear();
 }
 
@@ -49,6 +59,9 @@ void GameObjectManager::Update()
 	//全ての保留中のゲームオブジェクトを初期化
 	ProcessPendingGameObjects();
 
+	//アニメーションの更新
+	UpdateAnimators();
+
 	//ゲームオブジェクトの更新
 	for (const std::unique_ptr<GameObject>& gameObject : gameObjects_)
 	{
@@ -57,6 +70,9 @@ void GameObjectManager::Update()
 			gameObject->Update();
 		}
 	}
+
+	//ストレージのコンポーネントの更新
+	UpdateComponentStorages();
 }
 
 void GameObjectManager::Draw(const Camera& camera)
@@ -103,18 +119,29 @@ GameObject* GameObjectManager::CreateGameObjectInternal(const std::string& objec
 	//保留中のゲームオブジェクトに追加
 	pendingGameObjects_.push_back(std::unique_ptr<GameObject>(newGameObject));
 
+	//ハンドルを割り当てて名前の索引に追加
+	RegisterGameObject(newGameObject);
+
 	//新規ゲームオブジェクトを返す
 	return newGameObject;
 }
 
 void GameObjectManager::RemoveDestroyedGameObjects()
 {
-	//破壊フラグが立ったゲームオブジェクトを削除
-	std::vector<std::unique_ptr<GameObject>>::iterator it = std::remove_if(gameObjects_.begin(), gameObjects_.end(),
-		[](std::unique_ptr<GameObject>& gameObject)
-{
-			return gameObject->GetIsDestroy();
+	//破壊フラグが立ったゲームオブジェクトを順番を保ったまま後ろに集める
+	std::vector<std::unique_ptr<GameObject>>::iterator it = std::stable_partition(gameObjects_.begin(), gameObjects_.end(),
+		[](const std::unique_ptr<GameObject>& gameObject)
+		{
+			return !gameObject->GetIsDestroy();
 		});
+
+	//名前の索引とハンドルから削除してからゲームオブジェクトを削除（メモリはゲームオブジェクトプールで再利用される）
+	std::vector<GameObject*> destroyedObjects;
+	for (std::vector<std::unique_ptr<GameObject>>::iterator destroyed = it; destroyed != gameObjects_.end(); ++destroyed)
+	{
+		destroyedObjects.push_back(destroyed->get());
+	}
+	UnregisterGameObjects(destroyedObjects);
 	gameObjects_.erase(it, gameObjects_.end());
 }
 
@@ -132,4 +159,160 @@ void GameObjectManager::ProcessPendingGameObjects()
 
 	//保留中のゲームオブジェクトをゲームオブジェクトリストに追加
 	gameObjects_.insert(gameObjects_.end(), std::make_move_iterator(currentPending.begin()), std::make_move_iterator(currentPending.end()));
+}
+
+void GameObjectManager::UpdateAnimators()
+{
+	//有効なゲームオブジェクトのアニメーターを集める
+	animators_.clear();
+	for (const std::unique_ptr<GameObject>& gameObject : gameObjects_)
+	{
+		if (gameObject->GetIsActive())
+		{
+			if (AnimatorComponent* animator = gameObject->GetComponent<AnimatorComponent>())
+			{
+				animators_.push_back(animator);
+			}
+		}
+	}
+
+	//アニメーターごとに姿勢のサンプリングとブレンド、マトリックスパレットの計算を並列に行う（全て終わるまで待つ）
+	JobSystem::GetInstance()->ParallelFor(static_cast<uint32_t>(animators_.size()), 1, [this](uint32_t begin, uint32_t end, uint32_t) {
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			animators_[i]->UpdatePose();
+		}
+		});
+}
+
+void GameObjectManager::UpdateComponentStorages()
+{
+	//種類ごとに連続したメモリをまとめて更新する（登録順に更新されるので依存される種類を先に登録しておく）
+	for (const std::unique_ptr<IComponentStorage>& componentStorage : componentStorages_)
+	{
+		componentStorage->Update();
+	}
+}
+
+void GameObjectManager::OnGameObjectRenamed(GameObject* gameObject, const std::string& oldName)
+{
+	//索引に登録されている場合は新しい名前で登録し直す
+	if (RemoveFromNameIndex(gameObject, oldName))
+	{
+		AddToNameIndex(gameObject);
+	}
+}
+
+void GameObjectManager::RegisterGameObject(GameObject* gameObject)
+{
+	//空いているスロットを再利用し、なければ追加する
+	uint32_t index = 0;
+	if (!freeHandleIndices_.empty())
+	{
+		index = freeHandleIndices_.back();
+		freeHandleIndices_.pop_back();
+	}
+	else
+	{
+		index = static_cast<uint32_t>(handleSlots_.size());
+		handleSlots_.emplace_back();
+	}
+
+	//スロットにゲームオブジェクトを設定してハンドルを渡す
+	HandleSlot& slot = handleSlots_[index];
+	slot.gameObject = gameObject;
+	gameObject->SetHandle({ index, slot.generation });
+
+	//名前の索引に追加
+	AddToNameIndex(gameObject);
+}
+
+void GameObjectManager::UnregisterGameObjects(const std::vector<GameObject*>& gameObjects)
+{
+	//世代を進めてこれまでのハンドルを無効にし、スロットを返却
+	std::unordered_set<std::string_view> names;
+	for (GameObject* gameObject : gameObjects)
+	{
+		const GameObjectHandle& handle = gameObject->GetHandle();
+		HandleSlot& slot = handleSlots_[handle.index];
+		slot.gameObject = nullptr;
+		++slot.generation;
+		freeHandleIndices_.push_back(handle.index);
+		names.insert(gameObject->GetName());
+	}
+
+	//名前ごとにまとめて索引から削除（同じ名前のものが大量に破棄されても名前ごとに1回の走査で済む）
+	for (const std::string_view name : names)
+	{
+		auto it = nameIndex_.find(std::string(name));
+		if (it == nameIndex_.end())
+		{
+			continue;
+		}
+		std::erase_if(it->second, [this](GameObject* gameObject) { return handleSlots_[gameObject->GetHandle().index].gameObject != gameObject; });
+		EraseNameIfEmpty(it);
+	}
+}
+
+void GameObjectManager::AddToNameIndex(GameObject* gameObject)
+{
+	//初めての名前の場合は名前の全ての接尾辞を登録する（文字列はマップのキーを参照するので移動しない）
+	auto [it, inserted] = nameIndex_.try_emplace(gameObject->GetName());
+	if (inserted)
+	{
+		const std::string_view name = it->first;
+		for (size_t i = 0; i <= name.size(); ++i)
+		{
+			nameSuffixIndex_.emplace(std::make_pair(name.substr(i), name), &it->second);
+		}
+	}
+	it->second.push_back(gameObject);
+}
+
+bool GameObjectManager::RemoveFromNameIndex(GameObject* gameObject, const std::string& objectName)
+{
+	//名前の配列から削除
+	auto it = nameIndex_.find(objectName);
+	if (it == nameIndex_.end()) return false;
+	std::vector<GameObject*>& gameObjects = it->second;
+	auto found = std::find(gameObjects.begin(), gameObjects.end(), gameObject);
+	if (found == gameObjects.end()) return false;
+	gameObjects.erase(found);
+
+	//その名前のゲームオブジェクトがなくなった場合は名前も削除する
+	EraseNameIfEmpty(it);
+	return true;
+}
+
+void GameObjectManager::EraseNameIfEmpty(std::unordered_map<std::string, std::vector<GameObject*>>::iterator it)
+{
+	//その名前のゲームオブジェクトがなくなった場合は接尾辞も削除する
+	if (!it->second.empty()) return;
+	const std::string_view name = it->first;
+	for (size_t i = 0; i <= name.size(); ++i)
+	{
+		nameSuffixIndex_.erase({ name.substr(i), name });
+	}
+	nameIndex_.erase(it);
+}
+
+const std::vector<GameObject*>* GameObjectManager::FindGameObjectsByName(const std::string& objectName) const
+{
+	auto it = nameIndex_.find(objectName);
+	return it != nameIndex_.end() ? &it->second : nullptr;
+}
+
+std::vector<const std::vector<GameObject*>*> GameObjectManager::FindGameObjectsByStringProperty(const std::string& searchString) const
+{
+	//文字列で始まる接尾辞を持つ名前の配列を集める（同じ名前に複数回含まれる場合は1回だけ）
+	std::vector<const std::vector<GameObject*>*> result;
+	std::unordered_set<const std::vector<GameObject*>*> found;
+	for (auto it = nameSuffixIndex_.lower_bound({ searchString, std::string_view() }); it != nameSuffixIndex_.end() && it->first.first.starts_with(searchString); ++it)
+	{
+		if (found.insert(it->second).second)
+		{
+			result.push_back(it->second);
+		}
+	}
+	return result;
 }
\ No newline at end of file
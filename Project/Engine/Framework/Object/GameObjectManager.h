@@ -9,8 +9,14 @@
 #include "Engine/Framework/Object/AbstractGameObjectFactory.h"
 #include "Engine/Framework/Object/GameObject.h"
 #include "Engine/Components/Transform/TransformComponent.h"
+#include <map>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+class AnimatorComponent;
+
 class GameObjectManager
 {
 public:
@@ -70,7 +76,28 @@ public:
 	void SetGameObjectFactory(AbstractGameObjectFactory* gameObjectFactory) { gameObjectFactory_ = gameObjectFactory; };
 
 	/// <summary>
-	/// ゲームオブジェクトを取得（template）
+	/// コンポーネントを連続したメモリに確保してまとめて更新するストレージを登録（template、登録した順にゲームオブジェクトの更新の後で更新される）
+	/// </summary>
+	/// <typeparam name="Type">コンポーネントの種類（派生クラスは含まない）</typeparam>
+	template <typename Type>
+	void RegisterComponentStorage();
+
+	/// <summary>
+	/// 型ごとのストレージを取得
+	/// </summary>
+	/// <param name="typeId">型ごとの番号</param>
+	/// <returns>ストレージ（登録されていない場合はnullptr）</returns>
+	IComponentStorage* GetComponentStorage(const uint32_t typeId) const { return typeId < componentStoragesByTypeId_.size() ? componentStoragesByTypeId_[typeId] : nullptr; };
+
+	/// <summary>
+	/// ゲームオブジェクトの名前の変更を名前の索引に反映（GameObject::SetNameから呼ばれる）
+	/// </summary>
+	/// <param name="gameObject">ゲームオブジェクト</param>
+	/// <param name="oldName">変更前の名前</param>
+	void OnGameObjectRenamed(GameObject* gameObject, const std::string& oldName);
+
+	/// <summary>
+	/// ゲームオブジェクトを取得（template、保留中のものも含めて生成した順で最初のもの。名前を変更したものは変更した時点で最後になる）
 	/// </summary>
 	/// <typeparam name="Type">ゲームオブジェクトの種類</typeparam>
 	/// <param name="objectName">オブジェクトの名前</param>
@@ -79,7 +106,16 @@ public:
 	Type* GetGameObject(const std::string& objectName) const;
 
 	/// <summary>
-	/// 指定した名前を持つゲームオブジェクトを取得(template)
+	/// ハンドルからゲームオブジェクトを取得（template、破棄されている場合はnullptr）
+	/// </summary>
+	/// <typeparam name="Type">ゲームオブジェクトの種類</typeparam>
+	/// <param name="handle">ハンドル</param>
+	/// <returns>ゲームオブジェクト</returns>
+	template <typename Type>
+	Type* GetGameObject(const GameObjectHandle& handle) const;
+
+	/// <summary>
+	/// 指定した名前を持つゲームオブジェクトを取得(template、GetGameObjectsByStringPropertyの順番で最初のもの)
 	/// </summary>
 	/// <typeparam name="Type">ゲームオブジェクトの種類</typeparam>
 	/// <param name="searchString">探す文字列</param>
@@ -88,7 +124,7 @@ public:
 	Type* GetGameObjectByStringProperty(const std::string& searchString) const;
 
 	/// <summary>
-	/// ゲームオブジェクトをまとめて取得
+	/// ゲームオブジェクトをまとめて取得（保留中のものも含めて生成した順。名前を変更したものは変更した時点で最後になる）
 	/// </summary>
 	/// <typeparam name="Type">ゲームオブジェクトの種類</typeparam>
 	/// <param name="objectName">ゲームオブジェクトの名前</param>
@@ -97,7 +133,7 @@ public:
 	std::vector<Type*> GetGameObjects(const std::string& objectName) const;
 
 	/// <summary>
-	/// 指定した文字列を持つゲームオブジェクトをまとめて取得
+	/// 指定した文字列を持つゲームオブジェクトをまとめて取得（名前ごとにまとまり、同じ名前の中はGetGameObjectsと同じ順番。名前の間の順番は決まっていない）
 	/// </summary>
 	/// <typeparam name="Type">ゲームオブジェクトの種類</typeparam>
 	/// <param name="searchString">探す文字列</param>
@@ -137,53 +173,99 @@ private:
     /// </summary>
     void ProcessPendingGameObjects();
 
+    /// <summary>
+    /// 全てのアニメーターの姿勢を並列に更新（ゲームオブジェクトの更新でジョイントが参照される前に済ませる）
+    /// </summary>
+    void UpdateAnimators();
+
+    /// <summary>
+    /// 登録されたストレージのコンポーネントを種類ごとにまとめて更新
+    /// </summary>
+    void UpdateComponentStorages();
+
 	/// <summary>
-	/// ゲームオブジェクトを名前ベースで見つける
+	/// ハンドルを割り当てて名前の索引に追加
 	/// </summary>
-	/// <typeparam name="Type">ゲームオブジェクトの種類</typeparam>
-	/// <param name="objects">ゲームオブジェクトの配列</param>
-	/// <param name="objectName">ゲームオブジェクトの名前</param>
-	/// <returns>見つかったゲームオブジェクト</returns>
-	template <typename Type>
-	Type* FindGameObjectByName(const std::vector<std::unique_ptr<GameObject>>& objects, const std::string& objectName) const;
+	/// <param name="gameObject">ゲームオブジェクト</param>
+	void RegisterGameObject(GameObject* gameObject);
 
 	/// <summary>
-	/// 指定した名前を持つゲームオブジェクトを見つける
+	/// 名前の索引から削除してハンドルを無効にする（破棄する直前にまとめて呼ぶ）
 	/// </summary>
-	/// <typeparam name="Type">ゲームオブジェクトの種類</typeparam>
-	/// <param name="objects">ゲームオブジェクトの配列</param>
-	/// <param name="searchString">探す文字列</param>
-	/// <returns>見つかったゲームオブジェクト</returns>
-	template <typename Type>
-	Type* FindGameObjectByStringProperty(const std::vector<std::unique_ptr<GameObject>>& objects, const std::string& searchString) const;
+	/// <param name="gameObjects">ゲームオブジェクトの配列</param>
+	void UnregisterGameObjects(const std::vector<GameObject*>& gameObjects);
 
 	/// <summary>
-	/// 指定した名前のゲームオブジェクトを配列に追加
+	/// 名前の索引にゲームオブジェクトを追加
+	/// </summary>
+	/// <param name="gameObject">ゲームオブジェクト</param>
+	void AddToNameIndex(GameObject* gameObject);
+
+	/// <summary>
+	/// 名前の索引からゲームオブジェクトを削除
+	/// </summary>
+	/// <param name="gameObject">ゲームオブジェクト</param>
+	/// <param name="objectName">索引に登録されている名前</param>
+	/// <returns>索引に登録されていたかどうか</returns>
+	bool RemoveFromNameIndex(GameObject* gameObject, const std::string& objectName);
+
+	/// <summary>
+	/// 名前のゲームオブジェクトがなくなっていれば名前と接尾辞を索引から削除
+	/// </summary>
+	/// <param name="it">名前の索引の要素</param>
+	void EraseNameIfEmpty(std::unordered_map<std::string, std::vector<GameObject*>>::iterator it);
+
+	/// <summary>
+	/// 名前が一致するゲームオブジェクトの配列を取得
 	/// </summary>
-	/// <typeparam name="Type">ゲームオブジェクトの種類</typeparam>
-	/// <param name="objects">ゲームオブジェクトの配列</param>
 	/// <param name="objectName">ゲームオブジェクトの名前</param>
-	/// <param name="result">追加するゲームオブジェクトの配列</param>
-	template <typename Type>
-	void CollectGameObjectsByName(const std::vector<std::unique_ptr<GameObject>>& objects, const std::string& objectName, std::vector<Type*>& result) const;
+	/// <returns>ゲームオブジェクトの配列（ない場合はnullptr）</returns>
+	const std::vector<GameObject*>* FindGameObjectsByName(const std::string& objectName) const;
 
 	/// <summary>
-	/// 指定した名前を持つゲームオブジェクトを配列に追加
+	/// 指定した文字列を名前に含むゲームオブジェクトの配列を名前ごとに取得
 	/// </summary>
-	/// <typeparam name="Type">ゲームオブジェクトの種類</typeparam>
-	/// <param name="objects">ゲームオブジェクトの配列</param>
 	/// <param name="searchString">探す文字列</param>
-	/// <param name="result">追加するゲームオブジェクトの配列</param>
-	template <typename Type>
-	void CollectGameObjectsByStringProperty(const std::vector<std::unique_ptr<GameObject>>& objects, const std::string& searchString, std::vector<Type*>& result) const;
+	/// <returns>名前ごとのゲームオブジェクトの配列</returns>
+	std::vector<const std::vector<GameObject*>*> FindGameObjectsByStringProperty(const std::string& searchString) const;
 
 private:
     static GameObjectManager* instance_;
 
+    //コンポーネントのストレージ（登録した順、ゲームオブジェクトより後に破棄する）
+    std::vector<std::unique_ptr<IComponentStorage>> componentStorages_;
+
+    //型の番号ごとのストレージ
+    std::vector<IComponentStorage*> componentStoragesByTypeId_;
+
     std::vector<std::unique_ptr<GameObject>> gameObjects_;
 
     std::vector<std::unique_ptr<GameObject>> pendingGameObjects_;
 
+    //ハンドルのスロット構造体
+    struct HandleSlot
+    {
+        //ゲームオブジェクト（空いている場合はnullptr）
+        GameObject* gameObject = nullptr;
+        //世代（ゲームオブジェクトが破棄されるたびに進める）
+        uint32_t generation = 0;
+    };
+
+    //ハンドルのスロット
+    std::vector<HandleSlot> handleSlots_;
+
+    //空いているスロットの番号
+    std::vector<uint32_t> freeHandleIndices_;
+
+    //名前ごとのゲームオブジェクト（保留中のものも含む、作成した順）
+    std::unordered_map<std::string, std::vector<GameObject*>> nameIndex_;
+
+    //名前の全ての接尾辞と名前の組から名前ごとの配列へのマップ（接尾辞の前方一致で部分一致を探す、文字列は名前の索引のキーを参照する）
+    std::map<std::pair<std::string_view, std::string_view>, const std::vector<GameObject*>*> nameSuffixIndex_;
+
+    //姿勢を更新するアニメーター（毎フレーム集め直す）
+    std::vector<AnimatorComponent*> animators_;
+
     AbstractGameObjectFactory* gameObjectFactory_ = nullptr;
 };
 
@@ -202,30 +284,37 @@ Type* GameObjectManager::CreateGameObjectInternal(const std::string& objectName)
     Type* newObject = new Type();
 	newObject->SetName(objectName);
 	newObject->SetGameObjectManager(this);
-	newObject->AddComponent<TransformComponent>();
+	newObject->template AddComponent<TransformComponent>();
     pendingGameObjects_.push_back(std::unique_ptr<GameObject>(newObject));
+	RegisterGameObject(newObject);
     return newObject;
 }
 
 template <typename Type>
-Type* GameObjectManager::GetGameObject(const std::string& objectName) const
+void GameObjectManager::RegisterComponentStorage()
 {
-	//ゲームオブジェクトを検索し名前に一致するものがあれば返す
-	if (Type* foundObject = FindGameObjectByName<Type>(pendingGameObjects_, objectName))
+	//既に登録されている場合は何もしない
+	const uint32_t typeId = ComponentTypeId::Get<Type>();
+	if (GetComponentStorage(typeId)) return;
+
+	//ストレージを生成して型の番号と対応付ける
+	componentStorages_.push_back(std::make_unique<ComponentStorage<Type>>());
+	if (typeId >= componentStoragesByTypeId_.size())
 	{
-		return foundObject;
+		componentStoragesByTypeId_.resize(typeId + 1, nullptr);
 	}
-	return FindGameObjectByName<Type>(gameObjects_, objectName);
+	componentStoragesByTypeId_[typeId] = componentStorages_.back().get();
 }
 
 template <typename Type>
-Type* GameObjectManager::FindGameObjectByName(const std::vector<std::unique_ptr<GameObject>>& objects, const std::string& objectName) const
+Type* GameObjectManager::GetGameObject(const std::string& objectName) const
 {
-	for (const auto& gameObject : objects)
+	//名前の索引から種類が一致する最初のものを返す
+	if (const std::vector<GameObject*>* gameObjects = FindGameObjectsByName(objectName))
 	{
-		if (gameObject->GetName() == objectName)
+		for (GameObject* gameObject : *gameObjects)
 		{
-			if (Type* castedObject = dynamic_cast<Type*>(gameObject.get()))
+			if (Type* castedObject = dynamic_cast<Type*>(gameObject))
 			{
 				return castedObject;
 			}
@@ -235,24 +324,25 @@ Type* GameObjectManager::FindGameObjectByName(const std::vector<std::unique_ptr<
 }
 
 template <typename Type>
-Type* GameObjectManager::GetGameObjectByStringProperty(const std::string& searchString) const
+Type* GameObjectManager::GetGameObject(const GameObjectHandle& handle) const
 {
-	// 文字列に一致するプロパティを持つゲームオブジェクトを検索する
-	if (Type* foundObject = FindGameObjectByStringProperty<Type>(pendingGameObjects_, searchString))
+	//スロットの世代が一致しない場合は破棄されている
+	if (handle.index >= handleSlots_.size() || handleSlots_[handle.index].generation != handle.generation)
 	{
-		return foundObject;
+		return nullptr;
 	}
-	return FindGameObjectByStringProperty<Type>(gameObjects_, searchString);
+	return dynamic_cast<Type*>(handleSlots_[handle.index].gameObject);
 }
 
 template <typename Type>
-Type* GameObjectManager::FindGameObjectByStringProperty(const std::vector<std::unique_ptr<GameObject>>& objects, const std::string& searchString) const
+Type* GameObjectManager::GetGameObjectByStringProperty(const std::string& searchString) const
 {
-	for (const auto& gameObject : objects)
+	//文字列を含む名前ごとに種類が一致するものを探す
+	for (const std::vector<GameObject*>* gameObjects : FindGameObjectsByStringProperty(searchString))
 	{
-		if (gameObject->GetName().find(searchString) != std::string::npos)
+		for (GameObject* gameObject : *gameObjects)
 		{
-			if (Type* castedObject = dynamic_cast<Type*>(gameObject.get()))
+			if (Type* castedObject = dynamic_cast<Type*>(gameObject))
 			{
 				return castedObject;
 			}
@@ -264,51 +354,35 @@ Type* GameObjectManager::FindGameObjectByStringProperty(const std::vector<std::u
 template <typename Type>
 std::vector<Type*> GameObjectManager::GetGameObjects(const std::string& objectName) const
 {
-	std::vector<Type*> gameObjects;
-	//保留中のゲームオブジェクトから名前に一致するものを収集
-	CollectGameObjectsByName<Type>(pendingGameObjects_, objectName, gameObjects);
-	//既存のゲームオブジェクトからも収集
-	CollectGameObjectsByName<Type>(gameObjects_, objectName, gameObjects);
-	return gameObjects;
-}
-
-template <typename Type>
-void GameObjectManager::CollectGameObjectsByName(const std::vector<std::unique_ptr<GameObject>>& objects, const std::string& objectName, std::vector<Type*>& result) const
-{
-	for (const auto& gameObject : objects)
+	std::vector<Type*> result;
+	//名前の索引から種類が一致するものを収集
+	if (const std::vector<GameObject*>* gameObjects = FindGameObjectsByName(objectName))
 	{
-		if (gameObject->GetName() == objectName)
+		for (GameObject* gameObject : *gameObjects)
 		{
-			if (Type* castedObject = dynamic_cast<Type*>(gameObject.get()))
+			if (Type* castedObject = dynamic_cast<Type*>(gameObject))
 			{
 				result.push_back(castedObject);
 			}
 		}
 	}
+	return result;
 }
 
 template <typename Type>
 std::vector<Type*> GameObjectManager::GetGameObjectsByStringProperty(const std::string& searchString) const
 {
-	std::vector<Type*> gameObjects;
-	//保留中のゲームオブジェクトから名前に一致するものを収集
-	CollectGameObjectsByStringProperty<Type>(pendingGameObjects_, searchString, gameObjects);
-	//既存のゲームオブジェクトからも収集
-	CollectGameObjectsByStringProperty<Type>(gameObjects_, searchString, gameObjects);
-	return gameObjects;
-}
-
-template <typename Type>
-void GameObjectManager::CollectGameObjectsByStringProperty(const std::vector<std::unique_ptr<GameObject>>& objects, const std::string& searchString, std::vector<Type*>& result) const
-{
-	for (const auto& gameObject : objects)
+	std::vector<Type*> result;
+	//文字列を含む名前ごとに種類が一致するものを収集
+	for (const std::vector<GameObject*>* gameObjects : FindGameObjectsByStringProperty(searchString))
 	{
-		if (gameObject->GetName().find(searchString) != std::string::npos)
+		for (GameObject* gameObject : *gameObjects)
 		{
-			if (Type* castedObject = dynamic_cast<Type*>(gameObject.get()))
+			if (Type* castedObject = dynamic_cast<Type*>(gameObject))
 			{
 				result.push_back(castedObject);
 			}
 		}
 	}
+	return result;
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+/**
+ * @file GameObjectPool.cpp
+ * @brief ゲームオブジェクトのメモリを大きさごとにまとめて確保し、破棄されたものを再利用するクラス
+ * @author 青木智滉
+ * @date
+ */
+
+#include "GameObjectPool.h"
+#include <cstring>
+
+//実体定義
+GameObjectPool* GameObjectPool::instance_ = nullptr;
+
+GameObjectPool* GameObjectPool::GetInstance()
+{
+	if (instance_ == nullptr)
+	{
+		instance_ = new GameObjectPool();
+	}
+	return instance_;
+}
+
+void GameObjectPool::Destroy()
+{
+	if (instance_)
+	{
+		delete instance_;
+		instance_ = nullptr;
+	}
+}
+
+void* GameObjectPool::Allocate(const size_t size)
+{
+	//空いているブロックがなければチャンクをまとめて確保して分割する
+	const size_t blockSize = GetBlockSize(size);
+	std::lock_guard<std::mutex> lock(mutex_);
+	Pool& pool = pools_[blockSize];
+	if (pool.freeBlocks.empty())
+	{
+		std::byte* chunk = pool.chunks.emplace_back(new std::byte[blockSize * kBlocksPerChunk]).get();
+		for (size_t i = kBlocksPerChunk; i > 0; --i)
+		{
+			pool.freeBlocks.push_back(chunk + (i - 1) * blockSize);
+		}
+	}
+
+	//末尾のブロックを使う（先頭から順に使われる）
+	void* block = pool.freeBlocks.back();
+	pool.freeBlocks.pop_back();
+	return block;
+}
+
+void GameObjectPool::Free(void* block, const size_t size)
+{
+	const size_t blockSize = GetBlockSize(size);
+#ifdef _DEBUG
+	//破棄されたゲームオブジェクトへのアクセスに気付けるように埋めておく
+	std::memset(block, 0xDD, blockSize);
+#endif
+	std::lock_guard<std::mutex> lock(mutex_);
+	pools_[blockSize].freeBlocks.push_back(block);
+}
+
+size_t GameObjectPool::GetBlockSize(const size_t size)
+{
+	const size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+	return (size + alignment - 1) / alignment * alignment;
+}
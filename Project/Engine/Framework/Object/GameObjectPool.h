@@ -0,0 +1,76 @@
+/**
+ * @file GameObjectPool.h
+ * @brief ゲームオブジェクトのメモリを大きさごとにまとめて確保し、破棄されたものを再利用するクラス
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class GameObjectPool
+{
+public:
+	//1回にまとめて確保するブロックの数
+	static const size_t kBlocksPerChunk = 32;
+
+	/// <summary>
+	/// インスタンスを取得
+	/// </summary>
+	/// <returns>インスタンス</returns>
+	static GameObjectPool* GetInstance();
+
+	/// <summary>
+	/// 破棄処理（全てのゲームオブジェクトが破棄された後に行う）
+	/// </summary>
+	static void Destroy();
+
+	/// <summary>
+	/// ブロックを確保（読み込みスレッドからも生成されるので排他して行う）
+	/// </summary>
+	/// <param name="size">ゲームオブジェクトの大きさ</param>
+	/// <returns>ブロック</returns>
+	void* Allocate(const size_t size);
+
+	/// <summary>
+	/// ブロックを返却して同じ大きさのゲームオブジェクトで再利用する（排他して行う）
+	/// </summary>
+	/// <param name="block">ブロック</param>
+	/// <param name="size">ゲームオブジェクトの大きさ</param>
+	void Free(void* block, const size_t size);
+
+private:
+	//大きさごとのプール
+	struct Pool
+	{
+		//空いているブロック
+		std::vector<void*> freeBlocks{};
+		//確保したチャンク
+		std::vector<std::unique_ptr<std::byte[]>> chunks{};
+	};
+
+	GameObjectPool() = default;
+	~GameObjectPool() = default;
+	GameObjectPool(const GameObjectPool&) = delete;
+	GameObjectPool& operator=(const GameObjectPool&) = delete;
+
+	/// <summary>
+	/// ブロックの大きさを求める（次のブロックの先頭がアラインメントに揃うように切り上げる）
+	/// </summary>
+	/// <param name="size">ゲームオブジェクトの大きさ</param>
+	/// <returns>ブロックの大きさ</returns>
+	static size_t GetBlockSize(const size_t size);
+
+private:
+	static GameObjectPool* instance_;
+
+	//ブロックの大きさごとのプール（派生クラスごとにほぼ分かれる）
+	std::unordered_map<size_t, Pool> pools_{};
+
+	//プールを排他するミューテックス
+	std::mutex mutex_{};
+};
@@ -30,14 +30,31 @@ void LevelManager::LoadLevelAndCreateObjects(const std::string& fileName)
 	LevelManager::GetInstance()->LoadLevelAndCreateGameObjectsInternal(fileName);
 }
 
+void LevelManager::RequestModels(const std::string& fileName)
+{
+	//レベルデータで使われているモデルの読み込みを要求
+	for (const ObjectData& objectData : LevelManager::GetInstance()->LoadLevelData(fileName)->objects)
+	{
+		if (!objectData.modelName.empty())
+		{
+			ModelManager::LoadAsync(objectData.modelName);
+		}
+	}
+}
+
 void LevelManager::LoadLevelAndCreateGameObjectsInternal(const std::string& fileName)
 {
-	//読み込んだことのあるレベルデータなら再作成
+	//レベルデータを読み込んでゲームオブジェクトを作成
+	CreateGameObjects(LoadLevelData(fileName));
+}
+
+const LevelManager::LevelData* LevelManager::LoadLevelData(const std::string& fileName)
+{
+	//読み込んだことのあるレベルデータならそのまま返す
 	auto it = levelDatas_.find(fileName);
 	if (it != levelDatas_.end())
 	{
-		CreateGameObjects(it->second.get());
-		return;
+		return it->second.get();
 	}
 
 	//連結してフルパスを得る
@@ -81,8 +98,7 @@ void LevelManager::LoadLevelAndCreateGameObjectsInternal(const std::string& file
 	//レベルデータをマップに保存
 	levelDatas_[fileName] = std::unique_ptr<LevelData>(levelData);
 
-	//読み込んだゲームオブジェクトを作成
-	CreateGameObjects(levelData);
+	return levelData;
 }
 
 void LevelManager::ProcessObject(const nlohmann::json& object, LevelData* levelData)
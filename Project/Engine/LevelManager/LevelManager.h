@@ -62,6 +62,12 @@ public:
     /// <param name="fileName">ファイル名</param>
     static void LoadLevelAndCreateObjects(const std::string& fileName);
 
+    /// <summary>
+    /// レベルデータで使われているモデルの読み込みを要求（ゲームオブジェクトは生成しない）
+    /// </summary>
+    /// <param name="fileName">ファイル名</param>
+    static void RequestModels(const std::string& fileName);
+
 private:
     LevelManager() = default;
     ~LevelManager() = default;
@@ -74,6 +80,13 @@ private:
     /// <param name="fileName">ファイル名</param>
     void LoadLevelAndCreateGameObjectsInternal(const std::string& fileName);
 
+    /// <summary>
+    /// レベルデータを読み込む（読み込んだことがあればそのまま返す）
+    /// </summary>
+    /// <param name="fileName">ファイル名</param>
+    /// <returns>レベルデータ</returns>
+    const LevelData* LoadLevelData(const std::string& fileName);
+
     /// <summary>
     /// jsonデータを基にレベルデータを作成
     /// </summary>
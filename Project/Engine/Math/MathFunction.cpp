@@ -308,6 +308,46 @@ namespace Mathf
 	}
 
 
+	Matrix4x4 InverseTranspose(const Matrix4x4& m)
+	{
+		//アフィン行列でない場合は一般の逆行列から求める
+		if (m.m[0][3] != 0.0f || m.m[1][3] != 0.0f || m.m[2][3] != 0.0f || m.m[3][3] != 1.0f)
+		{
+			return Transpose(Inverse(m));
+		}
+
+		//3x3部分の逆転置行列は余因子行列を行列式で割ったもの
+		Matrix4x4 result{};
+		result.m[0][0] = m.m[1][1] * m.m[2][2] - m.m[1][2] * m.m[2][1];
+		result.m[0][1] = m.m[1][2] * m.m[2][0] - m.m[1][0] * m.m[2][2];
+		result.m[0][2] = m.m[1][0] * m.m[2][1] - m.m[1][1] * m.m[2][0];
+		result.m[1][0] = m.m[2][1] * m.m[0][2] - m.m[2][2] * m.m[0][1];
+		result.m[1][1] = m.m[2][2] * m.m[0][0] - m.m[2][0] * m.m[0][2];
+		result.m[1][2] = m.m[2][0] * m.m[0][1] - m.m[2][1] * m.m[0][0];
+		result.m[2][0] = m.m[0][1] * m.m[1][2] - m.m[0][2] * m.m[1][1];
+		result.m[2][1] = m.m[0][2] * m.m[1][0] - m.m[0][0] * m.m[1][2];
+		result.m[2][2] = m.m[0][0] * m.m[1][1] - m.m[0][1] * m.m[1][0];
+		float determinant = m.m[0][0] * result.m[0][0] + m.m[0][1] * result.m[0][1] + m.m[0][2] * result.m[0][2];
+		assert(determinant != 0.0f);
+		float determinantRecp = 1.0f / determinant;
+
+		//平行移動の逆変換は4列目に入る
+		for (int i = 0; i < 3; ++i)
+		{
+			result.m[i][0] *= determinantRecp;
+			result.m[i][1] *= determinantRecp;
+			result.m[i][2] *= determinantRecp;
+			result.m[i][3] = -(m.m[3][0] * result.m[i][0] + m.m[3][1] * result.m[i][1] + m.m[3][2] * result.m[i][2]);
+		}
+		result.m[3][0] = 0.0f;
+		result.m[3][1] = 0.0f;
+		result.m[3][2] = 0.0f;
+		result.m[3][3] = 1.0f;
+
+		return result;
+	}
+
+
 	Matrix4x4 MakeIdentity4x4()
 	{
 		Matrix4x4 result{};
@@ -471,31 +511,64 @@ namespace Mathf
 
 	Matrix4x4 MakeRotateMatrix(const Vector3& rotate)
 	{
-		Matrix4x4 rotateXMatrix = MakeRotateXMatrix(rotate.x);
-		Matrix4x4 rotateYMatrix = MakeRotateYMatrix(rotate.y);
-		Matrix4x4 rotateZMatrix = MakeRotateZMatrix(rotate.z);
-		return rotateXMatrix * rotateYMatrix * rotateZMatrix;
+		//X,Y,Z軸の回転行列を順にかけたものを直接計算する
+		const float sinX = std::sin(rotate.x), cosX = std::cos(rotate.x);
+		const float sinY = std::sin(rotate.y), cosY = std::cos(rotate.y);
+		const float sinZ = std::sin(rotate.z), cosZ = std::cos(rotate.z);
+
+		Matrix4x4 result{};
+		result.m[0][0] = cosY * cosZ;
+		result.m[0][1] = cosY * sinZ;
+		result.m[0][2] = -sinY;
+		result.m[0][3] = 0.0f;
+
+		result.m[1][0] = sinX * sinY * cosZ - cosX * sinZ;
+		result.m[1][1] = sinX * sinY * sinZ + cosX * cosZ;
+		result.m[1][2] = sinX * cosY;
+		result.m[1][3] = 0.0f;
+
+		result.m[2][0] = cosX * sinY * cosZ + sinX * sinZ;
+		result.m[2][1] = cosX * sinY * sinZ - sinX * cosZ;
+		result.m[2][2] = cosX * cosY;
+		result.m[2][3] = 0.0f;
+
+		result.m[3][0] = 0.0f;
+		result.m[3][1] = 0.0f;
+		result.m[3][2] = 0.0f;
+		result.m[3][3] = 1.0f;
+
+		return result;
 	}
 
 
 	Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate)
 	{
-		Matrix4x4 result{};
-		Matrix4x4 scaleMatrix = MakeScaleMatrix(scale);
-		Matrix4x4 rotateMatrix = MakeRotateMatrix(rotate);
-		Matrix4x4 translateMatrix = MakeTranslateMatrix(translate);
-		result = scaleMatrix * rotateMatrix * translateMatrix;
-		return result;
+		return MakeAffineMatrix(scale, MakeRotateMatrix(rotate), translate);
 	}
 
 
 	Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Quaternion& quaternion, const Vector3& translation)
 	{
+		return MakeAffineMatrix(scale, MakeRotateMatrix(quaternion), translation);
+	}
+
+
+	Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Matrix4x4& rotateMatrix, const Vector3& translate)
+	{
+		//スケール、回転、平行移動の行列をかけずに、回転行列の各行をスケール倍して平行移動を入れる
+		const float scales[3] = { scale.x, scale.y, scale.z };
 		Matrix4x4 result{};
-		Matrix4x4 scaleMatrix = MakeScaleMatrix(scale);
-		Matrix4x4 rotateMatrix = MakeRotateMatrix(quaternion);
-		Matrix4x4 translateMatrix = MakeTranslateMatrix(translation);
-		result = scaleMatrix * rotateMatrix * translateMatrix;
+		for (int i = 0; i < 3; ++i)
+		{
+			result.m[i][0] = rotateMatrix.m[i][0] * scales[i];
+			result.m[i][1] = rotateMatrix.m[i][1] * scales[i];
+			result.m[i][2] = rotateMatrix.m[i][2] * scales[i];
+			result.m[i][3] = 0.0f;
+		}
+		result.m[3][0] = translate.x;
+		result.m[3][1] = translate.y;
+		result.m[3][2] = translate.z;
+		result.m[3][3] = 1.0f;
 		return result;
 	}
 
@@ -759,7 +832,7 @@ namespace Mathf
 		}
 
 		float q[4];
-		float v = std::sqrtf(elem[biggestIdx]) * 0.5f;
+		float v = std::sqrt(elem[biggestIdx]) * 0.5f;
 		q[biggestIdx] = v;
 		float mult = 0.25f / v;
 
@@ -188,6 +188,13 @@ namespace Mathf
 	/// <returns>転置された行列</returns>
 	Matrix4x4 Transpose(const Matrix4x4& m);
 
+	/// <summary>
+	/// 逆転置行列を計算（アフィン行列の場合は3x3部分の余因子から求める）
+	/// </summary>
+	/// <param name="m">行列</param>
+	/// <returns>逆転置行列</returns>
+	Matrix4x4 InverseTranspose(const Matrix4x4& m);
+
 	/// <summary>
 	/// 単位行列を作成
 	/// </summary>
@@ -254,6 +261,15 @@ namespace Mathf
 	/// <returns>アフィン行列</returns>
 	Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Quaternion& quaternion, const Vector3& translation);
 
+	/// <summary>
+	/// アフィン行列を作成
+	/// </summary>
+	/// <param name="scale">スケール</param>
+	/// <param name="rotateMatrix">回転行列</param>
+	/// <param name="translate">座標</param>
+	/// <returns>アフィン行列</returns>
+	Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Matrix4x4& rotateMatrix, const Vector3& translate);
+
 	/// <summary>
 	/// 透視投影行列を作成
 	/// </summary>
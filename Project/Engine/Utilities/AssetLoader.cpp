@@ -0,0 +1,138 @@
+/**
+ * @file AssetLoader.cpp
+ * @brief アセットの読み込みをワーカースレッドで並列に行い、完了処理を順番に行うクラス
+ * @author 青木智滉
+ * @date
+ */
+
+#include "AssetLoader.h"
+#include <chrono>
+
+AssetLoader* AssetLoader::instance_ = nullptr;
+
+AssetLoader* AssetLoader::GetInstance()
+{
+	if (instance_ == nullptr)
+	{
+		instance_ = new AssetLoader();
+	}
+	return instance_;
+}
+
+void AssetLoader::Destroy()
+{
+	if (instance_)
+	{
+		delete instance_;
+		instance_ = nullptr;
+	}
+}
+
+AssetLoader::~AssetLoader()
+{
+	//ワーカースレッドの読み込みが終わるまで待つ（完了処理は行わないので読み込みの例外も捨てる）
+	for (PendingRequest& request : requests_)
+	{
+		try
+		{
+			request.job.get();
+		}
+		catch (...)
+		{
+		}
+	}
+}
+
+AssetLoader::Handle AssetLoader::Request(const LoadFunction& loadFunction)
+{
+	//ワーカースレッドで読み込み、完了処理を受け取る
+	PendingRequest request{};
+	request.finalizeFunction = std::make_shared<FinalizeFunction>();
+	request.job = JobSystem::GetInstance()->Submit([loadFunction, finalizeFunction = request.finalizeFunction]() {
+		*finalizeFunction = loadFunction();
+		});
+	Handle handle = request.promise.get_future().share();
+
+	//完了処理を待つ読み込みに追加
+	std::lock_guard<std::mutex> lock(mutex_);
+	requests_.push_back(std::move(request));
+	return handle;
+}
+
+void AssetLoader::Wait(const Handle& handle)
+{
+	//無効なハンドルは読み込み済み
+	if (!handle.valid()) return;
+
+	//完了処理が終わるまで完了処理を進める
+	while (handle.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		//待っている読み込みがない場合は別のスレッドが完了処理を行っているので終わるまで待つ
+		std::exception_ptr exception = nullptr;
+		if (!FinalizeNext(exception))
+		{
+			break;
+		}
+	}
+
+	//読み込みや完了処理で発生した例外は待っているスレッドで投げ直す
+	handle.get();
+}
+
+void AssetLoader::WaitAll()
+{
+	//全て完了処理を行ってから最初に発生した例外を投げ直す
+	std::exception_ptr firstException = nullptr;
+	std::exception_ptr exception = nullptr;
+	while (FinalizeNext(exception))
+	{
+		if (exception && !firstException)
+		{
+			firstException = exception;
+		}
+		exception = nullptr;
+	}
+	if (firstException)
+	{
+		std::rethrow_exception(firstException);
+	}
+}
+
+bool AssetLoader::FinalizeNext(std::exception_ptr& exception)
+{
+	//読み込み終わったものを探して取り出す（なければ最も古いもの。完了処理の中で新しく要求されることがあるため取り出してから行う）
+	PendingRequest request{};
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (requests_.empty()) return false;
+		auto it = requests_.begin();
+		for (auto candidate = requests_.begin(); candidate != requests_.end(); ++candidate)
+		{
+			if (candidate->job.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+			{
+				it = candidate;
+				break;
+			}
+		}
+		request = std::move(*it);
+		requests_.erase(it);
+	}
+
+	//読み込みの終了を待って完了処理を行う（例外はハンドルに渡す）
+	try
+	{
+		request.job.get();
+		if (*request.finalizeFunction)
+		{
+			(*request.finalizeFunction)();
+		}
+	}
+	catch (...)
+	{
+		exception = std::current_exception();
+		request.promise.set_exception(exception);
+		return true;
+	}
+	request.promise.set_value();
+	return true;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file AssetLoader.h
+ * @brief アセットの読み込みをワーカースレッドで並列に行い、完了処理を順番に行うクラス
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include "JobSystem.h"
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+
+class AssetLoader
+{
+public:
+	//読み込みの完了を待つハンドル（無効なハンドルは読み込み済みとして扱う）
+	using Handle = std::shared_future<void>;
+
+	//GPUリソースの作成など、待機したスレッドで順番に行う完了処理
+	using FinalizeFunction = std::function<void()>;
+
+	//ワーカースレッドで行うファイルの読み込みや解析（戻り値は完了処理、なければ空）
+	using LoadFunction = std::function<FinalizeFunction()>;
+
+	/// <summary>
+	/// インスタンスを取得
+	/// </summary>
+	/// <returns>インスタンス</returns>
+	static AssetLoader* GetInstance();
+
+	/// <summary>
+	/// 破棄処理
+	/// </summary>
+	static void Destroy();
+
+	/// <summary>
+	/// 読み込みを要求（ロード用のスレッドやワーカースレッドの読み込み中からも要求できる）
+	/// </summary>
+	/// <param name="loadFunction">ワーカースレッドで行う読み込み</param>
+	/// <returns>完了処理まで終わったことを待つハンドル</returns>
+	Handle Request(const LoadFunction& loadFunction);
+
+	/// <summary>
+	/// 指定した読み込みが終わるまで、読み込み終わったものから完了処理を行う（読み込みや完了処理の例外は投げ直す）
+	/// </summary>
+	/// <param name="handle">ハンドル</param>
+	void Wait(const Handle& handle);
+
+	/// <summary>
+	/// 全ての読み込みが終わるまで完了処理を行う（完了処理の中で要求されたものも含む。例外が発生した場合は最後に最初の例外を投げ直す）
+	/// </summary>
+	void WaitAll();
+
+private:
+	//完了処理を待っている読み込み
+	struct PendingRequest
+	{
+		//ワーカースレッドの処理のハンドル
+		JobSystem::JobHandle job;
+		//ワーカースレッドが書き込む完了処理
+		std::shared_ptr<FinalizeFunction> finalizeFunction;
+		//完了処理まで終わったことを通知する
+		std::promise<void> promise;
+	};
+
+	AssetLoader() = default;
+	~AssetLoader();
+	AssetLoader(const AssetLoader&) = delete;
+	AssetLoader& operator=(const AssetLoader&) = delete;
+
+	/// <summary>
+	/// 読み込み終わったものを1つ選んで完了処理を行う（なければ最も古いものを待つ）
+	/// </summary>
+	/// <param name="exception">読み込みや完了処理で発生した例外（ハンドルにも渡す）</param>
+	/// <returns>完了処理を行ったかどうか（待っている読み込みがなければfalse）</returns>
+	bool FinalizeNext(std::exception_ptr& exception);
+
+private:
+	static AssetLoader* instance_;
+
+	//完了処理を待っている読み込み（複数のスレッドから要求・待機されるのでミューテックスで保護する）
+	std::deque<PendingRequest> requests_{};
+	std::mutex mutex_{};
+};
@@ -0,0 +1,176 @@
+/**
+ * @file JobSystem.cpp
+ * @brief ワーカースレッドで処理を並列に実行するクラス
+ * @author 青木智滉
+ * @date
+ */
+
+#include "JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+JobSystem* JobSystem::instance_ = nullptr;
+
+JobSystem* JobSystem::GetInstance()
+{
+	if (instance_ == nullptr)
+	{
+		instance_ = new JobSystem();
+	}
+	return instance_;
+}
+
+void JobSystem::Destroy()
+{
+	if (instance_)
+	{
+		delete instance_;
+		instance_ = nullptr;
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	Finalize();
+}
+
+void JobSystem::Initialize(uint32_t workerCount)
+{
+	//既にワーカースレッドがあれば終了させる
+	Finalize();
+
+	//ワーカースレッドの数を決める
+	if (workerCount == 0)
+	{
+		const uint32_t hardwareThreadCount = std::thread::hardware_concurrency();
+		workerCount = hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 0;
+	}
+
+	//ワーカースレッドを起動（番号0は呼び出したスレッド）
+	isFinished_ = false;
+	for (uint32_t i = 0; i < workerCount; ++i)
+	{
+		workers_.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+	}
+}
+
+void JobSystem::Finalize()
+{
+	//ワーカースレッドに終了を通知
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		isFinished_ = true;
+	}
+	condition_.notify_all();
+
+	//全てのワーカースレッドの終了を待つ
+	for (std::thread& worker : workers_)
+	{
+		worker.join();
+	}
+	workers_.clear();
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t grainSize, const RangeFunction& function)
+{
+	//分割数を計算
+	grainSize = std::max<uint32_t>(grainSize, 1);
+	const uint32_t chunkCount = (count + grainSize - 1) / grainSize;
+
+	//ワーカースレッドがない、または分割する必要がなければそのまま実行
+	if (workers_.empty() || chunkCount <= 1)
+	{
+		if (count > 0)
+		{
+			function(0, count, 0);
+		}
+		return;
+	}
+
+	//ワーカースレッドと共有する状態（呼び出し元が先に戻っても安全なように共有ポインタで持つ）
+	struct SharedState
+	{
+		std::atomic<uint32_t> nextChunk{ 0 };
+		std::atomic<uint32_t> completedChunkCount{ 0 };
+		std::mutex mutex;
+		std::condition_variable condition;
+	};
+	std::shared_ptr<SharedState> state = std::make_shared<SharedState>();
+
+	//空いている分割を取り出して実行する処理
+	auto processChunks = [state, count, grainSize, chunkCount, &function](uint32_t threadIndex) {
+		for (uint32_t chunk = state->nextChunk.fetch_add(1); chunk < chunkCount; chunk = state->nextChunk.fetch_add(1))
+		{
+			const uint32_t begin = chunk * grainSize;
+			function(begin, std::min(begin + grainSize, count), threadIndex);
+			if (state->completedChunkCount.fetch_add(1) + 1 == chunkCount)
+			{
+				std::lock_guard<std::mutex> lock(state->mutex);
+				state->condition.notify_one();
+			}
+		}
+		};
+
+	//ワーカースレッドに処理を積む（分割を取り出せなかったワーカーは何もせずに戻るので関数は参照しない）
+	const uint32_t helperCount = std::min<uint32_t>(static_cast<uint32_t>(workers_.size()), chunkCount - 1);
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (uint32_t i = 0; i < helperCount; ++i)
+		{
+			jobs_.push(processChunks);
+		}
+	}
+	condition_.notify_all();
+
+	//呼び出したスレッドも処理に参加
+	processChunks(0);
+
+	//全ての分割が終わるまで待機
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->condition.wait(lock, [&]() { return state->completedChunkCount.load() == chunkCount; });
+}
+
+JobSystem::JobHandle JobSystem::Submit(const std::function<void()>& function)
+{
+	//完了を通知するタスク（std::functionに入れるため共有ポインタで持つ）
+	std::shared_ptr<std::packaged_task<void()>> task = std::make_shared<std::packaged_task<void()>>(function);
+	JobHandle handle = task->get_future().share();
+
+	//ワーカースレッドがなければその場で実行
+	if (workers_.empty())
+	{
+		(*task)();
+		return handle;
+	}
+
+	//ワーカースレッドに処理を積む
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		jobs_.push([task](uint32_t) { (*task)(); });
+	}
+	condition_.notify_one();
+	return handle;
+}
+
+void JobSystem::WorkerLoop(uint32_t threadIndex)
+{
+	while (true)
+	{
+		//処理が積まれるか終了が通知されるまで待機
+		std::function<void(uint32_t)> job;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			condition_.wait(lock, [&]() { return isFinished_ || !jobs_.empty(); });
+			if (jobs_.empty())
+			{
+				return;
+			}
+			job = std::move(jobs_.front());
+			jobs_.pop();
+		}
+
+		//処理を実行
+		job(threadIndex);
+	}
+}
@@ -0,0 +1,91 @@
+/**
+ * @file JobSystem.h
+ * @brief ワーカースレッドで処理を並列に実行するクラス
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+class JobSystem
+{
+public:
+	//並列に実行する処理（範囲の先頭、範囲の終端、実行しているスレッドの番号）
+	using RangeFunction = std::function<void(uint32_t begin, uint32_t end, uint32_t threadIndex)>;
+
+	//積んだ処理の完了を待つハンドル
+	using JobHandle = std::shared_future<void>;
+
+	/// <summary>
+	/// インスタンスを取得
+	/// </summary>
+	/// <returns>インスタンス</returns>
+	static JobSystem* GetInstance();
+
+	/// <summary>
+	/// 破棄処理
+	/// </summary>
+	static void Destroy();
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="workerCount">ワーカースレッドの数（0の場合はハードウェアのスレッド数-1）</param>
+	void Initialize(uint32_t workerCount = 0);
+
+	/// <summary>
+	/// ワーカースレッドを終了
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 範囲を分割して並列に実行し、全て終わるまで待機する（呼び出したスレッドも処理に参加する）
+	/// </summary>
+	/// <param name="count">要素数</param>
+	/// <param name="grainSize">一度に処理する要素数</param>
+	/// <param name="function">実行する処理</param>
+	void ParallelFor(uint32_t count, uint32_t grainSize, const RangeFunction& function);
+
+	/// <summary>
+	/// 処理を1つワーカースレッドに積む（ワーカースレッドがなければその場で実行する。処理の中で他の処理の完了を待たないこと）
+	/// </summary>
+	/// <param name="function">実行する処理</param>
+	/// <returns>完了を待つハンドル</returns>
+	JobHandle Submit(const std::function<void()>& function);
+
+	//処理に参加するスレッドの数を取得（呼び出したスレッドを含む）
+	const uint32_t GetThreadCount() const { return static_cast<uint32_t>(workers_.size()) + 1; };
+
+private:
+	JobSystem() = default;
+	~JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/// <summary>
+	/// ワーカースレッドの処理
+	/// </summary>
+	/// <param name="threadIndex">スレッドの番号</param>
+	void WorkerLoop(uint32_t threadIndex);
+
+private:
+	static JobSystem* instance_;
+
+	std::vector<std::thread> workers_{};
+
+	std::queue<std::function<void(uint32_t)>> jobs_{};
+
+	std::mutex mutex_{};
+
+	std::condition_variable condition_{};
+
+	bool isFinished_ = false;
+};
@@ -0,0 +1,73 @@
+/**
+ * @file MappedFile.cpp
+ * @brief ファイルを読み取り専用でメモリにマップするクラス
+ * @author 青木智滉
+ * @date
+ */
+
+#include "MappedFile.h"
+#include "Log.h"
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const std::string& filePath)
+{
+	//既に開いている場合は閉じる
+	Close();
+
+	//ファイルを開く
+	fileHandle_ = CreateFileW(MyUtility::ConvertString(filePath).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+	if (fileHandle_ == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	//サイズを取得（空のファイルはマップできない）
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(fileHandle_, &fileSize) || fileSize.QuadPart == 0)
+	{
+		Close();
+		return false;
+	}
+	size_ = static_cast<size_t>(fileSize.QuadPart);
+
+	//ファイル全体を読み取り専用でマップ
+	mappingHandle_ = CreateFileMappingW(fileHandle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle_ == nullptr)
+	{
+		Close();
+		return false;
+	}
+	data_ = static_cast<const uint8_t*>(MapViewOfFile(mappingHandle_, FILE_MAP_READ, 0, 0, 0));
+	if (data_ == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	//マップを解除してハンドルを閉じる
+	if (data_)
+	{
+		UnmapViewOfFile(data_);
+		data_ = nullptr;
+	}
+	if (mappingHandle_)
+	{
+		CloseHandle(mappingHandle_);
+		mappingHandle_ = nullptr;
+	}
+	if (fileHandle_ != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(fileHandle_);
+		fileHandle_ = INVALID_HANDLE_VALUE;
+	}
+	size_ = 0;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file MappedFile.h
+ * @brief ファイルを読み取り専用でメモリにマップするクラス
+ * @author 青木智滉
+ * @date
+ */
+
+#pragma once
+#include <Windows.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/// <summary>
+	/// ファイルを読み取り専用でマップ
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <returns>マップできたかどうか</returns>
+	bool Open(const std::string& filePath);
+
+	/// <summary>
+	/// マップを解除してファイルを閉じる
+	/// </summary>
+	void Close();
+
+	//マップしたデータを取得
+	const uint8_t* GetData() const { return data_; };
+
+	//ファイルのサイズを取得
+	const size_t GetSize() const { return size_; };
+
+private:
+	//ファイルのハンドル
+	HANDLE fileHandle_ = INVALID_HANDLE_VALUE;
+
+	//ファイルマッピングのハンドル
+	HANDLE mappingHandle_ = nullptr;
+
+	//マップしたデータの先頭
+	const uint8_t* data_ = nullptr;
+
+	//ファイルのサイズ
+	size_t size_ = 0;
+};